@@ -7,7 +7,12 @@
 #include "bgfx_utils.h"
 
 #include <bx/uint32_t.h>
+#include <bx/pixelformat.h>
+#include <bx/rng.h>
 #include "packrect.h"
+#include <imgui/imgui.h>
+
+#include "../../src/image.h"
 
 #include <list>
 
@@ -115,6 +120,33 @@ static void updateTextureCubeRectBgra8(bgfx::TextureHandle _handle, uint8_t _sid
 static const uint16_t textureside   = 512;
 static const uint32_t texture2dSize = 256;
 
+// Image convert benchmark converts RGBA8 image to each format, once with
+// format specific fast path and once with generic unpack/pack path.
+#define CONVERT_BENCHMARK_SIZE       512
+#define CONVERT_BENCHMARK_NUM_FRAMES 120
+
+struct ConvertBenchmark
+{
+	const char* m_name;
+	bgfx::TextureFormat::Enum m_format;
+	uint32_t m_bpp;
+	bx::PackFn m_pack;
+};
+
+static const ConvertBenchmark s_convertBenchmark[] =
+{
+	{ "R8",      bgfx::TextureFormat::R8,      8,   bx::packR8      },
+	{ "RGBA16F", bgfx::TextureFormat::RGBA16F, 64,  bx::packRgba16F },
+	{ "RGBA32F", bgfx::TextureFormat::RGBA32F, 128, bx::packRgba32F },
+};
+
+// Buffer churn benchmark keeps pool of dynamic index buffers alive, and
+// every frame replaces part of them with buffers of random size, which
+// stresses dynamic buffer allocator with allocations and frees.
+#define CHURN_BENCHMARK_NUM_BUFFERS 512
+#define CHURN_BENCHMARK_NUM_CHURN   64
+#define CHURN_BENCHMARK_NUM_FRAMES  600
+
 class ExampleUpdate : public entry::AppI
 {
 public:
@@ -282,10 +314,117 @@ public:
 		m_hit  = 0;
 		m_miss = 0;
 
+		imguiCreate();
+
+		m_convertSrc   = NULL;
+		m_convertDst   = NULL;
+		m_convertFrame = UINT32_MAX;
+
+		m_churnFrame = UINT32_MAX;
+
 		m_updateTime = 0;
 		m_timeOffset = bx::getHPCounter();
 	}
 
+	void convertBenchmarkBegin()
+	{
+		bx::AllocatorI* allocator = entry::getAllocator();
+
+		const uint32_t size = CONVERT_BENCHMARK_SIZE*CONVERT_BENCHMARK_SIZE;
+		m_convertSrc = (uint8_t*)BX_ALIGNED_ALLOC(allocator, size*4, 16);
+		m_convertDst = BX_ALIGNED_ALLOC(allocator, size*16, 16);
+
+		for (uint32_t ii = 0; ii < size*4; ++ii)
+		{
+			m_convertSrc[ii] = uint8_t(rand() );
+		}
+
+		bx::memSet(m_convertTime, 0, sizeof(m_convertTime) );
+		m_convertFrame = 0;
+	}
+
+	void convertBenchmarkStep()
+	{
+		const uint32_t size = CONVERT_BENCHMARK_SIZE;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_convertBenchmark); ++ii)
+		{
+			const ConvertBenchmark& cb = s_convertBenchmark[ii];
+
+			const int64_t start = bx::getHPCounter();
+			bgfx::imageConvert(m_convertDst, cb.m_format, m_convertSrc, bgfx::TextureFormat::RGBA8, size, size);
+			const int64_t fast = bx::getHPCounter();
+			bgfx::imageConvert(m_convertDst, cb.m_bpp, cb.m_pack, m_convertSrc, 32, bx::unpackRgba8, size, size, size*4);
+			const int64_t generic = bx::getHPCounter();
+
+			m_convertTime[ii][0] += fast    - start;
+			m_convertTime[ii][1] += generic - fast;
+		}
+
+		++m_convertFrame;
+	}
+
+	bgfx::DynamicIndexBufferHandle churnBenchmarkCreate()
+	{
+		// Sizes from 128 bytes to 128KB, with small sizes more likely.
+		const uint32_t num = (64<<(m_rng.gen()%11) ) + m_rng.gen()%64;
+		return bgfx::createDynamicIndexBuffer(num);
+	}
+
+	void churnBenchmarkBegin()
+	{
+		for (uint32_t ii = 0; ii < CHURN_BENCHMARK_NUM_BUFFERS; ++ii)
+		{
+			m_churnBuffer[ii] = churnBenchmarkCreate();
+		}
+
+		m_churnFrame         = 0;
+		m_churnTime          = 0;
+		m_churnFragmentation = 0.0f;
+	}
+
+	void churnBenchmarkStep()
+	{
+		const int64_t start = bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < CHURN_BENCHMARK_NUM_CHURN; ++ii)
+		{
+			const uint32_t idx = m_rng.gen()%CHURN_BENCHMARK_NUM_BUFFERS;
+			bgfx::destroyDynamicIndexBuffer(m_churnBuffer[idx]);
+			m_churnBuffer[idx] = churnBenchmarkCreate();
+		}
+
+		m_churnTime += bx::getHPCounter() - start;
+
+		// Free memory that can't be used for largest block is lost to
+		// fragmentation.
+		const bgfx::Stats* stats = bgfx::getStats();
+		const uint64_t free = stats->dynamicIndexBufferSize - stats->dynamicIndexBufferUsed;
+		m_churnFragmentation = 0 == free
+			? 0.0f
+			: 1.0f - float(stats->dynamicIndexBufferLargestFree)/float(free)
+			;
+
+		++m_churnFrame;
+	}
+
+	void churnBenchmarkEnd()
+	{
+		for (uint32_t ii = 0; ii < CHURN_BENCHMARK_NUM_BUFFERS; ++ii)
+		{
+			bgfx::destroyDynamicIndexBuffer(m_churnBuffer[ii]);
+		}
+	}
+
+	void convertBenchmarkEnd()
+	{
+		bx::AllocatorI* allocator = entry::getAllocator();
+		BX_ALIGNED_FREE(allocator, m_convertSrc, 16);
+		BX_ALIGNED_FREE(allocator, m_convertDst, 16);
+		m_convertSrc = NULL;
+		m_convertDst = NULL;
+	}
+
 	virtual int shutdown() BX_OVERRIDE
 	{
 		// m_texture2dData is managed from main thread, and it's passed to renderer
@@ -296,6 +435,18 @@ public:
 		// Cleanup.
 		free(m_texture2dData);
 
+		if (NULL != m_convertSrc)
+		{
+			convertBenchmarkEnd();
+		}
+
+		if (CHURN_BENCHMARK_NUM_FRAMES > m_churnFrame)
+		{
+			churnBenchmarkEnd();
+		}
+
+		imguiDestroy();
+
 		for (uint32_t ii = 0; ii < BX_COUNTOF(m_textures); ++ii)
 		{
 			bgfx::destroyTexture(m_textures[ii]);
@@ -340,7 +491,7 @@ public:
 
 	bool update() BX_OVERRIDE
 	{
-		if (!entry::processEvents(m_width, m_height, m_debug, m_reset) )
+		if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState) )
 		{
 			float borderColor[4] = { float(rand()%255)/255.0f, float(rand()%255)/255.0f, float(rand()%255)/255.0f, float(rand()%255)/255.0f };
 			bgfx::setPaletteColor(1, borderColor);
@@ -446,6 +597,103 @@ public:
 
 			bgfx::dbgTextPrintf(0, 4, 0x0f, "m_hit: %d, m_miss %d", m_hit, m_miss);
 
+			imguiBeginFrame(
+				   m_mouseState.m_mx
+				,  m_mouseState.m_my
+				, (m_mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Right ] ? IMGUI_MBUT_RIGHT  : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
+				,  m_mouseState.m_mz
+				, m_width
+				, m_height
+				);
+
+			ImGui::Begin("Benchmark"
+				, NULL
+				, ImVec2(300.0f, 100.0f)
+				, ImGuiWindowFlags_AlwaysAutoResize
+				);
+
+			const bool convertBenchmark = NULL != m_convertSrc;
+			const bool churnBenchmark   = CHURN_BENCHMARK_NUM_FRAMES > m_churnFrame;
+			if (convertBenchmark
+			||  churnBenchmark)
+			{
+				ImGui::Text("Benchmark is running...");
+			}
+			else if (ImGui::Button("Image convert") )
+			{
+				convertBenchmarkBegin();
+			}
+			else if (ImGui::Button("Buffer churn") )
+			{
+				churnBenchmarkBegin();
+			}
+
+			ImGui::End();
+
+			imguiEndFrame();
+
+			if (convertBenchmark)
+			{
+				convertBenchmarkStep();
+
+				if (CONVERT_BENCHMARK_NUM_FRAMES == m_convertFrame)
+				{
+					convertBenchmarkEnd();
+				}
+			}
+
+			if (UINT32_MAX != m_convertFrame)
+			{
+				bgfx::dbgTextPrintf(0, 6, 0x0f, "Converting RGBA8 %dx%d, frame %d/%d"
+					, CONVERT_BENCHMARK_SIZE
+					, CONVERT_BENCHMARK_SIZE
+					, m_convertFrame
+					, CONVERT_BENCHMARK_NUM_FRAMES
+					);
+
+				const double num = double(bx::uint32_max(1, m_convertFrame) );
+				for (uint32_t ii = 0; ii < BX_COUNTOF(s_convertBenchmark); ++ii)
+				{
+					bgfx::dbgTextPrintf(0, 7+ii, 0x0f, "%-8s fast: % 7.3f[ms], generic: % 7.3f[ms]"
+						, s_convertBenchmark[ii].m_name
+						, double(m_convertTime[ii][0])*toMs/num
+						, double(m_convertTime[ii][1])*toMs/num
+						);
+				}
+			}
+
+			if (churnBenchmark)
+			{
+				churnBenchmarkStep();
+
+				if (CHURN_BENCHMARK_NUM_FRAMES == m_churnFrame)
+				{
+					churnBenchmarkEnd();
+				}
+			}
+
+			if (UINT32_MAX != m_churnFrame)
+			{
+				const bgfx::Stats* stats = bgfx::getStats();
+				bgfx::dbgTextPrintf(0, 11, 0x0f, "Churning %d of %d index buffers, frame %d/%d"
+					, CHURN_BENCHMARK_NUM_CHURN
+					, CHURN_BENCHMARK_NUM_BUFFERS
+					, m_churnFrame
+					, CHURN_BENCHMARK_NUM_FRAMES
+					);
+				bgfx::dbgTextPrintf(0, 12, 0x0f, "Create/destroy: % 7.3f[us], fragmentation: %5.1f%%"
+					, double(m_churnTime)*toMs*1000.0/double(bx::uint32_max(1, m_churnFrame)*CHURN_BENCHMARK_NUM_CHURN)
+					, m_churnFragmentation*100.0f
+					);
+				bgfx::dbgTextPrintf(0, 13, 0x0f, "Size: %6.2f[MiB], used: %6.2f[MiB], largest free: %6.2f[MiB]"
+					, double(stats->dynamicIndexBufferSize)/(1024.0*1024.0)
+					, double(stats->dynamicIndexBufferUsed)/(1024.0*1024.0)
+					, double(stats->dynamicIndexBufferLargestFree)/(1024.0*1024.0)
+					);
+			}
+
 			float at[3] = { 0.0f, 0.0f, 0.0f };
 			float eye[3] = { 0.0f, 0.0f, -5.0f };
 
@@ -590,6 +838,19 @@ public:
 
 	uint8_t* m_texture2dData;
 
+	entry::MouseState m_mouseState;
+
+	uint8_t* m_convertSrc;
+	void* m_convertDst;
+	uint32_t m_convertFrame;
+	int64_t m_convertTime[BX_COUNTOF(s_convertBenchmark)][2];
+
+	bx::RngMwc m_rng;
+	bgfx::DynamicIndexBufferHandle m_churnBuffer[CHURN_BENCHMARK_NUM_BUFFERS];
+	uint32_t m_churnFrame;
+	int64_t m_churnTime;
+	float m_churnFragmentation;
+
 	uint32_t m_width;
 	uint32_t m_height;
 	uint32_t m_debug;
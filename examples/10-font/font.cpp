@@ -239,11 +239,10 @@ int _main_(int _argc, char** _argv)
 			bgfx::setViewRect(0, 0, 0, uint16_t(width), uint16_t(height) );
 		}
 
-		// Submit the debug text.
-		textBufferManager->submitTextBuffer(transientText, 0);
-
-		// Submit the static text.
-		textBufferManager->submitTextBuffer(staticText, 0);
+		// Submit the debug text and the static text, both use the same font
+		// type and are drawn with a single draw call.
+		const TextBufferHandle textBuffers[] = { transientText, staticText };
+		textBufferManager->submitTextBuffers(textBuffers, BX_COUNTOF(textBuffers), 0);
 
 		// Advance to next frame. Rendering thread will be kicked to
 		// process submitted rendering primitives.
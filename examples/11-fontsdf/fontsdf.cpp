@@ -15,6 +15,19 @@
 #include "font/text_buffer_manager.h"
 #include "imgui/imgui.h"
 
+// Distance bake benchmark creates a distance field font, preloads fixed set
+// of glyphs, and destroys the font again every frame. Reported time is
+// distance transform time only, glyph rasterization is excluded.
+#define SDF_BENCHMARK_PIXEL_SIZE 48
+#define SDF_BENCHMARK_NUM_FRAMES 60
+
+static const wchar_t s_benchmarkGlyphs[] =
+	L"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	L"abcdefghijklmnopqrstuvwxyz"
+	L"0123456789"
+	L"!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~"
+	;
+
 TrueTypeHandle loadTtf(FontManager* _fm, const char* _filePath)
 {
 	uint32_t size;
@@ -88,11 +101,17 @@ int _main_(int _argc, char** _argv)
 	entry::MouseState mouseState;
 	int32_t scrollArea = 0;
 	const int32_t guiPanelWidth = 250;
-	const int32_t guiPanelHeight = 200;
+	const int32_t guiPanelHeight = 280;
 	float textScroll = 0.0f;
 	float textRotation = 0.0f;
 	float textScale = 1.0f;
 	float textSize = 14.0f;
+	int32_t bakeThreads = 4;
+
+	uint32_t benchmarkFrame = UINT32_MAX;
+	uint32_t benchmarkThreads = 0;
+	double benchmarkGlyphTime = 0.0;
+	double benchmarkBatchTime = 0.0;
 
 	while (!entry::processEvents(width, height, debug, reset, &mouseState) )
 	{
@@ -115,9 +134,25 @@ int _main_(int _argc, char** _argv)
 			);
 		imguiSeparatorLine();
 
+		const bool benchmark = UINT32_MAX != benchmarkFrame;
+
+		if (imguiSlider("Bake threads", bakeThreads, 1, MAX_BAKE_THREADS, !benchmark) )
+		{
+			fontManager->setNumBakeThreads(uint32_t(bakeThreads) );
+		}
+
+		if (imguiButton(benchmark ? "Benchmark is running..." : "Distance bake benchmark", !benchmark) )
+		{
+			fontManager->resetGlyphCacheStats();
+			benchmarkFrame = 0;
+			benchmarkThreads = uint32_t(bakeThreads);
+		}
+
+		imguiSeparatorLine();
+
 		bool recomputeVisibleText = false;
-		recomputeVisibleText |= imguiSlider("Number of lines", visibleLineCount, 1.0f, 177.0f , 1.0f);
-		if (imguiSlider("Font size", textSize, 6.0f, 64.0f , 1.0f) )
+		recomputeVisibleText |= imguiSlider("Number of lines", visibleLineCount, 1.0f, 177.0f , 1.0f, !benchmark);
+		if (imguiSlider("Font size", textSize, 6.0f, 64.0f , 1.0f, !benchmark) )
 		{
 			fontManager->destroyFont(fontScaled);
 			fontScaled = fontManager->createScaledFontToPixelSize(fontSdf, (uint32_t) textSize);
@@ -125,9 +160,9 @@ int _main_(int _argc, char** _argv)
 			recomputeVisibleText = true;
 		}
 
-		recomputeVisibleText |= imguiSlider("Scroll", textScroll, 0.0f, (lineCount-visibleLineCount) , 1.0f);
+		recomputeVisibleText |= imguiSlider("Scroll", textScroll, 0.0f, (lineCount-visibleLineCount) , 1.0f, !benchmark);
 		imguiSlider("Rotate", textRotation, 0.0f, bx::pi*2.0f , 0.1f);
-		recomputeVisibleText |= imguiSlider("Scale", textScale, 0.1f, 10.0f , 0.1f);
+		recomputeVisibleText |= imguiSlider("Scale", textScale, 0.1f, 10.0f , 0.1f, !benchmark);
 
 		if (recomputeVisibleText)
 		{
@@ -160,6 +195,38 @@ int _main_(int _argc, char** _argv)
 		bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: Use a single distance field font to render text of various size.");
 		bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime) * toMs);
 
+		if (UINT32_MAX != benchmarkFrame)
+		{
+			FontHandle benchmarkFont = fontManager->createFontByPixelSize(font, 0, SDF_BENCHMARK_PIXEL_SIZE, FONT_TYPE_DISTANCE);
+			fontManager->preloadGlyph(benchmarkFont, s_benchmarkGlyphs);
+			fontManager->destroyFont(benchmarkFont);
+
+			++benchmarkFrame;
+			bgfx::dbgTextPrintf(0, 4, 0x0f, "Benchmark: frame %d / %d"
+				, benchmarkFrame
+				, SDF_BENCHMARK_NUM_FRAMES
+				);
+
+			if (SDF_BENCHMARK_NUM_FRAMES == benchmarkFrame)
+			{
+				const GlyphCacheStats& stats = fontManager->getGlyphCacheStats();
+				const double bakeTime = double(stats.distanceBakeTime)*toMs;
+				benchmarkGlyphTime = bakeTime / double(bx::uint32_max(stats.numDistanceBaked, 1) );
+				benchmarkBatchTime = bakeTime / SDF_BENCHMARK_NUM_FRAMES;
+				benchmarkFrame = UINT32_MAX;
+			}
+		}
+		else if (0.0 < benchmarkGlyphTime)
+		{
+			bgfx::dbgTextPrintf(0, 4, 0x0f, "Distance bake (%d glyphs, %dpx, %d threads): % 7.3f[ms] per glyph, % 7.3f[ms] per set"
+				, uint32_t(BX_COUNTOF(s_benchmarkGlyphs)-1)
+				, SDF_BENCHMARK_PIXEL_SIZE
+				, benchmarkThreads
+				, benchmarkGlyphTime
+				, benchmarkBatchTime
+				);
+		}
+
 		float at[3]  = { 0, 0, 0.0f };
 		float eye[3] = {0, 0, -1.0f };
 
@@ -5,7 +5,6 @@
 
 #include <string>
 #include <vector>
-#include <map>
 #include <tinystl/allocator.h>
 #include <tinystl/unordered_map.h>
 namespace stl = tinystl;
@@ -817,21 +816,6 @@ struct Group
 
 	typedef struct { float f[6]; } f6_t;
 
-	struct EdgeAndPlane
-	{
-		EdgeAndPlane(uint16_t _i0, uint16_t _i1)
-			: m_faceIndex(0)
-			, m_i0(_i0)
-			, m_i1(_i1)
-		{
-		}
-
-		bool m_faceReverseOrder[2];
-		uint8_t m_faceIndex;
-		uint16_t m_i0, m_i1;
-		Plane m_plane[2];
-	};
-
 	void fillStructures(const bgfx::VertexDecl& _decl)
 	{
 		uint16_t stride = _decl.getStride();
@@ -847,9 +831,6 @@ struct Group
 		m_edgePlanesUnalignedPtr = (Plane*)malloc(m_numIndices * sizeof(Plane) + 15);
 		m_edgePlanes = (Plane*)bx::alignPtr(m_edgePlanesUnalignedPtr, 0, 16);
 
-		typedef std::map<std::pair<uint16_t, uint16_t>, EdgeAndPlane> EdgeMap;
-		EdgeMap edgeMap;
-
 		//Get unique indices.
 		WeldedVertex* uniqueVertices = (WeldedVertex*)malloc(m_numVertices*sizeof(WeldedVertex) );
 		::weldVertices(uniqueVertices, _decl, m_vertices, m_numVertices, 0.0001f);
@@ -887,60 +868,40 @@ struct Group
 			face.m_i[2] = i2;
 			bx::memCopy(face.m_plane, plane, 4*sizeof(float) );
 			m_faces.push_back(face);
-
-			//Use unique indices for EdgeMap.
-			const uint16_t* uindices = &uniqueIndices[ii*3];
-			i0 = uindices[0];
-			i1 = uindices[1];
-			i2 = uindices[2];
-
-			const uint16_t triangleEdge[3][2] =
-			{
-				{ i0, i1 },
-				{ i1, i2 },
-				{ i2, i0 },
-			};
-
-			for (uint8_t jj = 0; jj < 3; ++jj)
-			{
-				const uint16_t ui0 = triangleEdge[jj][0];
-				const uint16_t ui1 = triangleEdge[jj][1];
-
-				std::pair<uint16_t, uint16_t> key    = std::make_pair(ui0, ui1);
-				std::pair<uint16_t, uint16_t> keyInv = std::make_pair(ui1, ui0);
-
-				EdgeMap::iterator iter = edgeMap.find(keyInv);
-				if (iter != edgeMap.end() )
-				{
-					EdgeAndPlane& ep = iter->second;
-					bx::memCopy(ep.m_plane[ep.m_faceIndex].m_plane, plane, 4*sizeof(float) );
-					ep.m_faceReverseOrder[ep.m_faceIndex] = true;
-				}
-				else
-				{
-					std::pair<EdgeMap::iterator, bool> result = edgeMap.insert(std::make_pair(key, EdgeAndPlane(ui0, ui1) ) );
-					EdgeAndPlane& ep = result.first->second;
-					bx::memCopy(ep.m_plane[ep.m_faceIndex].m_plane, plane, 4*sizeof(float) );
-					ep.m_faceReverseOrder[ep.m_faceIndex] = false;
-					ep.m_faceIndex++;
-				}
-			}
 		}
 
+		//Use unique indices for edges.
+		const uint32_t numEdges = bgfx::topologyBuildEdges(NULL, 0, m_vertices, stride, uniqueIndices, m_numIndices, false);
+		bgfx::TopologyEdge* edges = (bgfx::TopologyEdge*)malloc(numEdges*sizeof(bgfx::TopologyEdge) );
+		bgfx::topologyBuildEdges(edges, numEdges, m_vertices, stride, uniqueIndices, m_numIndices, false);
+
 		free(uniqueIndices);
 
-		uint32_t index = 0;
-		for (EdgeMap::const_iterator iter = edgeMap.begin(), end = edgeMap.end(); iter != end; ++iter)
+		for (uint32_t ii = 0; ii < numEdges; ++ii)
 		{
-			Edge* edge = &m_edges[m_numEdges];
-			Plane* plane = &m_edgePlanes[index];
+			const bgfx::TopologyEdge& src = edges[ii];
 
-			bx::memCopy(edge, iter->second.m_faceReverseOrder, sizeof(Edge) );
-			bx::memCopy(plane, iter->second.m_plane, 2 * sizeof(Plane) );
+			Edge* edge = &m_edges[m_numEdges];
+			edge->m_faceReverseOrder[0] = false;
+			edge->m_faceReverseOrder[1] = true;
+			edge->m_faceIndex = UINT32_MAX == src.face[1] ? 1 : 2;
+			edge->m_i0 = uint16_t(src.i0);
+			edge->m_i1 = uint16_t(src.i1);
+
+			//Face planes are flipped compared to planeNormal.
+			Plane* plane = &m_edgePlanes[m_numEdges*2];
+			for (uint32_t jj = 0; jj < 2; ++jj)
+			{
+				plane[jj].m_plane[0] = -src.plane[jj][0];
+				plane[jj].m_plane[1] = -src.plane[jj][1];
+				plane[jj].m_plane[2] = -src.plane[jj][2];
+				plane[jj].m_plane[3] = -src.plane[jj][3];
+			}
 
 			m_numEdges++;
-			index += 2;
 		}
+
+		free(edges);
 	}
 
 	void unload()
@@ -7,6 +7,8 @@
 #include "bgfx_utils.h"
 
 #include <bx/uint32_t.h>
+#include <bx/rng.h>
+#include <bx/sort.h>
 #include "imgui/imgui.h"
 
 #include <bgfx/embedded_shader.h>
@@ -80,6 +82,13 @@ static const int64_t highwm = 1000000/65;
 static const int64_t lowwm  = 1000000/57;
 #endif // BX_PLATFORM_EMSCRIPTEN || BX_PLATFORM_NACL
 
+// Sort benchmark submits maximum number of draw calls with random depth,
+// so that sort keys are not in order, and compares frame sort time
+// reported in stats with single threaded bx::radixSort of same number of
+// keys. Stats lag behind submit, so first frames are not measured.
+#define SORT_BENCHMARK_NUM_WARMUP_FRAMES 10
+#define SORT_BENCHMARK_NUM_FRAMES        300
+
 class ExampleDrawStress : public entry::AppI
 {
 	void init(int _argc, char** _argv) BX_OVERRIDE
@@ -103,6 +112,11 @@ class ExampleDrawStress : public entry::AppI
 		m_deltaTimeAvgNs = 0;
 		m_numFrames      = 0;
 
+		m_sortKeys       = NULL;
+		m_sortFrame      = UINT32_MAX;
+		m_sortTime[0]    = 0;
+		m_sortTime[1]    = 0;
+
 		bgfx::init(args.m_type, args.m_pciId);
 		bgfx::reset(m_width, m_height, m_reset);
 
@@ -145,9 +159,68 @@ class ExampleDrawStress : public entry::AppI
 		imguiCreate();
 	}
 
+	void sortBenchmarkBegin()
+	{
+		bx::AllocatorI* allocator = entry::getAllocator();
+
+		const uint32_t num = m_maxDim*m_maxDim*m_maxDim;
+		m_sortKeys       = (uint64_t*)BX_ALLOC(allocator, num*sizeof(uint64_t) );
+		m_sortTempKeys   = (uint64_t*)BX_ALLOC(allocator, num*sizeof(uint64_t) );
+		m_sortValues     = (uint32_t*)BX_ALLOC(allocator, num*sizeof(uint32_t) );
+		m_sortTempValues = (uint32_t*)BX_ALLOC(allocator, num*sizeof(uint32_t) );
+
+		m_sortAutoAdjust = m_autoAdjust;
+		m_autoAdjust     = false;
+		m_dim            = m_maxDim;
+
+		m_sortFrame   = 0;
+		m_sortTime[0] = 0;
+		m_sortTime[1] = 0;
+	}
+
+	void sortBenchmarkStep(const bgfx::Stats* _stats)
+	{
+		if (SORT_BENCHMARK_NUM_WARMUP_FRAMES <= m_sortFrame)
+		{
+			// Same key layout as draw call keys submitted by this example,
+			// draw bit and program are same, and depth is random.
+			const uint32_t num = m_dim*m_dim*m_dim;
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				m_sortKeys[ii]   = (UINT64_C(1)<<0x36) | m_rng.gen();
+				m_sortValues[ii] = ii;
+			}
+
+			const int64_t start = bx::getHPCounter();
+			bx::radixSort(m_sortKeys, m_sortTempKeys, m_sortValues, m_sortTempValues, num);
+
+			m_sortTime[0] += _stats->cpuTimeSort;
+			m_sortTime[1] += bx::getHPCounter() - start;
+		}
+
+		++m_sortFrame;
+	}
+
+	void sortBenchmarkEnd()
+	{
+		bx::AllocatorI* allocator = entry::getAllocator();
+		BX_FREE(allocator, m_sortKeys);
+		BX_FREE(allocator, m_sortTempKeys);
+		BX_FREE(allocator, m_sortValues);
+		BX_FREE(allocator, m_sortTempValues);
+		m_sortKeys = NULL;
+
+		m_autoAdjust = m_sortAutoAdjust;
+	}
+
 	int shutdown() BX_OVERRIDE
 	{
 		// Cleanup.
+		if (NULL != m_sortKeys)
+		{
+			sortBenchmarkEnd();
+		}
+
 		imguiDestroy();
 		bgfx::destroyIndexBuffer(m_ibh);
 		bgfx::destroyVertexBuffer(m_vbh);
@@ -233,6 +306,15 @@ class ExampleDrawStress : public entry::AppI
 			imguiLabel("CPU %0.6f [ms]", double(stats->cpuTimeEnd - stats->cpuTimeBegin)*1000.0/stats->cpuTimerFreq);
 			imguiLabel("Waiting for render thread %0.6f [ms]", double(stats->waitRender) * toMs);
 			imguiLabel("Waiting for submit thread %0.6f [ms]", double(stats->waitSubmit) * toMs);
+			imguiLabel("Sort %0.6f [ms]", double(stats->cpuTimeSort)*1000.0/stats->cpuTimerFreq);
+
+			imguiSeparatorLine();
+
+			const bool sortBenchmark = NULL != m_sortKeys;
+			if (imguiButton("Sort benchmark", !sortBenchmark) )
+			{
+				sortBenchmarkBegin();
+			}
 
 			imguiEndScrollArea();
 			imguiEndFrame();
@@ -261,6 +343,28 @@ class ExampleDrawStress : public entry::AppI
 			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: Draw stress, maximizing number of draw calls.");
 			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: %7.3f[ms]", double(frameTime)*toMs);
 
+			if (sortBenchmark)
+			{
+				sortBenchmarkStep(stats);
+
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Sorting %d draw calls, frame %d/%d..."
+					, m_dim*m_dim*m_dim
+					, m_sortFrame
+					, SORT_BENCHMARK_NUM_FRAMES
+					);
+
+				if (SORT_BENCHMARK_NUM_FRAMES == m_sortFrame)
+				{
+					sortBenchmarkEnd();
+				}
+			}
+			else if (SORT_BENCHMARK_NUM_FRAMES == m_sortFrame)
+			{
+				const uint32_t num = SORT_BENCHMARK_NUM_FRAMES - SORT_BENCHMARK_NUM_WARMUP_FRAMES;
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Frame sort    % 7.3f[ms]", double(m_sortTime[0])*1000.0/stats->cpuTimerFreq/num);
+				bgfx::dbgTextPrintf(0, 6, 0x0f, "bx::radixSort % 7.3f[ms]", double(m_sortTime[1])*toMs/num);
+			}
+
 			float mtxS[16];
 			const float scale = 0 == m_transform ? 0.25f : 0.0f;
 			bx::mtxScale(mtxS, scale, scale, scale);
@@ -297,8 +401,9 @@ class ExampleDrawStress : public entry::AppI
 						// Set render states.
 						bgfx::setState(BGFX_STATE_DEFAULT);
 
-						// Submit primitive for rendering to view 0.
-						bgfx::submit(0, m_program);
+						// Submit primitive for rendering to view 0. Sort benchmark
+						// uses random depth to shuffle sort keys.
+						bgfx::submit(0, m_program, sortBenchmark ? int32_t(m_rng.gen() ) : 0);
 					}
 				}
 			}
@@ -332,6 +437,15 @@ class ExampleDrawStress : public entry::AppI
 	int64_t  m_deltaTimeAvgNs;
 	int64_t  m_numFrames;
 
+	bx::RngMwc m_rng;
+	uint64_t*  m_sortKeys;
+	uint64_t*  m_sortTempKeys;
+	uint32_t*  m_sortValues;
+	uint32_t*  m_sortTempValues;
+	uint32_t   m_sortFrame;
+	int64_t    m_sortTime[2];
+	bool       m_sortAutoAdjust;
+
 	bgfx::ProgramHandle m_program;
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle  m_ibh;
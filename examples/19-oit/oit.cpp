@@ -83,6 +83,19 @@ static const uint16_t s_cubeIndices[36] =
 static float s_texelHalf = 0.0f;
 static bool s_flipV = false;
 
+// Sort benchmark sorts grid of cubes back to front on CPU, while camera
+// rotates around it by one degree per frame.
+#define SORT_BENCHMARK_GRID       24
+#define SORT_BENCHMARK_NUM_CUBES  (SORT_BENCHMARK_GRID*SORT_BENCHMARK_GRID*SORT_BENCHMARK_GRID)
+#define SORT_BENCHMARK_NUM_FRAMES 360
+
+static const char* s_sortBenchmarkNames[] =
+{
+	"Full sort",
+	"Coherent",
+	"Coherent MT",
+};
+
 inline void mtxProj(float* _result, float _fovy, float _aspect, float _near, float _far)
 {
 	bx::mtxProj(_result, _fovy, _aspect, _near, _far, s_flipV);
@@ -220,10 +233,141 @@ class ExampleOIT : public entry::AppI
 		m_oldReset  = m_reset;
 
 		m_timeOffset = bx::getHPCounter();
+
+		m_sortVertices = NULL;
+		m_sortIndices  = NULL;
+		m_sortDst      = NULL;
+		m_sortOrder    = NULL;
+		m_sortFrame    = UINT32_MAX;
+		bx::memSet(m_sortTime, 0, sizeof(m_sortTime) );
+	}
+
+	void sortBenchmarkBegin()
+	{
+		bx::AllocatorI* allocator = entry::getAllocator();
+
+		const uint32_t numVertices = SORT_BENCHMARK_NUM_CUBES*BX_COUNTOF(s_cubeVertices);
+		const uint32_t numIndices  = SORT_BENCHMARK_NUM_CUBES*BX_COUNTOF(s_cubeIndices);
+		const uint32_t numTris     = numIndices/3;
+
+		m_sortVertices = (float*   )BX_ALLOC(allocator, numVertices*3*sizeof(float) );
+		m_sortIndices  = (uint32_t*)BX_ALLOC(allocator, numIndices*sizeof(uint32_t) );
+		m_sortDst      = (uint32_t*)BX_ALLOC(allocator, numIndices*sizeof(uint32_t) );
+		m_sortOrder    = (uint32_t*)BX_ALLOC(allocator, numTris*2*sizeof(uint32_t) );
+
+		float*    vertex = m_sortVertices;
+		uint32_t* index  = m_sortIndices;
+
+		for (uint32_t ii = 0; ii < SORT_BENCHMARK_NUM_CUBES; ++ii)
+		{
+			const float xx = float(ii%SORT_BENCHMARK_GRID);
+			const float yy = float( (ii/SORT_BENCHMARK_GRID)%SORT_BENCHMARK_GRID);
+			const float zz = float(ii/(SORT_BENCHMARK_GRID*SORT_BENCHMARK_GRID) );
+			const float offset = float(SORT_BENCHMARK_GRID-1)*1.5f;
+			const uint32_t base = ii*BX_COUNTOF(s_cubeVertices);
+
+			for (uint32_t jj = 0; jj < BX_COUNTOF(s_cubeVertices); ++jj)
+			{
+				*vertex++ = s_cubeVertices[jj].m_x*0.5f + xx*3.0f - offset;
+				*vertex++ = s_cubeVertices[jj].m_y*0.5f + yy*3.0f - offset;
+				*vertex++ = s_cubeVertices[jj].m_z*0.5f + zz*3.0f - offset;
+			}
+
+			for (uint32_t jj = 0; jj < BX_COUNTOF(s_cubeIndices); ++jj)
+			{
+				*index++ = base + s_cubeIndices[jj];
+			}
+		}
+
+		// Order from previous frame, one per coherent variant.
+		m_sortOrder[0]       = UINT32_MAX;
+		m_sortOrder[numTris] = UINT32_MAX;
+
+		m_sortFrame = 0;
+		bx::memSet(m_sortTime, 0, sizeof(m_sortTime) );
+	}
+
+	void sortBenchmarkStep()
+	{
+		const uint32_t numIndices = SORT_BENCHMARK_NUM_CUBES*BX_COUNTOF(s_cubeIndices);
+		const uint32_t numTris    = numIndices/3;
+
+		const float angle = bx::toRad(float(m_sortFrame) );
+		const float eye[3] =
+		{
+			bx::fsin(angle)*float(SORT_BENCHMARK_GRID)*3.0f,
+			float(SORT_BENCHMARK_GRID),
+			bx::fcos(angle)*float(SORT_BENCHMARK_GRID)*3.0f,
+		};
+
+		float dir[3];
+		bx::vec3Norm(dir, eye);
+		dir[0] = -dir[0];
+		dir[1] = -dir[1];
+		dir[2] = -dir[2];
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_sortTime); ++ii)
+		{
+			const int64_t start = bx::getHPCounter();
+
+			if (0 == ii)
+			{
+				bgfx::topologySortTriList(bgfx::TopologySort::DistanceBackToFrontAvg
+					, m_sortDst
+					, numIndices*sizeof(uint32_t)
+					, dir
+					, eye
+					, m_sortVertices
+					, 3*sizeof(float)
+					, m_sortIndices
+					, numIndices
+					, true
+					);
+			}
+			else
+			{
+				bgfx::topologySortTriListCoherent(bgfx::TopologySort::DistanceBackToFrontAvg
+					, m_sortDst
+					, numIndices*sizeof(uint32_t)
+					, dir
+					, eye
+					, m_sortVertices
+					, 3*sizeof(float)
+					, m_sortIndices
+					, numIndices
+					, true
+					, &m_sortOrder[(ii-1)*numTris]
+					, 2 == ii
+					);
+			}
+
+			m_sortTime[ii] += double(bx::getHPCounter() - start);
+		}
+
+		++m_sortFrame;
+	}
+
+	void sortBenchmarkEnd()
+	{
+		bx::AllocatorI* allocator = entry::getAllocator();
+		BX_FREE(allocator, m_sortVertices);
+		BX_FREE(allocator, m_sortIndices);
+		BX_FREE(allocator, m_sortDst);
+		BX_FREE(allocator, m_sortOrder);
+
+		m_sortVertices = NULL;
+		m_sortIndices  = NULL;
+		m_sortDst      = NULL;
+		m_sortOrder    = NULL;
 	}
 
 	int shutdown() BX_OVERRIDE
 	{
+		if (NULL != m_sortVertices)
+		{
+			sortBenchmarkEnd();
+		}
+
 		// Cleanup.
 		imguiDestroy();
 
@@ -302,6 +446,14 @@ class ExampleOIT : public entry::AppI
 				m_fadeInOut ^= true;
 			}
 
+			imguiSeparatorLine();
+
+			const bool sortBenchmark = SORT_BENCHMARK_NUM_FRAMES > m_sortFrame;
+			if (imguiButton("CPU sort benchmark", !sortBenchmark) )
+			{
+				sortBenchmarkBegin();
+			}
+
 			imguiEndScrollArea();
 			imguiEndFrame();
 
@@ -328,6 +480,32 @@ class ExampleOIT : public entry::AppI
 			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: Weighted, Blended Order Independent Transparency.");
 			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime)*toMs);
 
+			if (SORT_BENCHMARK_NUM_FRAMES > m_sortFrame)
+			{
+				sortBenchmarkStep();
+
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Sorting %d triangles, frame %d/%d..."
+					, uint32_t(SORT_BENCHMARK_NUM_CUBES*BX_COUNTOF(s_cubeIndices)/3)
+					, m_sortFrame
+					, SORT_BENCHMARK_NUM_FRAMES
+					);
+
+				if (SORT_BENCHMARK_NUM_FRAMES == m_sortFrame)
+				{
+					sortBenchmarkEnd();
+				}
+			}
+			else if (SORT_BENCHMARK_NUM_FRAMES == m_sortFrame)
+			{
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_sortTime); ++ii)
+				{
+					bgfx::dbgTextPrintf(0, 5+ii, 0x0f, "%-12s % 7.3f[ms]"
+						, s_sortBenchmarkNames[ii]
+						, m_sortTime[ii]*toMs/SORT_BENCHMARK_NUM_FRAMES
+						);
+				}
+			}
+
 			float at[3] = { 0.0f, 0.0f, 0.0f };
 			float eye[3] = { 0.0f, 0.0f, -7.0f };
 
@@ -503,6 +681,13 @@ class ExampleOIT : public entry::AppI
 
 	int64_t m_timeOffset;
 
+	float*    m_sortVertices;
+	uint32_t* m_sortIndices;
+	uint32_t* m_sortDst;
+	uint32_t* m_sortOrder;
+	uint32_t  m_sortFrame;
+	double    m_sortTime[BX_COUNTOF(s_sortBenchmarkNames)];
+
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle  m_ibh;
 
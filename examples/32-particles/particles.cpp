@@ -17,6 +17,13 @@
 
 #include <ps/particle_system.h>
 
+// Benchmark runs fixed workload: emitters at full rate, fixed time step, and
+// fixed camera. Time is measured after particle count reaches steady state.
+#define BENCHMARK_NUM_EMITTERS      32
+#define BENCHMARK_MAX_PARTICLES     1024
+#define BENCHMARK_NUM_WARMUP_FRAMES 120
+#define BENCHMARK_NUM_FRAMES        600
+
 static const char* s_shapeNames[] =
 {
 	"Sphere",
@@ -247,7 +254,7 @@ class Particles : public entry::AppI
 
 		ddInit();
 
-		psInit();
+		psInit(64, NULL, 4);
 
 		for (uint32_t ii = 0; ii < BX_COUNTOF(m_emitter); ++ii)
 		{
@@ -263,10 +270,61 @@ class Particles : public entry::AppI
 		cameraSetVerticalAngle(0.0f);
 
 		m_timeOffset = bx::getHPCounter();
+
+		m_benchmarkFrame  = UINT32_MAX;
+		m_benchmarkUpdate = 0.0;
+		m_benchmarkRender = 0.0;
+		m_benchmarkGpu    = false;
+	}
+
+	void benchmarkBegin()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_emitter); ++ii)
+		{
+			m_emitter[ii].destroy();
+		}
+
+		for (uint32_t ii = 0; ii < BENCHMARK_NUM_EMITTERS; ++ii)
+		{
+			EmitterUniforms uniforms;
+			uniforms.reset();
+			uniforms.m_position[0] = float(ii%8)*2.0f - 7.0f;
+			uniforms.m_position[2] = float(ii/8)*2.0f;
+			uniforms.m_particlesPerSecond = BENCHMARK_MAX_PARTICLES;
+			uniforms.m_lifeSpan[0] = 2.0f;
+			uniforms.m_lifeSpan[1] = 2.0f;
+
+			m_benchmarkEmitter[ii] = psCreateEmitter(EmitterShape::Sphere, EmitterDirection::Outward, BENCHMARK_MAX_PARTICLES, m_benchmarkGpu);
+			psUpdateEmitter(m_benchmarkEmitter[ii], &uniforms);
+		}
+
+		m_benchmarkFrame  = 0;
+		m_benchmarkUpdate = 0.0;
+		m_benchmarkRender = 0.0;
+	}
+
+	void benchmarkEnd()
+	{
+		for (uint32_t ii = 0; ii < BENCHMARK_NUM_EMITTERS; ++ii)
+		{
+			psDestroyEmitter(m_benchmarkEmitter[ii]);
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_emitter); ++ii)
+		{
+			m_emitter[ii].create();
+		}
+
+		m_benchmarkFrame = UINT32_MAX;
 	}
 
 	virtual int shutdown() BX_OVERRIDE
 	{
+		if (UINT32_MAX != m_benchmarkFrame)
+		{
+			benchmarkEnd();
+		}
+
 		for (uint32_t ii = 0; ii < BX_COUNTOF(m_emitter); ++ii)
 		{
 			m_emitter[ii].destroy();
@@ -362,19 +420,39 @@ class Particles : public entry::AppI
 			static bool showBounds;
 			ImGui::Checkbox("Show bounds", &showBounds);
 
-			ImGui::Text("Emitter:");
-			static int currentEmitter = 0;
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_emitter); ++ii)
+			bool benchmark = UINT32_MAX != m_benchmarkFrame;
+			if (!benchmark)
 			{
-				ImGui::SameLine();
+				ImGui::Checkbox("Benchmark GPU emitters", &m_benchmarkGpu);
 
-				char name[16];
-				bx::snprintf(name, BX_COUNTOF(name), "%d", ii);
+				if (ImGui::Button("Benchmark") )
+				{
+					benchmarkBegin();
+					benchmark = true;
+				}
+			}
 
-				ImGui::RadioButton(name, &currentEmitter, ii);
+			static int currentEmitter = 0;
+			if (benchmark)
+			{
+				ImGui::Text("Benchmark is running...");
+				ImGui::End();
 			}
+			else
+			{
+				ImGui::Text("Emitter:");
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_emitter); ++ii)
+				{
+					ImGui::SameLine();
+
+					char name[16];
+					bx::snprintf(name, BX_COUNTOF(name), "%d", ii);
+
+					ImGui::RadioButton(name, &currentEmitter, ii);
+				}
 
-			m_emitter[currentEmitter].imgui(view, proj);
+				m_emitter[currentEmitter].imgui(view, proj);
+			}
 
 			imguiEndFrame();
 
@@ -386,12 +464,67 @@ class Particles : public entry::AppI
 			float eye[3];
 			cameraGetPosition(eye);
 
-			m_emitter[currentEmitter].update();
+			if (benchmark)
+			{
+				// Fixed camera looking at benchmark emitters.
+				const float at[3]  = { 0.0f, 0.0f,   3.0f };
+				const float pos[3] = { 0.0f, 6.0f, -12.0f };
+				bx::mtxLookAt(view, pos, at);
+				bx::vec3Move(eye, pos);
+				bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 100.0f, bgfx::getCaps()->homogeneousDepth);
+				bgfx::setViewTransform(0, view, proj);
+				bgfx::setViewRect(0, 0, 0, m_width, m_height);
+			}
+			else
+			{
+				m_emitter[currentEmitter].update();
+			}
 
-			psUpdate(deltaTime * timeScale);
+			const int64_t psStart = bx::getHPCounter();
+			const uint32_t numParticles = psUpdate(benchmark ? 1.0f/60.0f : deltaTime * timeScale);
+			const int64_t psUpdated = bx::getHPCounter();
 			psRender(0, view, eye);
+			const int64_t psRendered = bx::getHPCounter();
+
+			bgfx::dbgTextPrintf(0, 4, 0x0f, "Particles: %6d, update: % 7.3f[ms], render: % 7.3f[ms]"
+				, numParticles
+				, double(psUpdated  - psStart)*toMs
+				, double(psRendered - psUpdated)*toMs
+				);
 
-			if (showBounds)
+			if (benchmark)
+			{
+				if (m_benchmarkFrame >= BENCHMARK_NUM_WARMUP_FRAMES)
+				{
+					m_benchmarkUpdate += double(psUpdated  - psStart)*toMs;
+					m_benchmarkRender += double(psRendered - psUpdated)*toMs;
+				}
+
+				++m_benchmarkFrame;
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Benchmark: frame %d / %d"
+					, m_benchmarkFrame
+					, BENCHMARK_NUM_WARMUP_FRAMES + BENCHMARK_NUM_FRAMES
+					);
+
+				if (BENCHMARK_NUM_WARMUP_FRAMES + BENCHMARK_NUM_FRAMES == m_benchmarkFrame)
+				{
+					m_benchmarkUpdate /= BENCHMARK_NUM_FRAMES;
+					m_benchmarkRender /= BENCHMARK_NUM_FRAMES;
+					benchmarkEnd();
+				}
+			}
+			else if (0.0 < m_benchmarkUpdate)
+			{
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Benchmark (%d emitters x %d particles): update % 7.3f[ms], render % 7.3f[ms]"
+					, BENCHMARK_NUM_EMITTERS
+					, BENCHMARK_MAX_PARTICLES
+					, m_benchmarkUpdate
+					, m_benchmarkRender
+					);
+			}
+
+			if (!benchmark
+			&&  showBounds)
 			{
 				Aabb aabb;
 				psGetAabb(m_emitter[currentEmitter].m_handle, aabb);
@@ -421,6 +554,12 @@ class Particles : public entry::AppI
 	uint32_t m_reset;
 
 	Emitter m_emitter[4];
+
+	EmitterHandle m_benchmarkEmitter[BENCHMARK_NUM_EMITTERS];
+	uint32_t m_benchmarkFrame;
+	double   m_benchmarkUpdate;
+	double   m_benchmarkRender;
+	bool     m_benchmarkGpu;
 };
 
 ENTRY_IMPLEMENT_MAIN(Particles);
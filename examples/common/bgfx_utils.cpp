@@ -16,6 +16,7 @@ namespace stl = tinystl;
 #include <bx/fpumath.h>
 #include <bx/readerwriter.h>
 #include <bx/string.h>
+#include <bx/uint32_t.h>
 #include "entry/entry.h"
 #include <ib-compress/indexbufferdecompression.h>
 
@@ -142,7 +143,14 @@ static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const char* _name
 	bx::strlncat(filePath, BX_COUNTOF(filePath), _name);
 	bx::strlncat(filePath, BX_COUNTOF(filePath), ".bin");
 
-	return bgfx::createShader(loadMem(_reader, filePath) );
+	const bgfx::Memory* mem = loadMem(_reader, filePath);
+	if (NULL == mem)
+	{
+		bgfx::ShaderHandle invalid = BGFX_INVALID_HANDLE;
+		return invalid;
+	}
+
+	return bgfx::createShader(mem);
 }
 
 bgfx::ShaderHandle loadShader(const char* _name)
@@ -605,6 +613,26 @@ struct Primitive
 
 typedef stl::vector<Primitive> PrimitiveArray;
 
+struct Cluster
+{
+	uint32_t m_startIndex;
+	uint32_t m_numIndices;
+
+	Sphere m_sphere;
+	float m_cone[4];
+};
+
+typedef stl::vector<Cluster> ClusterArray;
+
+struct Lod
+{
+	float m_ratio;
+	uint32_t m_startIndex;
+	uint32_t m_numIndices;
+};
+
+typedef stl::vector<Lod> LodArray;
+
 struct Group
 {
 	Group()
@@ -616,7 +644,10 @@ struct Group
 	{
 		m_vbh.idx = bgfx::invalidHandle;
 		m_ibh.idx = bgfx::invalidHandle;
+		m_numIndices = UINT32_MAX;
 		m_prims.clear();
+		m_clusters.clear();
+		m_lods.clear();
 	}
 
 	bgfx::VertexBufferHandle m_vbh;
@@ -624,7 +655,101 @@ struct Group
 	Sphere m_sphere;
 	Aabb m_aabb;
 	Obb m_obb;
+	uint32_t m_numIndices;
 	PrimitiveArray m_prims;
+	ClusterArray m_clusters;
+	LodArray m_lods;
+};
+
+struct ClusterCull
+{
+	void init(const float* _mtx, const float* _view, const float* _proj, uint64_t _state)
+	{
+		float mtxModelView[16];
+		bx::mtxMul(mtxModelView, _mtx, _view);
+
+		float mvp[16];
+		bx::mtxMul(mvp, mtxModelView, _proj);
+
+		// Frustum planes in model space. Near plane is -w <= z, which is
+		// conservative when depth range is 0..1.
+		float col[4][4];
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			col[ii][0] = mvp[ 0+ii];
+			col[ii][1] = mvp[ 4+ii];
+			col[ii][2] = mvp[ 8+ii];
+			col[ii][3] = mvp[12+ii];
+		}
+
+		for (uint32_t ii = 0; ii < 6; ++ii)
+		{
+			const float  sign  = 0 == (ii&1) ? 1.0f : -1.0f;
+			const float* axis  = col[ii/2];
+			float*       plane = m_planes[ii];
+
+			for (uint32_t kk = 0; kk < 4; ++kk)
+			{
+				plane[kk] = col[3][kk] + sign*axis[kk];
+			}
+
+			const float len = bx::fsqrt(bx::vec3Dot(plane, plane) );
+			const float invLen = len > 0.0f ? 1.0f/len : 0.0f;
+			for (uint32_t kk = 0; kk < 4; ++kk)
+			{
+				plane[kk] *= invLen;
+			}
+		}
+
+		float mtxInv[16];
+		bx::mtxInverse(mtxInv, mtxModelView);
+		m_eye[0] = mtxInv[12];
+		m_eye[1] = mtxInv[13];
+		m_eye[2] = mtxInv[14];
+
+		// Cluster normal cones assume clockwise front faces.
+		m_cone = BGFX_STATE_CULL_CCW == (_state & BGFX_STATE_CULL_MASK);
+	}
+
+	bool isVisible(const Sphere& _sphere) const
+	{
+		for (uint32_t ii = 0; ii < 6; ++ii)
+		{
+			const float* plane = m_planes[ii];
+			if (bx::vec3Dot(plane, _sphere.m_center) + plane[3] < -_sphere.m_radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool isVisible(const Cluster& _cluster) const
+	{
+		if (!isVisible(_cluster.m_sphere) )
+		{
+			return false;
+		}
+
+		if (m_cone)
+		{
+			float dir[3];
+			bx::vec3Sub(dir, _cluster.m_sphere.m_center, m_eye);
+			const float len = bx::fsqrt(bx::vec3Dot(dir, dir) );
+
+			if (bx::vec3Dot(dir, _cluster.m_cone) >= _cluster.m_cone[3]*len + _cluster.m_sphere.m_radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	float m_planes[6][4];
+	float m_eye[3];
+	bool m_cone;
 };
 
 namespace bgfx
@@ -640,6 +765,8 @@ struct Mesh
 #define BGFX_CHUNK_MAGIC_IB  BX_MAKEFOURCC('I', 'B', ' ', 0x0)
 #define BGFX_CHUNK_MAGIC_IBC BX_MAKEFOURCC('I', 'B', 'C', 0x0)
 #define BGFX_CHUNK_MAGIC_PRI BX_MAKEFOURCC('P', 'R', 'I', 0x0)
+#define BGFX_CHUNK_MAGIC_CLU BX_MAKEFOURCC('C', 'L', 'U', 0x0)
+#define BGFX_CHUNK_MAGIC_LOD BX_MAKEFOURCC('L', 'O', 'D', 0x0)
 
 		using namespace bx;
 		using namespace bgfx;
@@ -707,6 +834,61 @@ struct Mesh
 				}
 				break;
 
+			case BGFX_CHUNK_MAGIC_CLU:
+				{
+					uint32_t num;
+					read(_reader, num);
+
+					group.m_clusters.resize(num);
+					for (uint32_t ii = 0; ii < num; ++ii)
+					{
+						Cluster& cluster = group.m_clusters[ii];
+						read(_reader, cluster.m_startIndex);
+						read(_reader, cluster.m_numIndices);
+						read(_reader, cluster.m_sphere);
+						read(_reader, cluster.m_cone);
+					}
+				}
+				break;
+
+			case BGFX_CHUNK_MAGIC_LOD:
+				{
+					uint16_t num;
+					read(_reader, num);
+
+					group.m_lods.resize(num);
+					for (uint32_t ii = 0; ii < num; ++ii)
+					{
+						Lod& lod = group.m_lods[ii];
+						read(_reader, lod.m_ratio);
+
+						uint16_t numPrims;
+						read(_reader, numPrims);
+
+						// Primitives of single LOD are continuous in index
+						// buffer, draw them as one range.
+						lod.m_startIndex = UINT32_MAX;
+						lod.m_numIndices = 0;
+						for (uint32_t jj = 0; jj < numPrims; ++jj)
+						{
+							uint32_t startIndex;
+							uint32_t numIndices;
+							read(_reader, startIndex);
+							read(_reader, numIndices);
+
+							lod.m_startIndex  = bx::uint32_min(lod.m_startIndex, startIndex);
+							lod.m_numIndices += numIndices;
+						}
+					}
+
+					// LOD indices are stored after full detail indices.
+					if (0 < num)
+					{
+						group.m_numIndices = group.m_lods[0].m_startIndex;
+					}
+				}
+				break;
+
 			case BGFX_CHUNK_MAGIC_PRI:
 				{
 					uint16_t len;
@@ -787,12 +969,139 @@ struct Mesh
 		{
 			const Group& group = *it;
 
-			bgfx::setIndexBuffer(group.m_ibh);
+			bgfx::setIndexBuffer(group.m_ibh, 0, group.m_numIndices);
 			bgfx::setVertexBuffer(group.m_vbh);
 			bgfx::submit(_id, _program, 0, it != itEnd-1);
 		}
 	}
 
+	void submit(uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, const float* _view, const float* _proj, uint64_t _state) const
+	{
+		if (BGFX_STATE_MASK == _state)
+		{
+			_state = 0
+				| BGFX_STATE_RGB_WRITE
+				| BGFX_STATE_ALPHA_WRITE
+				| BGFX_STATE_DEPTH_WRITE
+				| BGFX_STATE_DEPTH_TEST_LESS
+				| BGFX_STATE_CULL_CCW
+				| BGFX_STATE_MSAA
+				;
+		}
+
+		ClusterCull cull;
+		cull.init(_mtx, _view, _proj, _state);
+
+		uint32_t cached = UINT32_MAX;
+
+		for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
+		{
+			const Group& group = *it;
+
+			if (!cull.isVisible(group.m_sphere) )
+			{
+				continue;
+			}
+
+			if (group.m_clusters.empty() )
+			{
+				submit(group, _id, _program, _mtx, _state, cached, 0, group.m_numIndices);
+				continue;
+			}
+
+			// Merge adjacent visible clusters into single draw call.
+			uint32_t startIndex = 0;
+			uint32_t numIndices = 0;
+			for (ClusterArray::const_iterator clusterIt = group.m_clusters.begin(), clusterItEnd = group.m_clusters.end(); clusterIt != clusterItEnd; ++clusterIt)
+			{
+				const Cluster& cluster = *clusterIt;
+				if (!cull.isVisible(cluster) )
+				{
+					continue;
+				}
+
+				if (startIndex + numIndices == cluster.m_startIndex)
+				{
+					numIndices += cluster.m_numIndices;
+				}
+				else
+				{
+					submit(group, _id, _program, _mtx, _state, cached, startIndex, numIndices);
+					startIndex = cluster.m_startIndex;
+					numIndices = cluster.m_numIndices;
+				}
+			}
+
+			submit(group, _id, _program, _mtx, _state, cached, startIndex, numIndices);
+		}
+	}
+
+	void submit(uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint8_t _lod, uint64_t _state) const
+	{
+		if (BGFX_STATE_MASK == _state)
+		{
+			_state = 0
+				| BGFX_STATE_RGB_WRITE
+				| BGFX_STATE_ALPHA_WRITE
+				| BGFX_STATE_DEPTH_WRITE
+				| BGFX_STATE_DEPTH_TEST_LESS
+				| BGFX_STATE_CULL_CCW
+				| BGFX_STATE_MSAA
+				;
+		}
+
+		uint32_t cached = UINT32_MAX;
+
+		for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
+		{
+			const Group& group = *it;
+
+			if (0 == _lod
+			||  group.m_lods.empty() )
+			{
+				submit(group, _id, _program, _mtx, _state, cached, 0, group.m_numIndices);
+			}
+			else
+			{
+				const Lod& lod = group.m_lods[bx::uint32_min(_lod, uint32_t(group.m_lods.size() ) ) - 1];
+				submit(group, _id, _program, _mtx, _state, cached, lod.m_startIndex, lod.m_numIndices);
+			}
+		}
+	}
+
+	uint8_t getNumLods() const
+	{
+		uint32_t num = 0;
+		for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
+		{
+			num = bx::uint32_max(num, uint32_t(it->m_lods.size() ) );
+		}
+
+		return uint8_t(num);
+	}
+
+	void submit(const Group& _group, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state, uint32_t& _cached, uint32_t _startIndex, uint32_t _numIndices) const
+	{
+		if (0 == _numIndices)
+		{
+			return;
+		}
+
+		if (UINT32_MAX == _cached)
+		{
+			_cached = bgfx::setTransform(_mtx);
+		}
+		else
+		{
+			bgfx::setTransform(_cached);
+		}
+
+		bgfx::setState(_state);
+		bgfx::setIndexBuffer(_group.m_ibh, _startIndex, _numIndices);
+		bgfx::setVertexBuffer(_group.m_vbh);
+		bgfx::submit(_id, _program);
+	}
+
 	void submit(const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices) const
 	{
 		uint32_t cached = bgfx::setTransform(_mtx, _numMatrices);
@@ -818,7 +1127,7 @@ struct Mesh
 			{
 				const Group& group = *it;
 
-				bgfx::setIndexBuffer(group.m_ibh);
+				bgfx::setIndexBuffer(group.m_ibh, 0, group.m_numIndices);
 				bgfx::setVertexBuffer(group.m_vbh);
 				bgfx::submit(state.m_viewId, state.m_program, 0, it != itEnd-1);
 			}
@@ -872,6 +1181,21 @@ void meshSubmit(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, co
 	_mesh->submit(_id, _program, _mtx, _state);
 }
 
+void meshSubmit(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, const float* _view, const float* _proj, uint64_t _state)
+{
+	_mesh->submit(_id, _program, _mtx, _view, _proj, _state);
+}
+
+void meshSubmitLod(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint8_t _lod, uint64_t _state)
+{
+	_mesh->submit(_id, _program, _mtx, _lod, _state);
+}
+
+uint8_t meshGetNumLods(const Mesh* _mesh)
+{
+	return _mesh->getNumLods();
+}
+
 void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices)
 {
 	_mesh->submit(_state, _numPasses, _mtx, _numMatrices);
@@ -57,6 +57,25 @@ void meshStateDestroy(MeshState* _meshState);
 void meshSubmit(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state = BGFX_STATE_MASK);
 void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices = 1);
 
+/// Submit mesh, skipping groups and clusters outside of view frustum. When
+/// mesh is drawn with `BGFX_STATE_CULL_CCW`, back facing clusters are
+/// skipped too. Cluster data is generated with `geometryc --clusters`.
+///
+/// @param[in] _mtx Model matrix.
+/// @param[in] _view View matrix.
+/// @param[in] _proj Projection matrix.
+///
+void meshSubmit(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, const float* _view, const float* _proj, uint64_t _state = BGFX_STATE_MASK);
+
+/// Submit mesh level of detail generated with `geometryc --lod`. LOD 0 is
+/// full detail mesh, LODs past the last available are clamped to it.
+///
+void meshSubmitLod(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint8_t _lod, uint64_t _state = BGFX_STATE_MASK);
+
+/// Returns number of generated LODs, not counting full detail mesh.
+///
+uint8_t meshGetNumLods(const Mesh* _mesh);
+
 struct Args
 {
 	Args(int _argc, char** _argv);
@@ -7,6 +7,8 @@
 #include <bgfx/bgfx.h>
 
 #include <limits.h> // INT_MAX
+#include <stdlib.h> // qsort
+#include <bx/uint32_t.h>
 #include <vector>
 
 #include "cube_atlas.h"
@@ -245,8 +247,20 @@ void RectanglePacker::merge()
 
 struct Atlas::PackedLayer
 {
+	PackedLayer()
+		: removedSpace(0)
+	{
+	}
+
 	RectanglePacker packer;
 	AtlasRegion faceRegion;
+	uint32_t removedSpace; //< Surface of removed regions not reclaimed yet.
+};
+
+struct Atlas::RegionState
+{
+	uint16_t outline;
+	bool used;
 };
 
 Atlas::Atlas(uint16_t _textureSize, uint16_t _maxRegionsCount)
@@ -255,6 +269,8 @@ Atlas::Atlas(uint16_t _textureSize, uint16_t _maxRegionsCount)
 	, m_textureSize(_textureSize)
 	, m_regionCount(0)
 	, m_maxRegionCount(_maxRegionsCount)
+	, m_numFreeRegions(0)
+	, m_generation(0)
 {
 	BX_CHECK(_textureSize >= 64 && _textureSize <= 4096, "Invalid _textureSize %d.", _textureSize);
 	BX_CHECK(_maxRegionsCount >= 64 && _maxRegionsCount <= 32000, "Invalid _maxRegionsCount %d.", _maxRegionsCount);
@@ -268,6 +284,8 @@ Atlas::Atlas(uint16_t _textureSize, uint16_t _maxRegionsCount)
 	}
 
 	m_regions = new AtlasRegion[_maxRegionsCount];
+	m_regionStates = new RegionState[_maxRegionsCount];
+	m_freeRegions = new uint16_t[_maxRegionsCount];
 	m_textureBuffer = new uint8_t[ _textureSize * _textureSize * 6 * 4 ];
 	bx::memSet(m_textureBuffer, 0, _textureSize * _textureSize * 6 * 4);
 
@@ -279,19 +297,30 @@ Atlas::Atlas(uint16_t _textureSize, uint16_t _maxRegionsCount)
 }
 
 Atlas::Atlas(uint16_t _textureSize, const uint8_t* _textureBuffer, uint16_t _regionCount, const uint8_t* _regionBuffer, uint16_t _maxRegionsCount)
-	: m_usedLayers(24)
+	: m_layers(NULL)
+	, m_usedLayers(24)
 	, m_usedFaces(6)
 	, m_textureSize(_textureSize)
 	, m_regionCount(_regionCount)
 	, m_maxRegionCount(_regionCount < _maxRegionsCount ? _regionCount : _maxRegionsCount)
+	, m_numFreeRegions(0)
+	, m_generation(0)
 {
 	BX_CHECK(_regionCount <= 64 && _maxRegionsCount <= 4096, "_regionCount %d, _maxRegionsCount %d", _regionCount, _maxRegionsCount);
 
 	init();
 
 	m_regions = new AtlasRegion[_regionCount];
+	m_regionStates = new RegionState[_regionCount];
+	m_freeRegions = new uint16_t[_regionCount];
 	m_textureBuffer = new uint8_t[getTextureBufferSize()];
 
+	for (uint16_t ii = 0; ii < _regionCount; ++ii)
+	{
+		m_regionStates[ii].outline = 0;
+		m_regionStates[ii].used    = true;
+	}
+
 	bx::memCopy(m_regions, _regionBuffer, _regionCount * sizeof(AtlasRegion) );
 	bx::memCopy(m_textureBuffer, _textureBuffer, getTextureBufferSize() );
 
@@ -310,6 +339,8 @@ Atlas::~Atlas()
 
 	delete [] m_layers;
 	delete [] m_regions;
+	delete [] m_regionStates;
+	delete [] m_freeRegions;
 	delete [] m_textureBuffer;
 }
 
@@ -339,7 +370,8 @@ void Atlas::init()
 
 uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bitmapBuffer, AtlasRegion::Type _type, uint16_t outline)
 {
-	if (m_regionCount >= m_maxRegionCount)
+	if (0 == m_numFreeRegions
+	&&  m_regionCount >= m_maxRegionCount)
 	{
 		return UINT16_MAX;
 	}
@@ -385,7 +417,12 @@ uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bit
 		}
 	}
 
-	AtlasRegion& region = m_regions[m_regionCount];
+	const uint16_t handle = 0 < m_numFreeRegions
+		? m_freeRegions[--m_numFreeRegions]
+		: m_regionCount++
+		;
+
+	AtlasRegion& region = m_regions[handle];
 	region.x = xx;
 	region.y = yy;
 	region.width = _width;
@@ -399,7 +436,239 @@ uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bit
 	region.width -= (outline * 2);
 	region.height -= (outline * 2);
 
-	return m_regionCount++;
+	RegionState& state = m_regionStates[handle];
+	state.outline = outline;
+	state.used    = true;
+
+	return handle;
+}
+
+void Atlas::removeRegion(uint16_t _regionHandle)
+{
+	BX_CHECK(NULL != m_layers, "Regions can't be removed from static atlas.");
+	BX_CHECK(_regionHandle < m_regionCount && m_regionStates[_regionHandle].used, "Invalid region handle %d.", _regionHandle);
+
+	const AtlasRegion& region = m_regions[_regionHandle];
+	RegionState& state = m_regionStates[_regionHandle];
+
+	const uint32_t width  = region.width  + state.outline * 2 + 1;
+	const uint32_t height = region.height + state.outline * 2 + 1;
+
+	const uint32_t idx = findLayer(region.mask);
+	if (idx < m_usedLayers)
+	{
+		m_layers[idx].removedSpace += width * height;
+	}
+
+	state.used = false;
+	m_freeRegions[m_numFreeRegions++] = _regionHandle;
+}
+
+bool Atlas::defragment(uint16_t* _evicted, uint16_t* _numEvicted, const uint32_t* _pinned)
+{
+	uint16_t numEvicted = 0;
+	if (NULL != _numEvicted)
+	{
+		*_numEvicted = 0;
+	}
+
+	uint32_t best = UINT32_MAX;
+	uint32_t bestSpace = 0;
+
+	for (uint32_t ii = 0; ii < m_usedLayers; ++ii)
+	{
+		if (m_layers[ii].removedSpace > bestSpace)
+		{
+			best = ii;
+			bestSpace = m_layers[ii].removedSpace;
+		}
+	}
+
+	if (UINT32_MAX == best)
+	{
+		return false;
+	}
+
+	repackLayer(best, _evicted, numEvicted, _pinned);
+
+	if (NULL != _numEvicted)
+	{
+		*_numEvicted = numEvicted;
+	}
+
+	return true;
+}
+
+uint32_t Atlas::findLayer(uint32_t _mask) const
+{
+	uint32_t idx = 0;
+	while (idx < m_usedLayers
+	&&     m_layers[idx].faceRegion.mask != _mask)
+	{
+		++idx;
+	}
+
+	return idx;
+}
+
+struct RepackItem
+{
+	uint16_t handle;
+	uint16_t height;
+	uint32_t offset;
+	bool     pinned;
+};
+
+static int compareRepackItem(const void* _lhs, const void* _rhs)
+{
+	const RepackItem& lhs = *(const RepackItem*)_lhs;
+	const RepackItem& rhs = *(const RepackItem*)_rhs;
+	if (lhs.pinned != rhs.pinned)
+	{
+		return lhs.pinned ? -1 : 1;
+	}
+
+	return int32_t(rhs.height) - int32_t(lhs.height);
+}
+
+void Atlas::repackLayer(uint32_t _idx, uint16_t* _evicted, uint16_t& _numEvicted, const uint32_t* _pinned)
+{
+	PackedLayer& layer = m_layers[_idx];
+	const uint32_t mask = layer.faceRegion.mask;
+	const bool     bgra = AtlasRegion::TYPE_BGRA8 == layer.faceRegion.getType();
+	const uint32_t bpp  = bgra ? 4 : 1;
+	const uint32_t component = layer.faceRegion.getComponentIndex();
+	const uint32_t pitch     = m_textureSize * 4;
+	const uint32_t faceSize  = m_textureSize * pitch;
+	uint8_t* face = m_textureBuffer + layer.faceRegion.getFaceIndex() * faceSize;
+
+	// Save content of live regions, layer is going to be overwritten while
+	// regions are moved around.
+	RepackItem* items = new RepackItem[m_regionCount];
+	uint32_t num  = 0;
+	uint32_t size = 0;
+	for (uint16_t ii = 0; ii < m_regionCount; ++ii)
+	{
+		const AtlasRegion& region = m_regions[ii];
+		if (m_regionStates[ii].used
+		&&  region.mask == mask)
+		{
+			const uint32_t outline = m_regionStates[ii].outline;
+			RepackItem& item = items[num++];
+			item.handle = ii;
+			item.height = uint16_t(region.height + outline * 2);
+			item.offset = size;
+			item.pinned = NULL != _pinned && 0 != _pinned[ii];
+			size += (region.width + outline * 2) * item.height * bpp;
+		}
+	}
+
+	uint8_t* temp = new uint8_t[bx::uint32_max(size, 1)];
+
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		const RepackItem& item = items[ii];
+		const AtlasRegion& region = m_regions[item.handle];
+		const uint32_t outline = m_regionStates[item.handle].outline;
+		const uint32_t width = region.width + outline * 2;
+		uint8_t* dst = temp + item.offset;
+		uint8_t* src = face + (region.y - outline) * pitch + (region.x - outline) * 4;
+
+		for (uint32_t yy = 0; yy < item.height; ++yy, src += pitch)
+		{
+			if (bgra)
+			{
+				bx::memCopy(dst, src, width * 4);
+				bx::memSet(src, 0, width * 4);
+				dst += width * 4;
+			}
+			else
+			{
+				for (uint32_t xx = 0; xx < width; ++xx)
+				{
+					*dst++ = src[xx * 4 + component];
+					src[xx * 4 + component] = 0;
+				}
+			}
+		}
+	}
+
+	// Pinned regions first, then taller regions first, skyline packs them
+	// tighter.
+	qsort(items, num, sizeof(RepackItem), compareRepackItem);
+
+	layer.packer.clear();
+	layer.removedSpace = 0;
+
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		const RepackItem& item = items[ii];
+		AtlasRegion& region = m_regions[item.handle];
+		const uint32_t outline = m_regionStates[item.handle].outline;
+		const uint32_t width = region.width + outline * 2;
+
+		uint16_t xx;
+		uint16_t yy;
+		if (!layer.packer.addRectangle(uint16_t(width + 1), uint16_t(item.height + 1), xx, yy) )
+		{
+			// Region content is lost, evict it. Its space is not part of
+			// the layer anymore, it's not counted as removed space.
+			BX_WARN(false, "Failed to repack atlas region %d, evicting it.", item.handle);
+			region.width  = 0;
+			region.height = 0;
+
+			RegionState& state = m_regionStates[item.handle];
+			state.outline = 0;
+			state.used    = false;
+			m_freeRegions[m_numFreeRegions++] = item.handle;
+
+			if (NULL != _evicted)
+			{
+				_evicted[_numEvicted] = item.handle;
+			}
+
+			++_numEvicted;
+			continue;
+		}
+
+		const uint8_t* src = temp + item.offset;
+		uint8_t* dst = face + yy * pitch + xx * 4;
+
+		for (uint32_t jj = 0; jj < item.height; ++jj, dst += pitch)
+		{
+			if (bgra)
+			{
+				bx::memCopy(dst, src, width * 4);
+				src += width * 4;
+			}
+			else
+			{
+				for (uint32_t kk = 0; kk < width; ++kk)
+				{
+					dst[kk * 4 + component] = *src++;
+				}
+			}
+		}
+
+		region.x = uint16_t(xx + outline);
+		region.y = uint16_t(yy + outline);
+	}
+
+	delete [] temp;
+	delete [] items;
+
+	++m_generation;
+
+	bgfx::updateTextureCube(m_textureHandle
+		, 0
+		, uint8_t(layer.faceRegion.getFaceIndex() )
+		, 0
+		, 0
+		, 0
+		, m_textureSize
+		, m_textureSize
+		, bgfx::copy(face, faceSize)
+		);
 }
 
 void Atlas::updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffer)
@@ -70,6 +70,20 @@ public:
 	/// add a region to the atlas, and copy the content of mem to the underlying texture
 	uint16_t addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bitmapBuffer, AtlasRegion::Type _type = AtlasRegion::TYPE_BGRA8, uint16_t outline = 0);
 
+	/// remove a region from the atlas, its space is reclaimed by defragment
+	void removeRegion(uint16_t _regionHandle);
+
+	/// repack the layer with the most removed space, region handles stay
+	/// valid but their UV coordinates must be packed again (see getGeneration)
+	/// @param evicted if not NULL, receives handles of regions that didn't fit
+	///   the repacked layer, must hold getMaxRegionCount() handles. These
+	///   regions are removed from the atlas.
+	/// @param numEvicted number of handles written to evicted
+	/// @param pinned if not NULL, regions with non-zero entry are repacked
+	///   first, so they are evicted only if they alone don't fit the layer
+	/// @return false if there is no removed space to reclaim
+	bool defragment(uint16_t* _evicted = NULL, uint16_t* _numEvicted = NULL, const uint32_t* _pinned = NULL);
+
 	/// update a preallocated region
 	void updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffer);
 
@@ -116,6 +130,12 @@ public:
 		return m_regionCount;
 	}
 
+	/// retrieve the maximum number of region in the atlas
+	uint16_t getMaxRegionCount() const
+	{
+		return m_maxRegionCount;
+	}
+
 	/// retrieve a pointer to the region buffer (in order to serialize it)
 	const AtlasRegion* getRegionBuffer() const
 	{
@@ -134,12 +154,25 @@ public:
 		return m_textureBuffer;
 	}
 
+	/// retrieve the generation of region positions, it changes every time
+	/// regions are moved, UV coordinates packed with an older generation
+	/// must be packed again
+	uint32_t getGeneration() const
+	{
+		return m_generation;
+	}
+
 private:
 	void init();
+	uint32_t findLayer(uint32_t _mask) const;
+	void repackLayer(uint32_t _idx, uint16_t* _evicted, uint16_t& _numEvicted, const uint32_t* _pinned);
 
 	struct PackedLayer;
+	struct RegionState;
 	PackedLayer* m_layers;
 	AtlasRegion* m_regions;
+	RegionState* m_regionStates;
+	uint16_t* m_freeRegions;
 	uint8_t* m_textureBuffer;
 
 	uint32_t m_usedLayers;
@@ -152,6 +185,8 @@ private:
 
 	uint16_t m_regionCount;
 	uint16_t m_maxRegionCount;
+	uint16_t m_numFreeRegions;
+	uint32_t m_generation;
 };
 
 #endif // CUBE_ATLAS_H_HEADER_GUARD
@@ -5,6 +5,12 @@
 
 #define USE_EDTAA3 0
 
+// Bake distance glyphs with edtaa3 too, and warn when the distance transform
+// output differs by more than DISTANCE_VALIDATE_TOLERANCE (one pixel of
+// distance at DISTANCE_RADIUS).
+#define DISTANCE_VALIDATE 0
+#define DISTANCE_VALIDATE_TOLERANCE 16
+
 #include <bx/macros.h>
 
 #if BX_COMPILER_MSVC
@@ -27,12 +33,17 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 
 #include <bgfx/bgfx.h>
 
-#if USE_EDTAA3
+#if USE_EDTAA3 || DISTANCE_VALIDATE
 #	include <edtaa3/edtaa3func.cpp>
-#else
-#	define SDF_IMPLEMENTATION
-#	include <sdf/sdf.h>
-#endif // USE_EDTAA3
+#endif // USE_EDTAA3 || DISTANCE_VALIDATE
+
+#include <bx/allocator.h>
+#include <bx/cpu.h>
+#include <bx/fpumath.h>
+#include <bx/simd_t.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+#include <bx/uint32_t.h>
 
 #include <wchar.h> // wcslen
 
@@ -43,12 +54,215 @@ namespace stl = tinystl;
 #include "font_manager.h"
 #include "../cube_atlas.h"
 
+#define MAX_FONT_BUFFER_SIZE    (512 * 512 * 4)
+#define MAX_BAKE_BATCH_SIZE     256
+#define DISTANCE_GLYPH_PADDING  6
+#define DISTANCE_RADIUS         8.0f
+
 struct FTHolder
 {
 	FT_Library library;
 	FT_Face face;
 };
 
+/// Exact Euclidean distance transform (Felzenszwalb & Huttenlocher) in
+/// linear time, keeping its scratch memory between glyphs.
+struct DistanceTransform
+{
+	DistanceTransform()
+		: m_mem(NULL)
+		, m_outer(NULL)
+		, m_inner(NULL)
+		, m_ff(NULL)
+		, m_zz(NULL)
+		, m_vv(NULL)
+		, m_size(0)
+		, m_length(0)
+	{
+	}
+
+	~DistanceTransform()
+	{
+		free(m_mem);
+	}
+
+	/// Build distance field from 8bit coverage. Output is encoded the same
+	/// way as sdfBuild, 0 is _radius outside and 255 is _radius inside the
+	/// glyph. _out can be the same buffer as _img.
+	void build(uint8_t* _out, const uint8_t* _img, uint32_t _width, uint32_t _height, float _radius);
+
+private:
+	void reserve(uint32_t _size, uint32_t _length);
+	void transform(float* _grid, uint32_t _width, uint32_t _height);
+	void transform1d(float* _grid, uint32_t _stride, uint32_t _length);
+
+	void* m_mem;
+	float* m_outer;
+	float* m_inner;
+	float* m_ff;
+	float* m_zz;
+	uint16_t* m_vv;
+	uint32_t m_size;
+	uint32_t m_length;
+};
+
+void DistanceTransform::reserve(uint32_t _size, uint32_t _length)
+{
+	if (_size   <= m_size
+	&&  _length <= m_length)
+	{
+		return;
+	}
+
+	m_size   = bx::uint32_max(m_size, _size);
+	m_length = bx::uint32_max(m_length, _length);
+
+	const uint32_t size   = bx::strideAlign(m_size, 4);
+	const uint32_t length = bx::strideAlign(m_length + 1, 4);
+
+	free(m_mem);
+	m_mem = malloc( (size * 2 + length * 2) * sizeof(float) + length * sizeof(uint16_t) + 16);
+
+	m_outer = (float*)bx::alignPtr(m_mem, 0, 16);
+	m_inner = m_outer + size;
+	m_ff    = m_inner + size;
+	m_zz    = m_ff + length;
+	m_vv    = (uint16_t*)(m_zz + length);
+}
+
+void DistanceTransform::transform1d(float* _grid, uint32_t _stride, uint32_t _length)
+{
+	float* ff    = m_ff;
+	float* zz    = m_zz;
+	uint16_t* vv = m_vv;
+
+	for (uint32_t qq = 0; qq < _length; ++qq)
+	{
+		ff[qq] = _grid[qq * _stride];
+	}
+
+	// Lower envelope of parabolas rooted at each sample.
+	uint32_t kk = 0;
+	vv[0] = 0;
+	zz[0] = -bx::huge;
+	zz[1] = bx::huge;
+
+	for (uint32_t qq = 1; qq < _length; ++qq)
+	{
+		const float fq = ff[qq] + float(qq * qq);
+
+		uint32_t rr = vv[kk];
+		float ss = (fq - ff[rr] - float(rr * rr) ) / float(2 * (qq - rr) );
+
+		while (ss <= zz[kk])
+		{
+			--kk;
+			rr = vv[kk];
+			ss = (fq - ff[rr] - float(rr * rr) ) / float(2 * (qq - rr) );
+		}
+
+		++kk;
+		vv[kk]     = uint16_t(qq);
+		zz[kk]     = ss;
+		zz[kk + 1] = bx::huge;
+	}
+
+	kk = 0;
+	for (uint32_t qq = 0; qq < _length; ++qq)
+	{
+		while (zz[kk + 1] < float(qq) )
+		{
+			++kk;
+		}
+
+		const uint32_t rr = vv[kk];
+		const float dd = float(int32_t(qq) - int32_t(rr) );
+		_grid[qq * _stride] = ff[rr] + dd * dd;
+	}
+}
+
+void DistanceTransform::transform(float* _grid, uint32_t _width, uint32_t _height)
+{
+	for (uint32_t xx = 0; xx < _width; ++xx)
+	{
+		transform1d(&_grid[xx], _width, _height);
+	}
+
+	for (uint32_t yy = 0; yy < _height; ++yy)
+	{
+		transform1d(&_grid[yy * _width], 1, _width);
+	}
+}
+
+void DistanceTransform::build(uint8_t* _out, const uint8_t* _img, uint32_t _width, uint32_t _height, float _radius)
+{
+	const uint32_t num = _width * _height;
+	reserve(num, bx::uint32_max(_width, _height) );
+
+	// Squared distance seeds. Edge pixels get sub-pixel distance to the
+	// contour estimated from coverage, 0.5 coverage being on the contour.
+	const float inf = 1e20f;
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		const uint8_t alpha = _img[ii];
+
+		if (255 == alpha)
+		{
+			m_outer[ii] = 0.0f;
+			m_inner[ii] = inf;
+		}
+		else if (0 == alpha)
+		{
+			m_outer[ii] = inf;
+			m_inner[ii] = 0.0f;
+		}
+		else
+		{
+			const float dd = 0.5f - float(alpha) / 255.0f;
+			m_outer[ii] = dd > 0.0f ? dd * dd : 0.0f;
+			m_inner[ii] = dd < 0.0f ? dd * dd : 0.0f;
+		}
+	}
+
+	transform(m_outer, _width, _height);
+	transform(m_inner, _width, _height);
+
+	using namespace bx;
+
+	const float scale = -0.5f / _radius;
+
+	const simd128_t half   = simd_splat(0.5f);
+	const simd128_t vscale = simd_splat(scale);
+	const simd128_t zero   = simd_zero();
+	const simd128_t one    = simd_splat(1.0f);
+	const simd128_t full   = simd_splat(255.0f);
+
+	uint32_t ii = 0;
+	for (const uint32_t num4 = num & ~3; ii < num4; ii += 4)
+	{
+		const simd128_t outer = simd_sqrt(simd_ld(&m_outer[ii]) );
+		const simd128_t inner = simd_sqrt(simd_ld(&m_inner[ii]) );
+		const simd128_t dist  = simd_sub(outer, inner);
+		const simd128_t value = simd_madd(dist, vscale, half);
+		const simd128_t sat   = simd_min(simd_max(value, zero), one);
+		const simd128_t ival  = simd_ftoi(simd_mul(sat, full) );
+
+		BX_ALIGN_DECL_16(int32_t) tmp[4];
+		simd_st(tmp, ival);
+
+		_out[ii + 0] = uint8_t(tmp[0]);
+		_out[ii + 1] = uint8_t(tmp[1]);
+		_out[ii + 2] = uint8_t(tmp[2]);
+		_out[ii + 3] = uint8_t(tmp[3]);
+	}
+
+	for (; ii < num; ++ii)
+	{
+		const float dist = bx::fsqrt(m_outer[ii]) - bx::fsqrt(m_inner[ii]);
+		_out[ii] = uint8_t(bx::fsaturate(0.5f + dist * scale) * 255.0f);
+	}
+}
+
 class TrueTypeFont
 {
 public:
@@ -73,10 +287,11 @@ public:
 	/// @ remark buffer min size: glyphInfo.m_width * glyphInfo * height * sizeof(uint32_t)
 	bool bakeGlyphSubpixel(CodePoint _codePoint, GlyphInfo& _outGlyphInfo, uint8_t* _outBuffer);
 
-	/// raster a glyph as 8bit signed distance to a memory buffer
-	/// update the GlyphInfo according to the raster strategy
-	/// @ remark buffer min size: glyphInfo.m_width * glyphInfo * height * sizeof(char)
-	bool bakeGlyphDistance(CodePoint _codePoint, GlyphInfo& _outGlyphInfo, uint8_t* _outBuffer);
+	/// raster a glyph as 8bit alpha padded for distance field baking to a
+	/// memory buffer, update the GlyphInfo according to the raster strategy
+	/// @ remark return false when padded glyph doesn't fit into _outBufferSize,
+	///   glyphInfo width and height are set to padded size in that case
+	bool rasterGlyphDistance(CodePoint _codePoint, GlyphInfo& _outGlyphInfo, uint8_t* _outBuffer, uint32_t _outBufferSize);
 
 private:
 	FTHolder* m_font;
@@ -271,9 +486,9 @@ bool TrueTypeFont::bakeGlyphSubpixel(CodePoint _codePoint, GlyphInfo& _glyphInfo
 	return true;
 }
 
-static void makeDistanceMap(const uint8_t* _img, uint8_t* _outImg, uint32_t _width, uint32_t _height)
+#if USE_EDTAA3 || DISTANCE_VALIDATE
+static void makeDistanceMapEdtaa3(const uint8_t* _img, uint8_t* _outImg, uint32_t _width, uint32_t _height)
 {
-#if USE_EDTAA3
 	int16_t* xdist = (int16_t*)malloc(_width * _height * sizeof(int16_t) );
 	int16_t* ydist = (int16_t*)malloc(_width * _height * sizeof(int16_t) );
 	double* gx = (double*)calloc(_width * _height, sizeof(double) );
@@ -362,12 +577,47 @@ static void makeDistanceMap(const uint8_t* _img, uint8_t* _outImg, uint32_t _wid
 	free(data);
 	free(outside);
 	free(inside);
+}
+#endif // USE_EDTAA3 || DISTANCE_VALIDATE
+
+static void makeDistanceMap(DistanceTransform& _dt, const uint8_t* _img, uint8_t* _outImg, uint32_t _width, uint32_t _height)
+{
+#if USE_EDTAA3
+	BX_UNUSED(_dt);
+	makeDistanceMapEdtaa3(_img, _outImg, _width, _height);
 #else
-	sdfBuild(_outImg, _width, 8.0f, _img, _width, _height, _width);
+#	if DISTANCE_VALIDATE
+	// _img and _outImg can be the same buffer, reference is baked first.
+	const uint32_t num = _width * _height;
+	uint8_t* reference = (uint8_t*)malloc(num);
+	makeDistanceMapEdtaa3(_img, reference, _width, _height);
+#	endif // DISTANCE_VALIDATE
+
+	_dt.build(_outImg, _img, _width, _height, DISTANCE_RADIUS);
+
+#	if DISTANCE_VALIDATE
+	uint32_t maxDiff = 0;
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		const int32_t diff = int32_t(_outImg[ii]) - int32_t(reference[ii]);
+		maxDiff = bx::uint32_max(maxDiff, uint32_t(diff < 0 ? -diff : diff) );
+	}
+
+	BX_WARN(maxDiff <= DISTANCE_VALIDATE_TOLERANCE
+		, "Distance field (%dx%d) differs from edtaa3 by %d, tolerance is %d."
+		, _width
+		, _height
+		, maxDiff
+		, DISTANCE_VALIDATE_TOLERANCE
+		);
+	BX_UNUSED(maxDiff);
+
+	free(reference);
+#	endif // DISTANCE_VALIDATE
 #endif // USE_EDTAA3
 }
 
-bool TrueTypeFont::bakeGlyphDistance(CodePoint _codePoint, GlyphInfo& _glyphInfo, uint8_t* _outBuffer)
+bool TrueTypeFont::rasterGlyphDistance(CodePoint _codePoint, GlyphInfo& _glyphInfo, uint8_t* _outBuffer, uint32_t _outBufferSize)
 {
 	BX_CHECK(m_font != NULL, "TrueTypeFont not initialized");
 
@@ -401,32 +651,40 @@ bool TrueTypeFont::bakeGlyphDistance(CodePoint _codePoint, GlyphInfo& _glyphInfo
 	int32_t ww = bitmap->bitmap.width;
 	int32_t hh = bitmap->bitmap.rows;
 
-	glyphInfoInit(_glyphInfo, bitmap, slot, _outBuffer, 1);
+	const uint32_t dw = DISTANCE_GLYPH_PADDING;
+	const uint32_t dh = DISTANCE_GLYPH_PADDING;
 
-	FT_Done_Glyph(glyph);
+	const uint32_t nw = ww + dw * 2;
+	const uint32_t nh = hh + dh * 2;
 
-	if (ww * hh > 0)
+	if (ww * hh > 0
+	&&  nw * nh > _outBufferSize)
 	{
-		uint32_t dw = 6;
-		uint32_t dh = 6;
+		FT_Done_Glyph(glyph);
 
-		uint32_t nw = ww + dw * 2;
-		uint32_t nh = hh + dh * 2;
-		BX_CHECK(nw * nh < 128 * 128, "Buffer overflow (size %d)", nw * nh);
+		_glyphInfo.width  = (float)nw;
+		_glyphInfo.height = (float)nh;
+		return false;
+	}
 
-		uint32_t buffSize = nw * nh * sizeof(uint8_t);
+	glyphInfoInit(_glyphInfo, bitmap, slot, _outBuffer, 1);
 
-		uint8_t* alphaImg = (uint8_t*)malloc(buffSize);
-		bx::memSet(alphaImg, 0, nw * nh * sizeof(uint8_t) );
+	FT_Done_Glyph(glyph);
 
-		//copy the original buffer to the temp one
-		for (uint32_t ii = dh; ii < nh - dh; ++ii)
+	if (ww * hh > 0)
+	{
+		// Pad glyph in place, starting from the last row since padded rows
+		// never overlap source rows that are not moved yet.
+		for (int32_t ii = hh - 1; ii >= 0; --ii)
 		{
-			bx::memCopy(alphaImg + ii * nw + dw, _outBuffer + (ii - dh) * ww, ww);
+			uint8_t* dst = _outBuffer + (ii + dh) * nw;
+			bx::memMove(dst + dw, _outBuffer + ii * ww, ww);
+			bx::memSet(dst, 0, dw);
+			bx::memSet(dst + dw + ww, 0, dw);
 		}
 
-		makeDistanceMap(alphaImg, _outBuffer, nw, nh);
-		free(alphaImg);
+		bx::memSet(_outBuffer, 0, dh * nw);
+		bx::memSet(_outBuffer + (nh - dh) * nw, 0, dh * nw);
 
 		_glyphInfo.offset_x -= (float)dw;
 		_glyphInfo.offset_y -= (float)dh;
@@ -456,7 +714,189 @@ struct FontManager::CachedFont
 	int16_t padding;
 };
 
-#define MAX_FONT_BUFFER_SIZE (512 * 512 * 4)
+static void eraseGlyph(GlyphHashMap& _glyphs, CodePoint _codePoint)
+{
+	GlyphHashMap::iterator it = _glyphs.find(_codePoint);
+	if (it != _glyphs.end() )
+	{
+		_glyphs.erase(it);
+	}
+}
+
+struct FontManager::GlyphLruNode
+{
+	FontHandle handle;
+	CodePoint codePoint;
+	uint16_t prev;
+	uint16_t next;
+	bool used;
+};
+
+struct DistanceBakeJob
+{
+	uint8_t* data;
+	uint32_t width;
+	uint32_t height;
+};
+
+/// Bakes a batch of rasterized glyphs to distance field in place. Worker
+/// threads are started on demand and kept waiting between batches, each
+/// thread using its own distance transform scratch.
+class DistanceBakeQueue
+{
+public:
+	DistanceBakeQueue()
+		: m_num(0)
+		, m_next(0)
+		, m_numThreads(1)
+		, m_numStarted(1)
+		, m_exit(false)
+	{
+		for (uint32_t ii = 0; ii < MAX_BAKE_THREADS; ++ii)
+		{
+			m_worker[ii].queue = this;
+			m_worker[ii].dt    = &m_dt[ii];
+		}
+	}
+
+	~DistanceBakeQueue()
+	{
+#if BX_CONFIG_SUPPORTS_THREADING
+		m_exit = true;
+		if (1 < m_numStarted)
+		{
+			m_sem.post(m_numStarted-1);
+		}
+
+		for (uint32_t ii = 1; ii < m_numStarted; ++ii)
+		{
+			m_thread[ii].shutdown();
+		}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+	}
+
+	void setNumThreads(uint32_t _num)
+	{
+#if BX_CONFIG_SUPPORTS_THREADING
+		m_numThreads = bx::uint32_clamp(_num, 1, MAX_BAKE_THREADS);
+
+		for (; m_numStarted < m_numThreads; ++m_numStarted)
+		{
+			m_thread[m_numStarted].init(threadFunc, &m_worker[m_numStarted], 0, "font - distance");
+		}
+#else
+		BX_UNUSED(_num);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+	}
+
+	void add(uint8_t* _data, uint32_t _width, uint32_t _height)
+	{
+		BX_CHECK(m_num < MAX_BAKE_BATCH_SIZE, "Too many glyphs in batch.");
+		DistanceBakeJob& job = m_jobs[m_num++];
+		job.data   = _data;
+		job.width  = _width;
+		job.height = _height;
+	}
+
+	/// Bake queued glyphs, batch wall time and glyph count are added to
+	/// _stats.
+	void run(GlyphCacheStats& _stats)
+	{
+		if (0 == m_num)
+		{
+			return;
+		}
+
+		const int64_t start = bx::getHPCounter();
+		m_next = 0;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+		// Single glyph is not worth waking up threads.
+		const uint32_t numThreads = bx::uint32_min(m_numThreads, m_num/2);
+		if (1 < numThreads)
+		{
+			m_sem.post(numThreads-1);
+			execute(m_dt[0]);
+
+			for (uint32_t ii = 1; ii < numThreads; ++ii)
+			{
+				m_doneSem.wait();
+			}
+		}
+		else
+#endif // BX_CONFIG_SUPPORTS_THREADING
+		{
+			execute(m_dt[0]);
+		}
+
+		_stats.distanceBakeTime += bx::getHPCounter() - start;
+		_stats.numDistanceBaked += m_num;
+		m_num = 0;
+	}
+
+private:
+	struct Worker
+	{
+		DistanceBakeQueue* queue;
+		DistanceTransform* dt;
+	};
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	static int32_t threadFunc(void* _userData)
+	{
+		Worker* worker = (Worker*)_userData;
+		DistanceBakeQueue* queue = worker->queue;
+
+		for (;;)
+		{
+			queue->m_sem.wait();
+
+			if (queue->m_exit)
+			{
+				break;
+			}
+
+			queue->execute(*worker->dt);
+			queue->m_doneSem.post();
+		}
+
+		return EXIT_SUCCESS;
+	}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	void execute(DistanceTransform& _dt)
+	{
+		for (uint32_t idx = bx::atomicFetchAndAdd(&m_next, 1u); idx < m_num; idx = bx::atomicFetchAndAdd(&m_next, 1u) )
+		{
+			const DistanceBakeJob& job = m_jobs[idx];
+			makeDistanceMap(_dt, job.data, job.data, job.width, job.height);
+		}
+	}
+
+	DistanceBakeJob m_jobs[MAX_BAKE_BATCH_SIZE];
+	DistanceTransform m_dt[MAX_BAKE_THREADS];
+	Worker m_worker[MAX_BAKE_THREADS];
+	uint32_t m_num;
+	volatile uint32_t m_next;
+	uint32_t m_numThreads;
+	uint32_t m_numStarted;
+	bool m_exit;
+#if BX_CONFIG_SUPPORTS_THREADING
+	bx::Thread m_thread[MAX_BAKE_THREADS];
+	bx::Semaphore m_sem;
+	bx::Semaphore m_doneSem;
+#endif // BX_CONFIG_SUPPORTS_THREADING
+};
+
+static void scaleGlyphInfo(GlyphInfo& _glyphInfo, float _scale)
+{
+	_glyphInfo.advance_x = (_glyphInfo.advance_x * _scale);
+	_glyphInfo.advance_y = (_glyphInfo.advance_y * _scale);
+	_glyphInfo.offset_x = (_glyphInfo.offset_x * _scale);
+	_glyphInfo.offset_y = (_glyphInfo.offset_y * _scale);
+	_glyphInfo.height = (_glyphInfo.height * _scale);
+	_glyphInfo.width = (_glyphInfo.width * _scale);
+}
 
 FontManager::FontManager(Atlas* _atlas)
 	: m_ownAtlas(false)
@@ -477,17 +917,25 @@ void FontManager::init()
 	m_cachedFiles = new CachedFile[MAX_OPENED_FILES];
 	m_cachedFonts = new CachedFont[MAX_OPENED_FONT];
 	m_buffer = new uint8_t[MAX_FONT_BUFFER_SIZE];
+	m_bakeQueue = new DistanceBakeQueue;
+	m_bakeQueue->setNumThreads(4);
+
+	const uint16_t maxRegions = m_atlas->getMaxRegionCount();
+	m_lru = new GlyphLruNode[maxRegions];
+	m_evictedRegions = new uint16_t[maxRegions];
+	m_pinCount = new uint32_t[maxRegions];
+	bx::memSet(m_pinCount, 0, maxRegions*sizeof(uint32_t) );
+	for (uint16_t ii = 0; ii < maxRegions; ++ii)
+	{
+		m_lru[ii].used = false;
+	}
 
-	const uint32_t W = 3;
-	// Create filler rectangle
-	uint8_t buffer[W * W * 4];
-	bx::memSet(buffer, 255, W * W * 4);
-
-	m_blackGlyph.width = W;
-	m_blackGlyph.height = W;
+	m_lruHead = UINT16_MAX;
+	m_lruTail = UINT16_MAX;
+	m_maxGlyphs = 0;
+	bx::memSet(&m_stats, 0, sizeof(m_stats) );
 
-	///make sure the black glyph doesn't bleed by using a one pixel inner outline
-	m_blackGlyph.regionIndex = m_atlas->addRegion(W, W, buffer, AtlasRegion::TYPE_GRAY, 1);
+	addBlackGlyph();
 }
 
 FontManager::~FontManager()
@@ -499,6 +947,10 @@ FontManager::~FontManager()
 	delete [] m_cachedFiles;
 
 	delete [] m_buffer;
+	delete m_bakeQueue;
+	delete [] m_lru;
+	delete [] m_evictedRegions;
+	delete [] m_pinCount;
 
 	if (m_ownAtlas)
 	{
@@ -595,6 +1047,18 @@ void FontManager::destroyFont(FontHandle _handle)
 		font.trueTypeFont = NULL;
 	}
 
+	// Give atlas space of glyphs owned by this font back.
+	for (GlyphHashMap::iterator it = font.cachedGlyphs.begin(), itEnd = font.cachedGlyphs.end(); it != itEnd; ++it)
+	{
+		const uint16_t regionIndex = it->second.regionIndex;
+		if (UINT16_MAX != regionIndex
+		&&  m_lru[regionIndex].used
+		&&  m_lru[regionIndex].handle.idx == _handle.idx)
+		{
+			releaseGlyph(regionIndex);
+		}
+	}
+
 	font.cachedGlyphs.clear();
 	m_fontHandles.free(_handle.idx);
 }
@@ -609,6 +1073,12 @@ bool FontManager::preloadGlyph(FontHandle _handle, const wchar_t* _string)
 		return false;
 	}
 
+	if (FONT_TYPE_DISTANCE          == font.fontInfo.fontType
+	||  FONT_TYPE_DISTANCE_SUBPIXEL == font.fontInfo.fontType)
+	{
+		return preloadDistanceGlyphs(_handle, _string);
+	}
+
 	for (uint32_t ii = 0, end = (uint32_t)wcslen(_string); ii < end; ++ii)
 	{
 		CodePoint codePoint = _string[ii];
@@ -636,36 +1106,36 @@ bool FontManager::preloadGlyph(FontHandle _handle, CodePoint _codePoint)
 	if (NULL != font.trueTypeFont)
 	{
 		GlyphInfo glyphInfo;
+		bool baked = false;
 
 		switch (font.fontInfo.fontType)
 		{
 		case FONT_TYPE_ALPHA:
-			font.trueTypeFont->bakeGlyphAlpha(_codePoint, glyphInfo, m_buffer);
+			baked = font.trueTypeFont->bakeGlyphAlpha(_codePoint, glyphInfo, m_buffer);
 			break;
 
 		case FONT_TYPE_DISTANCE:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
-			break;
-
 		case FONT_TYPE_DISTANCE_SUBPIXEL:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
+			baked = font.trueTypeFont->rasterGlyphDistance(_codePoint, glyphInfo, m_buffer, MAX_FONT_BUFFER_SIZE);
+			if (baked
+			&&  glyphInfo.width * glyphInfo.height > 0.0f)
+			{
+				m_bakeQueue->add(m_buffer, uint32_t(glyphInfo.width), uint32_t(glyphInfo.height) );
+				m_bakeQueue->run(m_stats);
+			}
 			break;
 
 		default:
 			BX_CHECK(false, "TextureType not supported yet");
 		}
 
-		if (!addBitmap(glyphInfo, m_buffer) )
+		if (!baked
+		||  !addBitmap(glyphInfo, m_buffer, _handle, _codePoint) )
 		{
 			return false;
 		}
 
-		glyphInfo.advance_x = (glyphInfo.advance_x * fontInfo.scale);
-		glyphInfo.advance_y = (glyphInfo.advance_y * fontInfo.scale);
-		glyphInfo.offset_x = (glyphInfo.offset_x * fontInfo.scale);
-		glyphInfo.offset_y = (glyphInfo.offset_y * fontInfo.scale);
-		glyphInfo.height = (glyphInfo.height * fontInfo.scale);
-		glyphInfo.width = (glyphInfo.width * fontInfo.scale);
+		scaleGlyphInfo(glyphInfo, fontInfo.scale);
 
 		font.cachedGlyphs[_codePoint] = glyphInfo;
 		return true;
@@ -677,12 +1147,7 @@ bool FontManager::preloadGlyph(FontHandle _handle, CodePoint _codePoint)
 		const GlyphInfo* glyph = getGlyphInfo(font.masterFontHandle, _codePoint);
 
 		GlyphInfo glyphInfo = *glyph;
-		glyphInfo.advance_x = (glyphInfo.advance_x * fontInfo.scale);
-		glyphInfo.advance_y = (glyphInfo.advance_y * fontInfo.scale);
-		glyphInfo.offset_x = (glyphInfo.offset_x * fontInfo.scale);
-		glyphInfo.offset_y = (glyphInfo.offset_y * fontInfo.scale);
-		glyphInfo.height = (glyphInfo.height * fontInfo.scale);
-		glyphInfo.width = (glyphInfo.width * fontInfo.scale);
+		scaleGlyphInfo(glyphInfo, fontInfo.scale);
 
 		font.cachedGlyphs[_codePoint] = glyphInfo;
 		return true;
@@ -691,6 +1156,102 @@ bool FontManager::preloadGlyph(FontHandle _handle, CodePoint _codePoint)
 	return false;
 }
 
+void FontManager::setNumBakeThreads(uint32_t _num)
+{
+	m_bakeQueue->setNumThreads(_num);
+}
+
+bool FontManager::preloadDistanceGlyphs(FontHandle _handle, const wchar_t* _string)
+{
+	CachedFont& font = m_cachedFonts[_handle.idx];
+	const float scale = font.fontInfo.scale;
+
+	CodePoint codePoint[MAX_BAKE_BATCH_SIZE];
+	GlyphInfo glyphInfo[MAX_BAKE_BATCH_SIZE];
+	uint32_t offset[MAX_BAKE_BATCH_SIZE];
+
+	bool result = true;
+
+	for (uint32_t ii = 0, end = (uint32_t)wcslen(_string); ii < end;)
+	{
+		// FreeType face is not thread safe, raster serially into raster
+		// buffer, each glyph taking only its padded size, then bake distance
+		// of the whole batch in parallel.
+		uint32_t num = 0;
+		uint32_t size = 0;
+		for (; ii < end && num < MAX_BAKE_BATCH_SIZE; ++ii)
+		{
+			const CodePoint cp = _string[ii];
+
+			bool cached = font.cachedGlyphs.end() != font.cachedGlyphs.find(cp);
+			for (uint32_t jj = 0; jj < num && !cached; ++jj)
+			{
+				cached = cp == codePoint[jj];
+			}
+
+			if (cached)
+			{
+				continue;
+			}
+
+			GlyphInfo& info = glyphInfo[num];
+			info.width  = 0.0f;
+			info.height = 0.0f;
+
+			if (!font.trueTypeFont->rasterGlyphDistance(cp, info, &m_buffer[size], MAX_FONT_BUFFER_SIZE - size) )
+			{
+				const uint32_t required = uint32_t(info.width) * uint32_t(info.height);
+				if (0 != num
+				&&  required >  MAX_FONT_BUFFER_SIZE - size
+				&&  required <= MAX_FONT_BUFFER_SIZE)
+				{
+					// Raster buffer is full, bake this batch and raster the
+					// glyph again at the start of the next one.
+					break;
+				}
+
+				BX_WARN(required <= MAX_FONT_BUFFER_SIZE, "Glyph %d is too large (%dx%d)."
+					, cp
+					, uint32_t(info.width)
+					, uint32_t(info.height)
+					);
+				result = false;
+				continue;
+			}
+
+			const uint32_t width  = uint32_t(info.width);
+			const uint32_t height = uint32_t(info.height);
+			if (width * height > 0)
+			{
+				m_bakeQueue->add(&m_buffer[size], width, height);
+			}
+
+			codePoint[num] = cp;
+			offset[num]    = size;
+			size += width * height;
+			++num;
+		}
+
+		m_bakeQueue->run(m_stats);
+
+		for (uint32_t jj = 0; jj < num; ++jj)
+		{
+			GlyphInfo& info = glyphInfo[jj];
+			if (!addBitmap(info, &m_buffer[offset[jj] ], _handle, codePoint[jj]) )
+			{
+				result = false;
+				continue;
+			}
+
+			scaleGlyphInfo(info, scale);
+
+			font.cachedGlyphs[codePoint[jj] ] = info;
+		}
+	}
+
+	return result;
+}
+
 const FontInfo& FontManager::getFontInfo(FontHandle _handle) const
 {
 	BX_CHECK(bgfx::isValid(_handle), "Invalid handle used");
@@ -704,6 +1265,8 @@ const GlyphInfo* FontManager::getGlyphInfo(FontHandle _handle, CodePoint _codePo
 
 	if (it == cachedGlyphs.end() )
 	{
+		++m_stats.misses;
+
 		if (!preloadGlyph(_handle, _codePoint) )
 		{
 			return NULL;
@@ -711,13 +1274,238 @@ const GlyphInfo* FontManager::getGlyphInfo(FontHandle _handle, CodePoint _codePo
 
 		it = cachedGlyphs.find(_codePoint);
 	}
+	else
+	{
+		++m_stats.hits;
+	}
 
 	BX_CHECK(it != cachedGlyphs.end(), "Failed to preload glyph.");
+	touchGlyph(it->second.regionIndex);
 	return &it->second;
 }
 
-bool FontManager::addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data)
+void FontManager::setGlyphCacheSize(uint32_t _maxGlyphs)
 {
-	_glyphInfo.regionIndex = m_atlas->addRegion( (uint16_t) ceil(_glyphInfo.width), (uint16_t) ceil(_glyphInfo.height), _data, AtlasRegion::TYPE_GRAY);
+	m_maxGlyphs = _maxGlyphs;
+
+	while (0 != m_maxGlyphs
+	&&     m_stats.numGlyphs > m_maxGlyphs
+	&&     evictGlyph() )
+	{
+	}
+}
+
+void FontManager::resetGlyphCacheStats()
+{
+	m_stats.hits = 0;
+	m_stats.misses = 0;
+	m_stats.evictions = 0;
+	m_stats.defragments = 0;
+	m_stats.numDistanceBaked = 0;
+	m_stats.distanceBakeTime = 0;
+}
+
+bool FontManager::addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data, FontHandle _handle, CodePoint _codePoint)
+{
+	while (0 != m_maxGlyphs
+	&&     m_stats.numGlyphs >= m_maxGlyphs
+	&&     evictGlyph() )
+	{
+	}
+
+	const uint16_t width  = (uint16_t)ceil(_glyphInfo.width);
+	const uint16_t height = (uint16_t)ceil(_glyphInfo.height);
+
+	for (;;)
+	{
+		_glyphInfo.regionIndex = m_atlas->addRegion(width, height, _data, AtlasRegion::TYPE_GRAY);
+		if (UINT16_MAX != _glyphInfo.regionIndex)
+		{
+			break;
+		}
+
+		// Atlas is full, first reclaim space of already evicted glyphs, then
+		// evict least recently used glyphs.
+		uint16_t numEvicted = 0;
+		if (m_atlas->defragment(m_evictedRegions, &numEvicted, m_pinCount) )
+		{
+			++m_stats.defragments;
+
+			// Regions that didn't fit repacked layer are gone from atlas.
+			for (uint16_t ii = 0; ii < numEvicted; ++ii)
+			{
+				dropEvictedRegion(m_evictedRegions[ii]);
+			}
+		}
+		else if (!evictGlyph() )
+		{
+			return false;
+		}
+	}
+
+	GlyphLruNode& node = m_lru[_glyphInfo.regionIndex];
+	node.handle    = _handle;
+	node.codePoint = _codePoint;
+	node.used      = true;
+	lruLink(_glyphInfo.regionIndex);
+
+	++m_stats.numGlyphs;
 	return true;
 }
+
+void FontManager::lruLink(uint16_t _regionIndex)
+{
+	GlyphLruNode& node = m_lru[_regionIndex];
+	node.prev = UINT16_MAX;
+	node.next = m_lruHead;
+
+	if (UINT16_MAX != m_lruHead)
+	{
+		m_lru[m_lruHead].prev = _regionIndex;
+	}
+	else
+	{
+		m_lruTail = _regionIndex;
+	}
+
+	m_lruHead = _regionIndex;
+}
+
+void FontManager::lruUnlink(uint16_t _regionIndex)
+{
+	GlyphLruNode& node = m_lru[_regionIndex];
+
+	if (UINT16_MAX != node.prev)
+	{
+		m_lru[node.prev].next = node.next;
+	}
+	else
+	{
+		m_lruHead = node.next;
+	}
+
+	if (UINT16_MAX != node.next)
+	{
+		m_lru[node.next].prev = node.prev;
+	}
+	else
+	{
+		m_lruTail = node.prev;
+	}
+}
+
+void FontManager::touchGlyph(uint16_t _regionIndex)
+{
+	if (UINT16_MAX != _regionIndex
+	&&  m_lru[_regionIndex].used
+	&&  m_lruHead != _regionIndex)
+	{
+		lruUnlink(_regionIndex);
+		lruLink(_regionIndex);
+	}
+}
+
+void FontManager::pinGlyph(uint16_t _regionIndex)
+{
+	if (UINT16_MAX != _regionIndex)
+	{
+		++m_pinCount[_regionIndex];
+	}
+}
+
+void FontManager::unpinGlyph(uint16_t _regionIndex)
+{
+	if (UINT16_MAX != _regionIndex
+	&&  0 != m_pinCount[_regionIndex])
+	{
+		--m_pinCount[_regionIndex];
+	}
+}
+
+bool FontManager::evictGlyph()
+{
+	// Least recently used glyph that is not referenced by any text buffer.
+	uint16_t regionIndex = m_lruTail;
+	while (UINT16_MAX != regionIndex
+	&&     0 != m_pinCount[regionIndex])
+	{
+		regionIndex = m_lru[regionIndex].prev;
+	}
+
+	if (UINT16_MAX == regionIndex)
+	{
+		return false;
+	}
+
+	const GlyphLruNode& node = m_lru[regionIndex];
+	eraseGlyph(m_cachedFonts[node.handle.idx].cachedGlyphs, node.codePoint);
+
+	releaseGlyph(regionIndex);
+	++m_stats.evictions;
+
+	return true;
+}
+
+void FontManager::releaseGlyph(uint16_t _regionIndex)
+{
+	unlinkGlyph(_regionIndex);
+	m_atlas->removeRegion(_regionIndex);
+}
+
+void FontManager::unlinkGlyph(uint16_t _regionIndex)
+{
+	GlyphLruNode& node = m_lru[_regionIndex];
+
+	// Scaled fonts share atlas regions with their master font.
+	for (uint16_t ii = 0, num = m_fontHandles.getNumHandles(); ii < num; ++ii)
+	{
+		CachedFont& font = m_cachedFonts[m_fontHandles.getHandleAt(ii)];
+		if (font.masterFontHandle.idx == node.handle.idx)
+		{
+			eraseGlyph(font.cachedGlyphs, node.codePoint);
+		}
+	}
+
+	lruUnlink(_regionIndex);
+	node.used = false;
+
+	--m_stats.numGlyphs;
+}
+
+void FontManager::dropEvictedRegion(uint16_t _regionIndex)
+{
+	// Pinned regions are repacked first, they are dropped only when pinned
+	// glyphs alone overflow atlas layer.
+	BX_WARN(0 == m_pinCount[_regionIndex], "Atlas region %d used by text buffer was evicted.", _regionIndex);
+	m_pinCount[_regionIndex] = 0;
+
+	if (_regionIndex == m_blackGlyph.regionIndex)
+	{
+		addBlackGlyph();
+		return;
+	}
+
+	if (m_lru[_regionIndex].used)
+	{
+		const GlyphLruNode& node = m_lru[_regionIndex];
+		eraseGlyph(m_cachedFonts[node.handle.idx].cachedGlyphs, node.codePoint);
+
+		unlinkGlyph(_regionIndex);
+		++m_stats.evictions;
+	}
+}
+
+void FontManager::addBlackGlyph()
+{
+	const uint32_t W = 3;
+	// Create filler rectangle
+	uint8_t buffer[W * W * 4];
+	bx::memSet(buffer, 255, W * W * 4);
+
+	m_blackGlyph.width = W;
+	m_blackGlyph.height = W;
+
+	///make sure the black glyph doesn't bleed by using a one pixel inner outline
+	m_blackGlyph.regionIndex = m_atlas->addRegion(W, W, buffer, AtlasRegion::TYPE_GRAY, 1);
+	BX_WARN(UINT16_MAX != m_blackGlyph.regionIndex, "Failed to add black glyph to atlas.");
+}
@@ -10,9 +10,11 @@
 #include <bgfx/bgfx.h>
 
 class Atlas;
+class DistanceBakeQueue;
 
 #define MAX_OPENED_FILES 64
 #define MAX_OPENED_FONT  64
+#define MAX_BAKE_THREADS 8
 
 #define FONT_TYPE_ALPHA             UINT32_C(0x00000100) // L8
 // #define FONT_TYPE_LCD               UINT32_C(0x00000200) // BGRA8
@@ -113,6 +115,25 @@ struct GlyphInfo
 	uint16_t regionIndex;
 };
 
+/// Glyph cache statistics.
+struct GlyphCacheStats
+{
+	/// Number of glyph lookups served from the cache.
+	uint32_t hits;
+	/// Number of glyph lookups that had to bake the glyph.
+	uint32_t misses;
+	/// Number of glyphs evicted to make room in the atlas.
+	uint32_t evictions;
+	/// Number of atlas layers repacked to reclaim evicted glyphs space.
+	uint32_t defragments;
+	/// Number of glyphs currently stored in the atlas.
+	uint32_t numGlyphs;
+	/// Number of glyphs baked to distance field.
+	uint32_t numDistanceBaked;
+	/// Time spent baking distance field glyphs, in bx::getHPCounter ticks.
+	int64_t distanceBakeTime;
+};
+
 BGFX_HANDLE(TrueTypeHandle);
 BGFX_HANDLE(FontHandle);
 
@@ -162,6 +183,36 @@ public:
 	/// Preload a single glyph, return true on success.
 	bool preloadGlyph(FontHandle _handle, CodePoint _character);
 
+	/// Set the number of threads used to bake distance field glyphs when
+	/// preloading a set of glyphs.
+	void setNumBakeThreads(uint32_t _num);
+
+	/// Set the maximum number of glyphs stored in the atlas, 0 means
+	/// unbounded. When the limit is reached, or when the atlas is full, the
+	/// least recently used glyphs are evicted and the atlas is repacked.
+	///
+	/// @remark Repacking moves atlas regions around, text buffers pack
+	///   UV coordinates again when atlas generation changes. Glyphs used by
+	///   live text buffers are pinned and never evicted, cache can exceed
+	///   the limit while they are in use.
+	void setGlyphCacheSize(uint32_t _maxGlyphs);
+
+	/// Pin glyph atlas region, pinned glyphs are not evicted. Text buffers
+	/// pin every region they reference until they are cleared or destroyed.
+	void pinGlyph(uint16_t _regionIndex);
+
+	/// Release pin taken with pinGlyph.
+	void unpinGlyph(uint16_t _regionIndex);
+
+	/// Return glyph cache statistics.
+	const GlyphCacheStats& getGlyphCacheStats() const
+	{
+		return m_stats;
+	}
+
+	/// Reset glyph cache hit/miss/eviction and distance bake counters.
+	void resetGlyphCacheStats();
+
 	/// Return the font descriptor of a font.
 	///
 	/// @remark the handle is required to be valid
@@ -186,7 +237,18 @@ private:
 	};
 
 	void init();
-	bool addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data);
+	void addBlackGlyph();
+	struct GlyphLruNode;
+
+	bool addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data, FontHandle _handle, CodePoint _codePoint);
+	bool preloadDistanceGlyphs(FontHandle _handle, const wchar_t* _string);
+	void lruLink(uint16_t _regionIndex);
+	void lruUnlink(uint16_t _regionIndex);
+	void touchGlyph(uint16_t _regionIndex);
+	bool evictGlyph();
+	void releaseGlyph(uint16_t _regionIndex);
+	void unlinkGlyph(uint16_t _regionIndex);
+	void dropEvictedRegion(uint16_t _regionIndex);
 
 	bool m_ownAtlas;
 	Atlas* m_atlas;
@@ -201,6 +263,17 @@ private:
 
 	//temporary buffer to raster glyph
 	uint8_t* m_buffer;
+
+	DistanceBakeQueue* m_bakeQueue;
+
+	// glyphs owning an atlas region, indexed by region, most recently used first
+	GlyphLruNode* m_lru;
+	uint16_t* m_evictedRegions;
+	uint32_t* m_pinCount;
+	uint16_t m_lruHead;
+	uint16_t m_lruTail;
+	uint32_t m_maxGlyphs;
+	GlyphCacheStats m_stats;
 };
 
 #endif // FONT_MANAGER_H_HEADER_GUARD
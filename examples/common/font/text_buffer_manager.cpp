@@ -141,8 +141,27 @@ public:
 		return m_rectangle;
 	}
 
+	/// First vertex modified since last call to clearDirty.
+	uint32_t getDirtyVertexStart() const
+	{
+		return m_dirtyVertexStart;
+	}
+
+	/// Mark vertex buffer as uploaded.
+	void clearDirty()
+	{
+		m_dirtyVertexStart = m_vertexCount;
+	}
+
+	/// Pack UV coordinates again if atlas regions moved since they were
+	/// packed.
+	/// @return true if vertices were modified
+	bool updateUV();
+
 private:
 	void appendGlyph(FontHandle _handle, CodePoint _codePoint);
+	void packUV(uint16_t _regionIndex);
+	void unpinGlyphs();
 	void verticalCenterLastLine(float _txtDecalY, float _top, float _bottom);
 
 	static uint32_t toABGR(uint32_t _rgba)
@@ -180,12 +199,18 @@ private:
 
 	void setVertex(uint32_t _i, float _x, float _y, uint32_t _rgba, uint8_t _style = STYLE_NORMAL)
 	{
+		markDirty(_i);
 		m_vertexBuffer[_i].x = _x;
 		m_vertexBuffer[_i].y = _y;
 		m_vertexBuffer[_i].rgba = _rgba;
 		m_styleBuffer[_i] = _style;
 	}
 
+	void markDirty(uint32_t _vertex)
+	{
+		m_dirtyVertexStart = bx::uint32_min(m_dirtyVertexStart, _vertex);
+	}
+
 	struct TextVertex
 	{
 		float x, y;
@@ -196,9 +221,12 @@ private:
 	TextVertex* m_vertexBuffer;
 	uint16_t* m_indexBuffer;
 	uint8_t* m_styleBuffer;
+	uint16_t* m_regionBuffer; //< Atlas region of each quad.
 
+	uint32_t m_atlasGeneration;
 	uint32_t m_indexCount;
 	uint32_t m_lineStartIndex;
+	uint32_t m_dirtyVertexStart;
 	uint16_t m_vertexCount;
 };
 
@@ -220,8 +248,11 @@ TextBuffer::TextBuffer(FontManager* _fontManager)
 	, m_vertexBuffer(new TextVertex[MAX_BUFFERED_CHARACTERS * 4])
 	, m_indexBuffer(new uint16_t[MAX_BUFFERED_CHARACTERS * 6])
 	, m_styleBuffer(new uint8_t[MAX_BUFFERED_CHARACTERS * 4])
+	, m_regionBuffer(new uint16_t[MAX_BUFFERED_CHARACTERS])
+	, m_atlasGeneration(_fontManager->getAtlas()->getGeneration() )
 	, m_indexCount(0)
 	, m_lineStartIndex(0)
+	, m_dirtyVertexStart(0)
 	, m_vertexCount(0)
 {
 	m_rectangle.width = 0;
@@ -230,9 +261,71 @@ TextBuffer::TextBuffer(FontManager* _fontManager)
 
 TextBuffer::~TextBuffer()
 {
+	unpinGlyphs();
+
 	delete [] m_vertexBuffer;
 	delete [] m_indexBuffer;
 	delete [] m_styleBuffer;
+	delete [] m_regionBuffer;
+}
+
+bool TextBuffer::updateUV()
+{
+	const Atlas* atlas = m_fontManager->getAtlas();
+	const uint32_t generation = atlas->getGeneration();
+
+	if (generation == m_atlasGeneration)
+	{
+		return false;
+	}
+
+	m_atlasGeneration = generation;
+
+	bool modified = false;
+	for (uint32_t ii = 0, num = m_vertexCount/4; ii < num; ++ii)
+	{
+		const uint16_t regionIndex = m_regionBuffer[ii];
+		if (UINT16_MAX != regionIndex)
+		{
+			atlas->packUV(regionIndex
+				, (uint8_t*)m_vertexBuffer
+				, sizeof(TextVertex) * ii * 4 + offsetof(TextVertex, u)
+				, sizeof(TextVertex)
+				);
+
+			if (!modified)
+			{
+				markDirty(ii * 4);
+				modified = true;
+			}
+		}
+	}
+
+	return modified;
+}
+
+void TextBuffer::packUV(uint16_t _regionIndex)
+{
+	// Bring already packed quads to current atlas generation first, new quad
+	// is packed with current region position.
+	updateUV();
+
+	m_fontManager->getAtlas()->packUV(_regionIndex
+		, (uint8_t*)m_vertexBuffer
+		, sizeof(TextVertex) * m_vertexCount + offsetof(TextVertex, u)
+		, sizeof(TextVertex)
+		);
+
+	m_regionBuffer[m_vertexCount/4] = _regionIndex;
+	m_fontManager->pinGlyph(_regionIndex);
+}
+
+void TextBuffer::unpinGlyphs()
+{
+	for (uint32_t ii = 0, num = m_vertexCount/4; ii < num; ++ii)
+	{
+		m_fontManager->unpinGlyph(m_regionBuffer[ii]);
+	}
 }
 
 void TextBuffer::appendText(FontHandle _fontHandle, const char* _string, const char* _end)
@@ -308,6 +401,9 @@ void TextBuffer::appendAtlasFace(uint16_t _faceIndex)
 		, sizeof(TextVertex)
 		);
 
+	// Whole face doesn't move when atlas is repacked.
+	m_regionBuffer[m_vertexCount/4] = UINT16_MAX;
+
 	setVertex(m_vertexCount + 0, x0, y0, m_backgroundColor);
 	setVertex(m_vertexCount + 1, x0, y1, m_backgroundColor);
 	setVertex(m_vertexCount + 2, x1, y1, m_backgroundColor);
@@ -325,6 +421,8 @@ void TextBuffer::appendAtlasFace(uint16_t _faceIndex)
 
 void TextBuffer::clearTextBuffer()
 {
+	unpinGlyphs();
+
 	m_penX = 0;
 	m_penY = 0;
 	m_originX = 0;
@@ -396,7 +494,6 @@ void TextBuffer::appendGlyph(FontHandle _handle, CodePoint _codePoint)
 	m_penX += kerning;
 
 	const GlyphInfo& blackGlyph = m_fontManager->getBlackGlyph();
-	const Atlas* atlas = m_fontManager->getAtlas();
 
 	if (m_styleFlags & STYLE_BACKGROUND
 	&&  m_backgroundColor & 0xff000000)
@@ -406,11 +503,7 @@ void TextBuffer::appendGlyph(FontHandle _handle, CodePoint _codePoint)
 		float x1 = ( (float)x0 + (glyph->advance_x) );
 		float y1 = (m_penY + m_lineAscender - m_lineDescender + m_lineGap);
 
-		atlas->packUV(blackGlyph.regionIndex
-			, (uint8_t*)m_vertexBuffer
-			, sizeof(TextVertex) * m_vertexCount + offsetof(TextVertex, u)
-			, sizeof(TextVertex)
-			);
+		packUV(blackGlyph.regionIndex);
 
 		const uint16_t vertexCount = m_vertexCount;
 		setVertex(vertexCount + 0, x0, y0, m_backgroundColor, STYLE_BACKGROUND);
@@ -436,11 +529,7 @@ void TextBuffer::appendGlyph(FontHandle _handle, CodePoint _codePoint)
 		float x1 = ( (float)x0 + (glyph->advance_x) );
 		float y1 = y0 + font.underlineThickness;
 
-		atlas->packUV(blackGlyph.regionIndex
-			, (uint8_t*)m_vertexBuffer
-			, sizeof(TextVertex) * m_vertexCount + offsetof(TextVertex, u)
-			, sizeof(TextVertex)
-			);
+		packUV(blackGlyph.regionIndex);
 
 		setVertex(m_vertexCount + 0, x0, y0, m_underlineColor, STYLE_UNDERLINE);
 		setVertex(m_vertexCount + 1, x0, y1, m_underlineColor, STYLE_UNDERLINE);
@@ -465,11 +554,7 @@ void TextBuffer::appendGlyph(FontHandle _handle, CodePoint _codePoint)
 		float x1 = ( (float)x0 + (glyph->advance_x) );
 		float y1 = y0 + font.underlineThickness;
 
-		m_fontManager->getAtlas()->packUV(blackGlyph.regionIndex
-			, (uint8_t*)m_vertexBuffer
-			, sizeof(TextVertex) * m_vertexCount + offsetof(TextVertex, u)
-			, sizeof(TextVertex)
-			);
+		packUV(blackGlyph.regionIndex);
 
 		setVertex(m_vertexCount + 0, x0, y0, m_overlineColor, STYLE_OVERLINE);
 		setVertex(m_vertexCount + 1, x0, y1, m_overlineColor, STYLE_OVERLINE);
@@ -494,11 +579,7 @@ void TextBuffer::appendGlyph(FontHandle _handle, CodePoint _codePoint)
 		float x1 = ( (float)x0 + (glyph->advance_x) );
 		float y1 = y0 + font.underlineThickness;
 
-		atlas->packUV(blackGlyph.regionIndex
-			, (uint8_t*)m_vertexBuffer
-			, sizeof(TextVertex) * m_vertexCount + offsetof(TextVertex, u)
-			, sizeof(TextVertex)
-			);
+		packUV(blackGlyph.regionIndex);
 
 		setVertex(m_vertexCount + 0, x0, y0, m_strikeThroughColor, STYLE_STRIKE_THROUGH);
 		setVertex(m_vertexCount + 1, x0, y1, m_strikeThroughColor, STYLE_STRIKE_THROUGH);
@@ -520,11 +601,7 @@ void TextBuffer::appendGlyph(FontHandle _handle, CodePoint _codePoint)
 	float x1 = (x0 + glyph->width);
 	float y1 = (y0 + glyph->height);
 
-	atlas->packUV(glyph->regionIndex
-		, (uint8_t*)m_vertexBuffer
-		, sizeof(TextVertex) * m_vertexCount + offsetof(TextVertex, u)
-		, sizeof(TextVertex)
-		);
+	packUV(glyph->regionIndex);
 
 	setVertex(m_vertexCount + 0, x0, y0, m_textColor);
 	setVertex(m_vertexCount + 1, x0, y1, m_textColor);
@@ -554,6 +631,8 @@ void TextBuffer::appendGlyph(FontHandle _handle, CodePoint _codePoint)
 
 void TextBuffer::verticalCenterLastLine(float _dy, float _top, float _bottom)
 {
+	markDirty(m_lineStartIndex);
+
 	for (uint32_t ii = m_lineStartIndex; ii < m_vertexCount; ii += 4)
 	{
 		if (m_styleBuffer[ii] == STYLE_BACKGROUND)
@@ -630,6 +709,8 @@ TextBufferHandle TextBufferManager::createTextBuffer(uint32_t _type, BufferType:
 	bc.bufferType = _bufferType;
 	bc.indexBufferHandleIdx = bgfx::invalidHandle;
 	bc.vertexBufferHandleIdx = bgfx::invalidHandle;
+	bc.vertexCapacity = 0;
+	bc.numUploadedIndices = 0;
 
 	TextBufferHandle ret = {textIdx};
 	return ret;
@@ -694,34 +775,10 @@ void TextBufferManager::submitTextBuffer(TextBufferHandle _handle, uint8_t _id,
 
 	bgfx::setTexture(0, s_texColor, m_fontManager->getAtlas()->getTextureHandle() );
 
-	bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
-	switch (bc.fontType)
-	{
-	case FONT_TYPE_ALPHA:
-		program = m_basicProgram;
-		bgfx::setState(0
-			| BGFX_STATE_RGB_WRITE
-			| BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA)
-			);
-		break;
+	bgfx::ProgramHandle program = setProgramState(bc.fontType, bc.textBuffer->getTextColor() );
 
-	case FONT_TYPE_DISTANCE:
-		program = m_distanceProgram;
-		bgfx::setState(0
-			| BGFX_STATE_RGB_WRITE
-			| BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA)
-			);
-		break;
-
-	case FONT_TYPE_DISTANCE_SUBPIXEL:
-		program = m_distanceSubpixelProgram;
-		bgfx::setState(0
-			| BGFX_STATE_RGB_WRITE
-			| BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_FACTOR, BGFX_STATE_BLEND_INV_SRC_COLOR)
-			, bc.textBuffer->getTextColor()
-			);
-		break;
-	}
+	// Atlas regions could have been moved since text was appended.
+	const bool uvModified = bc.textBuffer->updateUV();
 
 	switch (bc.bufferType)
 	{
@@ -730,6 +787,16 @@ void TextBufferManager::submitTextBuffer(TextBufferHandle _handle, uint8_t _id,
 			bgfx::IndexBufferHandle ibh;
 			bgfx::VertexBufferHandle vbh;
 
+			if (uvModified
+			&&  bgfx::invalidHandle != bc.vertexBufferHandleIdx)
+			{
+				ibh.idx = bc.indexBufferHandleIdx;
+				vbh.idx = bc.vertexBufferHandleIdx;
+				bgfx::destroyIndexBuffer(ibh);
+				bgfx::destroyVertexBuffer(vbh);
+				bc.vertexBufferHandleIdx = bgfx::invalidHandle;
+			}
+
 			if (bgfx::invalidHandle == bc.vertexBufferHandleIdx)
 			{
 				ibh = bgfx::createIndexBuffer(
@@ -760,38 +827,64 @@ void TextBufferManager::submitTextBuffer(TextBufferHandle _handle, uint8_t _id,
 			bgfx::DynamicIndexBufferHandle ibh;
 			bgfx::DynamicVertexBufferHandle vbh;
 
-			if (bgfx::invalidHandle == bc.vertexBufferHandleIdx )
-			{
-				ibh = bgfx::createDynamicIndexBuffer(
-								bgfx::copy(bc.textBuffer->getIndexBuffer(), indexSize)
-								);
+			const uint32_t numVertices = bc.textBuffer->getVertexCount();
+			const uint32_t numIndices  = bc.textBuffer->getIndexCount();
+			uint32_t dirtyStart = bx::uint32_min(bc.textBuffer->getDirtyVertexStart(), numVertices);
 
-				vbh = bgfx::createDynamicVertexBuffer(
-								  bgfx::copy(bc.textBuffer->getVertexBuffer(), vertexSize)
-								, m_vertexDecl
-								);
+			if (bgfx::invalidHandle == bc.vertexBufferHandleIdx
+			||  numVertices > bc.vertexCapacity)
+			{
+				if (bgfx::invalidHandle != bc.vertexBufferHandleIdx)
+				{
+					ibh.idx = bc.indexBufferHandleIdx;
+					vbh.idx = bc.vertexBufferHandleIdx;
+					bgfx::destroyDynamicIndexBuffer(ibh);
+					bgfx::destroyDynamicVertexBuffer(vbh);
+				}
+
+				// Grow geometrically, so appending text doesn't recreate
+				// buffers every frame.
+				bc.vertexCapacity = bx::uint32_max(numVertices, bc.vertexCapacity * 2);
+				bc.numUploadedIndices = 0;
+
+				ibh = bgfx::createDynamicIndexBuffer(bc.vertexCapacity / 4 * 6);
+				vbh = bgfx::createDynamicVertexBuffer(bc.vertexCapacity, m_vertexDecl);
 
 				bc.indexBufferHandleIdx = ibh.idx;
 				bc.vertexBufferHandleIdx = vbh.idx;
+				dirtyStart = 0;
 			}
 			else
 			{
 				ibh.idx = bc.indexBufferHandleIdx;
 				vbh.idx = bc.vertexBufferHandleIdx;
+			}
 
-				bgfx::updateDynamicIndexBuffer(ibh
-						, 0
-						, bgfx::copy(bc.textBuffer->getIndexBuffer(), indexSize)
+			// Only upload vertices modified since last submit.
+			if (dirtyStart < numVertices)
+			{
+				const uint32_t stride = bc.textBuffer->getVertexSize();
+				bgfx::updateDynamicVertexBuffer(vbh
+						, dirtyStart
+						, bgfx::copy(bc.textBuffer->getVertexBuffer() + dirtyStart * stride, (numVertices - dirtyStart) * stride)
 						);
+			}
 
-				bgfx::updateDynamicVertexBuffer(vbh
-						, 0
-						, bgfx::copy(bc.textBuffer->getVertexBuffer(), vertexSize)
+			// Quads are always indexed the same way, indices already
+			// uploaded stay valid after text is cleared.
+			if (bc.numUploadedIndices < numIndices)
+			{
+				bgfx::updateDynamicIndexBuffer(ibh
+						, bc.numUploadedIndices
+						, bgfx::copy(bc.textBuffer->getIndexBuffer() + bc.numUploadedIndices, (numIndices - bc.numUploadedIndices) * bc.textBuffer->getIndexSize() )
 						);
+				bc.numUploadedIndices = numIndices;
 			}
 
-			bgfx::setVertexBuffer(vbh, 0, bc.textBuffer->getVertexCount() );
-			bgfx::setIndexBuffer(ibh, 0, bc.textBuffer->getIndexCount() );
+			bc.textBuffer->clearDirty();
+
+			bgfx::setVertexBuffer(vbh, 0, numVertices);
+			bgfx::setIndexBuffer(ibh, 0, numIndices);
 		}
 		break;
 
@@ -812,6 +905,144 @@ void TextBufferManager::submitTextBuffer(TextBufferHandle _handle, uint8_t _id,
 	bgfx::submit(_id, program, _depth);
 }
 
+void TextBufferManager::submitTextBuffers(const TextBufferHandle* _handles, uint32_t _num, uint8_t _id, int32_t _depth)
+{
+	BX_CHECK(_num <= MAX_TEXT_BUFFER_COUNT, "Too many text buffers %d (max: %d).", _num, MAX_TEXT_BUFFER_COUNT);
+
+	// 16-bit indices limit number of vertices per draw call.
+	const uint32_t maxVertices = UINT16_MAX + 1;
+
+	uint16_t batch[MAX_TEXT_BUFFER_COUNT];
+
+	// Only consecutive compatible buffers are merged, so draw order matches
+	// the order of handles.
+	for (uint32_t ii = 0; ii < _num;)
+	{
+		BX_CHECK(bgfx::isValid(_handles[ii]), "Invalid handle used");
+
+		// Subpixel font uses text color as blend factor, buffers with different
+		// text color can't be merged.
+		const BufferCache& first = m_textBuffers[_handles[ii].idx];
+		const uint32_t fontType = first.fontType;
+		const uint32_t rgba     = first.textBuffer->getTextColor();
+		const bool subpixel     = FONT_TYPE_DISTANCE_SUBPIXEL == fontType;
+
+		uint32_t numBatch    = 0;
+		uint32_t numVertices = 0;
+		uint32_t numIndices  = 0;
+
+		for (; ii < _num; ++ii)
+		{
+			BX_CHECK(bgfx::isValid(_handles[ii]), "Invalid handle used");
+			const BufferCache& bc = m_textBuffers[_handles[ii].idx];
+
+			if (bc.fontType != fontType
+			|| (subpixel && bc.textBuffer->getTextColor() != rgba) )
+			{
+				break;
+			}
+
+			const uint32_t vertexCount = bc.textBuffer->getVertexCount();
+			if (0 == vertexCount)
+			{
+				continue;
+			}
+
+			if (numVertices + vertexCount > maxVertices)
+			{
+				break;
+			}
+
+			batch[numBatch++] = _handles[ii].idx;
+			numVertices += vertexCount;
+			numIndices  += bc.textBuffer->getIndexCount();
+		}
+
+		if (0 == numBatch)
+		{
+			continue;
+		}
+
+		if (numVertices != bgfx::getAvailTransientVertexBuffer(numVertices, m_vertexDecl)
+		||  numIndices  != bgfx::getAvailTransientIndexBuffer(numIndices) )
+		{
+			BX_WARN(false, "Not enough transient buffer space to submit text (vertices %d, indices %d).", numVertices, numIndices);
+			continue;
+		}
+
+		bgfx::TransientIndexBuffer tib;
+		bgfx::TransientVertexBuffer tvb;
+		bgfx::allocTransientIndexBuffer(&tib, numIndices);
+		bgfx::allocTransientVertexBuffer(&tvb, numVertices, m_vertexDecl);
+
+		uint8_t* vertexData = tvb.data;
+		uint16_t* indexData = (uint16_t*)tib.data;
+		uint32_t baseVertex = 0;
+
+		for (uint32_t jj = 0; jj < numBatch; ++jj)
+		{
+			TextBuffer* textBuffer = m_textBuffers[batch[jj] ].textBuffer;
+			textBuffer->updateUV();
+
+			const uint32_t vertexCount = textBuffer->getVertexCount();
+			const uint32_t indexCount  = textBuffer->getIndexCount();
+			const uint32_t vertexSize  = vertexCount * textBuffer->getVertexSize();
+
+			bx::memCopy(vertexData, textBuffer->getVertexBuffer(), vertexSize);
+			vertexData += vertexSize;
+
+			const uint16_t* indices = textBuffer->getIndexBuffer();
+			for (uint32_t kk = 0; kk < indexCount; ++kk)
+			{
+				indexData[kk] = uint16_t(indices[kk] + baseVertex);
+			}
+
+			indexData  += indexCount;
+			baseVertex += vertexCount;
+		}
+
+		bgfx::setTexture(0, s_texColor, m_fontManager->getAtlas()->getTextureHandle() );
+		bgfx::ProgramHandle program = setProgramState(fontType, rgba);
+		bgfx::setVertexBuffer(&tvb, 0, numVertices);
+		bgfx::setIndexBuffer(&tib, 0, numIndices);
+		bgfx::submit(_id, program, _depth);
+	}
+}
+
+bgfx::ProgramHandle TextBufferManager::setProgramState(uint32_t _fontType, uint32_t _rgba)
+{
+	bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+	switch (_fontType)
+	{
+	case FONT_TYPE_ALPHA:
+		program = m_basicProgram;
+		bgfx::setState(0
+			| BGFX_STATE_RGB_WRITE
+			| BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA)
+			);
+		break;
+
+	case FONT_TYPE_DISTANCE:
+		program = m_distanceProgram;
+		bgfx::setState(0
+			| BGFX_STATE_RGB_WRITE
+			| BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA)
+			);
+		break;
+
+	case FONT_TYPE_DISTANCE_SUBPIXEL:
+		program = m_distanceSubpixelProgram;
+		bgfx::setState(0
+			| BGFX_STATE_RGB_WRITE
+			| BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_FACTOR, BGFX_STATE_BLEND_INV_SRC_COLOR)
+			, _rgba
+			);
+		break;
+	}
+
+	return program;
+}
+
 void TextBufferManager::setStyle(TextBufferHandle _handle, uint32_t _flags)
 {
 	BX_CHECK(bgfx::isValid(_handle), "Invalid handle used");
@@ -49,6 +49,12 @@ public:
 	void destroyTextBuffer(TextBufferHandle _handle);
 	void submitTextBuffer(TextBufferHandle _handle, uint8_t _id, int32_t _depth = 0);
 
+	/// Submit many text buffers at once. Runs of consecutive text buffers
+	/// sharing the same font type are packed into one transient vertex/index
+	/// buffer and drawn with a single draw call. Draw order follows the order
+	/// of handles.
+	void submitTextBuffers(const TextBufferHandle* _handles, uint32_t _num, uint8_t _id, int32_t _depth = 0);
+
 	void setStyle(TextBufferHandle _handle, uint32_t _flags = STYLE_NORMAL);
 	void setTextColor(TextBufferHandle _handle, uint32_t _rgba = 0x000000FF);
 	void setBackgroundColor(TextBufferHandle _handle, uint32_t _rgba = 0x000000FF);
@@ -82,8 +88,12 @@ private:
 		TextBuffer* textBuffer;
 		BufferType::Enum bufferType;
 		uint32_t fontType;
+		uint32_t vertexCapacity;
+		uint32_t numUploadedIndices;
 	};
 
+	bgfx::ProgramHandle setProgramState(uint32_t _fontType, uint32_t _rgba);
+
 	BufferCache* m_textBuffers;
 	bx::HandleAllocT<MAX_TEXT_BUFFER_COUNT> m_textBufferHandles;
 	FontManager* m_fontManager;
@@ -143,8 +143,20 @@ namespace
 		bgfx::TextureHandle texMissing;
 
 		bgfx::TransientVertexBuffer tvb;
+		bgfx::TransientIndexBuffer tib;
 		uint8_t m_viewId;
 
+		// Per flush index buffer and pending merged draw
+		uint32_t nindices;
+		uint32_t cindices;
+		uint32_t baseVertex;
+		uint32_t batchFirst;
+		uint64_t drawState;
+		uint32_t drawFstencil;
+		uint32_t drawBstencil;
+		int batchUniformOffset;
+		int batchImage;
+
 		struct GLNVGtexture* textures;
 		float view[2];
 		int ntextures;
@@ -532,20 +544,214 @@ namespace
 		bgfx::setViewRect(gl->m_viewId, 0, 0, width * devicePixelRatio, height * devicePixelRatio);
 	}
 
-	static void fan(uint32_t _start, uint32_t _count)
+	static uint32_t glnvg__stripIndexCount(int count)
 	{
-		uint32_t numTris = _count-2;
-		bgfx::TransientIndexBuffer tib;
-		bgfx::allocTransientIndexBuffer(&tib, numTris*3);
-		uint16_t* data = (uint16_t*)tib.data;
-		for (uint32_t ii = 0; ii < numTris; ++ii)
+		return 2 < count ? (count-2)*3 : 0;
+	}
+
+	// 16-bit indices are relative to base vertex, one draw can address at
+	// most this many vertices.
+	static const uint32_t s_maxWindowVertices = UINT16_MAX + 1;
+
+	static void glnvg__submit(struct GLNVGcontext* gl)
+	{
+		const uint32_t num = gl->nindices - gl->batchFirst;
+		if (0 < num)
+		{
+			const uint32_t numVertices = bx::uint32_min(gl->nverts - gl->baseVertex, s_maxWindowVertices);
+			bgfx::setState(gl->drawState);
+			bgfx::setStencil(gl->drawFstencil, gl->drawBstencil);
+			bgfx::setVertexBuffer(&gl->tvb, gl->baseVertex, numVertices);
+			bgfx::setIndexBuffer(&gl->tib, gl->batchFirst, num);
+			bgfx::setTexture(0, gl->s_tex, gl->th);
+			bgfx::submit(gl->m_viewId, gl->prog);
+		}
+
+		gl->batchFirst = gl->nindices;
+	}
+
+	static void glnvg__drawBegin(struct GLNVGcontext* gl, uint64_t state, uint32_t fstencil, uint32_t bstencil = BGFX_STENCIL_NONE)
+	{
+		gl->drawState    = state;
+		gl->drawFstencil = fstencil;
+		gl->drawBstencil = bstencil;
+	}
+
+	static bool glnvg__window(struct GLNVGcontext* gl, uint32_t start, uint32_t count)
+	{
+		if (start + count > uint32_t(gl->nverts) )
+		{
+			// Vertices were truncated.
+			return false;
+		}
+
+		if (start < gl->baseVertex
+		||  start + count > gl->baseVertex + s_maxWindowVertices)
+		{
+			// Range is not addressable from current base vertex, submit
+			// pending indices and rebase. Uniforms are still set for fill
+			// passes, merged draws set them now.
+			if (-1 != gl->batchUniformOffset)
+			{
+				nvgRenderSetUniforms(gl, gl->batchUniformOffset, gl->batchImage);
+			}
+
+			glnvg__submit(gl);
+			gl->baseVertex = start;
+		}
+
+		return true;
+	}
+
+	static void glnvg__fan(struct GLNVGcontext* gl, int start, int count)
+	{
+		const uint32_t num = glnvg__stripIndexCount(count);
+		if (0 == num
+		||  gl->nindices + num > gl->cindices)
+		{
+			return;
+		}
+
+		// Fan can't be split, every triangle uses the first vertex.
+		BX_WARN(uint32_t(count) <= s_maxWindowVertices, "Fan with %d vertices exceeds 16-bit indices, skipped.", count);
+		if (uint32_t(count) > s_maxWindowVertices
+		||  !glnvg__window(gl, start, count) )
+		{
+			return;
+		}
+
+		const uint32_t base = start - gl->baseVertex;
+		uint16_t* data = (uint16_t*)gl->tib.data + gl->nindices;
+		for (uint32_t ii = 0, numTris = num/3; ii < numTris; ++ii)
+		{
+			data[ii*3+0] = uint16_t(base);
+			data[ii*3+1] = uint16_t(base + ii + 1);
+			data[ii*3+2] = uint16_t(base + ii + 2);
+		}
+
+		gl->nindices += num;
+	}
+
+	static void glnvg__strip(struct GLNVGcontext* gl, int start, int count)
+	{
+		if (gl->nindices + glnvg__stripIndexCount(count) > gl->cindices)
 		{
-			data[ii*3+0] = _start;
-			data[ii*3+1] = _start + ii + 1;
-			data[ii*3+2] = _start + ii + 2;
+			return;
 		}
 
-		bgfx::setIndexBuffer(&tib);
+		// Long strips are split into windows overlapping by two vertices.
+		for (uint32_t first = start, last = start + count; first + 2 < last;)
+		{
+			const uint32_t numVertices = bx::uint32_min(last - first, s_maxWindowVertices);
+			if (!glnvg__window(gl, first, numVertices) )
+			{
+				return;
+			}
+
+			// Culling is disabled, winding of odd triangles doesn't matter.
+			const uint32_t base = first - gl->baseVertex;
+			const uint32_t num  = glnvg__stripIndexCount(numVertices);
+			uint16_t* data = (uint16_t*)gl->tib.data + gl->nindices;
+			for (uint32_t ii = 0, numTris = num/3; ii < numTris; ++ii)
+			{
+				data[ii*3+0] = uint16_t(base + ii);
+				data[ii*3+1] = uint16_t(base + ii + 1);
+				data[ii*3+2] = uint16_t(base + ii + 2);
+			}
+
+			gl->nindices += num;
+			first += numVertices - 2;
+		}
+	}
+
+	static void glnvg__list(struct GLNVGcontext* gl, int start, int count)
+	{
+		if (gl->nindices + count/3*3 > gl->cindices)
+		{
+			return;
+		}
+
+		const uint32_t maxVertices = s_maxWindowVertices/3*3;
+		for (uint32_t first = start, last = start + count/3*3; first < last;)
+		{
+			const uint32_t num = bx::uint32_min(last - first, maxVertices);
+			if (!glnvg__window(gl, first, num) )
+			{
+				return;
+			}
+
+			const uint32_t base = first - gl->baseVertex;
+			uint16_t* data = (uint16_t*)gl->tib.data + gl->nindices;
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				data[ii] = uint16_t(base + ii);
+			}
+
+			gl->nindices += num;
+			first += num;
+		}
+	}
+
+	static uint32_t glnvg__indexCount(struct GLNVGcontext* gl, struct GLNVGcall* call)
+	{
+		struct GLNVGpath* paths = &gl->paths[call->pathOffset];
+		uint32_t count = 0;
+
+		switch (call->type)
+		{
+		case GLNVG_FILL:
+		case GLNVG_CONVEXFILL:
+			for (int i = 0; i < call->pathCount; i++)
+			{
+				count += glnvg__stripIndexCount(paths[i].fillCount);
+				count += gl->edgeAntiAlias ? glnvg__stripIndexCount(paths[i].strokeCount) : 0;
+			}
+			count += GLNVG_FILL == call->type ? call->vertexCount/3*3 : 0;
+			break;
+
+		case GLNVG_STROKE:
+			for (int i = 0; i < call->pathCount; i++)
+			{
+				count += glnvg__stripIndexCount(paths[i].strokeCount);
+			}
+			break;
+
+		case GLNVG_TRIANGLES:
+			count += call->vertexCount/3*3;
+			break;
+		}
+
+		return count;
+	}
+
+	static void glnvg__batchFlush(struct GLNVGcontext* gl)
+	{
+		if (-1 != gl->batchUniformOffset)
+		{
+			nvgRenderSetUniforms(gl, gl->batchUniformOffset, gl->batchImage);
+			glnvg__submit(gl);
+		}
+
+		gl->batchFirst = gl->nindices;
+		gl->batchUniformOffset = -1;
+	}
+
+	static void glnvg__batchBegin(struct GLNVGcontext* gl, int uniformOffset, int image)
+	{
+		// Calls with the same paint, scissor and image are merged into one
+		// draw. Blend state is the same for the whole flush, and primitives
+		// within one draw are blended in order.
+		if (-1 != gl->batchUniformOffset
+		&&  gl->batchImage == image
+		&&  0 == bx::memCmp(nvg__fragUniformPtr(gl, gl->batchUniformOffset), nvg__fragUniformPtr(gl, uniformOffset), sizeof(struct GLNVGfragUniforms) ) )
+		{
+			return;
+		}
+
+		glnvg__batchFlush(gl);
+		glnvg__drawBegin(gl, gl->state, BGFX_STENCIL_NONE);
+		gl->batchUniformOffset = uniformOffset;
+		gl->batchImage = image;
 	}
 
 	static void glnvg__fill(struct GLNVGcontext* gl, struct GLNVGcall* call)
@@ -553,33 +759,31 @@ namespace
 		struct GLNVGpath* paths = &gl->paths[call->pathOffset];
 		int i, npaths = call->pathCount;
 
+		// Stencil passes can't be merged with other calls.
+		glnvg__batchFlush(gl);
+
 		// set bindpoint for solid loc
 		nvgRenderSetUniforms(gl, call->uniformOffset, 0);
 
+		glnvg__drawBegin(gl, 0
+			, 0
+			| BGFX_STENCIL_TEST_ALWAYS
+			| BGFX_STENCIL_FUNC_RMASK(0xff)
+			| BGFX_STENCIL_OP_FAIL_S_KEEP
+			| BGFX_STENCIL_OP_FAIL_Z_KEEP
+			| BGFX_STENCIL_OP_PASS_Z_INCR
+			, 0
+			| BGFX_STENCIL_TEST_ALWAYS
+			| BGFX_STENCIL_FUNC_RMASK(0xff)
+			| BGFX_STENCIL_OP_FAIL_S_KEEP
+			| BGFX_STENCIL_OP_FAIL_Z_KEEP
+			| BGFX_STENCIL_OP_PASS_Z_DECR
+			);
 		for (i = 0; i < npaths; i++)
 		{
-			if (2 < paths[i].fillCount)
-			{
-				bgfx::setState(0);
-				bgfx::setStencil(0
-					| BGFX_STENCIL_TEST_ALWAYS
-					| BGFX_STENCIL_FUNC_RMASK(0xff)
-					| BGFX_STENCIL_OP_FAIL_S_KEEP
-					| BGFX_STENCIL_OP_FAIL_Z_KEEP
-					| BGFX_STENCIL_OP_PASS_Z_INCR
-					, 0
-					| BGFX_STENCIL_TEST_ALWAYS
-					| BGFX_STENCIL_FUNC_RMASK(0xff)
-					| BGFX_STENCIL_OP_FAIL_S_KEEP
-					| BGFX_STENCIL_OP_FAIL_Z_KEEP
-					| BGFX_STENCIL_OP_PASS_Z_DECR
-					);
-				bgfx::setVertexBuffer(&gl->tvb);
-				bgfx::setTexture(0, gl->s_tex, gl->th);
-				fan(paths[i].fillOffset, paths[i].fillCount);
-				bgfx::submit(gl->m_viewId, gl->prog);
-			}
+			glnvg__fan(gl, paths[i].fillOffset, paths[i].fillCount);
 		}
+		glnvg__submit(gl);
 
 		// Draw aliased off-pixels
 		nvgRenderSetUniforms(gl, call->uniformOffset + gl->fragSize, call->image);
@@ -587,36 +791,32 @@ namespace
 		if (gl->edgeAntiAlias)
 		{
 			// Draw fringes
+			glnvg__drawBegin(gl, gl->state
+				, 0
+				| BGFX_STENCIL_TEST_EQUAL
+				| BGFX_STENCIL_FUNC_RMASK(0xff)
+				| BGFX_STENCIL_OP_FAIL_S_KEEP
+				| BGFX_STENCIL_OP_FAIL_Z_KEEP
+				| BGFX_STENCIL_OP_PASS_Z_KEEP
+				);
 			for (i = 0; i < npaths; i++)
 			{
-				bgfx::setState(gl->state
-					| BGFX_STATE_PT_TRISTRIP
-					);
-				bgfx::setStencil(0
-					| BGFX_STENCIL_TEST_EQUAL
-					| BGFX_STENCIL_FUNC_RMASK(0xff)
-					| BGFX_STENCIL_OP_FAIL_S_KEEP
-					| BGFX_STENCIL_OP_FAIL_Z_KEEP
-					| BGFX_STENCIL_OP_PASS_Z_KEEP
-					);
-				bgfx::setVertexBuffer(&gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-				bgfx::setTexture(0, gl->s_tex, gl->th);
-				bgfx::submit(gl->m_viewId, gl->prog);
+				glnvg__strip(gl, paths[i].strokeOffset, paths[i].strokeCount);
 			}
+			glnvg__submit(gl);
 		}
 
 		// Draw fill
-		bgfx::setState(gl->state);
-		bgfx::setVertexBuffer(&gl->tvb, call->vertexOffset, call->vertexCount);
-		bgfx::setTexture(0, gl->s_tex, gl->th);
-		bgfx::setStencil(0
-				| BGFX_STENCIL_TEST_NOTEQUAL
-				| BGFX_STENCIL_FUNC_RMASK(0xff)
-				| BGFX_STENCIL_OP_FAIL_S_ZERO
-				| BGFX_STENCIL_OP_FAIL_Z_ZERO
-				| BGFX_STENCIL_OP_PASS_Z_ZERO
-				);
-		bgfx::submit(gl->m_viewId, gl->prog);
+		glnvg__drawBegin(gl, gl->state
+			, 0
+			| BGFX_STENCIL_TEST_NOTEQUAL
+			| BGFX_STENCIL_FUNC_RMASK(0xff)
+			| BGFX_STENCIL_OP_FAIL_S_ZERO
+			| BGFX_STENCIL_OP_FAIL_Z_ZERO
+			| BGFX_STENCIL_OP_PASS_Z_ZERO
+			);
+		glnvg__list(gl, call->vertexOffset, call->vertexCount);
+		glnvg__submit(gl);
 	}
 
 	static void glnvg__convexFill(struct GLNVGcontext* gl, struct GLNVGcall* call)
@@ -624,16 +824,11 @@ namespace
 		struct GLNVGpath* paths = &gl->paths[call->pathOffset];
 		int i, npaths = call->pathCount;
 
-		nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
+		glnvg__batchBegin(gl, call->uniformOffset, call->image);
 
 		for (i = 0; i < npaths; i++)
 		{
-			if (paths[i].fillCount == 0) continue;
-			bgfx::setState(gl->state);
-			bgfx::setVertexBuffer(&gl->tvb);
-			bgfx::setTexture(0, gl->s_tex, gl->th);
-			fan(paths[i].fillOffset, paths[i].fillCount);
-			bgfx::submit(gl->m_viewId, gl->prog);
+			glnvg__fan(gl, paths[i].fillOffset, paths[i].fillCount);
 		}
 
 		if (gl->edgeAntiAlias)
@@ -641,12 +836,7 @@ namespace
 			// Draw fringes
 			for (i = 0; i < npaths; i++)
 			{
-				bgfx::setState(gl->state
-					| BGFX_STATE_PT_TRISTRIP
-					);
-				bgfx::setVertexBuffer(&gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-				bgfx::setTexture(0, gl->s_tex, gl->th);
-				bgfx::submit(gl->m_viewId, gl->prog);
+				glnvg__strip(gl, paths[i].strokeOffset, paths[i].strokeCount);
 			}
 		}
 	}
@@ -656,17 +846,12 @@ namespace
 		struct GLNVGpath* paths = &gl->paths[call->pathOffset];
 		int npaths = call->pathCount, i;
 
-		nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
+		glnvg__batchBegin(gl, call->uniformOffset, call->image);
 
 		// Draw Strokes
 		for (i = 0; i < npaths; i++)
 		{
-			bgfx::setState(gl->state
-				| BGFX_STATE_PT_TRISTRIP
-				);
-			bgfx::setVertexBuffer(&gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-			bgfx::setTexture(0, gl->s_tex, gl->th);
-			bgfx::submit(gl->m_viewId, gl->prog);
+			glnvg__strip(gl, paths[i].strokeOffset, paths[i].strokeCount);
 		}
 	}
 
@@ -674,12 +859,8 @@ namespace
 	{
 		if (3 <= call->vertexCount)
 		{
-			nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
-
-			bgfx::setState(gl->state);
-			bgfx::setVertexBuffer(&gl->tvb, call->vertexOffset, call->vertexCount);
-			bgfx::setTexture(0, gl->s_tex, gl->th);
-			bgfx::submit(gl->m_viewId, gl->prog);
+			glnvg__batchBegin(gl, call->uniformOffset, call->image);
+			glnvg__list(gl, call->vertexOffset, call->vertexCount);
 		}
 	}
 
@@ -739,6 +920,27 @@ namespace
 
 			bgfx::setUniform(gl->u_viewSize, gl->view);
 
+			// All calls share one index buffer, strips and fans are converted to
+			// triangle lists so that compatible calls can be merged.
+			uint32_t numIndices = 0;
+			for (uint32_t ii = 0, num = gl->ncalls; ii < num; ++ii)
+			{
+				numIndices += glnvg__indexCount(gl, &gl->calls[ii]);
+			}
+
+			gl->nindices = 0;
+			gl->cindices = bgfx::getAvailTransientIndexBuffer(numIndices);
+			BX_WARN(gl->cindices == numIndices, "Index number truncated due to transient index buffer overflow");
+
+			if (0 < gl->cindices)
+			{
+				bgfx::allocTransientIndexBuffer(&gl->tib, gl->cindices);
+			}
+
+			gl->baseVertex = 0;
+			gl->batchFirst = 0;
+			gl->batchUniformOffset = -1;
+
 			for (uint32_t ii = 0, num = gl->ncalls; ii < num; ++ii)
 			{
 				struct GLNVGcall* call = &gl->calls[ii];
@@ -761,6 +963,8 @@ namespace
 					break;
 				}
 			}
+
+			glnvg__batchFlush(gl);
 		}
 
 		// Reset calls
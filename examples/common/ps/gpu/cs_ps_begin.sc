@@ -0,0 +1,20 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_compute.sh"
+#include "uniforms.sh"
+
+BUFFER_RW(counterBuffer,  uint,  0);
+BUFFER_WR(indirectBuffer, uvec4, 1);
+
+NUM_THREADS(1, 1, 1)
+void main()
+{
+	uint numAlive = min(counterBuffer[0], u_psMaxParticles);
+	counterBuffer[0] = numAlive;
+	counterBuffer[1] = 0u;
+
+	dispatchIndirect(indirectBuffer, 0, (numAlive + uint(PS_GROUP_SIZE-1) )/uint(PS_GROUP_SIZE), 1u, 1u);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_compute.sh"
+#include "uniforms.sh"
+
+BUFFER_WR(nextParticleBuffer, vec4, 1);
+
+#include "particle.sh"
+
+#define PS_PI 3.1415926535897932384626433832795
+
+uint hash(uint _key)
+{
+	// Wang hash.
+	_key = (_key ^ 61u) ^ (_key >> 16u);
+	_key *= 9u;
+	_key = _key ^ (_key >> 4u);
+	_key *= 0x27d4eb2du;
+	_key = _key ^ (_key >> 15u);
+	return _key;
+}
+
+float frnd(inout uint _state)
+{
+	_state = hash(_state);
+	return uintBitsToFloat( (_state >> 9u) | 0x3f800000u) - 1.0;
+}
+
+float frndh(inout uint _state)
+{
+	return frnd(_state) * 2.0 - 1.0;
+}
+
+vec3 randUnitSphere(inout uint _state)
+{
+	float rand0 = frnd(_state) * 2.0 - 1.0;
+	float rand1 = frnd(_state) * PS_PI * 2.0;
+	float sqrtf1 = sqrt(1.0 - rand0*rand0);
+	return vec3(sqrtf1 * cos(rand1), sqrtf1 * sin(rand1), rand0);
+}
+
+vec3 randUnitCircle(inout uint _state)
+{
+	float angle = frnd(_state) * PS_PI * 2.0;
+	return vec3(cos(angle), 0.0, sin(angle) );
+}
+
+NUM_THREADS(PS_GROUP_SIZE, 1, 1)
+void main()
+{
+	uint id = gl_GlobalInvocationID.x;
+	if (id >= u_psNumSpawn)
+	{
+		return;
+	}
+
+	uint idx = allocParticle();
+	if (idx >= u_psMaxParticles)
+	{
+		return;
+	}
+
+	uint state = hash(id ^ u_psSeed);
+
+	vec3 pos;
+	if (0u == u_psShape)
+	{
+		// Sphere
+		pos = randUnitSphere(state);
+	}
+	else if (1u == u_psShape)
+	{
+		// Hemisphere
+		pos = randUnitSphere(state);
+		pos.y = abs(pos.y);
+	}
+	else if (2u == u_psShape)
+	{
+		// Circle
+		pos = randUnitCircle(state);
+	}
+	else if (3u == u_psShape)
+	{
+		// Disc
+		pos = randUnitCircle(state) * frnd(state);
+	}
+	else
+	{
+		// Rect
+		pos = vec3(frndh(state), 0.0, frndh(state) );
+	}
+
+	vec3 dir = 0u == u_psDirection
+		? vec3(0.0, 1.0, 0.0)
+		: normalize(pos)
+		;
+
+	float startOffset = mix(u_psOffsetStart.x, u_psOffsetStart.y, frnd(state) );
+	float endOffset   = mix(u_psOffsetEnd.x,   u_psOffsetEnd.y,   frnd(state) );
+	float lifeSpan    = mix(u_psLifeSpan.x,    u_psLifeSpan.y,    frnd(state) );
+
+	vec3 start = pos * startOffset;
+	vec3 end   = dir * endOffset + start;
+
+	start = u_psMtx0*start.x + u_psMtx1*start.y + u_psMtx2*start.z + u_psMtx3;
+	end   = u_psMtx0*end.x   + u_psMtx1*end.y   + u_psMtx2*end.z   + u_psMtx3;
+
+	float gravity = -9.81 * u_psGravityScale * lifeSpan * lifeSpan;
+
+	vec4 data0 = vec4(start, float(id) * u_psTimePerParticle);
+	vec4 data1 = vec4(end, 1.0/lifeSpan);
+	vec4 data2 = vec4(end + vec3(0.0, gravity, 0.0), 0.0);
+	vec4 data3 = vec4(
+		  mix(u_psBlendStart.x, u_psBlendStart.y, frnd(state) )
+		, mix(u_psBlendEnd.x,   u_psBlendEnd.y,   frnd(state) )
+		, mix(u_psScaleStart.x, u_psScaleStart.y, frnd(state) )
+		, mix(u_psScaleEnd.x,   u_psScaleEnd.y,   frnd(state) )
+		);
+
+	nextParticleBuffer[idx*4u+0u] = data0;
+	nextParticleBuffer[idx*4u+1u] = data1;
+	nextParticleBuffer[idx*4u+2u] = data2;
+	nextParticleBuffer[idx*4u+3u] = data3;
+
+	writeInstance(idx, data0, data1, data2, data3);
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_compute.sh"
+#include "uniforms.sh"
+
+BUFFER_RW(counterBuffer,  uint,  0);
+BUFFER_WR(indirectBuffer, uvec4, 1);
+
+NUM_THREADS(1, 1, 1)
+void main()
+{
+	// Emit may overshoot when emitter is full.
+	uint numAlive = min(counterBuffer[1], u_psMaxParticles);
+	counterBuffer[0] = numAlive;
+
+	drawIndexedIndirect(indirectBuffer, 1, 6u, numAlive, 0u, 0u, 0u);
+}
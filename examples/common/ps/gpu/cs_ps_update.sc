@@ -0,0 +1,41 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_compute.sh"
+#include "uniforms.sh"
+
+BUFFER_RO(prevParticleBuffer, vec4, 0);
+BUFFER_WR(nextParticleBuffer, vec4, 1);
+
+#include "particle.sh"
+
+NUM_THREADS(PS_GROUP_SIZE, 1, 1)
+void main()
+{
+	uint id = gl_GlobalInvocationID.x;
+	if (id >= counterBuffer[0])
+	{
+		return;
+	}
+
+	vec4 data0 = prevParticleBuffer[id*4u+0u];
+	vec4 data1 = prevParticleBuffer[id*4u+1u];
+	vec4 data2 = prevParticleBuffer[id*4u+2u];
+	vec4 data3 = prevParticleBuffer[id*4u+3u];
+
+	data0.w += u_psDeltaTime * data1.w;
+
+	if (data0.w <= 1.0)
+	{
+		// Survivors are compacted into next buffer.
+		uint idx = allocParticle();
+		nextParticleBuffer[idx*4u+0u] = data0;
+		nextParticleBuffer[idx*4u+1u] = data1;
+		nextParticleBuffer[idx*4u+2u] = data2;
+		nextParticleBuffer[idx*4u+3u] = data3;
+
+		writeInstance(idx, data0, data1, data2, data3);
+	}
+}
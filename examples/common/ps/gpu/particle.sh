@@ -0,0 +1,61 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+// Particle is stored as 4 vec4:
+//   0 - start.xyz,  life
+//   1 - end0.xyz,   1/lifeSpan
+//   2 - end1.xyz,   unused
+//   3 - blendStart, blendEnd, scaleStart, scaleEnd
+//
+// Instance is stored as 3 vec4:
+//   0 - pos.xyz,    scale
+//   1 - rgba
+//   2 - blend,      unused
+
+BUFFER_WR(instanceBuffer, vec4, 2);
+BUFFER_RW(counterBuffer,  uint, 3);
+BUFFER_RO(easeBuffer,     vec4, 4);
+
+uint allocParticle()
+{
+	uint result;
+#if BGFX_SHADER_LANGUAGE_HLSL
+	// atomicAdd from bgfx_compute.sh takes memory by value.
+	InterlockedAdd(counterBuffer[1], 1u, result);
+#else
+	result = atomicAdd(counterBuffer[1], 1u);
+#endif // BGFX_SHADER_LANGUAGE_HLSL
+	return result;
+}
+
+// Ease functions are sampled on CPU into LUT:
+//   x - position, y - scale, z - blend, w - color.
+vec4 sampleEase(float _life)
+{
+	float xx = saturate(_life) * float(PS_EASE_LUT_SIZE-1);
+	int   i0 = int(xx);
+	int   i1 = min(i0+1, PS_EASE_LUT_SIZE-1);
+	return mix(easeBuffer[i0], easeBuffer[i1], vec4_splat(xx - float(i0) ) );
+}
+
+void writeInstance(uint _idx, vec4 _data0, vec4 _data1, vec4 _data2, vec4 _data3)
+{
+	vec4 ease = sampleEase(_data0.w);
+
+	vec3 p0  = mix(_data0.xyz, _data1.xyz, vec3_splat(ease.x) );
+	vec3 p1  = mix(_data1.xyz, _data2.xyz, vec3_splat(ease.x) );
+	vec3 pos = mix(p0, p1, vec3_splat(ease.x) );
+
+	float scale = mix(_data3.z, _data3.w, ease.y);
+	float blend = mix(_data3.x, _data3.y, saturate(ease.z) );
+
+	float tt   = saturate(ease.w) * 4.0;
+	int   idx  = min(int(tt), 3);
+	vec4  rgba = mix(u_psRgba(idx), u_psRgba(idx+1), vec4_splat(tt - float(idx) ) );
+
+	instanceBuffer[_idx*3u+0u] = vec4(pos, scale);
+	instanceBuffer[_idx*3u+1u] = rgba;
+	instanceBuffer[_idx*3u+2u] = vec4(blend, 0.0, 0.0, 0.0);
+}
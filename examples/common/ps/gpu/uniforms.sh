@@ -0,0 +1,37 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+// Must match ps::GpuParams layout in particle_system.cpp.
+uniform vec4 u_psParams[15];
+
+#define PS_GROUP_SIZE    64
+#define PS_EASE_LUT_SIZE 32
+
+#define u_psDeltaTime       u_psParams[0].x
+#define u_psNumSpawn        floatBitsToUint(u_psParams[0].y)
+#define u_psTimePerParticle u_psParams[0].z
+#define u_psSeed            floatBitsToUint(u_psParams[0].w)
+
+#define u_psMaxParticles    floatBitsToUint(u_psParams[1].x)
+#define u_psShape           floatBitsToUint(u_psParams[1].y)
+#define u_psDirection       floatBitsToUint(u_psParams[1].z)
+#define u_psGravityScale    u_psParams[1].w
+
+#define u_psOffsetStart     u_psParams[2].xy
+#define u_psOffsetEnd       u_psParams[2].zw
+#define u_psBlendStart      u_psParams[3].xy
+#define u_psBlendEnd        u_psParams[3].zw
+#define u_psScaleStart      u_psParams[4].xy
+#define u_psScaleEnd        u_psParams[4].zw
+#define u_psLifeSpan        u_psParams[5].xy
+
+// Emitter transform, columns as in bx::vec3MulMtx.
+#define u_psMtx0            u_psParams[6].xyz
+#define u_psMtx1            u_psParams[7].xyz
+#define u_psMtx2            u_psParams[8].xyz
+#define u_psMtx3            u_psParams[9].xyz
+
+// Color gradient, 5 keys.
+#define u_psRgba(_idx)      u_psParams[10 + (_idx)]
@@ -0,0 +1,25 @@
+$input a_position, i_data0, i_data1, i_data2
+$output v_color0, v_texcoord0
+
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bgfx_shader.sh>
+
+// Camera right and up vectors, as used by CPU path.
+uniform vec4 u_psBillboard[2];
+
+void main()
+{
+	vec2 corner = a_position.xy * 2.0 - 1.0;
+	vec3 pos = i_data0.xyz
+		+ u_psBillboard[0].xyz * (corner.x * i_data0.w)
+		+ u_psBillboard[1].xyz * (corner.y * i_data0.w)
+		;
+
+	gl_Position = mul(u_modelViewProj, vec4(pos, 1.0) );
+	v_color0    = i_data1;
+	v_texcoord0 = vec4(a_position.xy, i_data2.x, 0.0);
+}
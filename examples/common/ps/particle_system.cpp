@@ -10,8 +10,13 @@
 #include "../bgfx_utils.h"
 
 #include <bx/easing.h>
+#include <bx/cpu.h>
 #include <bx/crtimpl.h>
 #include <bx/handlealloc.h>
+#include <bx/simd_t.h>
+#include <bx/sort.h>
+#include <bx/thread.h>
+#include <bx/uint32_t.h>
 
 #include "vs_particle.bin.h"
 #include "fs_particle.bin.h"
@@ -140,27 +145,48 @@ void EmitterUniforms::reset()
 	m_easeScale = bx::Easing::Linear;
 }
 
+#define PS_MAX_THREADS       16
+#define PS_GPU_NUM_PARAMS    15
+#define PS_GPU_GROUP_SIZE    64
+#define PS_GPU_EASE_LUT_SIZE 32
+
 namespace ps
 {
-	struct Particle
+	struct ParticleStream
 	{
-		float start[3];
-		float end[2][3];
-		float blendStart;
-		float blendEnd;
-		float scaleStart;
-		float scaleEnd;
-
-		uint32_t rgba[5];
-
-		float life;
-		float lifeSpan;
+		enum Enum
+		{
+			StartX,
+			StartY,
+			StartZ,
+			End0X,
+			End0Y,
+			End0Z,
+			End1X,
+			End1Y,
+			End1Z,
+			BlendStart,
+			BlendEnd,
+			ScaleStart,
+			ScaleEnd,
+			Rgba0,
+			Rgba1,
+			Rgba2,
+			Rgba3,
+			Rgba4,
+			Life,
+			InvLifeSpan,
+
+			Count
+		};
 	};
 
-	struct ParticleSort
+	struct ParticleRender
 	{
-		float    dist;
-		uint32_t idx;
+		float    pos[3];
+		float    scale;
+		float    blend;
+		uint32_t abgr;
 	};
 
 	inline uint32_t toAbgr(const float* _rgba)
@@ -183,34 +209,159 @@ namespace ps
 			;
 	}
 
+	inline uint32_t floatFlip(uint32_t _value)
+	{
+		using namespace bx;
+		const uint32_t tmp0   = uint32_sra(_value, 31);
+		const uint32_t tmp1   = uint32_neg(tmp0);
+		const uint32_t mask   = uint32_or(tmp1, 0x80000000);
+		const uint32_t result = uint32_xor(_value, mask);
+		return result;
+	}
+
+	// Transforms 4 points stored as x, y, z streams.
+	inline void vec3MulMtx4(float _result[3][4], const float _vec[3][4], const float* _mat)
+	{
+		using namespace bx;
+		const simd128_t xx = simd_ld(_vec[0]);
+		const simd128_t yy = simd_ld(_vec[1]);
+		const simd128_t zz = simd_ld(_vec[2]);
+
+		for (uint32_t ii = 0; ii < 3; ++ii)
+		{
+			const simd128_t tmp0 = simd_madd(zz, simd_splat(_mat[ 8+ii]), simd_splat(_mat[12+ii]) );
+			const simd128_t tmp1 = simd_madd(yy, simd_splat(_mat[ 4+ii]), tmp0);
+			const simd128_t tmp2 = simd_madd(xx, simd_splat(_mat[ 0+ii]), tmp1);
+			simd_st(_result[ii], tmp2);
+		}
+	}
+
+	inline bx::simd128_t simdLerp(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _t)
+	{
+		using namespace bx;
+		return simd_madd(simd_sub(_b, _a), _t, _a);
+	}
+
+	// Compute backend state. Particles never leave GPU memory, alive count
+	// is tracked by counter buffer and consumed by indirect dispatch/draw.
+	struct GpuEmitter
+	{
+		bgfx::DynamicVertexBufferHandle m_particleBuffer[2];
+		bgfx::DynamicVertexBufferHandle m_instanceBuffer;
+		bgfx::DynamicVertexBufferHandle m_easeBuffer;
+		bgfx::DynamicIndexBufferHandle  m_counterBuffer;
+		bgfx::IndirectBufferHandle      m_indirectBuffer;
+
+		uint32_t m_current;
+		uint32_t m_numSpawn;
+		float    m_numAlive;
+		uint32_t m_easeKey;
+		float    m_dt;
+		bool     m_simulate;
+		bool     m_reset;
+	};
+
+	// Must match u_psParams layout in gpu/uniforms.sh.
+	struct GpuParams
+	{
+		float    m_deltaTime;
+		uint32_t m_numSpawn;
+		float    m_timePerParticle;
+		uint32_t m_seed;
+
+		uint32_t m_maxParticles;
+		uint32_t m_shape;
+		uint32_t m_direction;
+		float    m_gravityScale;
+
+		float m_offsetStart[2];
+		float m_offsetEnd[2];
+		float m_blendStart[2];
+		float m_blendEnd[2];
+		float m_scaleStart[2];
+		float m_scaleEnd[2];
+		float m_lifeSpan[2];
+		float m_unused[2];
+
+		float m_mtx[16];
+		float m_rgba[5][4];
+	};
+	BX_STATIC_ASSERT(sizeof(GpuParams) == PS_GPU_NUM_PARAMS*16);
+
 	struct Emitter
 	{
-		void create(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles);
+		void create(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles, bool _gpu);
 		void destroy();
 
 		void reset()
 		{
 			m_num = 0;
+			m_gpu.m_reset    = true;
+			m_gpu.m_numAlive = 0.0f;
 			bx::memSet(&m_aabb, 0, sizeof(Aabb) );
 		}
 
+		uint32_t calcNumSpawn(float _dt)
+		{
+			const float timePerParticle = 1.0f/m_uniforms.m_particlesPerSecond;
+			m_dt += _dt;
+			const uint32_t numParticles = uint32_t(m_dt / timePerParticle);
+			m_dt -= numParticles * timePerParticle;
+			return numParticles;
+		}
+
 		void update(float _dt)
 		{
-			uint32_t num = m_num;
-			for (uint32_t ii = 0; ii < num; ++ii)
+			using namespace bx;
+
+			if (m_useGpu)
 			{
-				Particle& particle = m_particles[ii];
-				particle.life += _dt * 1.0f/particle.lifeSpan;
+				// Simulation is deferred to render, where compute dispatches
+				// can be submitted into view.
+				m_gpu.m_dt += _dt;
+				uint32_t numSpawn = 0;
+				if (0 < m_uniforms.m_particlesPerSecond)
+				{
+					numSpawn = calcNumSpawn(_dt);
+					m_gpu.m_numSpawn += numSpawn;
+				}
 
-				if (particle.life > 1.0f)
+				// Alive count lives in counter buffer and it's never read
+				// back. Estimate it by decaying with average life span.
+				const float lifeSpan = bx::fmax( (m_uniforms.m_lifeSpan[0] + m_uniforms.m_lifeSpan[1])*0.5f, _dt);
+				const float numAlive = m_gpu.m_numAlive * (1.0f - bx::fmin(_dt/lifeSpan, 1.0f) );
+				m_gpu.m_numAlive = bx::fmin(numAlive + float(numSpawn), float(m_max) );
+
+				m_gpu.m_simulate = true;
+				return;
+			}
+
+			float* life = m_stream[ParticleStream::Life];
+			const float* invLifeSpan = m_stream[ParticleStream::InvLifeSpan];
+
+			// Streams are padded to multiple of 4, lanes past m_num are
+			// updated too but never read.
+			const simd128_t dt = simd_splat(_dt);
+			for (uint32_t ii = 0, num = m_num; ii < num; ii += 4)
+			{
+				const simd128_t tmp = simd_madd(simd_ld(&invLifeSpan[ii]), dt, simd_ld(&life[ii]) );
+				simd_st(&life[ii], tmp);
+			}
+
+			uint32_t num = m_num;
+			for (uint32_t ii = 0; ii < num;)
+			{
+				if (life[ii] > 1.0f)
 				{
-					if (ii != num-1)
+					--num;
+					if (ii != num)
 					{
-						bx::memCopy(&particle, &m_particles[num-1], sizeof(Particle) );
-						--ii;
+						move(ii, num);
 					}
-
-					--num;
+				}
+				else
+				{
+					++ii;
 				}
 			}
 
@@ -222,6 +373,15 @@ namespace ps
 			}
 		}
 
+		void move(uint32_t _dst, uint32_t _src)
+		{
+			for (uint32_t ii = 0; ii < ParticleStream::Count; ++ii)
+			{
+				uint32_t* stream = (uint32_t*)m_stream[ii];
+				stream[_dst] = stream[_src];
+			}
+		}
+
 		void spawn(float _dt)
 		{
 			float mtx[16];
@@ -232,98 +392,128 @@ namespace ps
 				);
 
 			const float timePerParticle = 1.0f/m_uniforms.m_particlesPerSecond;
-			m_dt += _dt;
-			const uint32_t numParticles = uint32_t(m_dt / timePerParticle);
-			m_dt -= numParticles * timePerParticle;
+			const uint32_t numParticles = calcNumSpawn(_dt);
+			const uint32_t numSpawn = bx::uint32_min(numParticles, m_max - m_num);
+
+			float* const* stream = m_stream;
+			uint32_t* const* rgba = (uint32_t* const*)&m_stream[ParticleStream::Rgba0];
 
 			float time = 0.0f;
-			for (uint32_t ii = 0
-				; ii < numParticles && m_num < m_max
-				; ++ii
-				)
+			for (uint32_t ii = 0; ii < numSpawn; ii += 4)
 			{
-				Particle& particle = m_particles[m_num];
-				m_num++;
+				const uint32_t numBatch = bx::uint32_min(4, numSpawn - ii);
 
-				const float up[3] = { 0.0f, 1.0f, 0.0f };
+				BX_ALIGN_DECL_16(float) start[3][4];
+				BX_ALIGN_DECL_16(float) end[3][4];
+				BX_ALIGN_DECL_16(float) gravity[4];
+				bx::memSet(start,   0, sizeof(start) );
+				bx::memSet(end,     0, sizeof(end) );
+				bx::memSet(gravity, 0, sizeof(gravity) );
 
-				float pos[3];
-				switch (m_shape)
+				for (uint32_t jj = 0; jj < numBatch; ++jj)
 				{
-					default:
-					case EmitterShape::Sphere:
-						bx::randUnitSphere(pos, &m_rng);
-						break;
-
-					case EmitterShape::Hemisphere:
-						bx::randUnitHemisphere(pos, &m_rng, up);
-						break;
-
-					case EmitterShape::Circle:
-						bx::randUnitCircle(pos, &m_rng);
-						break;
-
-					case EmitterShape::Disc:
-						{
-							float tmp[3];
-							bx::randUnitCircle(tmp, &m_rng);
-							bx::vec3Mul(pos, tmp, bx::frnd(&m_rng) );
-						}
-						break;
-
-					case EmitterShape::Rect:
-						pos[0] = bx::frndh(&m_rng);
-						pos[1] = 0.0f;
-						pos[2] = bx::frndh(&m_rng);
-						break;
-				}
+					const uint32_t idx = m_num + jj;
 
-				float dir[3];
-				switch (m_direction)
-				{
-					default:
-					case EmitterDirection::Up:
-						bx::vec3Move(dir, up);
-						break;
-
-					case EmitterDirection::Outward:
-						bx::vec3Norm(dir, pos);
-						break;
-				}
+					const float up[3] = { 0.0f, 1.0f, 0.0f };
 
-				float start[3];
-				float end[3];
-				const float startOffset = bx::flerp(m_uniforms.m_offsetStart[0], m_uniforms.m_offsetStart[1], bx::frnd(&m_rng) );
-				bx::vec3Mul(start, pos, startOffset);
+					float pos[3];
+					switch (m_shape)
+					{
+						default:
+						case EmitterShape::Sphere:
+							bx::randUnitSphere(pos, &m_rng);
+							break;
+
+						case EmitterShape::Hemisphere:
+							bx::randUnitHemisphere(pos, &m_rng, up);
+							break;
+
+						case EmitterShape::Circle:
+							bx::randUnitCircle(pos, &m_rng);
+							break;
+
+						case EmitterShape::Disc:
+							{
+								float tmp[3];
+								bx::randUnitCircle(tmp, &m_rng);
+								bx::vec3Mul(pos, tmp, bx::frnd(&m_rng) );
+							}
+							break;
+
+						case EmitterShape::Rect:
+							pos[0] = bx::frndh(&m_rng);
+							pos[1] = 0.0f;
+							pos[2] = bx::frndh(&m_rng);
+							break;
+					}
+
+					float dir[3];
+					switch (m_direction)
+					{
+						default:
+						case EmitterDirection::Up:
+							bx::vec3Move(dir, up);
+							break;
+
+						case EmitterDirection::Outward:
+							bx::vec3Norm(dir, pos);
+							break;
+					}
 
-				const float endOffset = bx::flerp(m_uniforms.m_offsetEnd[0], m_uniforms.m_offsetEnd[1], bx::frnd(&m_rng) );
-				float tmp1[3];
-				bx::vec3Mul(tmp1, dir, endOffset);
-				bx::vec3Add(end, tmp1, start);
+					const float startOffset = bx::flerp(m_uniforms.m_offsetStart[0], m_uniforms.m_offsetStart[1], bx::frnd(&m_rng) );
+					const float endOffset   = bx::flerp(m_uniforms.m_offsetEnd[0],   m_uniforms.m_offsetEnd[1],   bx::frnd(&m_rng) );
 
-				particle.life = time;
-				particle.lifeSpan = bx::flerp(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1], bx::frnd(&m_rng) );
+					for (uint32_t kk = 0; kk < 3; ++kk)
+					{
+						start[kk][jj] = pos[kk]*startOffset;
+						end[kk][jj]   = dir[kk]*endOffset + start[kk][jj];
+					}
 
-				float gravity[3] = { 0.0f, -9.81f * m_uniforms.m_gravityScale * bx::fsq(particle.lifeSpan), 0.0f };
+					const float lifeSpan = bx::flerp(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1], bx::frnd(&m_rng) );
+					stream[ParticleStream::Life][idx]        = time;
+					stream[ParticleStream::InvLifeSpan][idx] = 1.0f/lifeSpan;
 
-				bx::vec3MulMtx(particle.start,  start, mtx);
-				bx::vec3MulMtx(particle.end[0], end,   mtx);
-				bx::vec3Add(particle.end[1], particle.end[0], gravity);
+					gravity[jj] = -9.81f * m_uniforms.m_gravityScale * bx::fsq(lifeSpan);
 
-				bx::memCopy(particle.rgba, m_uniforms.m_rgba, BX_COUNTOF(m_uniforms.m_rgba)*sizeof(uint32_t) );
+					for (uint32_t kk = 0; kk < BX_COUNTOF(m_uniforms.m_rgba); ++kk)
+					{
+						rgba[kk][idx] = m_uniforms.m_rgba[kk];
+					}
 
-				particle.blendStart = bx::flerp(m_uniforms.m_blendStart[0], m_uniforms.m_blendStart[1], bx::frnd(&m_rng) );
-				particle.blendEnd   = bx::flerp(m_uniforms.m_blendEnd[0],   m_uniforms.m_blendEnd[1],   bx::frnd(&m_rng) );
+					stream[ParticleStream::BlendStart][idx] = bx::flerp(m_uniforms.m_blendStart[0], m_uniforms.m_blendStart[1], bx::frnd(&m_rng) );
+					stream[ParticleStream::BlendEnd][idx]   = bx::flerp(m_uniforms.m_blendEnd[0],   m_uniforms.m_blendEnd[1],   bx::frnd(&m_rng) );
 
-				particle.scaleStart = bx::flerp(m_uniforms.m_scaleStart[0], m_uniforms.m_scaleStart[1], bx::frnd(&m_rng) );
-				particle.scaleEnd   = bx::flerp(m_uniforms.m_scaleEnd[0],   m_uniforms.m_scaleEnd[1],   bx::frnd(&m_rng) );
+					stream[ParticleStream::ScaleStart][idx] = bx::flerp(m_uniforms.m_scaleStart[0], m_uniforms.m_scaleStart[1], bx::frnd(&m_rng) );
+					stream[ParticleStream::ScaleEnd][idx]   = bx::flerp(m_uniforms.m_scaleEnd[0],   m_uniforms.m_scaleEnd[1],   bx::frnd(&m_rng) );
 
-				time += timePerParticle;
+					time += timePerParticle;
+				}
+
+				vec3MulMtx4(start, start, mtx);
+				vec3MulMtx4(end,   end,   mtx);
+
+				for (uint32_t jj = 0; jj < numBatch; ++jj)
+				{
+					const uint32_t idx = m_num + jj;
+
+					for (uint32_t kk = 0; kk < 3; ++kk)
+					{
+						stream[ParticleStream::StartX+kk][idx] = start[kk][jj];
+						stream[ParticleStream::End0X +kk][idx] = end[kk][jj];
+						stream[ParticleStream::End1X +kk][idx] = end[kk][jj];
+					}
+
+					stream[ParticleStream::End1Y][idx] += gravity[jj];
+				}
+
+				m_num += numBatch;
 			}
 		}
 
-		uint32_t render(const float* _mtxView, const float* _eye, uint32_t _first, uint32_t _max, ParticleSort* _outSort, PosColorTexCoord0Vertex* _outVertices)
+		void gather(const float* _mtxView, const float* _eye, uint32_t* _outKeys, uint32_t* _outValues, ParticleRender* _outRender, uint32_t _first)
 		{
+			using namespace bx;
+
 			bx::EaseFn easeRgba  = s_easeFunc[m_uniforms.m_easeRgba];
 			bx::EaseFn easePos   = s_easeFunc[m_uniforms.m_easePos];
 			bx::EaseFn easeBlend = s_easeFunc[m_uniforms.m_easeBlend];
@@ -335,92 +525,98 @@ namespace ps
 				{ -bx::huge, -bx::huge, -bx::huge },
 			};
 
-			for (uint32_t jj = 0, num = m_num, current = _first
-				; jj < num && current < _max
-				; ++jj, ++current
-				)
-			{
-				const Particle& particle = m_particles[jj];
-
-				const float ttPos   = easePos(particle.life);
-				const float ttScale = easeScale(particle.life);
-				const float ttBlend = bx::fsaturate(easeBlend(particle.life) );
-				const float ttRgba  = bx::fsaturate(easeRgba(particle.life) );
-
-				float p0[3];
-				bx::vec3Lerp(p0, particle.start, particle.end[0], ttPos);
-
-				float p1[3];
-				bx::vec3Lerp(p1, particle.end[0], particle.end[1], ttPos);
-
-				float pos[3];
-				bx::vec3Lerp(pos, p0, p1, ttPos);
-
-				ParticleSort& sort = _outSort[current];
-				float tmp[3];
-				bx::vec3Sub(tmp, _eye, pos);
-				sort.dist = bx::fsqrt(bx::vec3Dot(tmp, tmp) );
-				sort.idx  = current;
-
-				uint32_t idx = uint32_t(ttRgba*4);
-				float ttmod = bx::fmod(ttRgba, 0.25f)/0.25f;
-				uint32_t rgbaStart = particle.rgba[idx];
-				uint32_t rgbaEnd   = particle.rgba[idx+1];
-
-				float rr = bx::flerp( ( (uint8_t*)&rgbaStart)[0], ( (uint8_t*)&rgbaEnd)[0], ttmod)/255.0f;
-				float gg = bx::flerp( ( (uint8_t*)&rgbaStart)[1], ( (uint8_t*)&rgbaEnd)[1], ttmod)/255.0f;
-				float bb = bx::flerp( ( (uint8_t*)&rgbaStart)[2], ( (uint8_t*)&rgbaEnd)[2], ttmod)/255.0f;
-				float aa = bx::flerp( ( (uint8_t*)&rgbaStart)[3], ( (uint8_t*)&rgbaEnd)[3], ttmod)/255.0f;
-
-				float blend = bx::flerp(particle.blendStart, particle.blendEnd, ttBlend);
-				float scale = bx::flerp(particle.scaleStart, particle.scaleEnd, ttScale);
-
-				uint32_t abgr = toAbgr(rr, gg, bb, aa);
-
-				float udir[3] = { _mtxView[0]*scale, _mtxView[4]*scale, _mtxView[8]*scale };
-				float vdir[3] = { _mtxView[1]*scale, _mtxView[5]*scale, _mtxView[9]*scale };
-
-				PosColorTexCoord0Vertex* vertex = &_outVertices[current*4];
-				bx::vec3Sub(tmp, pos, udir);
-				bx::vec3Sub(&vertex->m_x, tmp, vdir);
-				aabbExpand(aabb, &vertex->m_x);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = 0.0f;
-				vertex->m_v     = 0.0f;
-				vertex->m_blend = blend;
-				++vertex;
-
-				bx::vec3Add(tmp, pos, udir);
-				bx::vec3Sub(&vertex->m_x, tmp, vdir);
-				aabbExpand(aabb, &vertex->m_x);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = 1.0f;
-				vertex->m_v     = 0.0f;
-				vertex->m_blend = blend;
-				++vertex;
-
-				bx::vec3Add(tmp, pos, udir);
-				bx::vec3Add(&vertex->m_x, tmp, vdir);
-				aabbExpand(aabb, &vertex->m_x);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = 1.0f;
-				vertex->m_v     = 1.0f;
-				vertex->m_blend = blend;
-				++vertex;
-
-				bx::vec3Sub(tmp, pos, udir);
-				bx::vec3Add(&vertex->m_x, tmp, vdir);
-				aabbExpand(aabb, &vertex->m_x);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = 0.0f;
-				vertex->m_v     = 1.0f;
-				vertex->m_blend = blend;
-				++vertex;
+			// Billboard corners are pos +/- udir +/- vdir, scaled by particle
+			// scale. Their bounds are pos +/- extent*scale on each axis.
+			const float extent[3] =
+			{
+				bx::fabsolute(_mtxView[0]) + bx::fabsolute(_mtxView[1]),
+				bx::fabsolute(_mtxView[4]) + bx::fabsolute(_mtxView[5]),
+				bx::fabsolute(_mtxView[8]) + bx::fabsolute(_mtxView[9]),
+			};
+
+			const simd128_t eye[3] =
+			{
+				simd_splat(_eye[0]),
+				simd_splat(_eye[1]),
+				simd_splat(_eye[2]),
+			};
+
+			const float* life = m_stream[ParticleStream::Life];
+			uint32_t* const* rgba = (uint32_t* const*)&m_stream[ParticleStream::Rgba0];
+
+			for (uint32_t ii = 0, num = m_num; ii < num; ii += 4)
+			{
+				BX_ALIGN_DECL_16(float) ttPos[4];
+				for (uint32_t jj = 0; jj < 4; ++jj)
+				{
+					ttPos[jj] = easePos(life[ii+jj]);
+				}
+
+				const simd128_t tt = simd_ld(ttPos);
+
+				BX_ALIGN_DECL_16(float) pos[3][4];
+				simd128_t dist = simd_splat(0.0f);
+
+				for (uint32_t kk = 0; kk < 3; ++kk)
+				{
+					const simd128_t start = simd_ld(&m_stream[ParticleStream::StartX+kk][ii]);
+					const simd128_t end0  = simd_ld(&m_stream[ParticleStream::End0X +kk][ii]);
+					const simd128_t end1  = simd_ld(&m_stream[ParticleStream::End1X +kk][ii]);
+					const simd128_t p0    = simdLerp(start, end0, tt);
+					const simd128_t p1    = simdLerp(end0,  end1, tt);
+					const simd128_t pp    = simdLerp(p0,    p1,   tt);
+					const simd128_t delta = simd_sub(eye[kk], pp);
+					dist = simd_madd(delta, delta, dist);
+					simd_st(pos[kk], pp);
+				}
+
+				BX_ALIGN_DECL_16(float) distSq[4];
+				simd_st(distSq, dist);
+
+				for (uint32_t jj = 0, numLanes = uint32_min(4, num-ii); jj < numLanes; ++jj)
+				{
+					const uint32_t idx = ii+jj;
+
+					const float ttScale = easeScale(life[idx]);
+					const float ttBlend = bx::fsaturate(easeBlend(life[idx]) );
+					const float ttRgba  = bx::fsaturate(easeRgba(life[idx]) );
+
+					uint32_t rgbaIdx = uint32_t(ttRgba*4);
+					float ttmod = bx::fmod(ttRgba, 0.25f)/0.25f;
+					uint32_t rgbaStart = rgba[rgbaIdx][idx];
+					uint32_t rgbaEnd   = rgba[rgbaIdx+1][idx];
+
+					float rr = bx::flerp( ( (uint8_t*)&rgbaStart)[0], ( (uint8_t*)&rgbaEnd)[0], ttmod)/255.0f;
+					float gg = bx::flerp( ( (uint8_t*)&rgbaStart)[1], ( (uint8_t*)&rgbaEnd)[1], ttmod)/255.0f;
+					float bb = bx::flerp( ( (uint8_t*)&rgbaStart)[2], ( (uint8_t*)&rgbaEnd)[2], ttmod)/255.0f;
+					float aa = bx::flerp( ( (uint8_t*)&rgbaStart)[3], ( (uint8_t*)&rgbaEnd)[3], ttmod)/255.0f;
+
+					const uint32_t current = _first + idx;
+
+					ParticleRender& render = _outRender[current];
+					render.pos[0] = pos[0][jj];
+					render.pos[1] = pos[1][jj];
+					render.pos[2] = pos[2][jj];
+					render.scale  = bx::flerp(m_stream[ParticleStream::ScaleStart][idx], m_stream[ParticleStream::ScaleEnd][idx], ttScale);
+					render.blend  = bx::flerp(m_stream[ParticleStream::BlendStart][idx], m_stream[ParticleStream::BlendEnd][idx], ttBlend);
+					render.abgr   = toAbgr(rr, gg, bb, aa);
+
+					for (uint32_t kk = 0; kk < 3; ++kk)
+					{
+						const float ext = extent[kk]*render.scale;
+						aabb.m_min[kk] = bx::fmin(aabb.m_min[kk], render.pos[kk] - ext);
+						aabb.m_max[kk] = bx::fmax(aabb.m_max[kk], render.pos[kk] + ext);
+					}
+
+					// Back to front, farthest particle gets smallest key.
+					union { float fl; uint32_t ui; } un;
+					un.fl = distSq[jj];
+					_outKeys[current]   = floatFlip(un.ui) ^ UINT32_MAX;
+					_outValues[current] = current;
+				}
 			}
 
 			m_aabb = aabb;
-
-			return m_num;
 		}
 
 		EmitterShape::Enum     m_shape;
@@ -432,21 +628,31 @@ namespace ps
 
 		Aabb m_aabb;
 
-		Particle* m_particles;
+		void simulateGpu(uint8_t _view);
+		void calcAabbGpu();
+
+		void*  m_data;
+		float* m_stream[ParticleStream::Count];
 		uint32_t m_num;
 		uint32_t m_max;
+
+		GpuEmitter m_gpu;
+		bool m_useGpu;
 	};
 
-	static int32_t particleSortFn(const void* _lhs, const void* _rhs)
+	struct ParticleJob
 	{
-		const ParticleSort& lhs = *(const ParticleSort*)_lhs;
-		const ParticleSort& rhs = *(const ParticleSort*)_rhs;
-		return lhs.dist > rhs.dist ? -1 : 1;
-	}
+		enum Enum
+		{
+			Update,
+			Gather,
+			Exit
+		};
+	};
 
 	struct ParticleSystem
 	{
-		void init(uint16_t _maxEmitters, bx::AllocatorI* _allocator)
+		void init(uint16_t _maxEmitters, bx::AllocatorI* _allocator, uint32_t _numThreads)
 		{
 			m_allocator = _allocator;
 
@@ -460,11 +666,19 @@ namespace ps
 
 			m_emitterAlloc = bx::createHandleAlloc(m_allocator, _maxEmitters);
 			m_emitter = (Emitter*)BX_ALLOC(m_allocator, sizeof(Emitter)*_maxEmitters);
+			m_emitterFirst = (uint32_t*)BX_ALLOC(m_allocator, sizeof(uint32_t)*_maxEmitters);
 
 			PosColorTexCoord0Vertex::init();
 
 			m_num = 0;
 
+			m_keys       = NULL;
+			m_values     = NULL;
+			m_tempKeys   = NULL;
+			m_tempValues = NULL;
+			m_render     = NULL;
+			m_maxSort    = 0;
+
 			s_texColor = bgfx::createUniform("s_texColor", bgfx::UniformType::Int1);
 			m_particleTexture = loadTexture("textures/particle.ktx");
 
@@ -474,114 +688,396 @@ namespace ps
 				, bgfx::createEmbeddedShader(s_embeddedShaders, type, "fs_particle")
 				, true
 				);
+
+			m_gpuInit      = false;
+			m_gpuSupported = false;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+			m_numThreads = bx::uint32_clamp(_numThreads, 1, PS_MAX_THREADS);
+			for (uint32_t ii = 1; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].init(threadFunc, this, 0, "ps - worker");
+			}
+#else
+			BX_UNUSED(_numThreads);
+			m_numThreads = 1;
+#endif // BX_CONFIG_SUPPORTS_THREADING
 		}
 
 		void shutdown()
 		{
+#if BX_CONFIG_SUPPORTS_THREADING
+			m_job = ParticleJob::Exit;
+			if (1 < m_numThreads)
+			{
+				m_sem.post(m_numThreads-1);
+			}
+
+			for (uint32_t ii = 1; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+			shutdownGpu();
+
 			bgfx::destroyProgram(m_particleProgram);
 			bgfx::destroyTexture(m_particleTexture);
 			bgfx::destroyUniform(s_texColor);
 
+			BX_FREE(m_allocator, m_keys);
+			BX_FREE(m_allocator, m_values);
+			BX_FREE(m_allocator, m_tempKeys);
+			BX_FREE(m_allocator, m_tempValues);
+			BX_FREE(m_allocator, m_render);
+
 			bx::destroyHandleAlloc(m_allocator, m_emitterAlloc);
+			BX_FREE(m_allocator, m_emitterFirst);
 			BX_FREE(m_allocator, m_emitter);
 
 			m_allocator = NULL;
 		}
 
-		void update(float _dt)
+		// Compute backend is initialized on first request for GPU emitter,
+		// CPU-only users never load compute shaders.
+		void initGpu()
 		{
-			uint32_t numParticles = 0;
+			m_gpuInit      = true;
+			m_gpuSupported = false;
+
+			const bgfx::Caps* caps = bgfx::getCaps();
+			if (0 == (caps->supported & BGFX_CAPS_COMPUTE)
+			||  0 == (caps->supported & BGFX_CAPS_DRAW_INDIRECT) )
+			{
+				return;
+			}
+
+			// Compute shaders are not embedded, they are loaded from runtime
+			// shaders directory and are built with make in gpu directory.
+			// CPU path is used when any of them is missing for current
+			// renderer.
+			m_gpuBegin  = bgfx::createProgram(loadShader("cs_ps_begin"),  true);
+			m_gpuUpdate = bgfx::createProgram(loadShader("cs_ps_update"), true);
+			m_gpuEmit   = bgfx::createProgram(loadShader("cs_ps_emit"),   true);
+			m_gpuEnd    = bgfx::createProgram(loadShader("cs_ps_end"),    true);
+
+			m_gpuProgram.idx = bgfx::invalidHandle;
+			bgfx::ShaderHandle vsh = loadShader("vs_ps_instance");
+			if (bgfx::isValid(vsh) )
+			{
+				bgfx::RendererType::Enum type = bgfx::getRendererType();
+				m_gpuProgram = bgfx::createProgram(
+					  vsh
+					, bgfx::createEmbeddedShader(s_embeddedShaders, type, "fs_particle")
+					, true
+					);
+			}
+
+			if (!bgfx::isValid(m_gpuBegin)
+			||  !bgfx::isValid(m_gpuUpdate)
+			||  !bgfx::isValid(m_gpuEmit)
+			||  !bgfx::isValid(m_gpuEnd)
+			||  !bgfx::isValid(m_gpuProgram) )
+			{
+				destroyGpuPrograms();
+				return;
+			}
+
+			m_gpuSupported = true;
+
+			u_psParams    = bgfx::createUniform("u_psParams",    bgfx::UniformType::Vec4, PS_GPU_NUM_PARAMS);
+			u_psBillboard = bgfx::createUniform("u_psBillboard", bgfx::UniformType::Vec4, 2);
+
+			m_quadDecl
+				.begin()
+				.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+				.end();
+
+			m_particleDecl
+				.begin()
+				.add(bgfx::Attrib::TexCoord0, 4, bgfx::AttribType::Float)
+				.add(bgfx::Attrib::TexCoord1, 4, bgfx::AttribType::Float)
+				.add(bgfx::Attrib::TexCoord2, 4, bgfx::AttribType::Float)
+				.add(bgfx::Attrib::TexCoord3, 4, bgfx::AttribType::Float)
+				.end();
+
+			m_instanceDecl
+				.begin()
+				.add(bgfx::Attrib::TexCoord0, 4, bgfx::AttribType::Float)
+				.add(bgfx::Attrib::TexCoord1, 4, bgfx::AttribType::Float)
+				.add(bgfx::Attrib::TexCoord2, 4, bgfx::AttribType::Float)
+				.end();
+
+			m_easeDecl
+				.begin()
+				.add(bgfx::Attrib::TexCoord0, 4, bgfx::AttribType::Float)
+				.end();
+
+			static const float s_quadVertices[] =
+			{
+				0.0f, 0.0f, 0.0f,
+				1.0f, 0.0f, 0.0f,
+				1.0f, 1.0f, 0.0f,
+				0.0f, 1.0f, 0.0f,
+			};
+
+			static const uint16_t s_quadIndices[] =
+			{
+				0, 1, 2,
+				2, 3, 0,
+			};
+
+			m_quadVb = bgfx::createVertexBuffer(bgfx::makeRef(s_quadVertices, sizeof(s_quadVertices) ), m_quadDecl);
+			m_quadIb = bgfx::createIndexBuffer(bgfx::makeRef(s_quadIndices, sizeof(s_quadIndices) ) );
+		}
+
+		void destroyGpuPrograms()
+		{
+			const bgfx::ProgramHandle programs[] = { m_gpuBegin, m_gpuUpdate, m_gpuEmit, m_gpuEnd, m_gpuProgram };
+			for (uint32_t ii = 0; ii < BX_COUNTOF(programs); ++ii)
+			{
+				if (bgfx::isValid(programs[ii]) )
+				{
+					bgfx::destroyProgram(programs[ii]);
+				}
+			}
+		}
+
+		void shutdownGpu()
+		{
+			if (m_gpuSupported)
+			{
+				destroyGpuPrograms();
+				bgfx::destroyUniform(u_psParams);
+				bgfx::destroyUniform(u_psBillboard);
+				bgfx::destroyVertexBuffer(m_quadVb);
+				bgfx::destroyIndexBuffer(m_quadIb);
+			}
+		}
+
+		// GPU emitters are not sorted, they are drawn after sorted CPU
+		// particles, each emitter in its own spawn order.
+		void renderGpu(uint8_t _view, const float* _mtxView, int32_t _depth)
+		{
+			const float billboard[2][4] =
+			{
+				{ _mtxView[0], _mtxView[4], _mtxView[8], 0.0f },
+				{ _mtxView[1], _mtxView[5], _mtxView[9], 0.0f },
+			};
+
 			for (uint16_t ii = 0, num = m_emitterAlloc->getNumHandles(); ii < num; ++ii)
 			{
 				const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
 				Emitter& emitter = m_emitter[idx];
-				emitter.update(_dt);
-				numParticles += emitter.m_num;
+
+				if (!emitter.m_useGpu)
+				{
+					continue;
+				}
+
+				emitter.simulateGpu(_view);
+
+				bgfx::setUniform(u_psBillboard, billboard, 2);
+				bgfx::setState(0
+					| BGFX_STATE_RGB_WRITE
+					| BGFX_STATE_ALPHA_WRITE
+					| BGFX_STATE_DEPTH_TEST_LESS
+					| BGFX_STATE_CULL_CW
+					| BGFX_STATE_BLEND_NORMAL
+					);
+				bgfx::setVertexBuffer(m_quadVb);
+				bgfx::setIndexBuffer(m_quadIb);
+				bgfx::setInstanceDataBuffer(emitter.m_gpu.m_instanceBuffer, 0, emitter.m_max);
+				bgfx::setTexture(0, s_texColor, m_particleTexture);
+				bgfx::submit(_view, m_gpuProgram, emitter.m_gpu.m_indirectBuffer, 1, 1, _depth);
+			}
+		}
+
+		uint32_t update(float _dt)
+		{
+			m_dt = _dt;
+			run(ParticleJob::Update);
+
+			uint32_t numParticles = 0;
+			for (uint16_t ii = 0, num = m_emitterAlloc->getNumHandles(); ii < num; ++ii)
+			{
+				const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
+				const Emitter& emitter = m_emitter[idx];
+				numParticles += emitter.m_useGpu
+					? uint32_t(emitter.m_gpu.m_numAlive + 0.5f)
+					: emitter.m_num
+					;
 			}
 
 			m_num = numParticles;
+
+			return numParticles;
 		}
 
 		void render(uint8_t _view, const float* _mtxView, const float* _eye)
 		{
-			if (0 != m_num)
+			const int32_t depth = renderCpu(_view, _mtxView, _eye);
+
+			if (m_gpuSupported)
 			{
-				bgfx::TransientVertexBuffer tvb;
-				bgfx::TransientIndexBuffer tib;
+				renderGpu(_view, _mtxView, depth);
+			}
+		}
+
+		// Returns depth past last submitted batch.
+		int32_t renderCpu(uint8_t _view, const float* _mtxView, const float* _eye)
+		{
+			uint32_t numParticles = 0;
+			for (uint16_t ii = 0, num = m_emitterAlloc->getNumHandles(); ii < num; ++ii)
+			{
+				const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
+				m_emitterFirst[ii] = numParticles;
+				numParticles += m_emitter[idx].m_useGpu ? 0 : m_emitter[idx].m_num;
+			}
 
-				const uint32_t numVertices = bgfx::getAvailTransientVertexBuffer(m_num*4, PosColorTexCoord0Vertex::ms_decl);
-				const uint32_t numIndices  = bgfx::getAvailTransientIndexBuffer(m_num*6);
+			if (0 == numParticles)
+			{
+				return 0;
+			}
+
+			if (numParticles > m_maxSort)
+			{
+				m_maxSort    = bx::uint32_max(numParticles, m_maxSort*2);
+				m_keys       = (uint32_t*)BX_REALLOC(m_allocator, m_keys,       m_maxSort*sizeof(uint32_t) );
+				m_values     = (uint32_t*)BX_REALLOC(m_allocator, m_values,     m_maxSort*sizeof(uint32_t) );
+				m_tempKeys   = (uint32_t*)BX_REALLOC(m_allocator, m_tempKeys,   m_maxSort*sizeof(uint32_t) );
+				m_tempValues = (uint32_t*)BX_REALLOC(m_allocator, m_tempValues, m_maxSort*sizeof(uint32_t) );
+				m_render     = (ParticleRender*)BX_REALLOC(m_allocator, m_render, m_maxSort*sizeof(ParticleRender) );
+			}
+
+			m_mtxView = _mtxView;
+			m_eye     = _eye;
+			run(ParticleJob::Gather);
+
+			bx::radixSort(m_keys, m_tempKeys, m_values, m_tempValues, numParticles);
+
+			// 16-bit indices address at most 16K quads, particles are split
+			// into multiple draws. Batches are submitted with increasing
+			// depth to preserve back to front order.
+			const uint32_t maxBatch = (UINT16_MAX+1)/4;
+
+			uint32_t batch = 0;
+			for (uint32_t first = 0; first < numParticles; first += maxBatch, ++batch)
+			{
+				const uint32_t num = bx::uint32_min(maxBatch, numParticles - first);
+
+				const uint32_t numVertices = bgfx::getAvailTransientVertexBuffer(num*4, PosColorTexCoord0Vertex::ms_decl);
+				const uint32_t numIndices  = bgfx::getAvailTransientIndexBuffer(num*6);
 				const uint32_t max = bx::uint32_min(numVertices/4, numIndices/6);
-				BX_WARN(m_num == max
+				BX_WARN(num == max
 					, "Truncating transient buffer for particles to maximum available (requested %d, available %d)."
-					, m_num
+					, num
 					, max
 					);
 
-				if (0 < max)
+				if (0 == max)
 				{
-					bgfx::allocTransientBuffers(&tvb
-						, PosColorTexCoord0Vertex::ms_decl
-						, max*4
-						, &tib
-						, max*6
-						);
-					PosColorTexCoord0Vertex* vertices = (PosColorTexCoord0Vertex*)tvb.data;
-
-					ParticleSort* particleSort = (ParticleSort*)BX_ALLOC(m_allocator, max*sizeof(ParticleSort) );
-
-					uint32_t pos = 0;
-					for (uint16_t ii = 0, numEmitters = m_emitterAlloc->getNumHandles(); ii < numEmitters; ++ii)
-					{
-						const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
-						Emitter& emitter = m_emitter[idx];
-						pos += emitter.render(_mtxView, _eye, pos, max, particleSort, vertices);
-					}
+					break;
+				}
 
-					qsort(particleSort
-						, max
-						, sizeof(ParticleSort)
-						, particleSortFn
-						);
+				bgfx::TransientVertexBuffer tvb;
+				bgfx::TransientIndexBuffer tib;
+				bgfx::allocTransientBuffers(&tvb
+					, PosColorTexCoord0Vertex::ms_decl
+					, max*4
+					, &tib
+					, max*6
+					);
 
-					uint16_t* indices = (uint16_t*)tib.data;
-					for (uint32_t ii = 0; ii < max; ++ii)
-					{
-						const ParticleSort& sort = particleSort[ii];
-						uint16_t* index = &indices[ii*6];
-						uint16_t idx = (uint16_t)sort.idx;
-						index[0] = idx*4+0;
-						index[1] = idx*4+1;
-						index[2] = idx*4+2;
-						index[3] = idx*4+2;
-						index[4] = idx*4+3;
-						index[5] = idx*4+0;
-					}
+				PosColorTexCoord0Vertex* vertex = (PosColorTexCoord0Vertex*)tvb.data;
+				uint16_t* index = (uint16_t*)tib.data;
 
-					BX_FREE(m_allocator, particleSort);
-
-					bgfx::setState(0
-						| BGFX_STATE_RGB_WRITE
-						| BGFX_STATE_ALPHA_WRITE
-						| BGFX_STATE_DEPTH_TEST_LESS
-						| BGFX_STATE_CULL_CW
-						| BGFX_STATE_BLEND_NORMAL
-						);
-					bgfx::setVertexBuffer(&tvb);
-					bgfx::setIndexBuffer(&tib);
-					bgfx::setTexture(0, s_texColor, m_particleTexture);
-					bgfx::submit(_view, m_particleProgram);
+				for (uint32_t ii = 0; ii < max; ++ii)
+				{
+					const ParticleRender& particle = m_render[m_values[first+ii] ];
+					const float* pos = particle.pos;
+					const float scale = particle.scale;
+
+					float udir[3] = { _mtxView[0]*scale, _mtxView[4]*scale, _mtxView[8]*scale };
+					float vdir[3] = { _mtxView[1]*scale, _mtxView[5]*scale, _mtxView[9]*scale };
+
+					float tmp[3];
+					bx::vec3Sub(tmp, pos, udir);
+					bx::vec3Sub(&vertex->m_x, tmp, vdir);
+					vertex->m_abgr  = particle.abgr;
+					vertex->m_u     = 0.0f;
+					vertex->m_v     = 0.0f;
+					vertex->m_blend = particle.blend;
+					++vertex;
+
+					bx::vec3Add(tmp, pos, udir);
+					bx::vec3Sub(&vertex->m_x, tmp, vdir);
+					vertex->m_abgr  = particle.abgr;
+					vertex->m_u     = 1.0f;
+					vertex->m_v     = 0.0f;
+					vertex->m_blend = particle.blend;
+					++vertex;
+
+					bx::vec3Add(tmp, pos, udir);
+					bx::vec3Add(&vertex->m_x, tmp, vdir);
+					vertex->m_abgr  = particle.abgr;
+					vertex->m_u     = 1.0f;
+					vertex->m_v     = 1.0f;
+					vertex->m_blend = particle.blend;
+					++vertex;
+
+					bx::vec3Sub(tmp, pos, udir);
+					bx::vec3Add(&vertex->m_x, tmp, vdir);
+					vertex->m_abgr  = particle.abgr;
+					vertex->m_u     = 0.0f;
+					vertex->m_v     = 1.0f;
+					vertex->m_blend = particle.blend;
+					++vertex;
+
+					const uint16_t idx = uint16_t(ii*4);
+					index[0] = idx+0;
+					index[1] = idx+1;
+					index[2] = idx+2;
+					index[3] = idx+2;
+					index[4] = idx+3;
+					index[5] = idx+0;
+					index += 6;
+				}
+
+				bgfx::setState(0
+					| BGFX_STATE_RGB_WRITE
+					| BGFX_STATE_ALPHA_WRITE
+					| BGFX_STATE_DEPTH_TEST_LESS
+					| BGFX_STATE_CULL_CW
+					| BGFX_STATE_BLEND_NORMAL
+					);
+				bgfx::setVertexBuffer(&tvb);
+				bgfx::setIndexBuffer(&tib);
+				bgfx::setTexture(0, s_texColor, m_particleTexture);
+				bgfx::submit(_view, m_particleProgram, int32_t(batch) );
+
+				if (max != num)
+				{
+					break;
 				}
 			}
+
+			return int32_t(batch+1);
 		}
 
-		EmitterHandle createEmitter(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles)
+		EmitterHandle createEmitter(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles, bool _gpu)
 		{
+			if (_gpu
+			&&  !m_gpuInit)
+			{
+				initGpu();
+			}
+
 			EmitterHandle handle = { m_emitterAlloc->alloc() };
 
 			if (UINT16_MAX != handle.idx)
 			{
-				m_emitter[handle.idx].create(_shape, _direction, _maxParticles);
+				m_emitter[handle.idx].create(_shape, _direction, _maxParticles, _gpu && m_gpuSupported);
 			}
 
 			return handle;
@@ -626,21 +1122,122 @@ namespace ps
 			m_emitterAlloc->free(_handle.idx);
 		}
 
+		// Runs job for every emitter, emitters are distributed between
+		// caller and worker threads.
+		void run(ParticleJob::Enum _job)
+		{
+			m_job  = _job;
+			m_next = 0;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+			const uint32_t numThreads = bx::uint32_min(m_numThreads, m_emitterAlloc->getNumHandles() );
+			if (1 < numThreads)
+			{
+				m_sem.post(numThreads-1);
+				execute();
+
+				for (uint32_t ii = 1; ii < numThreads; ++ii)
+				{
+					m_doneSem.wait();
+				}
+
+				return;
+			}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+			execute();
+		}
+
+		void execute()
+		{
+			const uint32_t num = m_emitterAlloc->getNumHandles();
+			for (uint32_t ii = bx::atomicFetchAndAdd(&m_next, 1u); ii < num; ii = bx::atomicFetchAndAdd(&m_next, 1u) )
+			{
+				Emitter& emitter = m_emitter[m_emitterAlloc->getHandleAt(uint16_t(ii) )];
+
+				if (ParticleJob::Update == m_job)
+				{
+					emitter.update(m_dt);
+				}
+				else if (!emitter.m_useGpu)
+				{
+					emitter.gather(m_mtxView, m_eye, m_keys, m_values, m_render, m_emitterFirst[ii]);
+				}
+			}
+		}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+		static int32_t threadFunc(void* _userData)
+		{
+			ParticleSystem* ps = (ParticleSystem*)_userData;
+
+			for (;;)
+			{
+				ps->m_sem.wait();
+
+				if (ParticleJob::Exit == ps->m_job)
+				{
+					break;
+				}
+
+				ps->execute();
+				ps->m_doneSem.post();
+			}
+
+			return EXIT_SUCCESS;
+		}
+
+		bx::Thread    m_thread[PS_MAX_THREADS];
+		bx::Semaphore m_sem;
+		bx::Semaphore m_doneSem;
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+		uint32_t m_numThreads;
+		ParticleJob::Enum m_job;
+		volatile uint32_t m_next;
+		float m_dt;
+		const float* m_mtxView;
+		const float* m_eye;
+
 		bx::AllocatorI* m_allocator;
 
 		bx::HandleAlloc* m_emitterAlloc;
 		Emitter* m_emitter;
+		uint32_t* m_emitterFirst;
+
+		uint32_t* m_keys;
+		uint32_t* m_values;
+		uint32_t* m_tempKeys;
+		uint32_t* m_tempValues;
+		ParticleRender* m_render;
+		uint32_t m_maxSort;
 
 		bgfx::UniformHandle s_texColor;
 		bgfx::TextureHandle m_particleTexture;
 		bgfx::ProgramHandle m_particleProgram;
 
+		bgfx::ProgramHandle m_gpuBegin;
+		bgfx::ProgramHandle m_gpuUpdate;
+		bgfx::ProgramHandle m_gpuEmit;
+		bgfx::ProgramHandle m_gpuEnd;
+		bgfx::ProgramHandle m_gpuProgram;
+		bgfx::UniformHandle u_psParams;
+		bgfx::UniformHandle u_psBillboard;
+		bgfx::VertexBufferHandle m_quadVb;
+		bgfx::IndexBufferHandle  m_quadIb;
+		bgfx::VertexDecl m_quadDecl;
+		bgfx::VertexDecl m_particleDecl;
+		bgfx::VertexDecl m_instanceDecl;
+		bgfx::VertexDecl m_easeDecl;
+		bool m_gpuInit;
+		bool m_gpuSupported;
+
 		uint32_t m_num;
 	};
 
 	static ParticleSystem s_ctx;
 
-	void Emitter::create(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles)
+	void Emitter::create(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles, bool _gpu)
 	{
 		m_dt = 0.0f;
 		m_uniforms.reset();
@@ -649,22 +1246,222 @@ namespace ps
 
 		m_num = 0;
 		m_max = _maxParticles;
-		m_particles = (Particle*)BX_ALLOC(s_ctx.m_allocator, m_max*sizeof(Particle) );
+
+		m_useGpu = _gpu;
+		bx::memSet(&m_gpu, 0, sizeof(GpuEmitter) );
+
+		if (m_useGpu)
+		{
+			m_data = NULL;
+			bx::memSet(m_stream, 0, sizeof(m_stream) );
+
+			const uint32_t max = bx::uint32_max(m_max, 1);
+			m_gpu.m_particleBuffer[0] = bgfx::createDynamicVertexBuffer(max, s_ctx.m_particleDecl, BGFX_BUFFER_COMPUTE_READ_WRITE);
+			m_gpu.m_particleBuffer[1] = bgfx::createDynamicVertexBuffer(max, s_ctx.m_particleDecl, BGFX_BUFFER_COMPUTE_READ_WRITE);
+			m_gpu.m_instanceBuffer    = bgfx::createDynamicVertexBuffer(max, s_ctx.m_instanceDecl, BGFX_BUFFER_COMPUTE_READ_WRITE);
+			m_gpu.m_easeBuffer        = bgfx::createDynamicVertexBuffer(PS_GPU_EASE_LUT_SIZE, s_ctx.m_easeDecl, BGFX_BUFFER_COMPUTE_READ);
+
+			const bgfx::Memory* mem = bgfx::alloc(4*sizeof(uint32_t) );
+			bx::memSet(mem->data, 0, mem->size);
+			m_gpu.m_counterBuffer  = bgfx::createDynamicIndexBuffer(mem, BGFX_BUFFER_COMPUTE_READ_WRITE|BGFX_BUFFER_INDEX32);
+			m_gpu.m_indirectBuffer = bgfx::createIndirectBuffer(2);
+
+			// Indirect draw arguments are valid only after first simulation.
+			m_gpu.m_easeKey  = UINT32_MAX;
+			m_gpu.m_simulate = true;
+			return;
+		}
+
+		// Streams are padded to multiple of 4 and 16-byte aligned for SIMD.
+		const uint32_t pitch = bx::strideAlign(bx::uint32_max(m_max, 1), 4)*sizeof(float);
+		m_data = BX_ALIGNED_ALLOC(s_ctx.m_allocator, pitch*ParticleStream::Count, 16);
+		bx::memSet(m_data, 0, pitch*ParticleStream::Count);
+
+		for (uint32_t ii = 0; ii < ParticleStream::Count; ++ii)
+		{
+			m_stream[ii] = (float*)( (uint8_t*)m_data + ii*pitch);
+		}
 	}
 
 	void Emitter::destroy()
 	{
-		BX_FREE(s_ctx.m_allocator, m_particles);
-		m_particles = NULL;
+		if (m_useGpu)
+		{
+			bgfx::destroyDynamicVertexBuffer(m_gpu.m_particleBuffer[0]);
+			bgfx::destroyDynamicVertexBuffer(m_gpu.m_particleBuffer[1]);
+			bgfx::destroyDynamicVertexBuffer(m_gpu.m_instanceBuffer);
+			bgfx::destroyDynamicVertexBuffer(m_gpu.m_easeBuffer);
+			bgfx::destroyDynamicIndexBuffer(m_gpu.m_counterBuffer);
+			bgfx::destroyIndirectBuffer(m_gpu.m_indirectBuffer);
+			return;
+		}
+
+		BX_ALIGNED_FREE(s_ctx.m_allocator, m_data, 16);
+		m_data = NULL;
+	}
+
+	void Emitter::simulateGpu(uint8_t _view)
+	{
+		const uint32_t easeKey = 0
+			| (uint32_t(m_uniforms.m_easePos  )<< 0)
+			| (uint32_t(m_uniforms.m_easeScale)<< 8)
+			| (uint32_t(m_uniforms.m_easeBlend)<<16)
+			| (uint32_t(m_uniforms.m_easeRgba )<<24)
+			;
+
+		if (easeKey != m_gpu.m_easeKey)
+		{
+			m_gpu.m_easeKey = easeKey;
+
+			bx::EaseFn easePos   = s_easeFunc[m_uniforms.m_easePos];
+			bx::EaseFn easeScale = s_easeFunc[m_uniforms.m_easeScale];
+			bx::EaseFn easeBlend = s_easeFunc[m_uniforms.m_easeBlend];
+			bx::EaseFn easeRgba  = s_easeFunc[m_uniforms.m_easeRgba];
+
+			const bgfx::Memory* mem = bgfx::alloc(PS_GPU_EASE_LUT_SIZE*4*sizeof(float) );
+			float* lut = (float*)mem->data;
+			for (uint32_t ii = 0; ii < PS_GPU_EASE_LUT_SIZE; ++ii)
+			{
+				const float tt = float(ii)/float(PS_GPU_EASE_LUT_SIZE-1);
+				lut[ii*4+0] = easePos(tt);
+				lut[ii*4+1] = easeScale(tt);
+				lut[ii*4+2] = easeBlend(tt);
+				lut[ii*4+3] = easeRgba(tt);
+			}
+
+			bgfx::updateDynamicVertexBuffer(m_gpu.m_easeBuffer, 0, mem);
+		}
+
+		if (m_gpu.m_reset)
+		{
+			m_gpu.m_reset = false;
+
+			const bgfx::Memory* mem = bgfx::alloc(4*sizeof(uint32_t) );
+			bx::memSet(mem->data, 0, mem->size);
+			bgfx::updateDynamicIndexBuffer(m_gpu.m_counterBuffer, 0, mem);
+		}
+
+		calcAabbGpu();
+
+		if (!m_gpu.m_simulate)
+		{
+			return;
+		}
+
+		m_gpu.m_simulate = false;
+
+		const uint32_t numSpawn = bx::uint32_min(m_gpu.m_numSpawn, m_max);
+
+		float mtx[16];
+		bx::mtxSRT(mtx
+			, 1.0f, 1.0f, 1.0f
+			, m_uniforms.m_angle[0],    m_uniforms.m_angle[1],    m_uniforms.m_angle[2]
+			, m_uniforms.m_position[0], m_uniforms.m_position[1], m_uniforms.m_position[2]
+			);
+
+		GpuParams params;
+		params.m_deltaTime       = m_gpu.m_dt;
+		params.m_numSpawn        = numSpawn;
+		params.m_timePerParticle = 0 < m_uniforms.m_particlesPerSecond ? 1.0f/m_uniforms.m_particlesPerSecond : 0.0f;
+		params.m_seed            = m_rng.gen();
+		params.m_maxParticles    = m_max;
+		params.m_shape           = m_shape;
+		params.m_direction       = m_direction;
+		params.m_gravityScale    = m_uniforms.m_gravityScale;
+		bx::memCopy(params.m_offsetStart, m_uniforms.m_offsetStart, sizeof(params.m_offsetStart) );
+		bx::memCopy(params.m_offsetEnd,   m_uniforms.m_offsetEnd,   sizeof(params.m_offsetEnd) );
+		bx::memCopy(params.m_blendStart,  m_uniforms.m_blendStart,  sizeof(params.m_blendStart) );
+		bx::memCopy(params.m_blendEnd,    m_uniforms.m_blendEnd,    sizeof(params.m_blendEnd) );
+		bx::memCopy(params.m_scaleStart,  m_uniforms.m_scaleStart,  sizeof(params.m_scaleStart) );
+		bx::memCopy(params.m_scaleEnd,    m_uniforms.m_scaleEnd,    sizeof(params.m_scaleEnd) );
+		bx::memCopy(params.m_lifeSpan,    m_uniforms.m_lifeSpan,    sizeof(params.m_lifeSpan) );
+		params.m_unused[0] = 0.0f;
+		params.m_unused[1] = 0.0f;
+		bx::memCopy(params.m_mtx, mtx, sizeof(mtx) );
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_uniforms.m_rgba); ++ii)
+		{
+			const uint8_t* rgba = (const uint8_t*)&m_uniforms.m_rgba[ii];
+			params.m_rgba[ii][0] = rgba[0]/255.0f;
+			params.m_rgba[ii][1] = rgba[1]/255.0f;
+			params.m_rgba[ii][2] = rgba[2]/255.0f;
+			params.m_rgba[ii][3] = rgba[3]/255.0f;
+		}
+
+		const uint32_t current = m_gpu.m_current;
+		const uint32_t next    = current^1;
+
+		// Reset emit counter, and prepare update dispatch size from number
+		// of particles alive at the end of previous simulation.
+		bgfx::setUniform(s_ctx.u_psParams, &params, PS_GPU_NUM_PARAMS);
+		bgfx::setBuffer(0, m_gpu.m_counterBuffer,  bgfx::Access::ReadWrite);
+		bgfx::setBuffer(1, m_gpu.m_indirectBuffer, bgfx::Access::Write);
+		bgfx::dispatch(_view, s_ctx.m_gpuBegin);
+
+		bgfx::setUniform(s_ctx.u_psParams, &params, PS_GPU_NUM_PARAMS);
+		bgfx::setBuffer(0, m_gpu.m_particleBuffer[current], bgfx::Access::Read);
+		bgfx::setBuffer(1, m_gpu.m_particleBuffer[next],    bgfx::Access::Write);
+		bgfx::setBuffer(2, m_gpu.m_instanceBuffer,          bgfx::Access::Write);
+		bgfx::setBuffer(3, m_gpu.m_counterBuffer,           bgfx::Access::ReadWrite);
+		bgfx::setBuffer(4, m_gpu.m_easeBuffer,              bgfx::Access::Read);
+		bgfx::dispatch(_view, s_ctx.m_gpuUpdate, m_gpu.m_indirectBuffer, 0);
+
+		if (0 < numSpawn)
+		{
+			bgfx::setUniform(s_ctx.u_psParams, &params, PS_GPU_NUM_PARAMS);
+			bgfx::setBuffer(1, m_gpu.m_particleBuffer[next], bgfx::Access::Write);
+			bgfx::setBuffer(2, m_gpu.m_instanceBuffer,       bgfx::Access::Write);
+			bgfx::setBuffer(3, m_gpu.m_counterBuffer,        bgfx::Access::ReadWrite);
+			bgfx::setBuffer(4, m_gpu.m_easeBuffer,           bgfx::Access::Read);
+			bgfx::dispatch(_view, s_ctx.m_gpuEmit, uint16_t( (numSpawn + PS_GPU_GROUP_SIZE - 1)/PS_GPU_GROUP_SIZE) );
+		}
+
+		// Clamp alive count and write indirect draw arguments.
+		bgfx::setUniform(s_ctx.u_psParams, &params, PS_GPU_NUM_PARAMS);
+		bgfx::setBuffer(0, m_gpu.m_counterBuffer,  bgfx::Access::ReadWrite);
+		bgfx::setBuffer(1, m_gpu.m_indirectBuffer, bgfx::Access::Write);
+		bgfx::dispatch(_view, s_ctx.m_gpuEnd);
+
+		m_gpu.m_current  = next;
+		m_gpu.m_numSpawn = 0;
+		m_gpu.m_dt       = 0.0f;
+	}
+
+	void Emitter::calcAabbGpu()
+	{
+		// Particle positions are not read back, use conservative bounds
+		// around emitter instead.
+		const float startOffset = bx::fmax(bx::fabsolute(m_uniforms.m_offsetStart[0]), bx::fabsolute(m_uniforms.m_offsetStart[1]) );
+		const float endOffset   = bx::fmax(bx::fabsolute(m_uniforms.m_offsetEnd[0]),   bx::fabsolute(m_uniforms.m_offsetEnd[1]) );
+		const float scale       = bx::fmax(
+			  bx::fmax(bx::fabsolute(m_uniforms.m_scaleStart[0]), bx::fabsolute(m_uniforms.m_scaleStart[1]) )
+			, bx::fmax(bx::fabsolute(m_uniforms.m_scaleEnd[0]),   bx::fabsolute(m_uniforms.m_scaleEnd[1]) )
+			);
+		const float lifeSpan    = bx::fmax(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1]);
+		const float gravity     = 9.81f * m_uniforms.m_gravityScale * bx::fsq(lifeSpan);
+
+		// Rect shape spans [-1, 1] square, other shapes fit in unit sphere.
+		// Billboard corner is at most scale*sqrt(2) away from particle.
+		const float sqrt2  = 1.41421356f;
+		const float radius = sqrt2*startOffset + endOffset + sqrt2*scale;
+
+		for (uint32_t ii = 0; ii < 3; ++ii)
+		{
+			m_aabb.m_min[ii] = m_uniforms.m_position[ii] - radius;
+			m_aabb.m_max[ii] = m_uniforms.m_position[ii] + radius;
+		}
+
+		m_aabb.m_min[1] -= bx::fmax(gravity, 0.0f);
+		m_aabb.m_max[1] -= bx::fmin(gravity, 0.0f);
 	}
 
 } // namespace ps
 
 using namespace ps;
 
-void psInit(uint16_t _maxEmitters, bx::AllocatorI* _allocator)
+void psInit(uint16_t _maxEmitters, bx::AllocatorI* _allocator, uint32_t _numThreads)
 {
-	s_ctx.init(_maxEmitters, _allocator);
+	s_ctx.init(_maxEmitters, _allocator, _numThreads);
 }
 
 void psShutdown()
@@ -672,9 +1469,9 @@ void psShutdown()
 	s_ctx.shutdown();
 }
 
-EmitterHandle psCreateEmitter(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles)
+EmitterHandle psCreateEmitter(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles, bool _gpu)
 {
-	return s_ctx.createEmitter(_shape, _direction, _maxParticles);
+	return s_ctx.createEmitter(_shape, _direction, _maxParticles, _gpu);
 }
 
 void psUpdateEmitter(EmitterHandle _handle, const EmitterUniforms* _uniforms)
@@ -692,9 +1489,9 @@ void psDestroyEmitter(EmitterHandle _handle)
 	s_ctx.destroyEmitter(_handle);
 }
 
-void psUpdate(float _dt)
+uint32_t psUpdate(float _dt)
 {
-	s_ctx.update(_dt);
+	return s_ctx.update(_dt);
 }
 
 void psRender(uint8_t _view, const float* _mtxView, const float* _eye)
@@ -65,13 +65,16 @@ struct EmitterUniforms
 struct EmitterHandle { uint16_t idx; };
 
 ///
-void psInit(uint16_t _maxEmitters = 64, bx::AllocatorI* _allocator = NULL);
+void psInit(uint16_t _maxEmitters = 64, bx::AllocatorI* _allocator = NULL, uint32_t _numThreads = 1);
 
 ///
 void psShutdown();
 
-///
-EmitterHandle psCreateEmitter(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles);
+/// Create emitter. When _gpu is true particles are simulated with compute
+/// shaders and drawn unsorted with indirect draw. Emitter falls back to CPU
+/// path if renderer doesn't support compute and indirect draw, or compute
+/// shaders for renderer are not built (see gpu/makefile).
+EmitterHandle psCreateEmitter(EmitterShape::Enum _shape, EmitterDirection::Enum _direction, uint32_t _maxParticles, bool _gpu = false);
 
 ///
 void psUpdateEmitter(EmitterHandle _handle, const EmitterUniforms* _uniforms = NULL);
@@ -82,8 +85,9 @@ void psGetAabb(EmitterHandle _handle, Aabb& _outAabb);
 ///
 void psDestroyEmitter(EmitterHandle _handle);
 
-///
-void psUpdate(float _dt);
+/// Returns number of live particles. For GPU emitters count is estimated,
+/// alive count is not read back from GPU.
+uint32_t psUpdate(float _dt);
 
 ///
 void psRender(uint8_t _view, const float* _mtxView, const float* _eye);
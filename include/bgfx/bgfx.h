@@ -309,6 +309,7 @@ namespace bgfx
 			TriListToLineList,   //!< Convert triangle list to line list.
 			TriStripToTriList,   //!< Convert triangle strip to triangle list.
 			LineStripToLineList, //!< Convert line strip to line list.
+			TriListToTriListAdj, //!< Convert triangle list to triangle list with adjacency.
 
 			Count
 		};
@@ -340,6 +341,62 @@ namespace bgfx
 		};
 	};
 
+	/// Topology optimization.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_optimize_t`.
+	///
+	struct TopologyOptimize
+	{
+		/// Topology optimization functions:
+		enum Enum
+		{
+			VertexCache, //!< Reorder triangle list for post-transform vertex cache.
+			Overdraw,    //!< Reorder vertex cache optimized triangle list to reduce overdraw.
+
+			Count
+		};
+	};
+
+	/// Vertex cache statistics of triangle list.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_stats_t`.
+	///
+	struct TopologyStats
+	{
+		float acmr; //!< Average cache miss ratio, vertex transforms per triangle (0.5 - 3.0).
+		float atvr; //!< Average transform to vertex ratio, vertex transforms per referenced vertex (1.0 - 3.0).
+	};
+
+	/// Triangle cluster, with bounds for per cluster culling.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_cluster_t`.
+	///
+	struct TopologyCluster
+	{
+		uint32_t startIndex;  //!< First index of cluster in destination index buffer.
+		uint32_t numIndices;  //!< Number of cluster indices.
+		uint32_t numVertices; //!< Number of unique vertices referenced by cluster.
+		float sphere[4];      //!< Bounding sphere center (x, y, z) and radius (w).
+		float cone[4];        //!< Normal cone axis (x, y, z) and cutoff (w). Cluster
+		                      //!  is back facing when `dot(center - eye, axis) >=
+		                      //!  cutoff * length(center - eye) + radius`.
+	};
+
+	/// Triangle list edge, with planes of faces sharing it.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_edge_t`.
+	///
+	struct TopologyEdge
+	{
+		uint32_t i0;          //!< First vertex index, in winding order of first face.
+		uint32_t i1;          //!< Second vertex index.
+		uint32_t face[2];     //!< Faces sharing edge. First face has edge as i0, i1, and
+		                      //!  second face as i1, i0. Second face is UINT32_MAX for
+		                      //!  open edge.
+		float plane[2][4];    //!< Face planes, normal is `normalize(cross(v1 - v0, v2 - v0) )`
+		                      //!  and w is distance. Second plane is zero for open edge.
+	};
+
 	static const uint16_t invalidHandle = UINT16_MAX;
 
 	BGFX_HANDLE(DynamicIndexBufferHandle);
@@ -720,17 +777,262 @@ namespace bgfx
 		int64_t waitRender;     //!< Time spent waiting for render backend thread to finish issuing
 		                        //!  draw commands to underlying graphics API.
 		int64_t waitSubmit;     //!< Time spent waiting for submit thread to advance to next frame.
+		int64_t cpuTimeSort;    //!< Time spent sorting draw call keys, in CPU timer ticks.
 
 		uint32_t numDraw;       //!< Number of draw calls submitted.
 		uint32_t numCompute;    //!< Number of compute calls submitted.
 		uint32_t maxGpuLatency; //!< GPU driver latency.
 
+		uint64_t textureStreamingMemory; //!< Memory allocated for streaming textures, including allocated mips that are not resident.
+		uint32_t textureStreamingUpload; //!< Streaming texture bytes uploaded in last frame.
+		uint16_t numStreamingTextures;   //!< Number of streaming textures.
+		uint16_t numStreamingPending;    //!< Number of streaming textures waiting for requested mips.
+
+		uint32_t uniformUpdateBytes;     //!< Uniform bytes updated by renderer.
+		uint32_t uniformSkippedBytes;    //!< Uniform bytes skipped because value didn't change.
+
+		uint64_t dynamicIndexBufferSize;         //!< Total size of dynamic index buffer pages.
+		uint64_t dynamicIndexBufferUsed;         //!< Dynamic index buffer bytes in use.
+		uint32_t dynamicIndexBufferLargestFree;  //!< Largest free dynamic index buffer block.
+		uint64_t dynamicVertexBufferSize;        //!< Total size of dynamic vertex buffer pages.
+		uint64_t dynamicVertexBufferUsed;        //!< Dynamic vertex buffer bytes in use.
+		uint32_t dynamicVertexBufferLargestFree; //!< Largest free dynamic vertex buffer block.
+
+		uint32_t numDeferredCommands; //!< Resource commands waiting in backlog, see
+		                              //!  `BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME`.
+		uint32_t numDeferredDraws;    //!< Draw and compute calls skipped in last frame because
+		                              //!  they used resources still waiting in backlog.
+
 		uint16_t width;         //!< Backbuffer width in pixels.
 		uint16_t height;        //!< Backbuffer height in pixels.
 		uint16_t textWidth;     //!< Debug text width in characters.
 		uint16_t textHeight;    //!< Debug text height in characters.
 	};
 
+	/// Encoder is used to record draw and compute calls from threads other than
+	/// the API thread. Obtain encoder with `bgfx::begin`, and return it with
+	/// `bgfx::end` before `bgfx::frame` is called. Each encoder must be used by
+	/// one thread at a time.
+	///
+	/// Draw calls recorded with encoder are written into submitted frame in
+	/// batches, and remaining draw calls are written when `bgfx::end` is
+	/// called.
+	///
+	struct Encoder
+	{
+		/// Sets debug marker. See: `bgfx::setMarker`.
+		///
+		void setMarker(const char* _marker);
+
+		/// Set render states for draw primitive. See: `bgfx::setState`.
+		///
+		void setState(uint64_t _state, uint32_t _rgba = 0);
+
+		/// Set condition for rendering. See: `bgfx::setCondition`.
+		///
+		void setCondition(OcclusionQueryHandle _handle, bool _visible);
+
+		/// Set stencil test state. See: `bgfx::setStencil`.
+		///
+		void setStencil(uint32_t _fstencil, uint32_t _bstencil = BGFX_STENCIL_NONE);
+
+		/// Set scissor for draw primitive. See: `bgfx::setScissor`.
+		///
+		uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height);
+
+		/// Set scissor from cache for draw primitive. See: `bgfx::setScissor`.
+		///
+		void setScissor(uint16_t _cache = UINT16_MAX);
+
+		/// Set model matrix for draw primitive. See: `bgfx::setTransform`.
+		///
+		uint32_t setTransform(const void* _mtx, uint16_t _num = 1);
+
+		/// Reserve `_num` matrices in internal matrix cache. See:
+		/// `bgfx::allocTransform`.
+		///
+		/// @attention Pointer returned can be modified until `bgfx::end` is called.
+		///
+		uint32_t allocTransform(Transform* _transform, uint16_t _num);
+
+		/// Set model matrix from matrix cache for draw primitive. See:
+		/// `bgfx::setTransform`.
+		///
+		void setTransform(uint32_t _cache, uint16_t _num = 1);
+
+		/// Set shader uniform parameter for draw primitive. See:
+		/// `bgfx::setUniform`.
+		///
+		void setUniform(UniformHandle _handle, const void* _value, uint16_t _num = 1);
+
+		/// Set index buffer for draw primitive. See: `bgfx::setIndexBuffer`.
+		///
+		void setIndexBuffer(IndexBufferHandle _handle);
+
+		/// Set index buffer for draw primitive. See: `bgfx::setIndexBuffer`.
+		///
+		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices);
+
+		/// Set index buffer for draw primitive. See: `bgfx::setIndexBuffer`.
+		///
+		void setIndexBuffer(DynamicIndexBufferHandle _handle);
+
+		/// Set index buffer for draw primitive. See: `bgfx::setIndexBuffer`.
+		///
+		void setIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices);
+
+		/// Set index buffer for draw primitive. See: `bgfx::setIndexBuffer`.
+		///
+		void setIndexBuffer(const TransientIndexBuffer* _tib);
+
+		/// Set index buffer for draw primitive. See: `bgfx::setIndexBuffer`.
+		///
+		void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices);
+
+		/// Set vertex buffer for draw primitive. See: `bgfx::setVertexBuffer`.
+		///
+		void setVertexBuffer(VertexBufferHandle _handle);
+
+		/// Set vertex buffer for draw primitive. See: `bgfx::setVertexBuffer`.
+		///
+		void setVertexBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices);
+
+		/// Set vertex buffer for draw primitive. See: `bgfx::setVertexBuffer`.
+		///
+		void setVertexBuffer(DynamicVertexBufferHandle _handle);
+
+		/// Set vertex buffer for draw primitive. See: `bgfx::setVertexBuffer`.
+		///
+		void setVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices);
+
+		/// Set vertex buffer for draw primitive. See: `bgfx::setVertexBuffer`.
+		///
+		void setVertexBuffer(const TransientVertexBuffer* _tvb);
+
+		/// Set vertex buffer for draw primitive. See: `bgfx::setVertexBuffer`.
+		///
+		void setVertexBuffer(const TransientVertexBuffer* _tvb, uint32_t _startVertex, uint32_t _numVertices);
+
+		/// Set instance data buffer for draw primitive. See:
+		/// `bgfx::setInstanceDataBuffer`.
+		///
+		void setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _num = UINT32_MAX);
+
+		/// Set instance data buffer for draw primitive. See:
+		/// `bgfx::setInstanceDataBuffer`.
+		///
+		void setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num);
+
+		/// Set instance data buffer for draw primitive. See:
+		/// `bgfx::setInstanceDataBuffer`.
+		///
+		void setInstanceDataBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num);
+
+		/// Set texture stage for draw primitive. See: `bgfx::setTexture`.
+		///
+		void setTexture(
+			  uint8_t _stage
+			, UniformHandle _sampler
+			, TextureHandle _handle
+			, uint32_t _flags = UINT32_MAX
+			);
+
+		/// Submit an empty primitive for rendering. See: `bgfx::touch`.
+		///
+		uint32_t touch(uint8_t _id);
+
+		/// Submit primitive for rendering. See: `bgfx::submit`.
+		///
+		uint32_t submit(
+			  uint8_t _id
+			, ProgramHandle _program
+			, int32_t _depth = 0
+			, bool _preserveState = false
+			);
+
+		/// Submit primitive with occlusion query for rendering. See:
+		/// `bgfx::submit`.
+		///
+		uint32_t submit(
+			  uint8_t _id
+			, ProgramHandle _program
+			, OcclusionQueryHandle _occlusionQuery
+			, int32_t _depth = 0
+			, bool _preserveState = false
+			);
+
+		/// Submit primitive for rendering with index and instance data info
+		/// from indirect buffer. See: `bgfx::submit`.
+		///
+		uint32_t submit(
+			  uint8_t _id
+			, ProgramHandle _program
+			, IndirectBufferHandle _indirectHandle
+			, uint16_t _start = 0
+			, uint16_t _num = 1
+			, int32_t _depth = 0
+			, bool _preserveState = false
+			);
+
+		/// Set compute index buffer. See: `bgfx::setBuffer`.
+		///
+		void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access);
+
+		/// Set compute vertex buffer. See: `bgfx::setBuffer`.
+		///
+		void setBuffer(uint8_t _stage, VertexBufferHandle _handle, Access::Enum _access);
+
+		/// Set compute dynamic index buffer. See: `bgfx::setBuffer`.
+		///
+		void setBuffer(uint8_t _stage, DynamicIndexBufferHandle _handle, Access::Enum _access);
+
+		/// Set compute dynamic vertex buffer. See: `bgfx::setBuffer`.
+		///
+		void setBuffer(uint8_t _stage, DynamicVertexBufferHandle _handle, Access::Enum _access);
+
+		/// Set compute indirect buffer. See: `bgfx::setBuffer`.
+		///
+		void setBuffer(uint8_t _stage, IndirectBufferHandle _handle, Access::Enum _access);
+
+		/// Set compute image from texture. See: `bgfx::setImage`.
+		///
+		void setImage(
+			  uint8_t _stage
+			, UniformHandle _sampler
+			, TextureHandle _handle
+			, uint8_t _mip
+			, Access::Enum _access
+			, TextureFormat::Enum _format = TextureFormat::Count
+			);
+
+		/// Dispatch compute. See: `bgfx::dispatch`.
+		///
+		uint32_t dispatch(
+			  uint8_t _id
+			, ProgramHandle _handle
+			, uint16_t _numX = 1
+			, uint16_t _numY = 1
+			, uint16_t _numZ = 1
+			, uint8_t _flags = BGFX_SUBMIT_EYE_FIRST
+			);
+
+		/// Dispatch compute indirect. See: `bgfx::dispatch`.
+		///
+		uint32_t dispatch(
+			  uint8_t _id
+			, ProgramHandle _handle
+			, IndirectBufferHandle _indirectHandle
+			, uint16_t _start = 0
+			, uint16_t _num = 1
+			, uint8_t _flags = BGFX_SUBMIT_EYE_FIRST
+			);
+
+		/// Discard all previously set state for draw or compute call. See:
+		/// `bgfx::discard`.
+		///
+		void discard();
+	};
+
 	/// Vertex declaration.
 	///
 	/// @attention C99 equivalent is `bgfx_vertex_decl_t`.
@@ -838,6 +1140,48 @@ namespace bgfx
 		, uint32_t _index = 0
 		);
 
+	/// Pack array of vec4 into vertex stream format.
+	///
+	/// @param[in] _input Array of `_num` vec4 values.
+	/// @param[in] _inputNormalized Input values are normalized.
+	/// @param[in] _attr Attribute to pack.
+	/// @param[in] _decl Vertex stream declaration.
+	/// @param[in] _data Vertex stream.
+	/// @param[in] _num Number of vertices to pack.
+	/// @param[in] _index Index of first vertex to pack.
+	///
+	/// @attention C99 equivalent is `bgfx_vertex_pack_n`.
+	///
+	void vertexPackN(
+		  const float* _input
+		, bool _inputNormalized
+		, Attrib::Enum _attr
+		, const VertexDecl& _decl
+		, void* _data
+		, uint32_t _num
+		, uint32_t _index = 0
+		);
+
+	/// Unpack array of vec4 from vertex stream format.
+	///
+	/// @param[out] _output Array of `_num` vec4 values.
+	/// @param[in] _attr Attribute to unpack.
+	/// @param[in] _decl Vertex stream declaration.
+	/// @param[in] _data Vertex stream.
+	/// @param[in] _num Number of vertices to unpack.
+	/// @param[in] _index Index of first vertex to unpack.
+	///
+	/// @attention C99 equivalent is `bgfx_vertex_unpack_n`.
+	///
+	void vertexUnpackN(
+		  float* _output
+		, Attrib::Enum _attr
+		, const VertexDecl& _decl
+		, const void* _data
+		, uint32_t _num
+		, uint32_t _index = 0
+		);
+
 	/// Converts vertex stream data from one vertex stream format to another.
 	///
 	/// @param[in] _destDecl Destination vertex stream declaration.
@@ -876,6 +1220,28 @@ namespace bgfx
 		, float _epsilon = 0.001f
 		);
 
+	/// Weld vertices.
+	///
+	/// @param[in] _output Welded vertices remapping table. The size of buffer
+	///   must be the same as number of vertices.
+	/// @param[in] _decl Vertex stream declaration.
+	/// @param[in] _data Vertex stream.
+	/// @param[in] _num Number of vertices in vertex stream.
+	/// @param[in] _epsilon Error tolerance for vertex position comparison.
+	/// @param[in] _flags Weld flags, see `BGFX_WELD_*`.
+	/// @returns Number of unique vertices after vertex welding.
+	///
+	/// @attention C99 equivalent is `bgfx_weld_vertices32`.
+	///
+	uint32_t weldVertices(
+		  uint32_t* _output
+		, const VertexDecl& _decl
+		, const void* _data
+		, uint32_t _num
+		, float _epsilon = 0.001f
+		, uint8_t _flags = BGFX_WELD_NONE
+		);
+
 	/// Convert index buffer for use with different primitive topologies.
 	///
 	/// @param[in] _conversion Conversion type, see `TopologyConvert::Enum`.
@@ -933,6 +1299,242 @@ namespace bgfx
 		, bool _index32
 		);
 
+	/// Sort indices, reusing triangle order from previous call. Intended
+	/// for sorting the same mesh every frame, when order changes only a
+	/// little between frames. Previous order is refined with insertion sort,
+	/// and when it's too far from sorted full sort is used instead.
+	///
+	/// @param[in] _sort Sort order, see `TopologySort::Enum`.
+	/// @param[in] _dst Index buffer.
+	/// @param[in] _dstSize Index buffer size.
+	/// @param[in] _dir Direction (vector must be normalized).
+	/// @param[in] _pos Position.
+	/// @param[in] _vertices Pointer to first vertex represented as
+	///    float x, y, z. Must contain at least number of vertices
+	///    referencende by index buffer.
+	/// @param[in] _stride Vertex stride.
+	/// @param[in] _indices Source indices.
+	/// @param[in] _numIndices Number of input indices.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	/// @param[in, out] _order Triangle order from previous call, one element
+	///    per triangle. Set first element to UINT32_MAX before first call, or
+	///    when mesh changes, to force full sort.
+	/// @param[in] _multithreaded Calculate sort keys of large meshes on
+	///    multiple threads.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_sort_tri_list_coherent`.
+	///
+	void topologySortTriListCoherent(
+		  TopologySort::Enum _sort
+		, void* _dst
+		, uint32_t _dstSize
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, uint32_t* _order
+		, bool _multithreaded = false
+		);
+
+	/// Optimize triangle list.
+	///
+	/// @param[in] _optimize Optimization, see `TopologyOptimize::Enum`.
+	///   `TopologyOptimize::Overdraw` expects triangle list already optimized
+	///   with `TopologyOptimize::VertexCache`.
+	/// @param[in] _dst Destination index buffer. If this argument it NULL
+	///    function will return number of indices after optimization. It can
+	///    point to the same memory as `_indices`.
+	/// @param[in] _dstSize Destination index buffer in bytes. If destination
+	///    size is insufficient index buffer will be truncated.
+	/// @param[in] _vertices Pointer to first vertex represented as
+	///    float x, y, z. Only used by `TopologyOptimize::Overdraw`, otherwise
+	///    it can be NULL.
+	/// @param[in] _numVertices Number of vertices referenced by index buffer.
+	/// @param[in] _stride Vertex stride.
+	/// @param[in] _indices Source indices.
+	/// @param[in] _numIndices Number of input indices.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	///
+	/// @returns Number of output indices.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_optimize`.
+	///
+	uint32_t topologyOptimize(
+		  TopologyOptimize::Enum _optimize
+		, void* _dst
+		, uint32_t _dstSize
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		);
+
+	/// Reorder vertices in order of first use by triangle list, to improve
+	/// vertex fetch locality. Vertices not referenced by index buffer are
+	/// removed.
+	///
+	/// @param[in] _dst Destination vertex buffer. Must not overlap with
+	///    `_vertices`. If this argument it NULL function will return number
+	///    of vertices after optimization.
+	/// @param[in] _dstSize Destination vertex buffer in bytes.
+	/// @param[in] _vertices Source vertices.
+	/// @param[in] _numVertices Number of source vertices.
+	/// @param[in] _stride Vertex stride.
+	/// @param[in, out] _indices Indices, remapped in place to destination
+	///    vertex buffer.
+	/// @param[in] _numIndices Number of indices.
+	/// @param[in] _index32 Set to `true` if indices are 32-bit.
+	///
+	/// @returns Number of output vertices, or 0 if destination vertex buffer
+	///    is too small.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_optimize_vertex_fetch`.
+	///
+	uint32_t topologyOptimizeVertexFetch(
+		  void* _dst
+		, uint32_t _dstSize
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		);
+
+	/// Calculate vertex cache statistics of triangle list, by simulating
+	/// FIFO post-transform vertex cache.
+	///
+	/// @param[out] _stats Vertex cache statistics.
+	/// @param[in] _cacheSize Number of vertices in simulated cache.
+	/// @param[in] _indices Indices.
+	/// @param[in] _numIndices Number of indices.
+	/// @param[in] _numVertices Number of vertices referenced by index buffer.
+	/// @param[in] _index32 Set to `true` if indices are 32-bit.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_calc_stats`.
+	///
+	void topologyCalcStats(
+		  TopologyStats* _stats
+		, uint32_t _cacheSize
+		, const void* _indices
+		, uint32_t _numIndices
+		, uint32_t _numVertices
+		, bool _index32
+		);
+
+	/// Split triangle list into clusters of spatially close triangles with
+	/// bounding sphere and normal cone, for culling at finer granularity
+	/// than whole draw call. Works best on triangle list optimized with
+	/// `TopologyOptimize::VertexCache`.
+	///
+	/// @param[out] _clusters Destination clusters. If this argument is NULL
+	///    function will return number of clusters.
+	/// @param[in] _maxClusters Maximum number of clusters written to
+	///    `_clusters`.
+	/// @param[in] _dst Destination index buffer, triangles are reordered so
+	///    that each cluster is continuous range. It can point to the same
+	///    memory as `_indices`.
+	/// @param[in] _dstSize Destination index buffer in bytes.
+	/// @param[in] _maxTriangles Maximum number of triangles per cluster.
+	/// @param[in] _maxVertices Maximum number of unique vertices per cluster.
+	/// @param[in] _vertices Pointer to first vertex represented as
+	///    float x, y, z.
+	/// @param[in] _numVertices Number of vertices referenced by index buffer.
+	/// @param[in] _stride Vertex stride.
+	/// @param[in] _indices Source indices.
+	/// @param[in] _numIndices Number of input indices.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	///
+	/// @returns Number of clusters.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_build_clusters`.
+	///
+	uint32_t topologyBuildClusters(
+		  TopologyCluster* _clusters
+		, uint32_t _maxClusters
+		, void* _dst
+		, uint32_t _dstSize
+		, uint32_t _maxTriangles
+		, uint32_t _maxVertices
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		);
+
+	/// Build table of unique triangle list edges with planes of adjacent
+	/// faces, for silhouette detection (shadow volumes, outlines). Edges
+	/// are matched by index, weld vertices first if mesh has seams.
+	///
+	/// @param[out] _edges Destination edges. If this argument is NULL
+	///    function will return number of edges.
+	/// @param[in] _maxEdges Maximum number of edges written to `_edges`.
+	/// @param[in] _vertices Pointer to first vertex represented as
+	///    float x, y, z.
+	/// @param[in] _stride Vertex stride.
+	/// @param[in] _indices Source indices.
+	/// @param[in] _numIndices Number of input indices.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	///
+	/// @returns Number of edges.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_build_edges`.
+	///
+	uint32_t topologyBuildEdges(
+		  TopologyEdge* _edges
+		, uint32_t _maxEdges
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		);
+
+	/// Reduce number of triangles by collapsing edges with the lowest
+	/// quadric error, for generating mesh level of detail. Vertices are
+	/// never moved or created, each collapse merges vertex into one of its
+	/// neighbours, so output indices reference the same vertex buffer.
+	/// Open borders and attribute seams are preserved.
+	///
+	/// @param[in] _dst Destination index buffer. If this argument is NULL
+	///    function will return number of indices after simplification.
+	///    It can point to the same memory as `_indices`.
+	/// @param[in] _dstSize Destination index buffer in bytes.
+	/// @param[in] _numTargetIndices Target number of indices.
+	/// @param[in] _maxError Maximum allowed distance from original surface,
+	///    in units of vertex position. Simplification stops before reaching
+	///    `_numTargetIndices` if any further collapse exceeds this error.
+	/// @param[in] _decl Vertex declaration, must contain position.
+	/// @param[in] _vertices Vertex data.
+	/// @param[in] _numVertices Number of vertices referenced by index buffer.
+	/// @param[in] _indices Source indices.
+	/// @param[in] _numIndices Number of input indices.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	///
+	/// @returns Number of output indices.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_simplify`.
+	///
+	uint32_t topologySimplify(
+		  void* _dst
+		, uint32_t _dstSize
+		, uint32_t _numTargetIndices
+		, float _maxError
+		, const VertexDecl& _decl
+		, const void* _vertices
+		, uint32_t _numVertices
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		);
+
 	/// Swizzle RGBA8 image to BGRA8.
 	///
 	/// @param[in] _dst Destination image. Must be the same size as input image.
@@ -1071,6 +1673,24 @@ namespace bgfx
 	///
 	uint32_t frame(bool _capture = false);
 
+	/// Begin submitting draw calls from thread other than API thread.
+	///
+	/// @returns Encoder, or NULL if all encoders are in use. Maximum number
+	///   of encoders is `BGFX_CONFIG_MAX_ENCODERS` minus one, since one
+	///   encoder is reserved for the API thread.
+	///
+	/// @remarks
+	///   Returned encoder must be ended with `bgfx::end` before `bgfx::frame`
+	///   is called.
+	///
+	Encoder* begin();
+
+	/// End submitting draw calls from thread.
+	///
+	/// @param[in] _encoder Encoder obtained with `bgfx::begin`.
+	///
+	void end(Encoder* _encoder);
+
 	/// Returns current renderer backend API type.
 	///
 	/// @remarks
@@ -1862,6 +2482,58 @@ namespace bgfx
 	///
 	void destroyTexture(TextureHandle _handle);
 
+	/// Create streaming texture from memory buffer. Only `_numResidentMips`
+	/// smallest mips are uploaded on creation, higher mips are uploaded on
+	/// request with `bgfx::requestTextureMips` from `bgfx::frame`, within
+	/// upload and memory budget set with `bgfx::setTextureStreamingBudget`.
+	///
+	/// @param[in] _mem DDS, KTX or PVR texture data. Memory is kept alive
+	///   until texture is destroyed.
+	/// @param[in] _flags Texture flags. See: `bgfx::createTexture`.
+	/// @param[in] _numResidentMips Number of mips resident on creation.
+	/// @param[out] _info When non-`NULL` is specified it returns parsed texture information.
+	/// @returns Texture handle.
+	///
+	/// @remarks
+	///   Only 2D textures with full mip chain can be streamed, other textures
+	///   are created as if `bgfx::createTexture` was called.
+	///
+	/// @attention When `BGFX_CAPS_TEXTURE_MIN_LOD` is supported, streaming
+	///   texture is created with full mip chain and sampling is clamped to
+	///   resident mips, until it's resized when evicted over memory cap.
+	///   Otherwise, or after eviction, mip 0 of streaming texture is top
+	///   resident mip.
+	/// @attention C99 equivalent is `bgfx_create_streaming_texture`.
+	///
+	TextureHandle createStreamingTexture(
+		  const Memory* _mem
+		, uint32_t _flags = BGFX_TEXTURE_NONE
+		, uint8_t _numResidentMips = 1
+		, TextureInfo* _info = NULL
+		);
+
+	/// Request number of resident mips for streaming texture. Requesting less
+	/// mips than currently resident releases top mips.
+	///
+	/// @param[in] _handle Streaming texture handle.
+	/// @param[in] _numMips Number of requested resident mips.
+	///
+	/// @attention C99 equivalent is `bgfx_request_texture_mips`.
+	///
+	void requestTextureMips(TextureHandle _handle, uint8_t _numMips);
+
+	/// Set texture streaming budget.
+	///
+	/// @param[in] _uploadBytesPerFrame Maximum number of bytes uploaded per
+	///   frame. At least one mip step is uploaded each frame.
+	/// @param[in] _memoryCap Maximum memory allocated for streaming textures.
+	///   When over cap, storage of largest textures is shrunk, first to
+	///   resident mips, then by evicting top mips.
+	///
+	/// @attention C99 equivalent is `bgfx_set_texture_streaming_budget`.
+	///
+	void setTextureStreamingBudget(uint32_t _uploadBytesPerFrame, uint64_t _memoryCap);
+
 	/// Create frame buffer (simple).
 	///
 	/// @param[in] _width Texture width.
@@ -2249,6 +2921,39 @@ namespace bgfx
 	///
 	void setViewOrder(uint8_t _id = 0, uint8_t _num = UINT8_MAX, const void* _remap = NULL);
 
+	/// Set view uniform value. View uniforms are applied once when view
+	/// starts rendering, instead of being replayed for each draw call.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _handle Uniform.
+	/// @param[in] _value Pointer to uniform data.
+	/// @param[in] _num Number of elements. Passing `UINT16_MAX` will
+	///   use the _num passed on uniform creation.
+	///
+	/// @remarks
+	///   Not persistent, view uniforms must be set each frame. Uniform set
+	///   with `bgfx::setUniform` overrides view uniform value for remaining
+	///   draw calls in view.
+	///
+	/// @attention C99 equivalent is `bgfx_set_view_uniform`.
+	///
+	void setViewUniform(uint8_t _id, UniformHandle _handle, const void* _value, uint16_t _num = 1);
+
+	/// Set frame uniform value. Frame uniforms are applied when each view
+	/// starts rendering, before view uniforms.
+	///
+	/// @param[in] _handle Uniform.
+	/// @param[in] _value Pointer to uniform data.
+	/// @param[in] _num Number of elements. Passing `UINT16_MAX` will
+	///   use the _num passed on uniform creation.
+	///
+	/// @remarks
+	///   Not persistent, frame uniforms must be set each frame.
+	///
+	/// @attention C99 equivalent is `bgfx_set_frame_uniform`.
+	///
+	void setFrameUniform(UniformHandle _handle, const void* _value, uint16_t _num = 1);
+
 	/// Reset all view settings to default.
 	///
 	/// @param[in] _id View id.
@@ -2550,7 +3255,8 @@ namespace bgfx
 	/// These empty draw calls will sort before ordinary draw calls.
 	///
 	/// @param[in] _id View id.
-	/// @returns Number of draw calls.
+	/// @returns Index of draw call in frame, or `UINT32_MAX` if draw call
+	///   was discarded or dropped.
 	///
 	uint32_t touch(uint8_t _id);
 
@@ -2561,7 +3267,8 @@ namespace bgfx
 	/// @param[in] _depth Depth for sorting.
 	/// @param[in] _preserveState Preserve internal draw state for next draw
 	///   call submit.
-	/// @returns Number of draw calls.
+	/// @returns Index of draw call in frame, or `UINT32_MAX` if draw call
+	///   was discarded or dropped.
 	///
 	/// @attention C99 equivalent is `bgfx_submit`.
 	///
@@ -2580,7 +3287,8 @@ namespace bgfx
 	/// @param[in] _depth Depth for sorting.
 	/// @param[in] _preserveState Preserve internal draw state for next draw
 	///   call submit.
-	/// @returns Number of draw calls.
+	/// @returns Index of draw call in frame, or `UINT32_MAX` if draw call
+	///   was discarded or dropped.
 	///
 	/// @attention C99 equivalent is `bgfx_submit_occlusion_query`.
 	///
@@ -2603,7 +3311,8 @@ namespace bgfx
 	/// @param[in] _depth Depth for sorting.
 	/// @param[in] _preserveState Preserve internal draw state for next draw
 	///   call submit.
-	/// @returns Number of draw calls.
+	/// @returns Index of draw call in frame, or `UINT32_MAX` if draw call
+	///   was discarded or dropped.
 	///
 	/// @attention C99 equivalent is `bgfx_submit_indirect`.
 	///
@@ -2698,6 +3407,8 @@ namespace bgfx
 	///   - `BGFX_VIEW_NONE` - View will be rendered only once if stereo mode is enabled.
 	///   - `BGFX_VIEW_STEREO` - View will be rendered for both eyes if stereo mode is enabled. When
 	///     stereo mode is disabled this flag doesn't have effect.
+	/// @returns Index of compute call in frame, or `UINT32_MAX` if compute
+	///   call was discarded or dropped.
 	///
 	/// @attention C99 equivalent is `bgfx_dispatch`.
 	///
@@ -2721,6 +3432,8 @@ namespace bgfx
 	///   - `BGFX_VIEW_NONE` - View will be rendered only once if stereo mode is enabled.
 	///   - `BGFX_VIEW_STEREO` - View will be rendered for both eyes if stereo mode is enabled. When
 	///     stereo mode is disabled this flag doesn't have effect.
+	/// @returns Index of compute call in frame, or `UINT32_MAX` if compute
+	///   call was discarded or dropped.
 	///
 	/// @attention C99 equivalent is `bgfx_dispatch_indirect`.
 	///
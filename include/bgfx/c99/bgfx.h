@@ -231,6 +231,7 @@ typedef enum bgfx_topology_convert
     BGFX_TOPOLOGY_CONVERT_TRI_LIST_TO_LINE_LIST,
     BGFX_TOPOLOGY_CONVERT_TRI_STRIP_TO_TRI_LIST,
     BGFX_TOPOLOGY_CONVERT_LINE_STRIP_TO_LINE_LIST,
+    BGFX_TOPOLOGY_CONVERT_TRI_LIST_TO_TRI_LIST_ADJ,
 
     BGFX_TOPOLOGY_CONVERT_COUNT
 
@@ -255,6 +256,41 @@ typedef enum bgfx_topology_sort
 
 } bgfx_topology_sort_t;
 
+typedef enum bgfx_topology_optimize
+{
+    BGFX_TOPOLOGY_OPTIMIZE_VERTEX_CACHE,
+    BGFX_TOPOLOGY_OPTIMIZE_OVERDRAW,
+
+    BGFX_TOPOLOGY_OPTIMIZE_COUNT
+
+} bgfx_topology_optimize_t;
+
+typedef struct bgfx_topology_stats
+{
+    float acmr;
+    float atvr;
+
+} bgfx_topology_stats_t;
+
+typedef struct bgfx_topology_cluster
+{
+    uint32_t startIndex;
+    uint32_t numIndices;
+    uint32_t numVertices;
+    float sphere[4];
+    float cone[4];
+
+} bgfx_topology_cluster_t;
+
+typedef struct bgfx_topology_edge
+{
+    uint32_t i0;
+    uint32_t i1;
+    uint32_t face[2];
+    float plane[2][4];
+
+} bgfx_topology_edge_t;
+
 #define BGFX_HANDLE_T(_name) \
     typedef struct _name { uint16_t idx; } _name##_t
 
@@ -329,11 +365,30 @@ typedef struct bgfx_stats
 
     int64_t waitRender;
     int64_t waitSubmit;
+    int64_t cpuTimeSort;
 
     uint32_t numDraw;
     uint32_t numCompute;
     uint32_t maxGpuLatency;
 
+    uint64_t textureStreamingMemory;
+    uint32_t textureStreamingUpload;
+    uint16_t numStreamingTextures;
+    uint16_t numStreamingPending;
+
+    uint32_t uniformUpdateBytes;
+    uint32_t uniformSkippedBytes;
+
+    uint64_t dynamicIndexBufferSize;
+    uint64_t dynamicIndexBufferUsed;
+    uint32_t dynamicIndexBufferLargestFree;
+    uint64_t dynamicVertexBufferSize;
+    uint64_t dynamicVertexBufferUsed;
+    uint32_t dynamicVertexBufferLargestFree;
+
+    uint32_t numDeferredCommands;
+    uint32_t numDeferredDraws;
+
     uint16_t width;
     uint16_t height;
     uint16_t textWidth;
@@ -536,18 +591,48 @@ BGFX_C_API void bgfx_vertex_pack(const float _input[4], bool _inputNormalized, b
 /**/
 BGFX_C_API void bgfx_vertex_unpack(float _output[4], bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _index);
 
+/**/
+BGFX_C_API void bgfx_vertex_pack_n(const float* _input, bool _inputNormalized, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, void* _data, uint32_t _num, uint32_t _index);
+
+/**/
+BGFX_C_API void bgfx_vertex_unpack_n(float* _output, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _num, uint32_t _index);
+
 /**/
 BGFX_C_API void bgfx_vertex_convert(const bgfx_vertex_decl_t* _destDecl, void* _destData, const bgfx_vertex_decl_t* _srcDecl, const void* _srcData, uint32_t _num);
 
 /**/
 BGFX_C_API uint16_t bgfx_weld_vertices(uint16_t* _output, const bgfx_vertex_decl_t* _decl, const void* _data, uint16_t _num, float _epsilon);
 
+/**/
+BGFX_C_API uint32_t bgfx_weld_vertices32(uint32_t* _output, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _num, float _epsilon, uint8_t _flags);
+
 /**/
 BGFX_C_API uint32_t bgfx_topology_convert(bgfx_topology_convert_t _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32);
 
 /**/
 BGFX_C_API void bgfx_topology_sort_tri_list(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
 
+/**/
+BGFX_C_API void bgfx_topology_sort_tri_list_coherent(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, uint32_t* _order, bool _multithreaded);
+
+/**/
+BGFX_C_API uint32_t bgfx_topology_optimize(bgfx_topology_optimize_t _optimize, void* _dst, uint32_t _dstSize, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+
+/**/
+BGFX_C_API uint32_t bgfx_topology_optimize_vertex_fetch(void* _dst, uint32_t _dstSize, const void* _vertices, uint32_t _numVertices, uint32_t _stride, void* _indices, uint32_t _numIndices, bool _index32);
+
+/**/
+BGFX_C_API void bgfx_topology_calc_stats(bgfx_topology_stats_t* _stats, uint32_t _cacheSize, const void* _indices, uint32_t _numIndices, uint32_t _numVertices, bool _index32);
+
+/**/
+BGFX_C_API uint32_t bgfx_topology_build_clusters(bgfx_topology_cluster_t* _clusters, uint32_t _maxClusters, void* _dst, uint32_t _dstSize, uint32_t _maxTriangles, uint32_t _maxVertices, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+
+/**/
+BGFX_C_API uint32_t bgfx_topology_build_edges(bgfx_topology_edge_t* _edges, uint32_t _maxEdges, const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+
+/**/
+BGFX_C_API uint32_t bgfx_topology_simplify(void* _dst, uint32_t _dstSize, uint32_t _numTargetIndices, float _maxError, const bgfx_vertex_decl_t* _decl, const void* _vertices, uint32_t _numVertices, const void* _indices, uint32_t _numIndices, bool _index32);
+
 /**/
 BGFX_C_API void bgfx_image_swizzle_bgra8(void* _dst, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src);
 
@@ -731,6 +816,15 @@ BGFX_C_API uint32_t bgfx_read_texture(bgfx_texture_handle_t _handle, void* _data
 /**/
 BGFX_C_API void bgfx_destroy_texture(bgfx_texture_handle_t _handle);
 
+/**/
+BGFX_C_API bgfx_texture_handle_t bgfx_create_streaming_texture(const bgfx_memory_t* _mem, uint32_t _flags, uint8_t _numResidentMips, bgfx_texture_info_t* _info);
+
+/**/
+BGFX_C_API void bgfx_request_texture_mips(bgfx_texture_handle_t _handle, uint8_t _numMips);
+
+/**/
+BGFX_C_API void bgfx_set_texture_streaming_budget(uint32_t _uploadBytesPerFrame, uint64_t _memoryCap);
+
 /**/
 BGFX_C_API bgfx_frame_buffer_handle_t bgfx_create_frame_buffer(uint16_t _width, uint16_t _height, bgfx_texture_format_t _format, uint32_t _textureFlags);
 
@@ -803,6 +897,12 @@ BGFX_C_API void bgfx_set_view_transform_stereo(uint8_t _id, const void* _view, c
 /**/
 BGFX_C_API void bgfx_set_view_order(uint8_t _id, uint8_t _num, const void* _order);
 
+/**/
+BGFX_C_API void bgfx_set_view_uniform(uint8_t _id, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+
+/**/
+BGFX_C_API void bgfx_set_frame_uniform(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+
 /**/
 BGFX_C_API void bgfx_reset_view(uint8_t _id);
 
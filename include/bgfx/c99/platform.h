@@ -76,10 +76,20 @@ typedef struct bgfx_interface_vtbl
     void (*vertex_decl_end)(bgfx_vertex_decl_t* _decl);
     void (*vertex_pack)(const float _input[4], bool _inputNormalized, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, void* _data, uint32_t _index);
     void (*vertex_unpack)(float _output[4], bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _index);
+    void (*vertex_pack_n)(const float* _input, bool _inputNormalized, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, void* _data, uint32_t _num, uint32_t _index);
+    void (*vertex_unpack_n)(float* _output, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _num, uint32_t _index);
     void (*vertex_convert)(const bgfx_vertex_decl_t* _destDecl, void* _destData, const bgfx_vertex_decl_t* _srcDecl, const void* _srcData, uint32_t _num);
     uint16_t (*weld_vertices)(uint16_t* _output, const bgfx_vertex_decl_t* _decl, const void* _data, uint16_t _num, float _epsilon);
+    uint32_t (*weld_vertices32)(uint32_t* _output, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _num, float _epsilon, uint8_t _flags);
     uint32_t (*topology_convert)(bgfx_topology_convert_t _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32);
     void (*topology_sort_tri_list)(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+    void (*topology_sort_tri_list_coherent)(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, uint32_t* _order, bool _multithreaded);
+    uint32_t (*topology_optimize)(bgfx_topology_optimize_t _optimize, void* _dst, uint32_t _dstSize, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+    uint32_t (*topology_optimize_vertex_fetch)(void* _dst, uint32_t _dstSize, const void* _vertices, uint32_t _numVertices, uint32_t _stride, void* _indices, uint32_t _numIndices, bool _index32);
+    void (*topology_calc_stats)(bgfx_topology_stats_t* _stats, uint32_t _cacheSize, const void* _indices, uint32_t _numIndices, uint32_t _numVertices, bool _index32);
+    uint32_t (*topology_build_clusters)(bgfx_topology_cluster_t* _clusters, uint32_t _maxClusters, void* _dst, uint32_t _dstSize, uint32_t _maxTriangles, uint32_t _maxVertices, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+    uint32_t (*topology_build_edges)(bgfx_topology_edge_t* _edges, uint32_t _maxEdges, const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+    uint32_t (*topology_simplify)(void* _dst, uint32_t _dstSize, uint32_t _numTargetIndices, float _maxError, const bgfx_vertex_decl_t* _decl, const void* _vertices, uint32_t _numVertices, const void* _indices, uint32_t _numIndices, bool _index32);
     void (*image_swizzle_bgra8)(void* _dst, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src);
     void (*image_rgba8_downsample_2x2)(void* _dst, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src);
     uint8_t (*get_supported_renderers)(uint8_t _max, bgfx_renderer_type_t* _enum);
@@ -140,6 +150,9 @@ typedef struct bgfx_interface_vtbl
     void (*update_texture_cube)(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _side, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
     uint32_t (*read_texture)(bgfx_texture_handle_t _handle, void* _data, uint8_t _mip);
     void (*destroy_texture)(bgfx_texture_handle_t _handle);
+    bgfx_texture_handle_t (*create_streaming_texture)(const bgfx_memory_t* _mem, uint32_t _flags, uint8_t _numResidentMips, bgfx_texture_info_t* _info);
+    void (*request_texture_mips)(bgfx_texture_handle_t _handle, uint8_t _numMips);
+    void (*set_texture_streaming_budget)(uint32_t _uploadBytesPerFrame, uint64_t _memoryCap);
     bgfx_frame_buffer_handle_t (*create_frame_buffer)(uint16_t _width, uint16_t _height, bgfx_texture_format_t _format, uint32_t _textureFlags);
     bgfx_frame_buffer_handle_t (*create_frame_buffer_scaled)(bgfx_backbuffer_ratio_t _ratio, bgfx_texture_format_t _format, uint32_t _textureFlags);
     bgfx_frame_buffer_handle_t (*create_frame_buffer_from_attachment)(uint8_t _num, const bgfx_attachment_t* _attachment, bool _destroyTextures);
@@ -163,6 +176,8 @@ typedef struct bgfx_interface_vtbl
     void (*set_view_transform)(uint8_t _id, const void* _view, const void* _proj);
     void (*set_view_transform_stereo)(uint8_t _id, const void* _view, const void* _projL, uint8_t _flags, const void* _projR);
     void (*set_view_order)(uint8_t _id, uint8_t _num, const void* _order);
+    void (*set_view_uniform)(uint8_t _id, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+    void (*set_frame_uniform)(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
     void (*set_marker)(const char* _marker);
     void (*set_state)(uint64_t _state, uint32_t _rgba);
     void (*set_condition)(bgfx_occlusion_query_handle_t _handle, bool _visible);
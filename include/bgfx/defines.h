@@ -6,7 +6,7 @@
 #ifndef BGFX_DEFINES_H_HEADER_GUARD
 #define BGFX_DEFINES_H_HEADER_GUARD
 
-#define BGFX_API_VERSION UINT32_C(35)
+#define BGFX_API_VERSION UINT32_C(48)
 
 ///
 #define BGFX_STATE_RGB_WRITE               UINT64_C(0x0000000000000001) //!< Enable RGB write.
@@ -389,6 +389,7 @@
 #define BGFX_CAPS_TEXTURE_READ_BACK      UINT64_C(0x0000000000200000) //!< Read-back texture is supported.
 #define BGFX_CAPS_VERTEX_ATTRIB_HALF     UINT64_C(0x0000000000400000) //!< Vertex attribute half-float is supported.
 #define BGFX_CAPS_VERTEX_ATTRIB_UINT10   UINT64_C(0x0000000000800000) //!< Vertex attribute 10_10_10_2 is supported.
+#define BGFX_CAPS_TEXTURE_MIN_LOD        UINT64_C(0x0000000001000000) //!< Texture min LOD clamp is supported.
 
 ///
 #define BGFX_CAPS_FORMAT_TEXTURE_NONE             UINT16_C(0x0000) //!< Texture format is not supported.
@@ -421,6 +422,11 @@
 #define BGFX_SUBMIT_RESERVED_SHIFT 7             //!< Internal bits shift.
 #define BGFX_SUBMIT_RESERVED_MASK  UINT8_C(0x80) //!< Internal bits mask.
 
+///
+#define BGFX_WELD_NONE           UINT8_C(0x00) //!< Compare only vertex position.
+#define BGFX_WELD_ALL_ATTRIBUTES UINT8_C(0x01) //!< Compare all vertex attributes.
+#define BGFX_WELD_MULTITHREADED  UINT8_C(0x02) //!< Split vertex bucketing and search between threads.
+
 ///
 #define BGFX_PCI_ID_NONE                UINT16_C(0x0000) //!< Autoselect adapter.
 #define BGFX_PCI_ID_SOFTWARE_RASTERIZER UINT16_C(0x0001) //!< Software rasterizer.
@@ -19,6 +19,7 @@ project "geometryc"
 		path.join(BGFX_DIR, "3rdparty/forsyth-too/**.h"),
 		path.join(BGFX_DIR, "3rdparty/ib-compress/**.cpp"),
 		path.join(BGFX_DIR, "3rdparty/ib-compress/**.h"),
+		path.join(BGFX_DIR, "src/topology.**"),
 		path.join(BGFX_DIR, "src/vertexdecl.**"),
 		path.join(BGFX_DIR, "tools/geometryc/**.cpp"),
 		path.join(BGFX_DIR, "tools/geometryc/**.h"),
@@ -37,6 +38,11 @@ project "geometryc"
 			"Cocoa.framework",
 		}
 
+	configuration { "osx or linux*" }
+		links {
+			"pthread",
+		}
+
 	configuration {}
 
 	strip()
@@ -49,6 +49,11 @@ project "texturec"
 			"Cocoa.framework",
 		}
 
+	configuration { "osx or linux*" }
+		links {
+			"pthread",
+		}
+
 	configuration { "vs20* or mingw*" }
 		links {
 			"psapi",
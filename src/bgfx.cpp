@@ -853,22 +853,38 @@ namespace bgfx
 		return PredefinedUniform::Count;
 	}
 
-	uint32_t Frame::submit(uint8_t _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, int32_t _depth, bool _preserveState)
+	uint32_t EncoderImpl::submit(uint8_t _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, int32_t _depth, bool _preserveState)
 	{
 		if (m_discard)
 		{
 			discard();
-			return m_num;
+			return UINT32_MAX;
 		}
 
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= m_num
-		|| (0 == m_draw.m_numVertices && 0 == m_draw.m_numIndices) )
+		if (0 == m_draw.m_numVertices
+		&&  0 == m_draw.m_numIndices)
 		{
-			++m_numDropped;
-			return m_num;
+			bx::atomicInc(&m_frame->m_numDropped);
+			return UINT32_MAX;
 		}
 
-		m_uniformEnd = m_uniformBuffer->getPos();
+		m_uniformEnd = getUniformBuffer()->getPos();
+
+		if (0 != s_ctx->m_numDeferredHandles
+		&&  s_ctx->isDeferred(m_draw, _program, _id) )
+		{
+			// Resources used by draw call are still in deferred backlog.
+			bx::atomicInc(&m_frame->m_numDeferredDraws);
+
+			if (!_preserveState)
+			{
+				m_draw.clear();
+				m_uniformBegin = m_uniformEnd;
+				m_stateFlags = BGFX_STATE_NONE;
+			}
+
+			return UINT32_MAX;
+		}
 
 		m_key.m_program = invalidHandle == _program.idx
 			? 0
@@ -877,17 +893,12 @@ namespace bgfx
 
 		m_key.m_depth  = (uint32_t)_depth;
 		m_key.m_view   = _id;
-		m_key.m_seq    = s_ctx->m_seq[_id] & s_ctx->m_seqMask[_id];
-		s_ctx->m_seq[_id]++;
-
-		uint64_t key = m_key.encodeDraw();
-		m_sortKeys[m_num]   = key;
-		m_sortValues[m_num] = m_numRenderItems;
-		++m_num;
+		m_key.m_seq    = 0;
 
 		m_draw.m_constBegin = m_uniformBegin;
 		m_draw.m_constEnd   = m_uniformEnd;
 		m_draw.m_stateFlags |= m_stateFlags;
+		m_draw.m_uniformIdx = m_uniformIdx;
 
 		uint32_t numVertices = UINT32_MAX;
 		for (uint32_t idx = 0, streamMask = m_draw.m_streamMask, ntz = bx::uint32_cnttz(streamMask)
@@ -909,8 +920,24 @@ namespace bgfx
 			m_draw.m_occlusionQuery = _occlusionQuery;
 		}
 
-		m_renderItem[m_numRenderItems].draw = m_draw;
-		++m_numRenderItems;
+		// Frame slot is reserved here, so that index of draw call is known
+		// at submit, even when item is written to frame later by flush.
+		uint32_t num = 1;
+		const uint32_t idx = m_frame->reserve(&num);
+
+		if (0 != num)
+		{
+			m_sortKeys[m_num] = m_key.encodeDraw();
+			m_renderItem[m_num].draw = m_draw;
+			m_itemIdx[m_num] = idx;
+			++m_num;
+		}
+
+		if (isDirect()
+		||  BGFX_CONFIG_ENCODER_BATCH_SIZE == m_num)
+		{
+			flush();
+		}
 
 		if (!_preserveState)
 		{
@@ -919,24 +946,30 @@ namespace bgfx
 			m_stateFlags = BGFX_STATE_NONE;
 		}
 
-		return m_num;
+		return 0 != num ? idx : UINT32_MAX;
 	}
 
-	uint32_t Frame::dispatch(uint8_t _id, ProgramHandle _handle, uint16_t _numX, uint16_t _numY, uint16_t _numZ, uint8_t _flags)
+	uint32_t EncoderImpl::dispatch(uint8_t _id, ProgramHandle _handle, uint16_t _numX, uint16_t _numY, uint16_t _numZ, uint8_t _flags)
 	{
 		if (m_discard)
 		{
 			discard();
-			return m_num;
+			return UINT32_MAX;
 		}
 
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= m_num)
+		m_uniformEnd = getUniformBuffer()->getPos();
+
+		if (0 != s_ctx->m_numDeferredHandles
+		&&  s_ctx->isDeferred(m_compute, _handle) )
 		{
-			++m_numDropped;
-			return m_num;
-		}
+			// Resources used by compute call are still in deferred backlog.
+			bx::atomicInc(&m_frame->m_numDeferredDraws);
 
-		m_uniformEnd = m_uniformBuffer->getPos();
+			m_compute.clear();
+			m_uniformBegin = m_uniformEnd;
+
+			return UINT32_MAX;
+		}
 
 		m_compute.m_matrix = m_draw.m_matrix;
 		m_compute.m_num    = m_draw.m_num;
@@ -944,27 +977,101 @@ namespace bgfx
 		m_compute.m_numY   = bx::uint16_max(_numY, 1);
 		m_compute.m_numZ   = bx::uint16_max(_numZ, 1);
 		m_compute.m_submitFlags = _flags;
+		m_compute.m_uniformIdx  = m_uniformIdx;
 
 		m_key.m_program = _handle.idx;
 		m_key.m_depth   = 0;
 		m_key.m_view    = _id;
-		m_key.m_seq     = s_ctx->m_seq[_id];
-		s_ctx->m_seq[_id]++;
-
-		uint64_t key = m_key.encodeCompute();
-		m_sortKeys[m_num]   = key;
-		m_sortValues[m_num] = m_numRenderItems;
-		++m_num;
+		m_key.m_seq     = 0;
 
 		m_compute.m_constBegin = m_uniformBegin;
 		m_compute.m_constEnd   = m_uniformEnd;
-		m_renderItem[m_numRenderItems].compute = m_compute;
-		++m_numRenderItems;
+
+		uint32_t num = 1;
+		const uint32_t idx = m_frame->reserve(&num);
+
+		if (0 != num)
+		{
+			m_sortKeys[m_num] = m_key.encodeCompute();
+			m_renderItem[m_num].compute = m_compute;
+			m_itemIdx[m_num] = idx;
+			++m_num;
+		}
+
+		if (isDirect()
+		||  BGFX_CONFIG_ENCODER_BATCH_SIZE == m_num)
+		{
+			flush();
+		}
 
 		m_compute.clear();
 		m_uniformBegin = m_uniformEnd;
 
-		return m_num;
+		return 0 != num ? idx : UINT32_MAX;
+	}
+
+	void EncoderImpl::flush()
+	{
+		if (0 == m_num)
+		{
+			return;
+		}
+
+		// Reserve per view sequence ranges. Draw calls from one encoder are
+		// kept in submit order within view, while other encoders can be
+		// flushing into the same view at the same time. Batch holds only
+		// items that already have frame slot, so dropped draw calls don't
+		// consume sequence numbers.
+		uint32_t viewSeq[BGFX_CONFIG_MAX_VIEWS];
+		uint16_t viewNum[BGFX_CONFIG_MAX_VIEWS];
+		uint8_t  views[BGFX_CONFIG_ENCODER_BATCH_SIZE];
+		uint32_t numViews = 0;
+
+		for (uint32_t ii = 0; ii < m_num; ++ii)
+		{
+			const uint8_t view = SortKey::decodeView(m_sortKeys[ii]);
+
+			bool found = false;
+			for (uint32_t jj = 0; jj < numViews; ++jj)
+			{
+				if (views[jj] == view)
+				{
+					found = true;
+					break;
+				}
+			}
+
+			if (!found)
+			{
+				views[numViews++] = view;
+				viewNum[view] = 0;
+			}
+
+			++viewNum[view];
+		}
+
+		for (uint32_t ii = 0; ii < numViews; ++ii)
+		{
+			const uint8_t view = views[ii];
+			viewSeq[view] = bx::atomicFetchAndAdd<uint32_t>(&s_ctx->m_seq[view], viewNum[view]);
+		}
+
+		for (uint32_t ii = 0, num = m_num; ii < num; ++ii)
+		{
+			const uint64_t key  = m_sortKeys[ii];
+			const uint8_t  view = SortKey::decodeView(key);
+			const uint32_t seq  = SortKey::isCompute(key)
+				? viewSeq[view]
+				: viewSeq[view] & s_ctx->m_seqMask[view]
+				;
+			++viewSeq[view];
+
+			const uint32_t idx = m_itemIdx[ii];
+			m_frame->getSortKey(idx)    = SortKey::remapSeq(key, seq);
+			m_frame->getRenderItem(idx) = m_renderItem[ii];
+		}
+
+		m_num = 0;
 	}
 
 	void Frame::blit(uint8_t _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
@@ -999,697 +1106,1665 @@ namespace bgfx
 		}
 	}
 
-	void Frame::sort()
+	void SortKeyRadixSort::init(uint32_t _numThreads)
 	{
-		uint8_t viewRemap[BGFX_CONFIG_MAX_VIEWS];
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+		m_numThreads = bx::uint32_min(_numThreads, BGFX_CONFIG_SORT_NUM_THREADS);
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
 		{
-			viewRemap[m_viewRemap[ii] ] = uint8_t(ii);
+			Worker& worker = m_worker[ii];
+			worker.m_sort = this;
+			worker.m_idx  = ii+1;
+			worker.m_thread.init(threadFunc, &worker, 0, "bgfx - sort thread");
 		}
+#else
+		BX_UNUSED(_numThreads);
+		m_numThreads = 0;
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+	}
 
-		for (uint32_t ii = 0, num = m_num; ii < num; ++ii)
+	void SortKeyRadixSort::shutdown()
+	{
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+		m_phase = Exit;
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
 		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			m_worker[ii].m_sem.post();
 		}
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_num);
 
-		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
 		{
-			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+			m_worker[ii].m_thread.shutdown();
 		}
-		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+
+		m_numThreads = 0;
+
+		BX_FREE(g_allocator, m_tempKeys);
+		BX_FREE(g_allocator, m_tempValues);
+		m_tempKeys   = NULL;
+		m_tempValues = NULL;
+		m_maxTemp    = 0;
 	}
 
-	RenderFrame::Enum renderFrame()
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+	int32_t SortKeyRadixSort::threadFunc(void* _userData)
 	{
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		Worker* worker = (Worker*)_userData;
+		SortKeyRadixSort* radixSort = worker->m_sort;
+
+		for (;;)
 		{
-			if (NULL == s_ctx)
-			{
-				s_renderFrameCalled = true;
-				s_threadIndex = ~BGFX_MAIN_THREAD_MAGIC;
-				return RenderFrame::NoContext;
-			}
+			worker->m_sem.wait();
 
-			BGFX_CHECK_RENDER_THREAD();
-			if (s_ctx->renderFrame() )
+			if (Exit == radixSort->m_phase)
 			{
-				Context* ctx = s_ctx;
-				ctx->apiSemWait();
-				s_ctx = NULL;
-				ctx->renderSemPost();
-				return RenderFrame::Exiting;
+				break;
 			}
 
-			return RenderFrame::Render;
+			radixSort->execute(worker->m_idx);
+			radixSort->m_doneSem.post();
 		}
 
-		BX_CHECK(false, "This call only makes sense if used with multi-threaded renderer.");
-		return RenderFrame::NoContext;
+		return EXIT_SUCCESS;
 	}
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
 
-	const uint32_t g_uniformTypeSize[UniformType::Count+1] =
+	void SortKeyRadixSort::run(Phase _phase)
 	{
-		sizeof(int32_t),
-		0,
-		4*sizeof(float),
-		3*3*sizeof(float),
-		4*4*sizeof(float),
-		1,
-	};
+		m_phase = _phase;
 
-	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
-	{
-		uint32_t opcode = encodeOpcode(_type, _loc, _num, true);
-		write(opcode);
-		write(_value, g_uniformTypeSize[_type]*_num);
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+		for (uint32_t ii = 1; ii < m_numActive; ++ii)
+		{
+			m_worker[ii-1].m_sem.post();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+
+		execute(0);
+
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+		for (uint32_t ii = 1; ii < m_numActive; ++ii)
+		{
+			m_doneSem.wait();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
 	}
 
-	void UniformBuffer::writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
+	void SortKeyRadixSort::execute(uint32_t _idx)
 	{
-		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
-		write(opcode);
-		write(&_handle, sizeof(UniformHandle) );
+		const uint32_t numPerThread = (m_num + m_numActive - 1) / m_numActive;
+		const uint32_t begin = bx::uint32_min(_idx*numPerThread, m_num);
+		const uint32_t end   = bx::uint32_min(begin+numPerThread, m_num);
+		const uint32_t shift = m_shift;
+		uint32_t* histogram  = m_histogram[_idx];
+
+		if (Histogram == m_phase)
+		{
+			bx::memSet(histogram, 0, BGFX_SORT_RADIX_SIZE*sizeof(uint32_t) );
+
+			for (uint32_t ii = begin; ii < end; ++ii)
+			{
+				const uint32_t digit = uint32_t(m_src[ii] >> shift) & BGFX_SORT_RADIX_MASK;
+				++histogram[digit];
+			}
+
+			return;
+		}
+
+		// Histogram holds destination offsets for this thread's block here.
+		for (uint32_t ii = begin; ii < end; ++ii)
+		{
+			const uint64_t key   = m_src[ii];
+			const uint32_t digit = uint32_t(key >> shift) & BGFX_SORT_RADIX_MASK;
+			const uint32_t dest  = histogram[digit]++;
+			m_dst[dest]       = key;
+			m_dstValues[dest] = m_srcValues[ii];
+		}
 	}
 
-	void UniformBuffer::writeMarker(const char* _marker)
+	void TexturePrepare::init(uint32_t _numThreads)
 	{
-		uint16_t num = (uint16_t)bx::strnlen(_marker)+1;
-		uint32_t opcode = encodeOpcode(bgfx::UniformType::Count, 0, num, true);
-		write(opcode);
-		write(_marker, num);
+		m_num  = 0;
+		m_next = 0;
+		m_exit = false;
+
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+		m_numThreads = bx::uint32_min(_numThreads, BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS);
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_thread[ii].init(threadFunc, this, 0, "bgfx - texture prepare thread");
+		}
+#else
+		BX_UNUSED(_numThreads);
+		m_numThreads = 0;
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
 	}
 
-	struct CapsFlags
+	void TexturePrepare::shutdown()
 	{
-		uint64_t m_flag;
-		const char* m_str;
-	};
+		wait();
 
-	static const CapsFlags s_capsFlags[] =
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+		m_exit = true;
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_sem.post();
+		}
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_thread[ii].shutdown();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+
+		m_numThreads = 0;
+	}
+
+	void TexturePrepare::add(const Memory* _src, const Memory* _data, uint8_t _startLod)
 	{
-#define CAPS_FLAGS(_x) { _x, #_x }
-		CAPS_FLAGS(BGFX_CAPS_ALPHA_TO_COVERAGE),
-		CAPS_FLAGS(BGFX_CAPS_BLEND_INDEPENDENT),
-		CAPS_FLAGS(BGFX_CAPS_COMPUTE),
-		CAPS_FLAGS(BGFX_CAPS_CONSERVATIVE_RASTER),
-		CAPS_FLAGS(BGFX_CAPS_DRAW_INDIRECT),
-		CAPS_FLAGS(BGFX_CAPS_FRAGMENT_DEPTH),
-		CAPS_FLAGS(BGFX_CAPS_FRAGMENT_ORDERING),
-		CAPS_FLAGS(BGFX_CAPS_GRAPHICS_DEBUGGER),
-		CAPS_FLAGS(BGFX_CAPS_HIDPI),
-		CAPS_FLAGS(BGFX_CAPS_HMD),
-		CAPS_FLAGS(BGFX_CAPS_INDEX32),
-		CAPS_FLAGS(BGFX_CAPS_INSTANCING),
-		CAPS_FLAGS(BGFX_CAPS_OCCLUSION_QUERY),
-		CAPS_FLAGS(BGFX_CAPS_RENDERER_MULTITHREADED),
-		CAPS_FLAGS(BGFX_CAPS_SWAP_CHAIN),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_2D_ARRAY),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_3D),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_BLIT),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_ALL),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_LEQUAL),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_CUBE_ARRAY),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_READ_BACK),
-		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_HALF),
-		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_UINT10),
-#undef CAPS_FLAGS
-	};
+		if (m_num == BX_COUNTOF(m_job) )
+		{
+			wait();
+		}
 
-	static void dumpCaps()
+		Job& job = m_job[m_num++];
+		job.m_src      = _src;
+		job.m_data     = _data;
+		job.m_startLod = _startLod;
+
+		if (0 == m_numThreads)
+		{
+			execute(job);
+			return;
+		}
+
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+		m_sem.post();
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+	}
+
+	void TexturePrepare::wait()
 	{
-		BX_TRACE("");
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+		if (0 != m_numThreads)
+		{
+			for (uint32_t ii = 0; ii < m_num; ++ii)
+			{
+				m_doneSem.wait();
+			}
+		}
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
 
-		if (0 < g_caps.numGPUs)
+		for (uint32_t ii = 0; ii < m_num; ++ii)
 		{
-			BX_TRACE("Detected GPUs (%d):", g_caps.numGPUs);
-			BX_TRACE("\t +----------------   Index");
-			BX_TRACE("\t |  +-------------   Device ID");
-			BX_TRACE("\t |  |    +--------   Vendor ID");
-			for (uint32_t ii = 0; ii < g_caps.numGPUs; ++ii)
+			const Memory* src = m_job[ii].m_src;
+
+			bx::MemoryReader reader(src->data, src->size);
+
+			uint32_t magic;
+			bx::read(&reader, magic);
+
+			if (BGFX_CHUNK_MAGIC_TEX == magic)
 			{
-				const Caps::GPU& gpu = g_caps.gpu[ii];
-				BX_UNUSED(gpu);
+				TextureCreate tc;
+				bx::read(&reader, tc);
 
-				BX_TRACE("\t %d: %04x %04x"
-					, ii
-					, gpu.deviceId
-					, gpu.vendorId
-					);
+				if (NULL != tc.m_mem)
+				{
+					release(tc.m_mem);
+				}
 			}
 
-			BX_TRACE("");
+			release(src);
 		}
 
-		RendererType::Enum renderers[RendererType::Count];
-		uint8_t num = getSupportedRenderers(BX_COUNTOF(renderers), renderers);
+		m_num  = 0;
+		m_next = 0;
+	}
 
-		BX_TRACE("Supported renderer backends (%d):", num);
-		for (uint32_t ii = 0; ii < num; ++ii)
+	bool TexturePrepare::isNeeded(const ImageContainer& _imageContainer, uint32_t _flags)
+	{
+		return true
+			&& (UINT32_MAX != _imageContainer.m_offset || NULL != _imageContainer.m_data)
+			&& 1 >= _imageContainer.m_depth
+			&& 0 == (_flags & (BGFX_TEXTURE_RT_MASK|BGFX_TEXTURE_COMPUTE_WRITE) )
+			&& getViableTextureFormat(_imageContainer) != _imageContainer.m_format
+			;
+	}
+
+	uint32_t TexturePrepare::getSize(const ImageContainer& _imageContainer, uint8_t _startLod)
+	{
+		const ImageBlockInfo& blockInfo = getBlockInfo(TextureFormat::Enum(_imageContainer.m_format) );
+		const uint32_t textureWidth  = bx::uint32_max(blockInfo.blockWidth,  _imageContainer.m_width >>_startLod);
+		const uint32_t textureHeight = bx::uint32_max(blockInfo.blockHeight, _imageContainer.m_height>>_startLod);
+		const uint16_t numSides = _imageContainer.m_numLayers * (_imageContainer.m_cubeMap ? 6 : 1);
+
+		uint32_t size = 0;
+		for (uint8_t lod = 0, num = uint8_t(_imageContainer.m_numMips - _startLod); lod < num; ++lod)
 		{
-			BX_TRACE("\t - %s", getRendererName(renderers[ii]) );
+			const uint32_t width  = bx::uint32_max(1, textureWidth >>lod);
+			const uint32_t height = bx::uint32_max(1, textureHeight>>lod);
+			size += width*height*4;
 		}
 
-		BX_TRACE("");
-		BX_TRACE("Sort key masks:");
-		BX_TRACE("\t  View     %016" PRIx64, SORT_KEY_VIEW_MASK);
-		BX_TRACE("\t  Draw bit %016" PRIx64, SORT_KEY_DRAW_BIT);
-		BX_TRACE("\t  Seq      %016" PRIx64, SORT_KEY_SEQ_MASK);
-		BX_TRACE("\tD Trans    %016" PRIx64, SORT_KEY_DRAW_TRANS_MASK);
-		BX_TRACE("\tD Program  %016" PRIx64, SORT_KEY_DRAW_PROGRAM_MASK);
-		BX_TRACE("\tC Program  %016" PRIx64, SORT_KEY_COMPUTE_PROGRAM_MASK);
-		BX_TRACE("\tD Depth    %016" PRIx64, SORT_KEY_DRAW_DEPTH_MASK);
+		return size*numSides;
+	}
 
-		BX_TRACE("");
-		BX_TRACE("Supported capabilities (renderer %s, vendor 0x%04x, device 0x%04x):"
-				, s_ctx->m_renderCtx->getRendererName()
-				, g_caps.vendorId
-				, g_caps.deviceId
-				);
-		for (uint32_t ii = 0; ii < BX_COUNTOF(s_capsFlags); ++ii)
+	const Memory* TexturePrepare::convertUpdate(TextureFormat::Enum _format, uint16_t _width, uint16_t _height, uint16_t _pitch, const Memory* _mem)
+	{
+		const ImageBlockInfo& blockInfo = getBlockInfo(_format);
+		const uint32_t blockWidth  = blockInfo.blockWidth;
+		const uint32_t blockHeight = blockInfo.blockHeight;
+		const uint32_t width  = (_width +blockWidth -1)/blockWidth *blockWidth;
+		const uint32_t height = (_height+blockHeight-1)/blockHeight*blockHeight;
+		const uint32_t srcPitch = width/blockWidth*blockInfo.blockSize;
+		const uint32_t dstPitch = _width*4;
+
+		const void* src = _mem->data;
+		uint8_t* packed = NULL;
+		if (UINT16_MAX != _pitch
+		&&  srcPitch   != _pitch)
 		{
-			if (0 != (g_caps.supported & s_capsFlags[ii].m_flag) )
-			{
-				BX_TRACE("\t%s", s_capsFlags[ii].m_str);
-			}
+			const uint32_t numRows = height/blockHeight;
+			packed = (uint8_t*)BX_ALLOC(g_allocator, numRows*srcPitch);
+			imageCopy(packed, numRows, _pitch, _mem->data, srcPitch);
+			src = packed;
 		}
 
-		BX_TRACE("");
-		BX_TRACE("Limits:");
-#define LIMITS(_x) BX_TRACE("\t%-24s %d", #_x, g_caps.limits._x)
-		LIMITS(maxDrawCalls);
-		LIMITS(maxBlits);
-		LIMITS(maxTextureSize);
-		LIMITS(maxViews);
-		LIMITS(maxFrameBuffers);
-		LIMITS(maxFBAttachments);
-		LIMITS(maxPrograms);
-		LIMITS(maxShaders);
-		LIMITS(maxTextures);
-		LIMITS(maxTextureSamplers);
-		LIMITS(maxVertexDecls);
-		LIMITS(maxVertexStreams);
-		LIMITS(maxIndexBuffers);
-		LIMITS(maxVertexBuffers);
-		LIMITS(maxDynamicIndexBuffers);
-		LIMITS(maxDynamicVertexBuffers);
-		LIMITS(maxUniforms);
-		LIMITS(maxOcclusionQueries);
-#undef LIMITS
+		uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, width*height*4);
+		imageDecodeToBgra8(temp, src, width, height, width*4, _format);
 
-		BX_TRACE("");
-		BX_TRACE("Supported texture formats:");
-		BX_TRACE("\t +----------------   2D: x = supported / * = emulated");
-		BX_TRACE("\t |+---------------   2D: sRGB format");
-		BX_TRACE("\t ||+--------------   3D: x = supported / * = emulated");
-		BX_TRACE("\t |||+-------------   3D: sRGB format");
-		BX_TRACE("\t ||||+------------ Cube: x = supported / * = emulated");
-		BX_TRACE("\t |||||+----------- Cube: sRGB format");
-		BX_TRACE("\t ||||||+---------- vertex format");
-		BX_TRACE("\t |||||||+--------- image");
-		BX_TRACE("\t ||||||||+-------- framebuffer");
-		BX_TRACE("\t |||||||||+------- MSAA framebuffer");
-		BX_TRACE("\t ||||||||||+------ MSAA texture");
-		BX_TRACE("\t |||||||||||+----- Auto-generated mips");
-		BX_TRACE("\t ||||||||||||  +-- name");
-		for (uint32_t ii = 0; ii < TextureFormat::Count; ++ii)
+		const Memory* mem = alloc(_height*dstPitch);
+		imageCopy(mem->data, _height, width*4, temp, dstPitch);
+
+		BX_FREE(g_allocator, temp);
+		if (NULL != packed)
 		{
-			if (TextureFormat::Unknown != ii
-			&&  TextureFormat::UnknownDepth != ii)
-			{
-				uint16_t flags = g_caps.formats[ii];
-				BX_TRACE("\t[%c%c%c%c%c%c%c%c%c%c%c%c] %s"
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_2D               ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED ? '*' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB          ? 'l' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_3D               ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED ? '*' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB          ? 'l' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE             ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED ? '*' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB        ? 'l' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_VERTEX           ? 'v' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_IMAGE            ? 'i' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER      ? 'f' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER_MSAA ? '+' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_MSAA             ? 'm' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_MIP_AUTOGEN      ? 'M' : ' '
-					, getName(TextureFormat::Enum(ii) )
-					);
-				BX_UNUSED(flags);
-			}
+			BX_FREE(g_allocator, packed);
 		}
 
-		BX_TRACE("");
-		BX_TRACE("NDC depth [%d, 1], origin %s left."
-			, g_caps.homogeneousDepth ? -1 : 0
-			, g_caps.originBottomLeft ? "bottom" : "top"
-			);
+		release(_mem);
 
-		BX_TRACE("");
+		return mem;
 	}
 
-	TextureFormat::Enum getViableTextureFormat(const ImageContainer& _imageContainer)
+	void TexturePrepare::execute(const Job& _job)
 	{
-		const uint32_t formatCaps = g_caps.formats[_imageContainer.m_format];
-		bool convert = 0 == formatCaps;
-
-		if (_imageContainer.m_cubeMap)
+		ImageContainer imageContainer;
+		if (!imageParse(imageContainer, _job.m_src->data, _job.m_src->size) )
 		{
-			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_CUBE)
-					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED)
-					;
+			return;
 		}
-		else if (_imageContainer.m_depth > 1)
+
+		const uint8_t startLod = _job.m_startLod;
+		const ImageBlockInfo& blockInfo = getBlockInfo(TextureFormat::Enum(imageContainer.m_format) );
+		const uint32_t textureWidth  = bx::uint32_max(blockInfo.blockWidth,  imageContainer.m_width >>startLod);
+		const uint32_t textureHeight = bx::uint32_max(blockInfo.blockHeight, imageContainer.m_height>>startLod);
+		const uint16_t numSides = imageContainer.m_numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+		const uint8_t  numMips  = uint8_t(imageContainer.m_numMips - startLod);
+
+		ImageMip mip;
+		imageGetRawData(imageContainer, 0, startLod, _job.m_src->data, _job.m_src->size, mip);
+		uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, mip.m_width*mip.m_height*4);
+
+		uint8_t* dst = _job.m_data->data;
+
+		for (uint16_t side = 0; side < numSides; ++side)
 		{
-			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_3D)
-					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED)
-					;
+			for (uint8_t lod = 0; lod < numMips; ++lod)
+			{
+				const uint32_t width  = bx::uint32_max(1, textureWidth >>lod);
+				const uint32_t height = bx::uint32_max(1, textureHeight>>lod);
+				const uint32_t pitch  = width*4;
+
+				if (imageGetRawData(imageContainer, side, lod+startLod, _job.m_src->data, _job.m_src->size, mip) )
+				{
+					imageDecodeToBgra8(temp
+						, mip.m_data
+						, mip.m_width
+						, mip.m_height
+						, mip.m_width*4
+						, mip.m_format
+						);
+					imageCopy(dst, height, mip.m_width*4, temp, pitch);
+				}
+				else
+				{
+					bx::memSet(dst, 0, height*pitch);
+				}
+
+				dst += height*pitch;
+			}
 		}
-		else
+
+		BX_FREE(g_allocator, temp);
+	}
+
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+	int32_t TexturePrepare::threadFunc(void* _userData)
+	{
+		TexturePrepare* texturePrepare = (TexturePrepare*)_userData;
+
+		for (;;)
 		{
-			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_2D)
-					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED)
-					;
+			texturePrepare->m_sem.wait();
+
+			if (texturePrepare->m_exit)
+			{
+				break;
+			}
+
+			const uint32_t idx = bx::atomicFetchAndAdd(&texturePrepare->m_next, 1u);
+			execute(texturePrepare->m_job[idx]);
+			texturePrepare->m_doneSem.post();
 		}
 
-		if (convert)
+		return EXIT_SUCCESS;
+	}
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+
+	void TextureStreaming::shutdown()
+	{
+		for (uint32_t ii = 0; ii < m_num; ++ii)
 		{
-			return TextureFormat::BGRA8;
+			release(m_entry[ii].m_mem);
 		}
 
-		return _imageContainer.m_format;
+		m_num    = 0;
+		m_next   = 0;
+		m_memory = 0;
+		bx::memSet(m_index, 0xff, sizeof(m_index) );
 	}
 
-	static TextureFormat::Enum s_emulatedFormats[] =
+	TextureStreaming::Entry* TextureStreaming::add(TextureHandle _handle, const Memory* _mem, uint8_t _numMips, uint8_t _topLod, uint8_t _lod)
 	{
-		TextureFormat::BC1,
-		TextureFormat::BC2,
-		TextureFormat::BC3,
-		TextureFormat::BC4,
-		TextureFormat::BC5,
-		TextureFormat::ETC1,
-		TextureFormat::ETC2,
-		TextureFormat::ETC2A,
-		TextureFormat::ETC2A1,
-		TextureFormat::PTC14,
-		TextureFormat::PTC14A,
-		TextureFormat::BGRA8, // GL doesn't support BGRA8 without extensions.
-		TextureFormat::RGBA8, // D3D9 doesn't support RGBA8
-	};
+		BX_CHECK(!isFull(), "Too many streaming textures (max: %d).", BGFX_CONFIG_MAX_STREAMING_TEXTURES);
 
-	bool Context::init(RendererType::Enum _type)
-	{
-		BX_CHECK(!m_rendererInitialized, "Already initialized?");
+		const uint16_t idx = uint16_t(m_num++);
+		m_index[_handle.idx] = idx;
 
-		m_exit    = false;
-		m_flipped = true;
-		m_frames  = 0;
-		m_debug   = BGFX_DEBUG_NONE;
+		Entry& entry = m_entry[idx];
+		entry.m_mem          = _mem;
+		entry.m_size         = 0;
+		entry.m_frame        = 0;
+		entry.m_handle       = _handle.idx;
+		entry.m_numMips      = _numMips;
+		entry.m_topLod       = _topLod;
+		entry.m_residentLod  = _lod;
+		entry.m_requestedLod = _lod;
+		entry.m_uploadedLod  = _lod;
 
-		m_submit->create();
+		return &entry;
+	}
 
-#if BGFX_CONFIG_MULTITHREADED
-		m_render->create();
+	void TextureStreaming::remove(TextureHandle _handle)
+	{
+		const uint16_t idx = m_index[_handle.idx];
+		if (UINT16_MAX == idx)
+		{
+			return;
+		}
 
-		if (s_renderFrameCalled)
+		Entry& entry = m_entry[idx];
+		release(entry.m_mem);
+		m_memory -= entry.m_size;
+		m_index[_handle.idx] = UINT16_MAX;
+
+		const uint16_t last = uint16_t(--m_num);
+		if (idx != last)
 		{
-			// When bgfx::renderFrame is called before init render thread
-			// should not be created.
-			BX_TRACE("Application called bgfx::renderFrame directly, not creating render thread.");
-			m_singleThreaded = true
-				&& ~BGFX_MAIN_THREAD_MAGIC == s_threadIndex
-				;
+			entry = m_entry[last];
+			m_index[entry.m_handle] = idx;
 		}
-		else
+	}
+
+	uint16_t TextureStreaming::getNumPending() const
+	{
+		uint16_t num = 0;
+		for (uint32_t ii = 0; ii < m_num; ++ii)
 		{
-			BX_TRACE("Creating rendering thread.");
-			m_thread.init(renderThread, this, 0, "bgfx - renderer backend thread");
-			m_singleThreaded = false;
+			num += m_entry[ii].m_requestedLod < m_entry[ii].m_residentLod;
 		}
-#else
-		BX_TRACE("Multithreaded renderer is disabled.");
-		m_singleThreaded = true;
-#endif // BGFX_CONFIG_MULTITHREADED
 
-		BX_TRACE("Running in %s-threaded mode", m_singleThreaded ? "single" : "multi");
+		return num;
+	}
 
-		s_threadIndex = BGFX_MAIN_THREAD_MAGIC;
+	uint32_t TextureStreaming::getMipSize(const Entry& _entry, uint8_t _lod)
+	{
+		const Memory* src = _entry.m_mem;
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(m_viewRemap); ++ii)
+		ImageContainer imageContainer;
+		ImageMip mip;
+		if (imageParse(imageContainer, src->data, src->size)
+		&&  imageGetRawData(imageContainer, 0, _lod, src->data, src->size, mip) )
 		{
-			m_viewRemap[ii] = uint8_t(ii);
+			return mip.m_size;
 		}
 
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		return 0;
+	}
+
+	uint32_t TextureStreaming::getResidentSize(const Entry& _entry, uint8_t _lod)
+	{
+		const Memory* src = _entry.m_mem;
+
+		ImageContainer imageContainer;
+		if (!imageParse(imageContainer, src->data, src->size) )
 		{
-			resetView(uint8_t(ii) );
+			return 0;
 		}
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(m_clearColor); ++ii)
+		uint32_t size = 0;
+		for (uint8_t lod = _lod; lod < _entry.m_numMips; ++lod)
 		{
-			m_clearColor[ii][0] = 0.0f;
-			m_clearColor[ii][1] = 0.0f;
-			m_clearColor[ii][2] = 0.0f;
-			m_clearColor[ii][3] = 1.0f;
+			ImageMip mip;
+			if (imageGetRawData(imageContainer, 0, lod, src->data, src->size, mip) )
+			{
+				size += mip.m_size;
+			}
 		}
 
-		m_declRef.init();
+		return size;
+	}
 
-		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
-		cmdbuf.write(_type);
+	uint32_t Context::textureStreamingUpload(TextureStreaming::Entry& _entry, uint8_t _begin, uint8_t _end, uint8_t _topLod)
+	{
+		const Memory* src = _entry.m_mem;
 
-		frameNoRenderWait();
+		ImageContainer imageContainer;
+		imageParse(imageContainer, src->data, src->size);
 
-		// Make sure renderer init is called from render thread.
-		// g_caps is initialized and available after this point.
-		frame();
+		const TextureHandle handle = { _entry.m_handle };
 
-		if (!m_rendererInitialized)
+		uint32_t size = 0;
+		for (uint8_t lod = _begin; lod < _end; ++lod)
 		{
-			getCommandBuffer(CommandBuffer::RendererShutdownEnd);
-			frame();
-			frame();
-			m_declRef.shutdown(m_vertexDeclHandle);
-			m_submit->destroy();
-#if BGFX_CONFIG_MULTITHREADED
-			m_render->destroy();
-#endif // BGFX_CONFIG_MULTITHREADED
-			return false;
+			ImageMip mip;
+			if (imageGetRawData(imageContainer, 0, lod, src->data, src->size, mip) )
+			{
+				updateTexture(handle
+					, 0
+					, uint8_t(lod - _topLod)
+					, 0
+					, 0
+					, 0
+					, uint16_t(mip.m_width)
+					, uint16_t(mip.m_height)
+					, 1
+					, UINT16_MAX
+					, copy(mip.m_data, mip.m_size)
+					);
+				size += mip.m_size;
+			}
 		}
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(s_emulatedFormats); ++ii)
-		{
-			const uint32_t fmt = s_emulatedFormats[ii];
-			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_2D  ) ? BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
-			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_3D  ) ? BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
-			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_CUBE) ? BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
-		}
+		return size;
+	}
 
-		for (uint32_t ii = 0; ii < TextureFormat::UnknownDepth; ++ii)
+	uint32_t Context::textureStreamingSetLod(TextureStreaming::Entry& _entry, uint8_t _lod, bool _resize)
+	{
+		const TextureHandle handle = { _entry.m_handle };
+
+		uint32_t uploaded = 0;
+
+		const bool minLod = 0 != (g_caps.supported & BGFX_CAPS_TEXTURE_MIN_LOD);
+		if (minLod
+		&&  !_resize
+		&&  _lod >= _entry.m_topLod)
 		{
-			bool convertable = imageConvert(TextureFormat::BGRA8, TextureFormat::Enum(ii) );
-			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_2D  ) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
-			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_3D  ) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
-			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_CUBE) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
+			// Requested mips fit in allocated storage, only mips that were
+			// never uploaded are uploaded, and sampling is clamped to
+			// resident mips. Released mips stay allocated.
+			if (_lod < _entry.m_uploadedLod)
+			{
+				uploaded = textureStreamingUpload(_entry, _lod, _entry.m_uploadedLod, _entry.m_topLod);
+				_entry.m_uploadedLod = _lod;
+			}
+
+			textureStreamingSetMinLod(handle, uint8_t(_lod - _entry.m_topLod) );
 		}
+		else
+		{
+			const Memory* src = _entry.m_mem;
 
-		g_caps.rendererType = m_renderCtx->getRendererType();
-		initAttribTypeSizeTable(g_caps.rendererType);
+			ImageContainer imageContainer;
+			imageParse(imageContainer, src->data, src->size);
 
-		g_caps.supported |= 0
-			| (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) && !m_singleThreaded ? BGFX_CAPS_RENDERER_MULTITHREADED : 0)
-			| (isGraphicsDebuggerPresent() ? BGFX_CAPS_GRAPHICS_DEBUGGER : 0)
-			;
+			ImageMip mip;
+			imageGetRawData(imageContainer, 0, _lod, src->data, src->size, mip);
 
-		dumpCaps();
+			const uint16_t width   = uint16_t(mip.m_width);
+			const uint16_t height  = uint16_t(mip.m_height);
+			const uint8_t  numMips = uint8_t(_entry.m_numMips - _lod);
 
-		m_textVideoMemBlitter.init();
-		m_clearQuad.init();
+			// Renderer recreates texture storage on resize, and all resident
+			// mips are uploaded again. Texture updates are batched after
+			// resize, so texture must not be resized more than once per
+			// frame.
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::ResizeTexture, handle.idx);
+			cmdbuf.write(handle);
+			cmdbuf.write(width);
+			cmdbuf.write(height);
+			cmdbuf.write(numMips);
 
-		m_submit->m_transientVb = createTransientVertexBuffer(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
-		m_submit->m_transientIb = createTransientIndexBuffer(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
-		frame();
+			m_textureRef[handle.idx].m_numMips = numMips;
 
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
-		{
-			m_submit->m_transientVb = createTransientVertexBuffer(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
-			m_submit->m_transientIb = createTransientIndexBuffer(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
-			frame();
+			uploaded = textureStreamingUpload(_entry, _lod, _entry.m_numMips, _lod);
+			_entry.m_uploadedLod = _lod;
+			_entry.m_topLod      = _lod;
+
+			if (minLod)
+			{
+				textureStreamingSetMinLod(handle, 0);
+			}
 		}
 
-		g_internalData.caps = getCaps();
+		BX_TRACE("Streaming texture %3d: %d mips resident, %d mips allocated, %d bytes uploaded."
+			, handle.idx
+			, _entry.m_numMips - _lod
+			, _entry.m_numMips - _entry.m_topLod
+			, uploaded
+			);
 
-		return true;
+		const uint32_t size = TextureStreaming::getResidentSize(_entry, _entry.m_topLod);
+		m_textureStreaming.m_memory -= _entry.m_size;
+		m_textureStreaming.m_memory += size;
+		_entry.m_size        = size;
+		_entry.m_residentLod = _lod;
+		_entry.m_frame       = m_frames;
+
+		return uploaded;
 	}
 
-	void Context::shutdown()
+	void Context::textureStreamingUpdate()
 	{
-		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
-		frame();
-
-		destroyTransientVertexBuffer(m_submit->m_transientVb);
-		destroyTransientIndexBuffer(m_submit->m_transientIb);
-		m_textVideoMemBlitter.shutdown();
-		m_clearQuad.shutdown();
-		frame();
+		TextureStreaming& ts = m_textureStreaming;
+		uint32_t uploaded = ts.m_uploaded;
 
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		// Release top mips that are not requested anymore. Releasing and
+		// evicting mips is not charged to upload budget.
+		for (uint32_t ii = 0; ii < ts.m_num; ++ii)
 		{
-			destroyTransientVertexBuffer(m_submit->m_transientVb);
-			destroyTransientIndexBuffer(m_submit->m_transientIb);
-			frame();
+			TextureStreaming::Entry& entry = ts.m_entry[ii];
+			if (entry.m_residentLod < entry.m_requestedLod
+			&&  entry.m_frame != m_frames)
+			{
+				textureStreamingSetLod(entry, entry.m_requestedLod, false);
+			}
 		}
 
-		frame(); // If any VertexDecls needs to be destroyed.
-
-		getCommandBuffer(CommandBuffer::RendererShutdownEnd);
-		frame();
-
-		m_dynVertexBufferAllocator.compact();
-		m_dynIndexBufferAllocator.compact();
-
-		BX_CHECK(m_vertexDeclHandle.getNumHandles() == m_declRef.m_vertexDeclMap.getNumElements()
-				, "VertexDeclRef mismatch, num handles %d, handles in hash map %d."
-				, m_vertexDeclHandle.getNumHandles()
-				, m_declRef.m_vertexDeclMap.getNumElements()
-				);
-
-		m_declRef.shutdown(m_vertexDeclHandle);
-
-#if BGFX_CONFIG_MULTITHREADED
-		// Render thread shutdown sequence.
-		renderSemWait(); // Wait for previous frame.
-		apiSemPost();   // OK to set context to NULL.
-		// s_ctx is NULL here.
-		renderSemWait(); // In RenderFrame::Exiting state.
-
-		if (m_thread.isRunning() )
+		// Evict until under memory cap. Texture storage is resized, so
+		// memory is actually freed even when renderer can clamp min LOD.
+		// Largest texture first drops allocated mips that are not resident,
+		// then its top resident mip.
+		while (ts.m_memory > ts.m_memoryCap)
 		{
-			m_thread.shutdown();
-		}
-
-		m_render->destroy();
-#endif // BGFX_CONFIG_MULTITHREADED
+			TextureStreaming::Entry* largest = NULL;
+			for (uint32_t ii = 0; ii < ts.m_num; ++ii)
+			{
+				TextureStreaming::Entry& entry = ts.m_entry[ii];
+				if ( (entry.m_topLod < entry.m_residentLod || entry.m_residentLod+1 < entry.m_numMips)
+				&&  entry.m_frame != m_frames
+				&&  (NULL == largest || entry.m_size > largest->m_size) )
+				{
+					largest = &entry;
+				}
+			}
 
-		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
-		s_ctx = NULL;
+			if (NULL == largest)
+			{
+				break;
+			}
 
-		m_submit->destroy();
+			const uint8_t lod = largest->m_topLod < largest->m_residentLod
+				? largest->m_residentLod
+				: uint8_t(largest->m_residentLod+1)
+				;
+			textureStreamingSetLod(*largest, lod, true);
+		}
 
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
+		// Stream in one requested mip per texture, starting where previous
+		// frame stopped. At least one mip is streamed in each frame even when
+		// it's larger than upload budget.
+		const uint32_t num = ts.m_num;
+		uint32_t numSteps = 0;
+		uint32_t ii = 0;
+		for (; ii < num; ++ii)
 		{
-#define CHECK_HANDLE_LEAK(_handleAlloc) \
-					BX_MACRO_BLOCK_BEGIN \
-						BX_WARN(0 == _handleAlloc.getNumHandles() \
-							, "LEAK: " #_handleAlloc " %d (max: %d)" \
-							, _handleAlloc.getNumHandles() \
-							, _handleAlloc.getMaxHandles() \
-							); \
-					BX_MACRO_BLOCK_END
+			if (0 != numSteps
+			&&  uploaded >= ts.m_uploadBudget)
+			{
+				break;
+			}
 
-			CHECK_HANDLE_LEAK(m_dynamicIndexBufferHandle);
-			CHECK_HANDLE_LEAK(m_dynamicVertexBufferHandle);
-			CHECK_HANDLE_LEAK(m_indexBufferHandle);
-			CHECK_HANDLE_LEAK(m_vertexDeclHandle);
-			CHECK_HANDLE_LEAK(m_vertexBufferHandle);
-			CHECK_HANDLE_LEAK(m_shaderHandle);
-			CHECK_HANDLE_LEAK(m_programHandle);
-			CHECK_HANDLE_LEAK(m_textureHandle);
-			CHECK_HANDLE_LEAK(m_frameBufferHandle);
-			CHECK_HANDLE_LEAK(m_uniformHandle);
-			CHECK_HANDLE_LEAK(m_occlusionQueryHandle);
-#undef CHECK_HANDLE_LEAK
+			TextureStreaming::Entry& entry = ts.m_entry[(ts.m_next + ii) % num];
+			if (entry.m_requestedLod < entry.m_residentLod
+			&&  entry.m_frame != m_frames)
+			{
+				// Mip already allocated doesn't need memory.
+				const uint8_t  lod  = uint8_t(entry.m_residentLod-1);
+				const uint32_t size = lod < entry.m_topLod
+					? TextureStreaming::getMipSize(entry, lod)
+					: 0
+					;
+				if (ts.m_memory + size <= ts.m_memoryCap)
+				{
+					uploaded += textureStreamingSetLod(entry, lod, false);
+					++numSteps;
+				}
+			}
 		}
+
+		ts.m_next          = 0 == num ? 0 : (ts.m_next + ii) % num;
+		ts.m_frameUploaded = uploaded;
+		ts.m_uploaded      = 0;
 	}
 
-	void Context::freeDynamicBuffers()
+	static bool isSorted(const uint64_t* _keys, uint32_t _num)
 	{
-		for (uint16_t ii = 0, num = m_numFreeDynamicIndexBufferHandles; ii < num; ++ii)
-		{
-			destroyDynamicIndexBufferInternal(m_freeDynamicIndexBufferHandle[ii]);
-		}
-		m_numFreeDynamicIndexBufferHandles = 0;
-
-		for (uint16_t ii = 0, num = m_numFreeDynamicVertexBufferHandles; ii < num; ++ii)
+		for (uint32_t ii = 1; ii < _num; ++ii)
 		{
-			destroyDynamicVertexBufferInternal(m_freeDynamicVertexBufferHandle[ii]);
+			if (_keys[ii-1] > _keys[ii])
+			{
+				return false;
+			}
 		}
-		m_numFreeDynamicVertexBufferHandles = 0;
 
-		for (uint16_t ii = 0, num = m_numFreeOcclusionQueryHandles; ii < num; ++ii)
-		{
-			m_occlusionQueryHandle.free(m_freeOcclusionQueryHandle[ii].idx);
-		}
-		m_numFreeOcclusionQueryHandles = 0;
+		return true;
 	}
 
-	void Context::freeAllHandles(Frame* _frame)
+	void SortKeyRadixSort::sort(uint64_t* _keys, RenderItemCount* _values, uint32_t _num, const bool* _sequential)
 	{
-		for (uint16_t ii = 0, num = _frame->m_freeIndexBuffer.getNumQueued(); ii < num; ++ii)
-		{
-			m_indexBufferHandle.free(_frame->m_freeIndexBuffer.get(ii).idx);
-		}
-
-		for (uint16_t ii = 0, num = _frame->m_freeVertexBuffer.getNumQueued(); ii < num; ++ii)
+		// Keys are often already in order, for example when views are
+		// submitted one after another, or when all views are sequential.
+		if (isSorted(_keys, _num) )
 		{
-			destroyVertexBufferInternal(_frame->m_freeVertexBuffer.get(ii));
+			return;
 		}
 
-		for (uint16_t ii = 0, num = _frame->m_freeVertexDecl.getNumQueued(); ii < num; ++ii)
+		if (_num > m_maxTemp)
 		{
-			m_vertexDeclHandle.free(_frame->m_freeVertexDecl.get(ii).idx);
+			m_maxTemp    = _num + _num/2;
+			m_tempKeys   = (uint64_t*)BX_REALLOC(g_allocator, m_tempKeys, m_maxTemp*sizeof(uint64_t) );
+			m_tempValues = (RenderItemCount*)BX_REALLOC(g_allocator, m_tempValues, m_maxTemp*sizeof(RenderItemCount) );
 		}
 
-		for (uint16_t ii = 0, num = _frame->m_freeShader.getNumQueued(); ii < num; ++ii)
-		{
-			m_shaderHandle.free(_frame->m_freeShader.get(ii).idx);
-		}
+		// Bucket keys by view first, and then sort each view separately.
+		// Views already in order are skipped, and sequential views are
+		// sorted only by draw bit and sequence, since sequence is unique
+		// within sequential view.
+		sort(_keys, _values, m_tempKeys, m_tempValues, _num, SORT_KEY_VIEW_SHIFT, 64);
 
-		for (uint16_t ii = 0, num = _frame->m_freeProgram.getNumQueued(); ii < num; ++ii)
+		for (uint32_t begin = 0; begin < _num;)
 		{
-			m_programHandle.free(_frame->m_freeProgram.get(ii).idx);
-		}
+			const uint8_t view = SortKey::decodeView(_keys[begin]);
 
-		for (uint16_t ii = 0, num = _frame->m_freeTexture.getNumQueued(); ii < num; ++ii)
-		{
-			m_textureHandle.free(_frame->m_freeTexture.get(ii).idx);
-		}
+			uint32_t end = begin+1;
+			for (; end < _num && view == SortKey::decodeView(_keys[end]); ++end)
+			{
+			}
 
-		for (uint16_t ii = 0, num = _frame->m_freeFrameBuffer.getNumQueued(); ii < num; ++ii)
-		{
-			m_frameBufferHandle.free(_frame->m_freeFrameBuffer.get(ii).idx);
-		}
+			const uint32_t num = end - begin;
+			if (!isSorted(&_keys[begin], num) )
+			{
+				sort(&_keys[begin]
+					, &_values[begin]
+					, &m_tempKeys[begin]
+					, &m_tempValues[begin]
+					, num
+					, _sequential[view] ? SORT_KEY_SEQ_SHIFT : 0
+					, SORT_KEY_VIEW_SHIFT
+					);
+			}
 
-		for (uint16_t ii = 0, num = _frame->m_freeUniform.getNumQueued(); ii < num; ++ii)
-		{
-			m_uniformHandle.free(_frame->m_freeUniform.get(ii).idx);
+			begin = end;
 		}
 	}
 
-	uint32_t Context::frame(bool _capture)
+	void SortKeyRadixSort::sort(uint64_t* _keys, RenderItemCount* _values, uint64_t* _tempKeys, RenderItemCount* _tempValues, uint32_t _num, uint32_t _beginBit, uint32_t _endBit)
 	{
-		BX_CHECK(0 == m_instBufferCount, "Instance buffer allocated, but not used. This is incorrect, and causes memory leak.");
-
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG_OCCLUSION) )
-		{
-			m_occlusionQuerySet.clear();
-		}
-
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
-		{
-			m_uniformSet.clear();
-		}
+		m_numActive = _num >= BGFX_CONFIG_SORT_PARALLEL_THRESHOLD
+			? m_numThreads+1
+			: 1
+			;
+		m_src       = _keys;
+		m_dst       = _tempKeys;
+		m_srcValues = _values;
+		m_dstValues = _tempValues;
+		m_num       = _num;
+
+		for (uint32_t shift = _beginBit; shift < _endBit; shift += BGFX_SORT_RADIX_BITS)
+		{
+			m_shift = shift;
+			run(Histogram);
+
+			// Turn per thread digit counts into per thread destination
+			// offsets. Blocks are laid out in thread order, which keeps
+			// sort stable.
+			bool skip = false;
+			uint32_t offset = 0;
+			for (uint32_t digit = 0; digit < BGFX_SORT_RADIX_SIZE && !skip; ++digit)
+			{
+				uint32_t count = 0;
+				for (uint32_t ii = 0; ii < m_numActive; ++ii)
+				{
+					const uint32_t num = m_histogram[ii][digit];
+					m_histogram[ii][digit] = offset;
+					offset += num;
+					count  += num;
+				}
 
-		m_submit->m_capture = _capture;
+				skip = count == _num;
+			}
 
-		BGFX_PROFILER_SCOPE(bgfx, main_thread_frame, 0xff2040ff);
-		// wait for render thread to finish
-		renderSemWait();
-		frameNoRenderWait();
+			if (skip)
+			{
+				continue;
+			}
 
-		return m_frames;
-	}
+			run(Scatter);
 
-	void Context::frameNoRenderWait()
-	{
-		swap();
+			bx::xchg(m_src, m_dst);
+			bx::xchg(m_srcValues, m_dstValues);
+		}
 
-		// release render thread
-		apiSemPost();
+		if (m_src != _keys)
+		{
+			bx::memCopy(_keys, m_src, _num*sizeof(uint64_t) );
+			bx::memCopy(_values, m_srcValues, _num*sizeof(RenderItemCount) );
+		}
 	}
 
-	void Context::swap()
+	void Frame::sort()
 	{
-		freeDynamicBuffers();
-		m_submit->m_resolution = m_resolution;
-		m_resolution.m_flags &= ~BGFX_RESET_INTERNAL_FORCE;
-		m_submit->m_debug = m_debug;
+		BGFX_PROFILER_SCOPE(bgfx, sort, 0xff2040ff);
 
-		bx::memCopy(m_submit->m_viewRemap, m_viewRemap, sizeof(m_viewRemap) );
-		bx::memCopy(m_submit->m_fb, m_fb, sizeof(m_fb) );
-		bx::memCopy(m_submit->m_clear, m_clear, sizeof(m_clear) );
-		bx::memCopy(m_submit->m_rect, m_rect, sizeof(m_rect) );
-		bx::memCopy(m_submit->m_scissor, m_scissor, sizeof(m_scissor) );
-		bx::memCopy(m_submit->m_view, m_view, sizeof(m_view) );
-		bx::memCopy(m_submit->m_proj, m_proj, sizeof(m_proj) );
-		bx::memCopy(m_submit->m_viewFlags, m_viewFlags, sizeof(m_viewFlags) );
-		if (m_colorPaletteDirty > 0)
+		bool identity = true;
+		uint8_t viewRemap[BGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 		{
-			--m_colorPaletteDirty;
-			bx::memCopy(m_submit->m_colorPalette, m_clearColor, sizeof(m_clearColor) );
+			viewRemap[m_viewRemap[ii] ] = uint8_t(ii);
+			identity &= m_viewRemap[ii] == ii;
 		}
-		m_submit->finish();
 
-		bx::xchg(m_render, m_submit);
+		const uint32_t num = m_num;
 
-		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
+		// One extra slot for terminator key, renderers read one item past
+		// the end to detect last view change.
+		growSortItems(num+1);
+		growRenderItems(num+1);
 
-		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
-		||  m_singleThreaded)
+		// Gather keys from render item chunks into contiguous array for
+		// sort, remapping views along the way.
+		for (uint32_t chunk = 0, first = 0; first < num; ++chunk, first += BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE)
 		{
-			renderFrame();
+			const uint64_t* keys = m_chunk[chunk]->m_sortKey;
+			const uint32_t  end  = bx::uint32_min(num-first, BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE);
+
+			if (identity)
+			{
+				bx::memCopy(&m_sortKeys[first], keys, end*sizeof(uint64_t) );
+			}
+			else
+			{
+				for (uint32_t ii = 0; ii < end; ++ii)
+				{
+					m_sortKeys[first+ii] = SortKey::remapView(keys[ii], viewRemap);
+				}
+			}
+
+			for (uint32_t ii = 0; ii < end; ++ii)
+			{
+				m_sortValues[first+ii] = RenderItemCount(first+ii);
+			}
 		}
 
-		m_frames++;
-		m_submit->start();
+		if (!identity)
+		{
+			for (uint32_t ii = 0, numBlitItems = m_numBlitItems; ii < numBlitItems; ++ii)
+			{
+				m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+			}
+		}
 
-		bx::memSet(m_seq, 0, sizeof(m_seq) );
-		freeAllHandles(m_submit);
+		bool sequential[BGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			sequential[ii] = 0 != m_seqMask[m_viewRemap[ii] ];
+		}
 
-		m_submit->resetFreeHandles();
-		m_submit->m_textVideoMem->resize(m_render->m_textVideoMem->m_small
-			, m_resolution.m_width
-			, m_resolution.m_height
-			);
-	}
+		const int64_t sortStart = bx::getHPCounter();
+		s_ctx->m_sortKeyRadixSort.sort(m_sortKeys, m_sortValues, num, sequential);
+		m_perfStats.cpuTimeSort = bx::getHPCounter() - sortStart;
+		bx::radixSort(m_blitKeys, s_ctx->m_tempBlitKeys, m_numBlitItems);
 
-	const char* Context::getName(UniformHandle _handle) const
-	{
-		return m_uniformRef[_handle.idx].m_name.getPtr();
+		SortKey term;
+		term.reset();
+		term.m_program = invalidHandle;
+		m_sortKeys[num]   = term.encodeDraw();
+		m_sortValues[num] = RenderItemCount(num);
 	}
 
-	bool Context::renderFrame()
+	RenderFrame::Enum renderFrame()
 	{
-		BGFX_PROFILER_SCOPE(bgfx, render_frame, 0xff2040ff);
-
-		if (m_rendererInitialized
-		&& !m_flipAfterRender
-		&& !m_flipped)
-		{
-			m_renderCtx->flip(m_render->m_hmd);
-			m_flipped = true;
-		}
-
-		if (apiSemWait(BGFX_CONFIG_API_SEMAPHORE_TIMEOUT) )
+		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
 		{
-			rendererExecCommands(m_render->m_cmdPre);
-			if (m_rendererInitialized)
+			if (NULL == s_ctx)
 			{
-				BGFX_PROFILER_SCOPE(bgfx, render_submit, 0xff2040ff);
-				m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
-				m_flipped = false;
+				s_renderFrameCalled = true;
+				s_threadIndex = ~BGFX_MAIN_THREAD_MAGIC;
+				return RenderFrame::NoContext;
 			}
-			rendererExecCommands(m_render->m_cmdPost);
-
-			renderSemPost();
 
-			if (m_rendererInitialized
-			&&  m_flipAfterRender)
+			BGFX_CHECK_RENDER_THREAD();
+			if (s_ctx->renderFrame() )
 			{
-				m_renderCtx->flip(m_render->m_hmd);
-				m_flipped = true;
+				Context* ctx = s_ctx;
+				ctx->apiSemWait();
+				s_ctx = NULL;
+				ctx->renderSemPost();
+				return RenderFrame::Exiting;
 			}
+
+			return RenderFrame::Render;
 		}
 
-		return m_exit;
+		BX_CHECK(false, "This call only makes sense if used with multi-threaded renderer.");
+		return RenderFrame::NoContext;
 	}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	const uint32_t g_uniformTypeSize[UniformType::Count+1] =
 	{
-		_uniformBuffer->reset(_begin);
-		while (_uniformBuffer->getPos() < _end)
-		{
-			uint32_t opcode = _uniformBuffer->read();
-
-			if (UniformType::End == opcode)
+		sizeof(int32_t),
+		0,
+		4*sizeof(float),
+		3*3*sizeof(float),
+		4*4*sizeof(float),
+		1,
+	};
+
+	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, true);
+		write(opcode);
+		write(_value, g_uniformTypeSize[_type]*_num);
+	}
+
+	void UniformBuffer::writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
+		write(opcode);
+		write(&_handle, sizeof(UniformHandle) );
+	}
+
+	void UniformBuffer::writeMarker(const char* _marker)
+	{
+		uint16_t num = (uint16_t)bx::strnlen(_marker)+1;
+		uint32_t opcode = encodeOpcode(bgfx::UniformType::Count, 0, num, true);
+		write(opcode);
+		write(_marker, num);
+	}
+
+	struct CapsFlags
+	{
+		uint64_t m_flag;
+		const char* m_str;
+	};
+
+	static const CapsFlags s_capsFlags[] =
+	{
+#define CAPS_FLAGS(_x) { _x, #_x }
+		CAPS_FLAGS(BGFX_CAPS_ALPHA_TO_COVERAGE),
+		CAPS_FLAGS(BGFX_CAPS_BLEND_INDEPENDENT),
+		CAPS_FLAGS(BGFX_CAPS_COMPUTE),
+		CAPS_FLAGS(BGFX_CAPS_CONSERVATIVE_RASTER),
+		CAPS_FLAGS(BGFX_CAPS_DRAW_INDIRECT),
+		CAPS_FLAGS(BGFX_CAPS_FRAGMENT_DEPTH),
+		CAPS_FLAGS(BGFX_CAPS_FRAGMENT_ORDERING),
+		CAPS_FLAGS(BGFX_CAPS_GRAPHICS_DEBUGGER),
+		CAPS_FLAGS(BGFX_CAPS_HIDPI),
+		CAPS_FLAGS(BGFX_CAPS_HMD),
+		CAPS_FLAGS(BGFX_CAPS_INDEX32),
+		CAPS_FLAGS(BGFX_CAPS_INSTANCING),
+		CAPS_FLAGS(BGFX_CAPS_OCCLUSION_QUERY),
+		CAPS_FLAGS(BGFX_CAPS_RENDERER_MULTITHREADED),
+		CAPS_FLAGS(BGFX_CAPS_SWAP_CHAIN),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_2D_ARRAY),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_3D),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_BLIT),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_ALL),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_LEQUAL),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_CUBE_ARRAY),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_MIN_LOD),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_READ_BACK),
+		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_HALF),
+		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_UINT10),
+#undef CAPS_FLAGS
+	};
+
+	static void dumpCaps()
+	{
+		BX_TRACE("");
+
+		if (0 < g_caps.numGPUs)
+		{
+			BX_TRACE("Detected GPUs (%d):", g_caps.numGPUs);
+			BX_TRACE("\t +----------------   Index");
+			BX_TRACE("\t |  +-------------   Device ID");
+			BX_TRACE("\t |  |    +--------   Vendor ID");
+			for (uint32_t ii = 0; ii < g_caps.numGPUs; ++ii)
+			{
+				const Caps::GPU& gpu = g_caps.gpu[ii];
+				BX_UNUSED(gpu);
+
+				BX_TRACE("\t %d: %04x %04x"
+					, ii
+					, gpu.deviceId
+					, gpu.vendorId
+					);
+			}
+
+			BX_TRACE("");
+		}
+
+		RendererType::Enum renderers[RendererType::Count];
+		uint8_t num = getSupportedRenderers(BX_COUNTOF(renderers), renderers);
+
+		BX_TRACE("Supported renderer backends (%d):", num);
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			BX_TRACE("\t - %s", getRendererName(renderers[ii]) );
+		}
+
+		BX_TRACE("");
+		BX_TRACE("Sort key masks:");
+		BX_TRACE("\t  View     %016" PRIx64, SORT_KEY_VIEW_MASK);
+		BX_TRACE("\t  Draw bit %016" PRIx64, SORT_KEY_DRAW_BIT);
+		BX_TRACE("\t  Seq      %016" PRIx64, SORT_KEY_SEQ_MASK);
+		BX_TRACE("\tD Trans    %016" PRIx64, SORT_KEY_DRAW_TRANS_MASK);
+		BX_TRACE("\tD Program  %016" PRIx64, SORT_KEY_DRAW_PROGRAM_MASK);
+		BX_TRACE("\tC Program  %016" PRIx64, SORT_KEY_COMPUTE_PROGRAM_MASK);
+		BX_TRACE("\tD Depth    %016" PRIx64, SORT_KEY_DRAW_DEPTH_MASK);
+
+		BX_TRACE("");
+		BX_TRACE("Supported capabilities (renderer %s, vendor 0x%04x, device 0x%04x):"
+				, s_ctx->m_renderCtx->getRendererName()
+				, g_caps.vendorId
+				, g_caps.deviceId
+				);
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_capsFlags); ++ii)
+		{
+			if (0 != (g_caps.supported & s_capsFlags[ii].m_flag) )
+			{
+				BX_TRACE("\t%s", s_capsFlags[ii].m_str);
+			}
+		}
+
+		BX_TRACE("");
+		BX_TRACE("Limits:");
+#define LIMITS(_x) BX_TRACE("\t%-24s %d", #_x, g_caps.limits._x)
+		LIMITS(maxDrawCalls);
+		LIMITS(maxBlits);
+		LIMITS(maxTextureSize);
+		LIMITS(maxViews);
+		LIMITS(maxFrameBuffers);
+		LIMITS(maxFBAttachments);
+		LIMITS(maxPrograms);
+		LIMITS(maxShaders);
+		LIMITS(maxTextures);
+		LIMITS(maxTextureSamplers);
+		LIMITS(maxVertexDecls);
+		LIMITS(maxVertexStreams);
+		LIMITS(maxIndexBuffers);
+		LIMITS(maxVertexBuffers);
+		LIMITS(maxDynamicIndexBuffers);
+		LIMITS(maxDynamicVertexBuffers);
+		LIMITS(maxUniforms);
+		LIMITS(maxOcclusionQueries);
+#undef LIMITS
+
+		BX_TRACE("");
+		BX_TRACE("Supported texture formats:");
+		BX_TRACE("\t +----------------   2D: x = supported / * = emulated");
+		BX_TRACE("\t |+---------------   2D: sRGB format");
+		BX_TRACE("\t ||+--------------   3D: x = supported / * = emulated");
+		BX_TRACE("\t |||+-------------   3D: sRGB format");
+		BX_TRACE("\t ||||+------------ Cube: x = supported / * = emulated");
+		BX_TRACE("\t |||||+----------- Cube: sRGB format");
+		BX_TRACE("\t ||||||+---------- vertex format");
+		BX_TRACE("\t |||||||+--------- image");
+		BX_TRACE("\t ||||||||+-------- framebuffer");
+		BX_TRACE("\t |||||||||+------- MSAA framebuffer");
+		BX_TRACE("\t ||||||||||+------ MSAA texture");
+		BX_TRACE("\t |||||||||||+----- Auto-generated mips");
+		BX_TRACE("\t ||||||||||||  +-- name");
+		for (uint32_t ii = 0; ii < TextureFormat::Count; ++ii)
+		{
+			if (TextureFormat::Unknown != ii
+			&&  TextureFormat::UnknownDepth != ii)
+			{
+				uint16_t flags = g_caps.formats[ii];
+				BX_TRACE("\t[%c%c%c%c%c%c%c%c%c%c%c%c] %s"
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_2D               ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED ? '*' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB          ? 'l' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_3D               ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED ? '*' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB          ? 'l' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE             ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED ? '*' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB        ? 'l' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_VERTEX           ? 'v' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_IMAGE            ? 'i' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER      ? 'f' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER_MSAA ? '+' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_MSAA             ? 'm' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_MIP_AUTOGEN      ? 'M' : ' '
+					, getName(TextureFormat::Enum(ii) )
+					);
+				BX_UNUSED(flags);
+			}
+		}
+
+		BX_TRACE("");
+		BX_TRACE("NDC depth [%d, 1], origin %s left."
+			, g_caps.homogeneousDepth ? -1 : 0
+			, g_caps.originBottomLeft ? "bottom" : "top"
+			);
+
+		BX_TRACE("");
+	}
+
+	TextureFormat::Enum getViableTextureFormat(const ImageContainer& _imageContainer)
+	{
+		const uint32_t formatCaps = g_caps.formats[_imageContainer.m_format];
+		bool convert = 0 == formatCaps;
+
+		if (_imageContainer.m_cubeMap)
+		{
+			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_CUBE)
+					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED)
+					;
+		}
+		else if (_imageContainer.m_depth > 1)
+		{
+			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_3D)
+					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED)
+					;
+		}
+		else
+		{
+			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_2D)
+					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED)
+					;
+		}
+
+		if (convert)
+		{
+			return TextureFormat::BGRA8;
+		}
+
+		return _imageContainer.m_format;
+	}
+
+	static TextureFormat::Enum s_emulatedFormats[] =
+	{
+		TextureFormat::BC1,
+		TextureFormat::BC2,
+		TextureFormat::BC3,
+		TextureFormat::BC4,
+		TextureFormat::BC5,
+		TextureFormat::ETC1,
+		TextureFormat::ETC2,
+		TextureFormat::ETC2A,
+		TextureFormat::ETC2A1,
+		TextureFormat::PTC14,
+		TextureFormat::PTC14A,
+		TextureFormat::BGRA8, // GL doesn't support BGRA8 without extensions.
+		TextureFormat::RGBA8, // D3D9 doesn't support RGBA8
+	};
+
+	bool Context::init(RendererType::Enum _type)
+	{
+		BX_CHECK(!m_rendererInitialized, "Already initialized?");
+
+		m_exit    = false;
+		m_flipped = true;
+		m_frames  = 0;
+		m_debug   = BGFX_DEBUG_NONE;
+
+		m_uniformCache.invalidate();
+		m_uniformUpdateBytes  = 0;
+		m_uniformSkippedBytes = 0;
+
+		m_submit->create();
+
+		m_cmdDeferred.start();
+		m_deferredCmd.clear();
+		m_numDeferredRetired  = 0;
+		m_numResourceCommands = 0;
+		m_numDeferredHandles  = 0;
+		m_numDeferredDraws    = 0;
+		bx::memSet(m_deferredIndexBuffer,  0, sizeof(m_deferredIndexBuffer) );
+		bx::memSet(m_deferredVertexBuffer, 0, sizeof(m_deferredVertexBuffer) );
+		bx::memSet(m_deferredProgram,      0, sizeof(m_deferredProgram) );
+		bx::memSet(m_deferredTexture,      0, sizeof(m_deferredTexture) );
+		bx::memSet(m_deferredFrameBuffer,  0, sizeof(m_deferredFrameBuffer) );
+		bx::memSet(m_deferredUniform,      0, sizeof(m_deferredUniform) );
+
+		m_encoderHandle.alloc();
+		m_encoder0 = reinterpret_cast<Encoder*>(&m_encoder[0]);
+		m_encoder[0].begin(m_submit, 0);
+
+#if BGFX_CONFIG_MULTITHREADED
+		m_render->create();
+
+		if (s_renderFrameCalled)
+		{
+			// When bgfx::renderFrame is called before init render thread
+			// should not be created.
+			BX_TRACE("Application called bgfx::renderFrame directly, not creating render thread.");
+			m_singleThreaded = true
+				&& ~BGFX_MAIN_THREAD_MAGIC == s_threadIndex
+				;
+		}
+		else
+		{
+			BX_TRACE("Creating rendering thread.");
+			m_thread.init(renderThread, this, 0, "bgfx - renderer backend thread");
+			m_singleThreaded = false;
+		}
+#else
+		BX_TRACE("Multithreaded renderer is disabled.");
+		m_singleThreaded = true;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		m_sortKeyRadixSort.init(BGFX_CONFIG_SORT_NUM_THREADS);
+		m_texturePrepare.init(BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS);
+
+		BX_TRACE("Running in %s-threaded mode", m_singleThreaded ? "single" : "multi");
+
+		s_threadIndex = BGFX_MAIN_THREAD_MAGIC;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_viewRemap); ++ii)
+		{
+			m_viewRemap[ii] = uint8_t(ii);
+		}
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			resetView(uint8_t(ii) );
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_clearColor); ++ii)
+		{
+			m_clearColor[ii][0] = 0.0f;
+			m_clearColor[ii][1] = 0.0f;
+			m_clearColor[ii][2] = 0.0f;
+			m_clearColor[ii][3] = 1.0f;
+		}
+
+		m_declRef.init();
+
+		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
+		cmdbuf.write(_type);
+
+		frameNoRenderWait();
+
+		// Make sure renderer init is called from render thread.
+		// g_caps is initialized and available after this point.
+		frame();
+
+		if (!m_rendererInitialized)
+		{
+			getCommandBuffer(CommandBuffer::RendererShutdownEnd);
+			frame();
+			frame();
+			m_declRef.shutdown(m_vertexDeclHandle);
+			m_submit->destroy();
+#if BGFX_CONFIG_MULTITHREADED
+			m_render->destroy();
+#endif // BGFX_CONFIG_MULTITHREADED
+			return false;
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_emulatedFormats); ++ii)
+		{
+			const uint32_t fmt = s_emulatedFormats[ii];
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_2D  ) ? BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_3D  ) ? BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_CUBE) ? BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
+		}
+
+		for (uint32_t ii = 0; ii < TextureFormat::UnknownDepth; ++ii)
+		{
+			bool convertable = imageConvert(TextureFormat::BGRA8, TextureFormat::Enum(ii) );
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_2D  ) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_3D  ) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_CUBE) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
+		}
+
+		g_caps.rendererType = m_renderCtx->getRendererType();
+		initAttribTypeSizeTable(g_caps.rendererType);
+
+		g_caps.supported |= 0
+			| (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) && !m_singleThreaded ? BGFX_CAPS_RENDERER_MULTITHREADED : 0)
+			| (isGraphicsDebuggerPresent() ? BGFX_CAPS_GRAPHICS_DEBUGGER : 0)
+			;
+
+		dumpCaps();
+
+		m_textVideoMemBlitter.init();
+		m_clearQuad.init();
+
+		m_submit->m_transientVb = createTransientVertexBuffer(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
+		m_submit->m_transientIb = createTransientIndexBuffer(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
+		frame();
+
+		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		{
+			m_submit->m_transientVb = createTransientVertexBuffer(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
+			m_submit->m_transientIb = createTransientIndexBuffer(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
+			frame();
+		}
+
+		g_internalData.caps = getCaps();
+
+		return true;
+	}
+
+	void Context::shutdown()
+	{
+		retireDeferredCommands(UINT32_MAX);
+		while (m_numDeferredRetired != uint32_t(m_deferredCmd.size() ) )
+		{
+			frame();
+			retireDeferredCommands(UINT32_MAX);
+		}
+
+		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
+		frame();
+
+		destroyTransientVertexBuffer(m_submit->m_transientVb);
+		destroyTransientIndexBuffer(m_submit->m_transientIb);
+		m_textVideoMemBlitter.shutdown();
+		m_clearQuad.shutdown();
+		frame();
+
+		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		{
+			destroyTransientVertexBuffer(m_submit->m_transientVb);
+			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			frame();
+		}
+
+		frame(); // If any VertexDecls needs to be destroyed.
+
+		getCommandBuffer(CommandBuffer::RendererShutdownEnd);
+		frame();
+
+		m_dynVertexBufferAllocator.compact();
+		m_dynIndexBufferAllocator.compact();
+
+		BX_CHECK(m_vertexDeclHandle.getNumHandles() == m_declRef.m_vertexDeclMap.getNumElements()
+				, "VertexDeclRef mismatch, num handles %d, handles in hash map %d."
+				, m_vertexDeclHandle.getNumHandles()
+				, m_declRef.m_vertexDeclMap.getNumElements()
+				);
+
+		m_declRef.shutdown(m_vertexDeclHandle);
+
+#if BGFX_CONFIG_MULTITHREADED
+		// Render thread shutdown sequence.
+		renderSemWait(); // Wait for previous frame.
+		apiSemPost();   // OK to set context to NULL.
+		// s_ctx is NULL here.
+		renderSemWait(); // In RenderFrame::Exiting state.
+
+		if (m_thread.isRunning() )
+		{
+			m_thread.shutdown();
+		}
+
+		m_render->destroy();
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		m_sortKeyRadixSort.shutdown();
+		m_texturePrepare.shutdown();
+		m_textureStreaming.shutdown();
+
+		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
+		s_ctx = NULL;
+
+		m_submit->destroy();
+
+		m_encoderHandle.free(0);
+		m_encoder0 = NULL;
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
+		{
+#define CHECK_HANDLE_LEAK(_handleAlloc) \
+					BX_MACRO_BLOCK_BEGIN \
+						BX_WARN(0 == _handleAlloc.getNumHandles() \
+							, "LEAK: " #_handleAlloc " %d (max: %d)" \
+							, _handleAlloc.getNumHandles() \
+							, _handleAlloc.getMaxHandles() \
+							); \
+					BX_MACRO_BLOCK_END
+
+			CHECK_HANDLE_LEAK(m_dynamicIndexBufferHandle);
+			CHECK_HANDLE_LEAK(m_dynamicVertexBufferHandle);
+			CHECK_HANDLE_LEAK(m_indexBufferHandle);
+			CHECK_HANDLE_LEAK(m_vertexDeclHandle);
+			CHECK_HANDLE_LEAK(m_vertexBufferHandle);
+			CHECK_HANDLE_LEAK(m_shaderHandle);
+			CHECK_HANDLE_LEAK(m_programHandle);
+			CHECK_HANDLE_LEAK(m_textureHandle);
+			CHECK_HANDLE_LEAK(m_frameBufferHandle);
+			CHECK_HANDLE_LEAK(m_uniformHandle);
+			CHECK_HANDLE_LEAK(m_occlusionQueryHandle);
+			CHECK_HANDLE_LEAK(m_encoderHandle);
+#undef CHECK_HANDLE_LEAK
+		}
+	}
+
+	void Context::freeDynamicBuffers()
+	{
+		for (uint16_t ii = 0, num = m_numFreeDynamicIndexBufferHandles; ii < num; ++ii)
+		{
+			destroyDynamicIndexBufferInternal(m_freeDynamicIndexBufferHandle[ii]);
+		}
+		m_numFreeDynamicIndexBufferHandles = 0;
+
+		for (uint16_t ii = 0, num = m_numFreeDynamicVertexBufferHandles; ii < num; ++ii)
+		{
+			destroyDynamicVertexBufferInternal(m_freeDynamicVertexBufferHandle[ii]);
+		}
+		m_numFreeDynamicVertexBufferHandles = 0;
+
+		for (uint16_t ii = 0, num = m_numFreeOcclusionQueryHandles; ii < num; ++ii)
+		{
+			m_occlusionQueryHandle.free(m_freeOcclusionQueryHandle[ii].idx);
+		}
+		m_numFreeOcclusionQueryHandles = 0;
+	}
+
+	void Context::freeAllHandles(Frame* _frame)
+	{
+		for (uint16_t ii = 0, num = _frame->m_freeIndexBuffer.getNumQueued(); ii < num; ++ii)
+		{
+			m_indexBufferHandle.free(_frame->m_freeIndexBuffer.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeVertexBuffer.getNumQueued(); ii < num; ++ii)
+		{
+			destroyVertexBufferInternal(_frame->m_freeVertexBuffer.get(ii));
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeVertexDecl.getNumQueued(); ii < num; ++ii)
+		{
+			m_vertexDeclHandle.free(_frame->m_freeVertexDecl.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeShader.getNumQueued(); ii < num; ++ii)
+		{
+			m_shaderHandle.free(_frame->m_freeShader.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeProgram.getNumQueued(); ii < num; ++ii)
+		{
+			m_programHandle.free(_frame->m_freeProgram.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeTexture.getNumQueued(); ii < num; ++ii)
+		{
+			m_textureHandle.free(_frame->m_freeTexture.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeFrameBuffer.getNumQueued(); ii < num; ++ii)
+		{
+			m_frameBufferHandle.free(_frame->m_freeFrameBuffer.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeUniform.getNumQueued(); ii < num; ++ii)
+		{
+			m_uniformHandle.free(_frame->m_freeUniform.get(ii).idx);
+		}
+	}
+
+	uint32_t Context::frame(bool _capture)
+	{
+		BX_CHECK(0 == m_instBufferCount, "Instance buffer allocated, but not used. This is incorrect, and causes memory leak.");
+		BX_CHECK(1 == m_encoderHandle.getNumHandles()
+			, "Encoders still in use (%d). All encoders obtained with bgfx::begin must be ended with bgfx::end before bgfx::frame is called."
+			, m_encoderHandle.getNumHandles() - 1
+			);
+
+		m_submit->m_capture = _capture;
+
+		textureStreamingUpdate();
+
+		BGFX_PROFILER_SCOPE(bgfx, main_thread_frame, 0xff2040ff);
+		// wait for render thread to finish
+		renderSemWait();
+		frameNoRenderWait();
+
+		return m_frames;
+	}
+
+	void Context::frameNoRenderWait()
+	{
+		swap();
+
+		// release render thread
+		apiSemPost();
+	}
+
+	void Context::swap()
+	{
+		// Textures must be decoded before render thread executes their
+		// CreateTexture commands.
+		m_texturePrepare.wait();
+
+		freeDynamicBuffers();
+		m_submit->m_resolution = m_resolution;
+		m_resolution.m_flags &= ~BGFX_RESET_INTERNAL_FORCE;
+		m_submit->m_debug = m_debug;
+
+		bx::memCopy(m_submit->m_viewRemap, m_viewRemap, sizeof(m_viewRemap) );
+		bx::memCopy(m_submit->m_fb, m_fb, sizeof(m_fb) );
+		bx::memCopy(m_submit->m_clear, m_clear, sizeof(m_clear) );
+		bx::memCopy(m_submit->m_rect, m_rect, sizeof(m_rect) );
+		bx::memCopy(m_submit->m_scissor, m_scissor, sizeof(m_scissor) );
+		bx::memCopy(m_submit->m_view, m_view, sizeof(m_view) );
+		bx::memCopy(m_submit->m_proj, m_proj, sizeof(m_proj) );
+		bx::memCopy(m_submit->m_viewFlags, m_viewFlags, sizeof(m_viewFlags) );
+		bx::memCopy(m_submit->m_seqMask, m_seqMask, sizeof(m_seqMask) );
+		if (m_colorPaletteDirty > 0)
+		{
+			--m_colorPaletteDirty;
+			bx::memCopy(m_submit->m_colorPalette, m_clearColor, sizeof(m_clearColor) );
+		}
+
+		m_numDeferredDraws = m_submit->m_numDeferredDraws;
+		BX_WARN(0 == m_numDeferredDraws
+			, "Skipped %d draw/compute calls using resources in deferred backlog."
+			, m_numDeferredDraws
+			);
+
+		m_submit->finish();
+
+		bx::xchg(m_render, m_submit);
+
+		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
+
+		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
+		||  m_singleThreaded)
+		{
+			renderFrame();
+		}
+
+		m_frames++;
+		m_submit->start();
+
+		m_numResourceCommands = 0;
+		retireDeferredCommands(BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME);
+
+		bx::memSet(m_seq, 0, sizeof(m_seq) );
+		m_encoder[0].begin(m_submit, 0);
+		freeAllHandles(m_submit);
+
+		m_submit->resetFreeHandles();
+		m_submit->m_textVideoMem->resize(m_render->m_textVideoMem->m_small
+			, m_resolution.m_width
+			, m_resolution.m_height
+			);
+	}
+
+	void Context::retireDeferredCommands(uint32_t _budget)
+	{
+		const uint32_t num = uint32_t(m_deferredCmd.size() );
+		if (m_numDeferredRetired == num)
+		{
+			return;
+		}
+
+		// Renderer executes pre commands before post commands of the same
+		// frame. Retiring stops at first pre command following post command
+		// (destroy, read back), so it's not executed ahead of it.
+		uint32_t last  = m_numDeferredRetired;
+		uint32_t count = 0;
+		uint32_t split = num;
+		for (; last < num; ++last)
+		{
+			const DeferredCommand& dc = m_deferredCmd[last];
+			const bool post = CommandBuffer::End < dc.m_cmd;
+			if (post)
+			{
+				split = bx::uint32_min(split, last);
+			}
+			else if (num != split)
+			{
+				break;
+			}
+
+			if (dc.m_create)
+			{
+				if (count == _budget)
+				{
+					break;
+				}
+
+				++count;
+			}
+
+			if (invalidHandle != dc.m_handle)
+			{
+				uint8_t* deferred = getDeferredHandles(dc.m_cmd);
+				--deferred[dc.m_handle];
+				--m_numDeferredHandles;
+			}
+		}
+
+		split = bx::uint32_min(split, last);
+
+		// Commands in deferred buffer start at command alignment, copying them
+		// at the same alignment preserves padding of their payload.
+		const uint32_t begin  = m_deferredCmd[m_numDeferredRetired].m_offset;
+		const uint32_t middle = split < num ? m_deferredCmd[split].m_offset : m_cmdDeferred.m_pos;
+		const uint32_t end    = last  < num ? m_deferredCmd[last].m_offset  : m_cmdDeferred.m_pos;
+
+		if (begin != middle)
+		{
+			CommandBuffer& cmdbuf = m_submit->m_cmdPre;
+			cmdbuf.align(CommandBuffer::CommandAlignment);
+			cmdbuf.write(&m_cmdDeferred.m_buffer[begin], middle-begin);
+		}
+
+		if (middle != end)
+		{
+			CommandBuffer& cmdbuf = m_submit->m_cmdPost;
+			cmdbuf.align(CommandBuffer::CommandAlignment);
+			cmdbuf.write(&m_cmdDeferred.m_buffer[middle], end-middle);
+		}
+
+		m_numResourceCommands += count;
+
+		if (last == num)
+		{
+			m_cmdDeferred.start();
+			m_deferredCmd.clear();
+			m_numDeferredRetired = 0;
+		}
+		else
+		{
+			m_numDeferredRetired = last;
+		}
+
+		BX_TRACE("Retired %d deferred resource commands, %d remaining."
+			, count
+			, num - last
+			);
+	}
+
+	const char* Context::getName(UniformHandle _handle) const
+	{
+		return m_uniformRef[_handle.idx].m_name.getPtr();
+	}
+
+	bool Context::renderFrame()
+	{
+		BGFX_PROFILER_SCOPE(bgfx, render_frame, 0xff2040ff);
+
+		if (m_rendererInitialized
+		&& !m_flipAfterRender
+		&& !m_flipped)
+		{
+			m_renderCtx->flip(m_render->m_hmd);
+			m_flipped = true;
+		}
+
+		if (apiSemWait(BGFX_CONFIG_API_SEMAPHORE_TIMEOUT) )
+		{
+			rendererExecCommands(m_render->m_cmdPre);
+			if (m_rendererInitialized)
+			{
+				BGFX_PROFILER_SCOPE(bgfx, render_submit, 0xff2040ff);
+				m_uniformUpdateBytes  = 0;
+				m_uniformSkippedBytes = 0;
+				m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
+				m_render->m_perfStats.uniformUpdateBytes  = m_uniformUpdateBytes;
+				m_render->m_perfStats.uniformSkippedBytes = m_uniformSkippedBytes;
+				m_flipped = false;
+			}
+			rendererExecCommands(m_render->m_cmdPost);
+
+			renderSemPost();
+
+			if (m_rendererInitialized
+			&&  m_flipAfterRender)
+			{
+				m_renderCtx->flip(m_render->m_hmd);
+				m_flipped = true;
+			}
+		}
+
+		return m_exit;
+	}
+
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	{
+		// Renderer keeps copy of last value of each uniform, and values that
+		// didn't change are skipped. Returns true when any uniform changed.
+		UniformCache& uniformCache = s_ctx->m_uniformCache;
+		bool changed = false;
+
+		_uniformBuffer->reset(_begin);
+		while (_uniformBuffer->getPos() < _end)
+		{
+			uint32_t opcode = _uniformBuffer->read();
+
+			if (UniformType::End == opcode)
 			{
 				break;
 			}
@@ -1704,13 +2779,17 @@ namespace bgfx
 			const char* data = _uniformBuffer->read(size);
 			if (UniformType::Count > type)
 			{
-				if (copy)
+				const char* value = copy ? data : *(const char**)(data);
+
+				if (!uniformCache.update(loc, value, size) )
 				{
-					_renderCtx->updateUniform(loc, data, size);
+					s_ctx->m_uniformSkippedBytes += size;
 				}
 				else
 				{
-					_renderCtx->updateUniform(loc, *(const char**)(data), size);
+					s_ctx->m_uniformUpdateBytes += size;
+					_renderCtx->updateUniform(loc, value, size);
+					changed = true;
 				}
 			}
 			else
@@ -1718,6 +2797,30 @@ namespace bgfx
 				_renderCtx->setMarker(data, size);
 			}
 		}
+
+		return changed;
+	}
+
+	bool rendererUpdateViewUniforms(RendererContextI* _renderCtx, Frame* _render, uint16_t _view)
+	{
+		bool changed = false;
+
+		const uint16_t scope[] = { BGFX_CONFIG_MAX_VIEWS, _view };
+		for (uint32_t ii = 0; ii < BX_COUNTOF(scope); ++ii)
+		{
+			for (uint16_t idx = _render->m_viewUniformFirst[scope[ii] ]; UINT16_MAX != idx; idx = _render->m_viewUniformRange[idx].m_next)
+			{
+				const ViewUniformRange& range = _render->m_viewUniformRange[idx];
+				changed |= rendererUpdateUniforms(_renderCtx, _render->m_viewUniformBuffer, range.m_begin, range.m_end);
+			}
+		}
+
+		return changed;
+	}
+
+	void rendererInvalidateUniforms()
+	{
+		s_ctx->m_uniformCache.invalidate();
 	}
 
 	void Context::flushTextureUpdateBatch(CommandBuffer& _cmdbuf)
@@ -1977,8 +3080,7 @@ namespace bgfx
 
 		if (NULL == m_renderCtx)
 		{
-			uint8_t command;
-			_cmdbuf.read(command);
+			uint8_t command = _cmdbuf.readCommand();
 
 			switch (command)
 			{
@@ -2005,7 +3107,7 @@ namespace bgfx
 
 					if (!m_rendererInitialized)
 					{
-						_cmdbuf.read(command);
+						command = _cmdbuf.readCommand();
 						BX_CHECK(CommandBuffer::End == command, "Unexpected command %d?"
 							, command
 							);
@@ -2018,8 +3120,7 @@ namespace bgfx
 
 		do
 		{
-			uint8_t command;
-			_cmdbuf.read(command);
+			uint8_t command = _cmdbuf.readCommand();
 
 			switch (command)
 			{
@@ -2036,6 +3137,11 @@ namespace bgfx
 					rendererDestroy();
 					m_renderCtx = NULL;
 					m_exit = true;
+
+					for (uint16_t ii = 0; ii < BGFX_CONFIG_MAX_UNIFORMS; ++ii)
+					{
+						m_uniformCache.destroy(ii);
+					}
 				}
 				// fall through
 
@@ -2352,7 +3458,19 @@ namespace bgfx
 					uint8_t numMips;
 					_cmdbuf.read(numMips);
 
-					m_renderCtx->resizeTexture(handle, width, height, numMips);
+					m_renderCtx->resizeTexture(handle, width, height, numMips);
+				}
+				break;
+
+			case CommandBuffer::SetTextureMinLod:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint8_t lod;
+					_cmdbuf.read(lod);
+
+					m_renderCtx->setTextureMinLod(handle, lod);
 				}
 				break;
 
@@ -2428,6 +3546,7 @@ namespace bgfx
 					const char* name = (const char*)_cmdbuf.skip(len);
 
 					m_renderCtx->createUniform(handle, type, num, name);
+					m_uniformCache.create(handle.idx, g_uniformTypeSize[type]*num);
 				}
 				break;
 
@@ -2437,6 +3556,7 @@ namespace bgfx
 					_cmdbuf.read(handle);
 
 					m_renderCtx->destroyUniform(handle);
+					m_uniformCache.destroy(handle.idx);
 				}
 				break;
 
@@ -2474,6 +3594,11 @@ namespace bgfx
 		flushTextureUpdateBatch(_cmdbuf);
 	}
 
+	uint32_t weldVertices(uint32_t* _output, const VertexDecl& _decl, const void* _data, uint32_t _num, float _epsilon, uint8_t _flags)
+	{
+		return weldVertices(_output, _decl, _data, _num, _epsilon, _flags, g_allocator);
+	}
+
 	uint32_t topologyConvert(TopologyConvert::Enum _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32)
 	{
 		return topologyConvert(_conversion, _dst, _dstSize, _indices, _numIndices, _index32, g_allocator);
@@ -2484,6 +3609,41 @@ namespace bgfx
 		topologySortTriList(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, g_allocator);
 	}
 
+	void topologySortTriListCoherent(TopologySort::Enum _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, uint32_t* _order, bool _multithreaded)
+	{
+		topologySortTriListCoherent(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, _order, _multithreaded, g_allocator);
+	}
+
+	uint32_t topologyOptimize(TopologyOptimize::Enum _optimize, void* _dst, uint32_t _dstSize, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+	{
+		return topologyOptimize(_optimize, _dst, _dstSize, _vertices, _numVertices, _stride, _indices, _numIndices, _index32, g_allocator);
+	}
+
+	uint32_t topologyOptimizeVertexFetch(void* _dst, uint32_t _dstSize, const void* _vertices, uint32_t _numVertices, uint32_t _stride, void* _indices, uint32_t _numIndices, bool _index32)
+	{
+		return topologyOptimizeVertexFetch(_dst, _dstSize, _vertices, _numVertices, _stride, _indices, _numIndices, _index32, g_allocator);
+	}
+
+	void topologyCalcStats(TopologyStats* _stats, uint32_t _cacheSize, const void* _indices, uint32_t _numIndices, uint32_t _numVertices, bool _index32)
+	{
+		topologyCalcStats(_stats, _cacheSize, _indices, _numIndices, _numVertices, _index32, g_allocator);
+	}
+
+	uint32_t topologyBuildClusters(TopologyCluster* _clusters, uint32_t _maxClusters, void* _dst, uint32_t _dstSize, uint32_t _maxTriangles, uint32_t _maxVertices, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+	{
+		return topologyBuildClusters(_clusters, _maxClusters, _dst, _dstSize, _maxTriangles, _maxVertices, _vertices, _numVertices, _stride, _indices, _numIndices, _index32, g_allocator);
+	}
+
+	uint32_t topologyBuildEdges(TopologyEdge* _edges, uint32_t _maxEdges, const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+	{
+		return topologyBuildEdges(_edges, _maxEdges, _vertices, _stride, _indices, _numIndices, _index32, g_allocator);
+	}
+
+	uint32_t topologySimplify(void* _dst, uint32_t _dstSize, uint32_t _numTargetIndices, float _maxError, const VertexDecl& _decl, const void* _vertices, uint32_t _numVertices, const void* _indices, uint32_t _numIndices, bool _index32)
+	{
+		return topologySimplify(_dst, _dstSize, _numTargetIndices, _maxError, _decl, _vertices, _numVertices, _indices, _numIndices, _index32, g_allocator);
+	}
+
 	uint8_t getSupportedRenderers(uint8_t _max, RendererType::Enum* _enum)
 	{
 		_enum = _max == 0 ? NULL : _enum;
@@ -2636,1005 +3796,1356 @@ error:
 			break;
 		}
 
-		return false;
+		return false;
+	}
+
+	void shutdown()
+	{
+		BX_TRACE("Shutdown...");
+
+		BGFX_CHECK_MAIN_THREAD();
+		Context* ctx = s_ctx; // it's going to be NULLd inside shutdown.
+		ctx->shutdown();
+		BX_CHECK(NULL == s_ctx, "bgfx is should be uninitialized here.");
+
+		BX_ALIGNED_DELETE(g_allocator, ctx, 16);
+
+		BX_TRACE("Shutdown complete.");
+
+		if (NULL != s_allocatorStub)
+		{
+			s_allocatorStub->checkLeaks();
+		}
+
+		if (NULL != s_callbackStub)
+		{
+			BX_DELETE(g_allocator, s_callbackStub);
+			s_callbackStub = NULL;
+		}
+
+		if (NULL != s_allocatorStub)
+		{
+			bx::CrtAllocator allocator;
+			BX_DELETE(&allocator, s_allocatorStub);
+			s_allocatorStub = NULL;
+		}
+
+		s_threadIndex = 0;
+		g_callback    = NULL;
+		g_allocator   = NULL;
+	}
+
+	void reset(uint32_t _width, uint32_t _height, uint32_t _flags)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(0 == (_flags&BGFX_RESET_RESERVED_MASK), "Do not set reset reserved flags!");
+		s_ctx->reset(_width, _height, _flags);
+	}
+
+	uint32_t frame(bool _capture)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		return s_ctx->frame(_capture);
+	}
+
+	const Caps* getCaps()
+	{
+		return &g_caps;
+	}
+
+	const HMD* getHMD()
+	{
+		return s_ctx->getHMD();
+	}
+
+	const Stats* getStats()
+	{
+		return s_ctx->getPerfStats();
+	}
+
+	RendererType::Enum getRendererType()
+	{
+		return g_caps.rendererType;
+	}
+
+	const Memory* alloc(uint32_t _size)
+	{
+		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
+		Memory* mem = (Memory*)BX_ALLOC(g_allocator, sizeof(Memory) + _size);
+		mem->size = _size;
+		mem->data = (uint8_t*)mem + sizeof(Memory);
+		return mem;
+	}
+
+	const Memory* copy(const void* _data, uint32_t _size)
+	{
+		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
+		const Memory* mem = alloc(_size);
+		bx::memCopy(mem->data, _data, _size);
+		return mem;
+	}
+
+	struct MemoryRef
+	{
+		Memory mem;
+		ReleaseFn releaseFn;
+		void* userData;
+	};
+
+	const Memory* makeRef(const void* _data, uint32_t _size, ReleaseFn _releaseFn, void* _userData)
+	{
+		MemoryRef* memRef = (MemoryRef*)BX_ALLOC(g_allocator, sizeof(MemoryRef) );
+		memRef->mem.size  = _size;
+		memRef->mem.data  = (uint8_t*)_data;
+		memRef->releaseFn = _releaseFn;
+		memRef->userData  = _userData;
+		return &memRef->mem;
+	}
+
+	bool isMemoryRef(const Memory* _mem)
+	{
+		return _mem->data != (uint8_t*)_mem + sizeof(Memory);
+	}
+
+	void release(const Memory* _mem)
+	{
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		Memory* mem = const_cast<Memory*>(_mem);
+		if (isMemoryRef(mem) )
+		{
+			MemoryRef* memRef = reinterpret_cast<MemoryRef*>(mem);
+			if (NULL != memRef->releaseFn)
+			{
+				memRef->releaseFn(mem->data, memRef->userData);
+			}
+		}
+		BX_FREE(g_allocator, mem);
+	}
+
+	void setDebug(uint32_t _debug)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->setDebug(_debug);
+	}
+
+	void dbgTextClear(uint8_t _attr, bool _small)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->dbgTextClear(_attr, _small);
+	}
+
+	void dbgTextPrintfVargs(uint16_t _x, uint16_t _y, uint8_t _attr, const char* _format, va_list _argList)
+	{
+		s_ctx->dbgTextPrintfVargs(_x, _y, _attr, _format, _argList);
+	}
+
+	void dbgTextPrintf(uint16_t _x, uint16_t _y, uint8_t _attr, const char* _format, ...)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		va_list argList;
+		va_start(argList, _format);
+		s_ctx->dbgTextPrintfVargs(_x, _y, _attr, _format, argList);
+		va_end(argList);
+	}
+
+	void dbgTextImage(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const void* _data, uint16_t _pitch)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->dbgTextImage(_x, _y, _width, _height, _data, _pitch);
+	}
+
+	IndexBufferHandle createIndexBuffer(const Memory* _mem, uint16_t _flags)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		return s_ctx->createIndexBuffer(_mem, _flags);
+	}
+
+	void destroyIndexBuffer(IndexBufferHandle _handle)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyIndexBuffer(_handle);
+	}
+
+	VertexBufferHandle createVertexBuffer(const Memory* _mem, const VertexDecl& _decl, uint16_t _flags)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
+		return s_ctx->createVertexBuffer(_mem, _decl, _flags);
+	}
+
+	void destroyVertexBuffer(VertexBufferHandle _handle)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyVertexBuffer(_handle);
+	}
+
+	DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		return s_ctx->createDynamicIndexBuffer(_num, _flags);
+	}
+
+	DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint16_t _flags)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		return s_ctx->createDynamicIndexBuffer(_mem, _flags);
+	}
+
+	void updateDynamicIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		s_ctx->updateDynamicIndexBuffer(_handle, _startIndex, _mem);
+	}
+
+	void destroyDynamicIndexBuffer(DynamicIndexBufferHandle _handle)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyDynamicIndexBuffer(_handle);
+	}
+
+	DynamicVertexBufferHandle createDynamicVertexBuffer(uint32_t _num, const VertexDecl& _decl, uint16_t _flags)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
+		return s_ctx->createDynamicVertexBuffer(_num, _decl, _flags);
+	}
+
+	DynamicVertexBufferHandle createDynamicVertexBuffer(const Memory* _mem, const VertexDecl& _decl, uint16_t _flags)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
+		return s_ctx->createDynamicVertexBuffer(_mem, _decl, _flags);
+	}
+
+	void updateDynamicVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		s_ctx->updateDynamicVertexBuffer(_handle, _startVertex, _mem);
+	}
+
+	void destroyDynamicVertexBuffer(DynamicVertexBufferHandle _handle)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyDynamicVertexBuffer(_handle);
 	}
 
-	void shutdown()
+	uint32_t getAvailTransientIndexBuffer(uint32_t _num)
 	{
-		BX_TRACE("Shutdown...");
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(0 < _num, "Requesting 0 indices.");
+		return s_ctx->getAvailTransientIndexBuffer(_num);
+	}
 
+	uint32_t getAvailTransientVertexBuffer(uint32_t _num, const VertexDecl& _decl)
+	{
 		BGFX_CHECK_MAIN_THREAD();
-		Context* ctx = s_ctx; // it's going to be NULLd inside shutdown.
-		ctx->shutdown();
-		BX_CHECK(NULL == s_ctx, "bgfx is should be uninitialized here.");
+		BX_CHECK(0 < _num, "Requesting 0 vertices.");
+		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
+		return s_ctx->getAvailTransientVertexBuffer(_num, _decl.m_stride);
+	}
 
-		BX_ALIGNED_DELETE(g_allocator, ctx, 16);
+	uint32_t getAvailInstanceDataBuffer(uint32_t _num, uint16_t _stride)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(0 < _num, "Requesting 0 instances.");
+		return s_ctx->getAvailTransientVertexBuffer(_num, _stride);
+	}
 
-		BX_TRACE("Shutdown complete.");
+	void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _tib, "_tib can't be NULL");
+		BX_CHECK(0 < _num, "Requesting 0 indices.");
+		s_ctx->allocTransientIndexBuffer(_tib, _num);
+		BX_CHECK(_num == _tib->size/2, "Failed to allocate transient index buffer (requested %d, available %d). Use bgfx::checkAvailTransient* functions to ensure availability."
+			, _num
+			, _tib->size/2
+			);
+	}
 
-		if (NULL != s_allocatorStub)
-		{
-			s_allocatorStub->checkLeaks();
-		}
+	void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _tvb, "_tvb can't be NULL");
+		BX_CHECK(0 < _num, "Requesting 0 vertices.");
+		BX_CHECK(UINT16_MAX >= _num, "Requesting %d vertices (max: %d).", _num, UINT16_MAX);
+		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
+		s_ctx->allocTransientVertexBuffer(_tvb, _num, _decl);
+		BX_CHECK(_num == _tvb->size / _decl.m_stride, "Failed to allocate transient vertex buffer (requested %d, available %d). Use bgfx::checkAvailTransient* functions to ensure availability."
+			, _num
+			, _tvb->size / _decl.m_stride
+			);
+	}
 
-		if (NULL != s_callbackStub)
+	bool allocTransientBuffers(bgfx::TransientVertexBuffer* _tvb, const bgfx::VertexDecl& _decl, uint32_t _numVertices, bgfx::TransientIndexBuffer* _tib, uint32_t _numIndices)
+	{
+		if (_numVertices == getAvailTransientVertexBuffer(_numVertices, _decl)
+		&&  _numIndices  == getAvailTransientIndexBuffer(_numIndices) )
 		{
-			BX_DELETE(g_allocator, s_callbackStub);
-			s_callbackStub = NULL;
+			allocTransientVertexBuffer(_tvb, _numVertices, _decl);
+			allocTransientIndexBuffer(_tib, _numIndices);
+			return true;
 		}
 
-		if (NULL != s_allocatorStub)
-		{
-			bx::CrtAllocator allocator;
-			BX_DELETE(&allocator, s_allocatorStub);
-			s_allocatorStub = NULL;
-		}
+		return false;
+	}
 
-		s_threadIndex = 0;
-		g_callback    = NULL;
-		g_allocator   = NULL;
+	const InstanceDataBuffer* allocInstanceDataBuffer(uint32_t _num, uint16_t _stride)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BGFX_CHECK_CAPS(BGFX_CAPS_INSTANCING, "Instancing is not supported!");
+		BX_CHECK(0 < _num, "Requesting 0 instanced data vertices.");
+		const InstanceDataBuffer* idb = s_ctx->allocInstanceDataBuffer(_num, _stride);
+		BX_CHECK(_num == idb->size / _stride, "Failed to allocate instance data buffer (requested %d, available %d). Use bgfx::checkAvailTransient* functions to ensure availability."
+			, _num
+			, idb->size / _stride
+			);
+		return idb;
 	}
 
-	void reset(uint32_t _width, uint32_t _height, uint32_t _flags)
+	IndirectBufferHandle createIndirectBuffer(uint32_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(0 == (_flags&BGFX_RESET_RESERVED_MASK), "Do not set reset reserved flags!");
-		s_ctx->reset(_width, _height, _flags);
+		return s_ctx->createIndirectBuffer(_num);
 	}
 
-	uint32_t frame(bool _capture)
+	void destroyIndirectBuffer(IndirectBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->frame(_capture);
+		s_ctx->destroyIndirectBuffer(_handle);
 	}
 
-	const Caps* getCaps()
+	ShaderHandle createShader(const Memory* _mem)
 	{
-		return &g_caps;
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		return s_ctx->createShader(_mem);
 	}
 
-	const HMD* getHMD()
+	uint16_t getShaderUniforms(ShaderHandle _handle, UniformHandle* _uniforms, uint16_t _max)
 	{
-		return s_ctx->getHMD();
+		BGFX_CHECK_MAIN_THREAD();
+		return s_ctx->getShaderUniforms(_handle, _uniforms, _max);
 	}
 
-	const Stats* getStats()
+	void destroyShader(ShaderHandle _handle)
 	{
-		return s_ctx->getPerfStats();
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyShader(_handle);
 	}
 
-	RendererType::Enum getRendererType()
+	ProgramHandle createProgram(ShaderHandle _vsh, ShaderHandle _fsh, bool _destroyShaders)
 	{
-		return g_caps.rendererType;
+		BGFX_CHECK_MAIN_THREAD();
+		if (!isValid(_fsh) )
+		{
+			return createProgram(_vsh, _destroyShaders);
+		}
+
+		return s_ctx->createProgram(_vsh, _fsh, _destroyShaders);
 	}
 
-	const Memory* alloc(uint32_t _size)
+	ProgramHandle createProgram(ShaderHandle _csh, bool _destroyShader)
 	{
-		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
-		Memory* mem = (Memory*)BX_ALLOC(g_allocator, sizeof(Memory) + _size);
-		mem->size = _size;
-		mem->data = (uint8_t*)mem + sizeof(Memory);
-		return mem;
+		BGFX_CHECK_MAIN_THREAD();
+		return s_ctx->createProgram(_csh, _destroyShader);
 	}
 
-	const Memory* copy(const void* _data, uint32_t _size)
+	void destroyProgram(ProgramHandle _handle)
 	{
-		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
-		const Memory* mem = alloc(_size);
-		bx::memCopy(mem->data, _data, _size);
-		return mem;
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyProgram(_handle);
 	}
 
-	struct MemoryRef
+	static void isTextureValid(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, bx::Error* _err)
 	{
-		Memory mem;
-		ReleaseFn releaseFn;
-		void* userData;
-	};
+		BX_ERROR_SCOPE(_err);
 
-	const Memory* makeRef(const void* _data, uint32_t _size, ReleaseFn _releaseFn, void* _userData)
+		const bool is3DTexture = 1 < _depth;
+
+		if (_cubeMap && is3DTexture)
+		{
+			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
+				, "Texture can't be depth and cube map at the same time."
+				);
+			return;
+		}
+
+		if (is3DTexture
+		&& 	0 == (g_caps.supported & BGFX_CAPS_TEXTURE_3D) )
+		{
+			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
+				, "Texture3D is not supported! "
+				  "Use bgfx::getCaps to check BGFX_CAPS_TEXTURE_3D backend renderer capabilities."
+				);
+			return;
+		}
+
+		if (0 != (_flags & BGFX_TEXTURE_RT_MASK)
+		&&  0 != (_flags & BGFX_TEXTURE_READ_BACK) )
+		{
+			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
+				, "Can't create render target with BGFX_TEXTURE_READ_BACK flag."
+				);
+			return;
+		}
+
+		if (1 < _numLayers
+		&&  0 == (g_caps.supported & BGFX_CAPS_TEXTURE_2D_ARRAY) )
+		{
+			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
+				, "Texture array is not supported! "
+				  "Use bgfx::getCaps to check BGFX_CAPS_TEXTURE_2D_ARRAY backend renderer capabilities."
+				);
+			return;
+		}
+
+		bool formatSupported = 0 != (g_caps.formats[_format] & (0
+				| BGFX_CAPS_FORMAT_TEXTURE_2D
+				| BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED
+				| BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB
+				) );
+		uint16_t srgbCaps = BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB;
+
+		if (_cubeMap)
+		{
+			formatSupported = 0 != (g_caps.formats[_format] & (0
+				| BGFX_CAPS_FORMAT_TEXTURE_CUBE
+				| BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED
+				| BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB
+				) );
+			srgbCaps = BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB;
+		}
+		else if (is3DTexture)
+		{
+			formatSupported = 0 != (g_caps.formats[_format] & (0
+				| BGFX_CAPS_FORMAT_TEXTURE_3D
+				| BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED
+				| BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB
+				) );
+			srgbCaps = BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB;
+		}
+
+		if (!formatSupported)
+		{
+			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
+				, "Texture format is not supported! "
+				  "Use bgfx::isTextureValid to check support for texture format before creating it."
+				);
+			return;
+		}
+
+		if (0 != (_flags & BGFX_TEXTURE_MSAA_SAMPLE)
+		&&  0 == (g_caps.supported & BGFX_CAPS_FORMAT_TEXTURE_MSAA) )
+		{
+			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
+				, "MSAA sampling for this texture format is not supported."
+				);
+			return;
+		}
+
+		if (0 != (_flags & BGFX_TEXTURE_SRGB)
+		&&  0 == (g_caps.supported & srgbCaps & (0
+				| BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB
+				| BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB
+				| BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB
+				) ) )
+		{
+			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
+				, "sRGB sampling for this texture format is not supported."
+				);
+			return;
+		}
+	}
+
+	bool isTextureValid(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags)
 	{
-		MemoryRef* memRef = (MemoryRef*)BX_ALLOC(g_allocator, sizeof(MemoryRef) );
-		memRef->mem.size  = _size;
-		memRef->mem.data  = (uint8_t*)_data;
-		memRef->releaseFn = _releaseFn;
-		memRef->userData  = _userData;
-		return &memRef->mem;
+		bx::Error err;
+		isTextureValid(_depth, _cubeMap, _numLayers, _format, _flags, &err);
+		return err.isOk();
 	}
 
-	bool isMemoryRef(const Memory* _mem)
+	void calcTextureSize(TextureInfo& _info, uint16_t _width, uint16_t _height, uint16_t _depth, bool _cubeMap, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format)
 	{
-		return _mem->data != (uint8_t*)_mem + sizeof(Memory);
+		imageGetSize(&_info, _width, _height, _depth, _cubeMap, _hasMips, _numLayers, _format);
 	}
 
-	void release(const Memory* _mem)
+	TextureHandle createTexture(const Memory* _mem, uint32_t _flags, uint8_t _skip, TextureInfo* _info)
 	{
+		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		Memory* mem = const_cast<Memory*>(_mem);
-		if (isMemoryRef(mem) )
-		{
-			MemoryRef* memRef = reinterpret_cast<MemoryRef*>(mem);
-			if (NULL != memRef->releaseFn)
-			{
-				memRef->releaseFn(mem->data, memRef->userData);
-			}
-		}
-		BX_FREE(g_allocator, mem);
+		return s_ctx->createTexture(_mem, _flags, _skip, _info, BackbufferRatio::Count);
 	}
 
-	void setDebug(uint32_t _debug)
+	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setDebug(_debug);
+		switch (_ratio)
+		{
+		case BackbufferRatio::Half:      _width /=  2; _height /=  2; break;
+		case BackbufferRatio::Quarter:   _width /=  4; _height /=  4; break;
+		case BackbufferRatio::Eighth:    _width /=  8; _height /=  8; break;
+		case BackbufferRatio::Sixteenth: _width /= 16; _height /= 16; break;
+		case BackbufferRatio::Double:    _width *=  2; _height *=  2; break;
+
+		default:
+			break;
+		}
+
+		_width  = bx::uint16_max(1, _width);
+		_height = bx::uint16_max(1, _height);
 	}
 
-	void dbgTextClear(uint8_t _attr, bool _small)
+	static TextureHandle createTexture2D(BackbufferRatio::Enum _ratio, uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->dbgTextClear(_attr, _small);
+
+		bx::Error err;
+		isTextureValid(0, false, _numLayers, _format, _flags, &err);
+		BX_CHECK(err.isOk(), "%s (layers %d, format %s)"
+			, err.getMessage().getPtr()
+			, _numLayers
+			, getName(_format)
+			);
+
+		if (BackbufferRatio::Count != _ratio)
+		{
+			_width  = uint16_t(s_ctx->m_resolution.m_width);
+			_height = uint16_t(s_ctx->m_resolution.m_height);
+			getTextureSizeFromRatio(_ratio, _width, _height);
+		}
+
+		const uint8_t numMips = calcNumMips(_hasMips, _width, _height);
+		_numLayers = bx::uint16_max(_numLayers, 1);
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG)
+		&&  NULL != _mem)
+		{
+			TextureInfo ti;
+			calcTextureSize(ti, _width, _height, 1, false, _hasMips, _numLayers, _format);
+			BX_CHECK(ti.storageSize == _mem->size
+				, "createTexture2D: Texture storage size doesn't match passed memory size (storage size: %d, memory size: %d)"
+				, ti.storageSize
+				, _mem->size
+				);
+		}
+
+		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
+		const Memory* mem = alloc(size);
+
+		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+		bx::write(&writer, magic);
+
+		TextureCreate tc;
+		tc.m_width     = _width;
+		tc.m_height    = _height;
+		tc.m_depth     = 0;
+		tc.m_numLayers = _numLayers;
+		tc.m_numMips   = numMips;
+		tc.m_format    = _format;
+		tc.m_cubeMap   = false;
+		tc.m_mem       = _mem;
+		bx::write(&writer, tc);
+
+		return s_ctx->createTexture(mem, _flags, 0, NULL, _ratio);
 	}
 
-	void dbgTextPrintfVargs(uint16_t _x, uint16_t _y, uint8_t _attr, const char* _format, va_list _argList)
+	TextureHandle createTexture2D(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
 	{
-		s_ctx->dbgTextPrintfVargs(_x, _y, _attr, _format, _argList);
+		BX_CHECK(_width > 0 && _height > 0, "Invalid texture size (width %d, height %d).", _width, _height);
+		return createTexture2D(BackbufferRatio::Count, _width, _height, _hasMips, _numLayers, _format, _flags, _mem);
 	}
 
-	void dbgTextPrintf(uint16_t _x, uint16_t _y, uint8_t _attr, const char* _format, ...)
+	TextureHandle createTexture2D(BackbufferRatio::Enum _ratio, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		va_list argList;
-		va_start(argList, _format);
-		s_ctx->dbgTextPrintfVargs(_x, _y, _attr, _format, argList);
-		va_end(argList);
+		BX_CHECK(_ratio < BackbufferRatio::Count, "Invalid back buffer ratio.");
+		return createTexture2D(_ratio, 0, 0, _hasMips, _numLayers, _format, _flags, NULL);
 	}
 
-	void dbgTextImage(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const void* _data, uint16_t _pitch)
+	TextureHandle createTexture3D(uint16_t _width, uint16_t _height, uint16_t _depth, bool _hasMips, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->dbgTextImage(_x, _y, _width, _height, _data, _pitch);
+
+		bx::Error err;
+		isTextureValid(_depth, false, 1, _format, _flags, &err);
+		BX_CHECK(err.isOk(), "%s", err.getMessage().getPtr() );
+
+		const uint8_t numMips = calcNumMips(_hasMips, _width, _height, _depth);
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG)
+		&&  NULL != _mem)
+		{
+			TextureInfo ti;
+			calcTextureSize(ti, _width, _height, _depth, false, _hasMips, 1, _format);
+			BX_CHECK(ti.storageSize == _mem->size
+				, "createTexture3D: Texture storage size doesn't match passed memory size (storage size: %d, memory size: %d)"
+				, ti.storageSize
+				, _mem->size
+				);
+		}
+
+		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
+		const Memory* mem = alloc(size);
+
+		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+		bx::write(&writer, magic);
+
+		TextureCreate tc;
+		tc.m_width     = _width;
+		tc.m_height    = _height;
+		tc.m_depth     = _depth;
+		tc.m_numLayers = 1;
+		tc.m_numMips   = numMips;
+		tc.m_format    = _format;
+		tc.m_cubeMap   = false;
+		tc.m_mem       = _mem;
+		bx::write(&writer, tc);
+
+		return s_ctx->createTexture(mem, _flags, 0, NULL, BackbufferRatio::Count);
 	}
 
-	IndexBufferHandle createIndexBuffer(const Memory* _mem, uint16_t _flags)
+	TextureHandle createTextureCube(uint16_t _size, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createIndexBuffer(_mem, _flags);
+
+		bx::Error err;
+		isTextureValid(0, true, _numLayers, _format, _flags, &err);
+		BX_CHECK(err.isOk(), "%s", err.getMessage().getPtr() );
+
+		const uint8_t numMips = calcNumMips(_hasMips, _size, _size);
+		_numLayers = bx::uint16_max(_numLayers, 1);
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG)
+		&&  NULL != _mem)
+		{
+			TextureInfo ti;
+			calcTextureSize(ti, _size, _size, 1, true, _hasMips, _numLayers, _format);
+			BX_CHECK(ti.storageSize == _mem->size
+				, "createTextureCube: Texture storage size doesn't match passed memory size (storage size: %d, memory size: %d)"
+				, ti.storageSize
+				, _mem->size
+				);
+		}
+
+		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
+		const Memory* mem = alloc(size);
+
+		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+		bx::write(&writer, magic);
+
+		TextureCreate tc;
+		tc.m_width     = _size;
+		tc.m_height    = _size;
+		tc.m_depth     = 0;
+		tc.m_numLayers = _numLayers;
+		tc.m_numMips   = numMips;
+		tc.m_format    = _format;
+		tc.m_cubeMap   = true;
+		tc.m_mem       = _mem;
+		bx::write(&writer, tc);
+
+		return s_ctx->createTexture(mem, _flags, 0, NULL, BackbufferRatio::Count);
 	}
 
-	void destroyIndexBuffer(IndexBufferHandle _handle)
+	void destroyTexture(TextureHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyIndexBuffer(_handle);
+		s_ctx->destroyTexture(_handle);
 	}
 
-	VertexBufferHandle createVertexBuffer(const Memory* _mem, const VertexDecl& _decl, uint16_t _flags)
+	TextureHandle createStreamingTexture(const Memory* _mem, uint32_t _flags, uint8_t _numResidentMips, TextureInfo* _info)
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
-		return s_ctx->createVertexBuffer(_mem, _decl, _flags);
+		return s_ctx->createStreamingTexture(_mem, _flags, _numResidentMips, _info);
 	}
 
-	void destroyVertexBuffer(VertexBufferHandle _handle)
+	void requestTextureMips(TextureHandle _handle, uint8_t _numMips)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyVertexBuffer(_handle);
+		s_ctx->requestTextureMips(_handle, _numMips);
 	}
 
-	DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags)
+	void setTextureStreamingBudget(uint32_t _uploadBytesPerFrame, uint64_t _memoryCap)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createDynamicIndexBuffer(_num, _flags);
+		s_ctx->setTextureStreamingBudget(_uploadBytesPerFrame, _memoryCap);
 	}
 
-	DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint16_t _flags)
+	void updateTexture2D(TextureHandle _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const Memory* _mem, uint16_t _pitch)
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createDynamicIndexBuffer(_mem, _flags);
+		if (_width  == 0
+		||  _height == 0)
+		{
+			release(_mem);
+		}
+		else
+		{
+			s_ctx->updateTexture(_handle, 0, _mip, _x, _y, _layer, _width, _height, 1, _pitch, _mem);
+		}
 	}
 
-	void updateDynamicIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem)
+	void updateTexture3D(TextureHandle _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const Memory* _mem)
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		s_ctx->updateDynamicIndexBuffer(_handle, _startIndex, _mem);
+		BGFX_CHECK_CAPS(BGFX_CAPS_TEXTURE_3D, "Texture3D is not supported!");
+
+		if (0 == _width
+		||  0 == _height
+		||  0 == _depth)
+		{
+			release(_mem);
+		}
+		else
+		{
+			s_ctx->updateTexture(_handle, 0, _mip, _x, _y, _z, _width, _height, _depth, UINT16_MAX, _mem);
+		}
 	}
 
-	void destroyDynamicIndexBuffer(DynamicIndexBufferHandle _handle)
+	void updateTextureCube(TextureHandle _handle, uint16_t _layer, uint8_t _side, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const Memory* _mem, uint16_t _pitch)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyDynamicIndexBuffer(_handle);
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		BX_CHECK(_side <= 5, "Invalid side %d.", _side);
+		if (0 == _width
+		||  0 == _height)
+		{
+			release(_mem);
+		}
+		else
+		{
+			s_ctx->updateTexture(_handle, _side, _mip, _x, _y, _layer, _width, _height, 1, _pitch, _mem);
+		}
 	}
 
-	DynamicVertexBufferHandle createDynamicVertexBuffer(uint32_t _num, const VertexDecl& _decl, uint16_t _flags)
+	uint32_t readTexture(TextureHandle _handle, void* _data, uint8_t _mip)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
-		return s_ctx->createDynamicVertexBuffer(_num, _decl, _flags);
+		BX_CHECK(NULL != _data, "_data can't be NULL");
+		BGFX_CHECK_CAPS(BGFX_CAPS_TEXTURE_READ_BACK, "Texture read-back is not supported!");
+		return s_ctx->readTexture(_handle, _data, _mip);
 	}
 
-	DynamicVertexBufferHandle createDynamicVertexBuffer(const Memory* _mem, const VertexDecl& _decl, uint16_t _flags)
+	FrameBufferHandle createFrameBuffer(uint16_t _width, uint16_t _height, TextureFormat::Enum _format, uint32_t _textureFlags)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
-		return s_ctx->createDynamicVertexBuffer(_mem, _decl, _flags);
+		_textureFlags |= _textureFlags&BGFX_TEXTURE_RT_MSAA_MASK ? 0 : BGFX_TEXTURE_RT;
+		TextureHandle th = createTexture2D(_width, _height, false, 1, _format, _textureFlags);
+		return createFrameBuffer(1, &th, true);
 	}
 
-	void updateDynamicVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem)
+	FrameBufferHandle createFrameBuffer(BackbufferRatio::Enum _ratio, TextureFormat::Enum _format, uint32_t _textureFlags)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		s_ctx->updateDynamicVertexBuffer(_handle, _startVertex, _mem);
+		BX_CHECK(_ratio < BackbufferRatio::Count, "Invalid back buffer ratio.");
+		_textureFlags |= _textureFlags&BGFX_TEXTURE_RT_MSAA_MASK ? 0 : BGFX_TEXTURE_RT;
+		TextureHandle th = createTexture2D(_ratio, false, 1, _format, _textureFlags);
+		return createFrameBuffer(1, &th, true);
 	}
 
-	void destroyDynamicVertexBuffer(DynamicVertexBufferHandle _handle)
+	FrameBufferHandle createFrameBuffer(uint8_t _num, const TextureHandle* _handles, bool _destroyTextures)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyDynamicVertexBuffer(_handle);
+		Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+		for (uint8_t ii = 0; ii < _num; ++ii)
+		{
+			Attachment& at = attachment[ii];
+			at.handle = _handles[ii];
+			at.mip    = 0;
+			at.layer  = 0;
+		}
+		return createFrameBuffer(_num, attachment, _destroyTextures);
 	}
 
-	uint32_t getAvailTransientIndexBuffer(uint32_t _num)
+	FrameBufferHandle createFrameBuffer(uint8_t _num, const Attachment* _attachment, bool _destroyTextures)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(0 < _num, "Requesting 0 indices.");
-		return s_ctx->getAvailTransientIndexBuffer(_num);
+		BX_CHECK(_num != 0, "Number of frame buffer attachments can't be 0.");
+		BX_CHECK(_num <= BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS, "Number of frame buffer attachments is larger than allowed %d (max: %d)."
+			, _num
+			, BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS
+			);
+		BX_CHECK(NULL != _attachment, "_attachment can't be NULL");
+		return s_ctx->createFrameBuffer(_num, _attachment, _destroyTextures);
 	}
 
-	uint32_t getAvailTransientVertexBuffer(uint32_t _num, const VertexDecl& _decl)
+	FrameBufferHandle createFrameBuffer(void* _nwh, uint16_t _width, uint16_t _height, TextureFormat::Enum _depthFormat)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(0 < _num, "Requesting 0 vertices.");
-		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
-		return s_ctx->getAvailTransientVertexBuffer(_num, _decl.m_stride);
+		return s_ctx->createFrameBuffer(_nwh, _width, _height, _depthFormat);
 	}
 
-	uint32_t getAvailInstanceDataBuffer(uint32_t _num, uint16_t _stride)
+	TextureHandle getTexture(FrameBufferHandle _handle, uint8_t _attachment)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(0 < _num, "Requesting 0 instances.");
-		return s_ctx->getAvailTransientVertexBuffer(_num, _stride);
+		return s_ctx->getTexture(_handle, _attachment);
 	}
 
-	void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num)
+	void destroyFrameBuffer(FrameBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _tib, "_tib can't be NULL");
-		BX_CHECK(0 < _num, "Requesting 0 indices.");
-		s_ctx->allocTransientIndexBuffer(_tib, _num);
-		BX_CHECK(_num == _tib->size/2, "Failed to allocate transient index buffer (requested %d, available %d). Use bgfx::checkAvailTransient* functions to ensure availability."
-			, _num
-			, _tib->size/2
-			);
+		s_ctx->destroyFrameBuffer(_handle);
 	}
 
-	void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl)
+	UniformHandle createUniform(const char* _name, UniformType::Enum _type, uint16_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _tvb, "_tvb can't be NULL");
-		BX_CHECK(0 < _num, "Requesting 0 vertices.");
-		BX_CHECK(UINT16_MAX >= _num, "Requesting %d vertices (max: %d).", _num, UINT16_MAX);
-		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
-		s_ctx->allocTransientVertexBuffer(_tvb, _num, _decl);
-		BX_CHECK(_num == _tvb->size / _decl.m_stride, "Failed to allocate transient vertex buffer (requested %d, available %d). Use bgfx::checkAvailTransient* functions to ensure availability."
-			, _num
-			, _tvb->size / _decl.m_stride
-			);
+		return s_ctx->createUniform(_name, _type, _num);
 	}
 
-	bool allocTransientBuffers(bgfx::TransientVertexBuffer* _tvb, const bgfx::VertexDecl& _decl, uint32_t _numVertices, bgfx::TransientIndexBuffer* _tib, uint32_t _numIndices)
+	void getUniformInfo(UniformHandle _handle, UniformInfo& _info)
 	{
-		if (_numVertices == getAvailTransientVertexBuffer(_numVertices, _decl)
-		&&  _numIndices  == getAvailTransientIndexBuffer(_numIndices) )
-		{
-			allocTransientVertexBuffer(_tvb, _numVertices, _decl);
-			allocTransientIndexBuffer(_tib, _numIndices);
-			return true;
-		}
-
-		return false;
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->getUniformInfo(_handle, _info);
 	}
 
-	const InstanceDataBuffer* allocInstanceDataBuffer(uint32_t _num, uint16_t _stride)
+	void destroyUniform(UniformHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BGFX_CHECK_CAPS(BGFX_CAPS_INSTANCING, "Instancing is not supported!");
-		BX_CHECK(0 < _num, "Requesting 0 instanced data vertices.");
-		const InstanceDataBuffer* idb = s_ctx->allocInstanceDataBuffer(_num, _stride);
-		BX_CHECK(_num == idb->size / _stride, "Failed to allocate instance data buffer (requested %d, available %d). Use bgfx::checkAvailTransient* functions to ensure availability."
-			, _num
-			, idb->size / _stride
-			);
-		return idb;
+		s_ctx->destroyUniform(_handle);
 	}
 
-	IndirectBufferHandle createIndirectBuffer(uint32_t _num)
+	OcclusionQueryHandle createOcclusionQuery()
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createIndirectBuffer(_num);
+		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
+		return s_ctx->createOcclusionQuery();
 	}
 
-	void destroyIndirectBuffer(IndirectBufferHandle _handle)
+	OcclusionQueryResult::Enum getResult(OcclusionQueryHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyIndirectBuffer(_handle);
+		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
+		return s_ctx->getResult(_handle);
 	}
 
-	ShaderHandle createShader(const Memory* _mem)
+	void destroyOcclusionQuery(OcclusionQueryHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createShader(_mem);
+		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
+		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
-	uint16_t getShaderUniforms(ShaderHandle _handle, UniformHandle* _uniforms, uint16_t _max)
+	void setPaletteColor(uint8_t _index, uint32_t _rgba)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->getShaderUniforms(_handle, _uniforms, _max);
+
+		const uint8_t rr = uint8_t(_rgba>>24);
+		const uint8_t gg = uint8_t(_rgba>>16);
+		const uint8_t bb = uint8_t(_rgba>> 8);
+		const uint8_t aa = uint8_t(_rgba>> 0);
+
+		float rgba[4] =
+		{
+			rr * 1.0f/255.0f,
+			gg * 1.0f/255.0f,
+			bb * 1.0f/255.0f,
+			aa * 1.0f/255.0f,
+		};
+		s_ctx->setPaletteColor(_index, rgba);
 	}
 
-	void destroyShader(ShaderHandle _handle)
+	void setPaletteColor(uint8_t _index, float _r, float _g, float _b, float _a)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyShader(_handle);
+		float rgba[4] = { _r, _g, _b, _a };
+		s_ctx->setPaletteColor(_index, rgba);
 	}
 
-	ProgramHandle createProgram(ShaderHandle _vsh, ShaderHandle _fsh, bool _destroyShaders)
+	void setPaletteColor(uint8_t _index, const float _rgba[4])
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		if (!isValid(_fsh) )
-		{
-			return createProgram(_vsh, _destroyShaders);
-		}
+		s_ctx->setPaletteColor(_index, _rgba);
+	}
 
-		return s_ctx->createProgram(_vsh, _fsh, _destroyShaders);
+	bool checkView(uint8_t _id)
+	{
+		// workaround GCC 4.9 type-limit check.
+		const uint32_t id = _id;
+		return id < BGFX_CONFIG_MAX_VIEWS;
 	}
 
-	ProgramHandle createProgram(ShaderHandle _csh, bool _destroyShader)
+	void setViewName(uint8_t _id, const char* _name)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createProgram(_csh, _destroyShader);
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewName(_id, _name);
 	}
 
-	void destroyProgram(ProgramHandle _handle)
+	void setViewRect(uint8_t _id, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyProgram(_handle);
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewRect(_id, _x, _y, _width, _height);
 	}
 
-	static void isTextureValid(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, bx::Error* _err)
+	void setViewRect(uint8_t _id, uint16_t _x, uint16_t _y, BackbufferRatio::Enum _ratio)
 	{
-		BX_ERROR_SCOPE(_err);
-
-		const bool is3DTexture = 1 < _depth;
-
-		if (_cubeMap && is3DTexture)
-		{
-			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
-				, "Texture can't be depth and cube map at the same time."
-				);
-			return;
-		}
-
-		if (is3DTexture
-		&& 	0 == (g_caps.supported & BGFX_CAPS_TEXTURE_3D) )
-		{
-			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
-				, "Texture3D is not supported! "
-				  "Use bgfx::getCaps to check BGFX_CAPS_TEXTURE_3D backend renderer capabilities."
-				);
-			return;
-		}
-
-		if (0 != (_flags & BGFX_TEXTURE_RT_MASK)
-		&&  0 != (_flags & BGFX_TEXTURE_READ_BACK) )
-		{
-			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
-				, "Can't create render target with BGFX_TEXTURE_READ_BACK flag."
-				);
-			return;
-		}
-
-		if (1 < _numLayers
-		&&  0 == (g_caps.supported & BGFX_CAPS_TEXTURE_2D_ARRAY) )
-		{
-			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
-				, "Texture array is not supported! "
-				  "Use bgfx::getCaps to check BGFX_CAPS_TEXTURE_2D_ARRAY backend renderer capabilities."
-				);
-			return;
-		}
-
-		bool formatSupported = 0 != (g_caps.formats[_format] & (0
-				| BGFX_CAPS_FORMAT_TEXTURE_2D
-				| BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED
-				| BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB
-				) );
-		uint16_t srgbCaps = BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB;
-
-		if (_cubeMap)
-		{
-			formatSupported = 0 != (g_caps.formats[_format] & (0
-				| BGFX_CAPS_FORMAT_TEXTURE_CUBE
-				| BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED
-				| BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB
-				) );
-			srgbCaps = BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB;
-		}
-		else if (is3DTexture)
-		{
-			formatSupported = 0 != (g_caps.formats[_format] & (0
-				| BGFX_CAPS_FORMAT_TEXTURE_3D
-				| BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED
-				| BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB
-				) );
-			srgbCaps = BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB;
-		}
-
-		if (!formatSupported)
-		{
-			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
-				, "Texture format is not supported! "
-				  "Use bgfx::isTextureValid to check support for texture format before creating it."
-				);
-			return;
-		}
-
-		if (0 != (_flags & BGFX_TEXTURE_MSAA_SAMPLE)
-		&&  0 == (g_caps.supported & BGFX_CAPS_FORMAT_TEXTURE_MSAA) )
-		{
-			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
-				, "MSAA sampling for this texture format is not supported."
-				);
-			return;
-		}
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
 
-		if (0 != (_flags & BGFX_TEXTURE_SRGB)
-		&&  0 == (g_caps.supported & srgbCaps & (0
-				| BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB
-				| BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB
-				| BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB
-				) ) )
-		{
-			_err->setError(BGFX_ERROR_TEXTURE_VALIDATION
-				, "sRGB sampling for this texture format is not supported."
-				);
-			return;
-		}
+		uint16_t width  = uint16_t(s_ctx->m_resolution.m_width);
+		uint16_t height = uint16_t(s_ctx->m_resolution.m_height);
+		getTextureSizeFromRatio(_ratio, width, height);
+		setViewRect(_id, _x, _y, width, height);
 	}
 
-	bool isTextureValid(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags)
+	void setViewScissor(uint8_t _id, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 	{
-		bx::Error err;
-		isTextureValid(_depth, _cubeMap, _numLayers, _format, _flags, &err);
-		return err.isOk();
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewScissor(_id, _x, _y, _width, _height);
 	}
 
-	void calcTextureSize(TextureInfo& _info, uint16_t _width, uint16_t _height, uint16_t _depth, bool _cubeMap, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format)
+	void setViewClear(uint8_t _id, uint16_t _flags, uint32_t _rgba, float _depth, uint8_t _stencil)
 	{
-		imageGetSize(&_info, _width, _height, _depth, _cubeMap, _hasMips, _numLayers, _format);
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewClear(_id, _flags, _rgba, _depth, _stencil);
 	}
 
-	TextureHandle createTexture(const Memory* _mem, uint32_t _flags, uint8_t _skip, TextureInfo* _info)
+	void setViewClear(uint8_t _id, uint16_t _flags, float _depth, uint8_t _stencil, uint8_t _0, uint8_t _1, uint8_t _2, uint8_t _3, uint8_t _4, uint8_t _5, uint8_t _6, uint8_t _7)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createTexture(_mem, _flags, _skip, _info, BackbufferRatio::Count);
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewClear(_id, _flags, _depth, _stencil, _0, _1, _2, _3, _4, _5, _6, _7);
 	}
 
-	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height)
+	void setViewSeq(uint8_t _id, bool _enabled)
 	{
-		switch (_ratio)
-		{
-		case BackbufferRatio::Half:      _width /=  2; _height /=  2; break;
-		case BackbufferRatio::Quarter:   _width /=  4; _height /=  4; break;
-		case BackbufferRatio::Eighth:    _width /=  8; _height /=  8; break;
-		case BackbufferRatio::Sixteenth: _width /= 16; _height /= 16; break;
-		case BackbufferRatio::Double:    _width *=  2; _height *=  2; break;
-
-		default:
-			break;
-		}
-
-		_width  = bx::uint16_max(1, _width);
-		_height = bx::uint16_max(1, _height);
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewSeq(_id, _enabled);
 	}
 
-	static TextureHandle createTexture2D(BackbufferRatio::Enum _ratio, uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
+	void setViewFrameBuffer(uint8_t _id, FrameBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-
-		bx::Error err;
-		isTextureValid(0, false, _numLayers, _format, _flags, &err);
-		BX_CHECK(err.isOk(), "%s (layers %d, format %s)"
-			, err.getMessage().getPtr()
-			, _numLayers
-			, getName(_format)
-			);
-
-		if (BackbufferRatio::Count != _ratio)
-		{
-			_width  = uint16_t(s_ctx->m_resolution.m_width);
-			_height = uint16_t(s_ctx->m_resolution.m_height);
-			getTextureSizeFromRatio(_ratio, _width, _height);
-		}
-
-		const uint8_t numMips = calcNumMips(_hasMips, _width, _height);
-		_numLayers = bx::uint16_max(_numLayers, 1);
-
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG)
-		&&  NULL != _mem)
-		{
-			TextureInfo ti;
-			calcTextureSize(ti, _width, _height, 1, false, _hasMips, _numLayers, _format);
-			BX_CHECK(ti.storageSize == _mem->size
-				, "createTexture2D: Texture storage size doesn't match passed memory size (storage size: %d, memory size: %d)"
-				, ti.storageSize
-				, _mem->size
-				);
-		}
-
-		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
-		const Memory* mem = alloc(size);
-
-		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
-		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
-		bx::write(&writer, magic);
-
-		TextureCreate tc;
-		tc.m_width     = _width;
-		tc.m_height    = _height;
-		tc.m_depth     = 0;
-		tc.m_numLayers = _numLayers;
-		tc.m_numMips   = numMips;
-		tc.m_format    = _format;
-		tc.m_cubeMap   = false;
-		tc.m_mem       = _mem;
-		bx::write(&writer, tc);
-
-		return s_ctx->createTexture(mem, _flags, 0, NULL, _ratio);
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewFrameBuffer(_id, _handle);
 	}
 
-	TextureHandle createTexture2D(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
+	void setViewTransform(uint8_t _id, const void* _view, const void* _projL, uint8_t _flags, const void* _projR)
 	{
-		BX_CHECK(_width > 0 && _height > 0, "Invalid texture size (width %d, height %d).", _width, _height);
-		return createTexture2D(BackbufferRatio::Count, _width, _height, _hasMips, _numLayers, _format, _flags, _mem);
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewTransform(_id, _view, _projL, _flags, _projR);
 	}
 
-	TextureHandle createTexture2D(BackbufferRatio::Enum _ratio, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags)
+	void setViewUniform(uint8_t _id, UniformHandle _handle, const void* _value, uint16_t _num)
 	{
-		BX_CHECK(_ratio < BackbufferRatio::Count, "Invalid back buffer ratio.");
-		return createTexture2D(_ratio, 0, 0, _hasMips, _numLayers, _format, _flags, NULL);
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewUniform(_id, _handle, _value, _num);
 	}
 
-	TextureHandle createTexture3D(uint16_t _width, uint16_t _height, uint16_t _depth, bool _hasMips, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
+	void setFrameUniform(UniformHandle _handle, const void* _value, uint16_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->setViewUniform(BGFX_CONFIG_MAX_VIEWS, _handle, _value, _num);
+	}
 
-		bx::Error err;
-		isTextureValid(_depth, false, 1, _format, _flags, &err);
-		BX_CHECK(err.isOk(), "%s", err.getMessage().getPtr() );
-
-		const uint8_t numMips = calcNumMips(_hasMips, _width, _height, _depth);
-
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG)
-		&&  NULL != _mem)
-		{
-			TextureInfo ti;
-			calcTextureSize(ti, _width, _height, _depth, false, _hasMips, 1, _format);
-			BX_CHECK(ti.storageSize == _mem->size
-				, "createTexture3D: Texture storage size doesn't match passed memory size (storage size: %d, memory size: %d)"
-				, ti.storageSize
-				, _mem->size
-				);
-		}
-
-		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
-		const Memory* mem = alloc(size);
-
-		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
-		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
-		bx::write(&writer, magic);
-
-		TextureCreate tc;
-		tc.m_width     = _width;
-		tc.m_height    = _height;
-		tc.m_depth     = _depth;
-		tc.m_numLayers = 1;
-		tc.m_numMips   = numMips;
-		tc.m_format    = _format;
-		tc.m_cubeMap   = false;
-		tc.m_mem       = _mem;
-		bx::write(&writer, tc);
-
-		return s_ctx->createTexture(mem, _flags, 0, NULL, BackbufferRatio::Count);
+	void setViewOrder(uint8_t _id, uint8_t _num, const void* _order)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewOrder(_id, _num, _order);
 	}
 
-	TextureHandle createTextureCube(uint16_t _size, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
+	void resetView(uint8_t _id)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->resetView(_id);
+	}
 
-		bx::Error err;
-		isTextureValid(0, true, _numLayers, _format, _flags, &err);
-		BX_CHECK(err.isOk(), "%s", err.getMessage().getPtr() );
+#define BGFX_ENCODER(_func) reinterpret_cast<EncoderImpl*>(this)->_func
 
-		const uint8_t numMips = calcNumMips(_hasMips, _size, _size);
-		_numLayers = bx::uint16_max(_numLayers, 1);
+	void Encoder::setMarker(const char* _marker)
+	{
+		BGFX_ENCODER(setMarker(_marker) );
+	}
 
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG)
-		&&  NULL != _mem)
-		{
-			TextureInfo ti;
-			calcTextureSize(ti, _size, _size, 1, true, _hasMips, _numLayers, _format);
-			BX_CHECK(ti.storageSize == _mem->size
-				, "createTextureCube: Texture storage size doesn't match passed memory size (storage size: %d, memory size: %d)"
-				, ti.storageSize
-				, _mem->size
-				);
-		}
+	void Encoder::setState(uint64_t _state, uint32_t _rgba)
+	{
+		BX_CHECK(0 == (_state&BGFX_STATE_RESERVED_MASK), "Do not set state reserved flags!");
+		BGFX_ENCODER(setState(_state, _rgba) );
+	}
 
-		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
-		const Memory* mem = alloc(size);
+	void Encoder::setCondition(OcclusionQueryHandle _handle, bool _visible)
+	{
+		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
+		BGFX_ENCODER(setCondition(_handle, _visible) );
+	}
 
-		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
-		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
-		bx::write(&writer, magic);
+	void Encoder::setStencil(uint32_t _fstencil, uint32_t _bstencil)
+	{
+		BGFX_ENCODER(setStencil(_fstencil, _bstencil) );
+	}
 
-		TextureCreate tc;
-		tc.m_width     = _size;
-		tc.m_height    = _size;
-		tc.m_depth     = 0;
-		tc.m_numLayers = _numLayers;
-		tc.m_numMips   = numMips;
-		tc.m_format    = _format;
-		tc.m_cubeMap   = true;
-		tc.m_mem       = _mem;
-		bx::write(&writer, tc);
+	uint16_t Encoder::setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
+	{
+		return BGFX_ENCODER(setScissor(_x, _y, _width, _height) );
+	}
 
-		return s_ctx->createTexture(mem, _flags, 0, NULL, BackbufferRatio::Count);
+	void Encoder::setScissor(uint16_t _cache)
+	{
+		BGFX_ENCODER(setScissor(_cache) );
 	}
 
-	void destroyTexture(TextureHandle _handle)
+	uint32_t Encoder::setTransform(const void* _mtx, uint16_t _num)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyTexture(_handle);
+		return BGFX_ENCODER(setTransform(_mtx, _num) );
 	}
 
-	void updateTexture2D(TextureHandle _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const Memory* _mem, uint16_t _pitch)
+	uint32_t Encoder::allocTransform(Transform* _transform, uint16_t _num)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		if (_width  == 0
-		||  _height == 0)
-		{
-			release(_mem);
-		}
-		else
-		{
-			s_ctx->updateTexture(_handle, 0, _mip, _x, _y, _layer, _width, _height, 1, _pitch, _mem);
-		}
+		return BGFX_ENCODER(allocTransform(_transform, _num) );
 	}
 
-	void updateTexture3D(TextureHandle _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const Memory* _mem)
+	void Encoder::setTransform(uint32_t _cache, uint16_t _num)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		BGFX_CHECK_CAPS(BGFX_CAPS_TEXTURE_3D, "Texture3D is not supported!");
+		BGFX_ENCODER(setTransform(_cache, _num) );
+	}
 
-		if (0 == _width
-		||  0 == _height
-		||  0 == _depth)
+	void Encoder::setUniform(UniformHandle _handle, const void* _value, uint16_t _num)
+	{
+		BGFX_CHECK_HANDLE("setUniform", s_ctx->m_uniformHandle, _handle);
+		const Context::UniformRef& uniform = s_ctx->m_uniformRef[_handle.idx];
+		BX_CHECK(isValid(_handle) && 0 < uniform.m_refCount, "Setting invalid uniform (handle %3d)!", _handle.idx);
+		BX_CHECK(_num == UINT16_MAX || uniform.m_num >= _num, "Truncated uniform update. %d (max: %d)", _num, uniform.m_num);
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
 		{
-			release(_mem);
+			EncoderImpl::HandleSet& uniformSet = BGFX_ENCODER(m_uniformSet);
+			BX_CHECK(uniformSet.end() == uniformSet.find(_handle.idx)
+				, "Uniform %d (%s) was already set for this draw call."
+				, _handle.idx
+				, s_ctx->getName(_handle)
+				);
+			uniformSet.insert(_handle.idx);
 		}
-		else
+
+		if (0 != s_ctx->m_numDeferredHandles
+		&&  0 != s_ctx->m_deferredUniform[_handle.idx])
 		{
-			s_ctx->updateTexture(_handle, 0, _mip, _x, _y, _z, _width, _height, _depth, UINT16_MAX, _mem);
+			// Uniform is not created on renderer side yet.
+			return;
 		}
+
+		BGFX_ENCODER(setUniform(uniform.m_type, _handle, _value, bx::uint16_min(uniform.m_num, _num) ) );
 	}
 
-	void updateTextureCube(TextureHandle _handle, uint16_t _layer, uint8_t _side, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const Memory* _mem, uint16_t _pitch)
+	void Encoder::setIndexBuffer(IndexBufferHandle _handle)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		BX_CHECK(_side <= 5, "Invalid side %d.", _side);
-		if (0 == _width
-		||  0 == _height)
-		{
-			release(_mem);
-		}
-		else
-		{
-			s_ctx->updateTexture(_handle, _side, _mip, _x, _y, _layer, _width, _height, 1, _pitch, _mem);
-		}
+		setIndexBuffer(_handle, 0, UINT32_MAX);
 	}
 
-	uint32_t readTexture(TextureHandle _handle, void* _data, uint8_t _mip)
+	void Encoder::setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _data, "_data can't be NULL");
-		BGFX_CHECK_CAPS(BGFX_CAPS_TEXTURE_READ_BACK, "Texture read-back is not supported!");
-		return s_ctx->readTexture(_handle, _data, _mip);
+		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_indexBufferHandle, _handle);
+		BGFX_ENCODER(setIndexBuffer(_handle, _firstIndex, _numIndices) );
 	}
 
-	FrameBufferHandle createFrameBuffer(uint16_t _width, uint16_t _height, TextureFormat::Enum _format, uint32_t _textureFlags)
+	void Encoder::setIndexBuffer(DynamicIndexBufferHandle _handle)
 	{
-		_textureFlags |= _textureFlags&BGFX_TEXTURE_RT_MSAA_MASK ? 0 : BGFX_TEXTURE_RT;
-		TextureHandle th = createTexture2D(_width, _height, false, 1, _format, _textureFlags);
-		return createFrameBuffer(1, &th, true);
+		setIndexBuffer(_handle, 0, UINT32_MAX);
 	}
 
-	FrameBufferHandle createFrameBuffer(BackbufferRatio::Enum _ratio, TextureFormat::Enum _format, uint32_t _textureFlags)
+	void Encoder::setIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 	{
-		BX_CHECK(_ratio < BackbufferRatio::Count, "Invalid back buffer ratio.");
-		_textureFlags |= _textureFlags&BGFX_TEXTURE_RT_MSAA_MASK ? 0 : BGFX_TEXTURE_RT;
-		TextureHandle th = createTexture2D(_ratio, false, 1, _format, _textureFlags);
-		return createFrameBuffer(1, &th, true);
+		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
+		BGFX_ENCODER(setIndexBuffer(s_ctx->m_dynamicIndexBuffers[_handle.idx], _firstIndex, _numIndices) );
 	}
 
-	FrameBufferHandle createFrameBuffer(uint8_t _num, const TextureHandle* _handles, bool _destroyTextures)
+	void Encoder::setIndexBuffer(const TransientIndexBuffer* _tib)
 	{
-		Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
-		for (uint8_t ii = 0; ii < _num; ++ii)
-		{
-			Attachment& at = attachment[ii];
-			at.handle = _handles[ii];
-			at.mip    = 0;
-			at.layer  = 0;
-		}
-		return createFrameBuffer(_num, attachment, _destroyTextures);
+		setIndexBuffer(_tib, 0, UINT32_MAX);
 	}
 
-	FrameBufferHandle createFrameBuffer(uint8_t _num, const Attachment* _attachment, bool _destroyTextures)
+	void Encoder::setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(_num != 0, "Number of frame buffer attachments can't be 0.");
-		BX_CHECK(_num <= BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS, "Number of frame buffer attachments is larger than allowed %d (max: %d)."
-			, _num
-			, BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS
-			);
-		BX_CHECK(NULL != _attachment, "_attachment can't be NULL");
-		return s_ctx->createFrameBuffer(_num, _attachment, _destroyTextures);
+		BX_CHECK(NULL != _tib, "_tib can't be NULL");
+		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_indexBufferHandle, _tib->handle);
+		uint32_t numIndices = bx::uint32_min(_numIndices, _tib->size/2);
+		BGFX_ENCODER(setIndexBuffer(_tib, _tib->startIndex + _firstIndex, numIndices) );
 	}
 
-	FrameBufferHandle createFrameBuffer(void* _nwh, uint16_t _width, uint16_t _height, TextureFormat::Enum _depthFormat)
+	void Encoder::setVertexBuffer(VertexBufferHandle _handle)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createFrameBuffer(_nwh, _width, _height, _depthFormat);
+		setVertexBuffer(_handle, 0, UINT32_MAX);
 	}
 
-	TextureHandle getTexture(FrameBufferHandle _handle, uint8_t _attachment)
+	void Encoder::setVertexBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->getTexture(_handle, _attachment);
+		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_vertexBufferHandle, _handle);
+		BGFX_ENCODER(setVertexBuffer(0, _handle, _startVertex, _numVertices) );
 	}
 
-	void destroyFrameBuffer(FrameBufferHandle _handle)
+	void Encoder::setVertexBuffer(DynamicVertexBufferHandle _handle)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyFrameBuffer(_handle);
+		setVertexBuffer(_handle, 0, UINT32_MAX);
 	}
 
-	UniformHandle createUniform(const char* _name, UniformType::Enum _type, uint16_t _num)
+	void Encoder::setVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createUniform(_name, _type, _num);
+		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
+		BGFX_ENCODER(setVertexBuffer(0, s_ctx->m_dynamicVertexBuffers[_handle.idx], _startVertex, _numVertices) );
 	}
 
-	void getUniformInfo(UniformHandle _handle, UniformInfo& _info)
+	void Encoder::setVertexBuffer(const TransientVertexBuffer* _tvb)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->getUniformInfo(_handle, _info);
+		setVertexBuffer(_tvb, 0, UINT32_MAX);
 	}
 
-	void destroyUniform(UniformHandle _handle)
+	void Encoder::setVertexBuffer(const TransientVertexBuffer* _tvb, uint32_t _startVertex, uint32_t _numVertices)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->destroyUniform(_handle);
+		BX_CHECK(NULL != _tvb, "_tvb can't be NULL");
+		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_vertexBufferHandle, _tvb->handle);
+		BGFX_ENCODER(setVertexBuffer(0, _tvb, _startVertex, _numVertices) );
 	}
 
-	OcclusionQueryHandle createOcclusionQuery()
+	void Encoder::setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _num)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
-		return s_ctx->createOcclusionQuery();
+		BX_CHECK(NULL != _idb, "_idb can't be NULL");
+		bx::atomicDec(&s_ctx->m_instBufferCount);
+		BGFX_ENCODER(setInstanceDataBuffer(_idb, _num) );
 	}
 
-	OcclusionQueryResult::Enum getResult(OcclusionQueryHandle _handle)
+	void Encoder::setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
-		return s_ctx->getResult(_handle);
+		BGFX_CHECK_HANDLE("setInstanceDataBuffer", s_ctx->m_vertexBufferHandle, _handle);
+		const VertexBuffer& vb = s_ctx->m_vertexBuffers[_handle.idx];
+		BGFX_ENCODER(setInstanceDataBuffer(_handle, _startVertex, _num, vb.m_stride) );
 	}
 
-	void destroyOcclusionQuery(OcclusionQueryHandle _handle)
+	void Encoder::setInstanceDataBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
-		s_ctx->destroyOcclusionQuery(_handle);
+		BGFX_CHECK_HANDLE("setInstanceDataBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
+		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(setInstanceDataBuffer(dvb.m_handle
+			, dvb.m_startVertex + _startVertex
+			, _num
+			, dvb.m_stride
+			) );
 	}
 
-	void setPaletteColor(uint8_t _index, uint32_t _rgba)
+	void Encoder::setTexture(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint32_t _flags)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-
-		const uint8_t rr = uint8_t(_rgba>>24);
-		const uint8_t gg = uint8_t(_rgba>>16);
-		const uint8_t bb = uint8_t(_rgba>> 8);
-		const uint8_t aa = uint8_t(_rgba>> 0);
-
-		float rgba[4] =
-		{
-			rr * 1.0f/255.0f,
-			gg * 1.0f/255.0f,
-			bb * 1.0f/255.0f,
-			aa * 1.0f/255.0f,
-		};
-		s_ctx->setPaletteColor(_index, rgba);
+		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		BGFX_CHECK_HANDLE_INVALID_OK("setTexture/TextureHandle", s_ctx->m_textureHandle, _handle);
+		BGFX_ENCODER(setTexture(_stage, _sampler, _handle, _flags) );
 	}
 
-	void setPaletteColor(uint8_t _index, float _r, float _g, float _b, float _a)
+	uint32_t Encoder::touch(uint8_t _id)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		float rgba[4] = { _r, _g, _b, _a };
-		s_ctx->setPaletteColor(_index, rgba);
+		ProgramHandle handle = BGFX_INVALID_HANDLE;
+		return submit(_id, handle);
 	}
 
-	void setPaletteColor(uint8_t _index, const float _rgba[4])
+	uint32_t Encoder::submit(uint8_t _id, ProgramHandle _program, int32_t _depth, bool _preserveState)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setPaletteColor(_index, _rgba);
+		OcclusionQueryHandle handle = BGFX_INVALID_HANDLE;
+		return submit(_id, _program, handle, _depth, _preserveState);
 	}
 
-	bool checkView(uint8_t _id)
+	uint32_t Encoder::submit(uint8_t _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, int32_t _depth, bool _preserveState)
 	{
-		// workaround GCC 4.9 type-limit check.
-		const uint32_t id = _id;
-		return id < BGFX_CONFIG_MAX_VIEWS;
+		BX_CHECK(false
+			|| !isValid(_occlusionQuery)
+			|| 0 != (g_caps.supported & BGFX_CAPS_OCCLUSION_QUERY)
+			, "Occlusion query is not supported! Use bgfx::getCaps to check BGFX_CAPS_OCCLUSION_QUERY backend renderer capabilities."
+			);
+		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_programHandle, _program);
+		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_occlusionQueryHandle, _occlusionQuery);
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
+		&& !_preserveState)
+		{
+			BGFX_ENCODER(m_uniformSet.clear() );
+		}
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_OCCLUSION)
+		&&  isValid(_occlusionQuery) )
+		{
+			EncoderImpl::HandleSet& occlusionQuerySet = BGFX_ENCODER(m_occlusionQuerySet);
+			BX_CHECK(occlusionQuerySet.end() == occlusionQuerySet.find(_occlusionQuery.idx)
+				, "OcclusionQuery %d was already used for this frame."
+				, _occlusionQuery.idx
+				);
+			occlusionQuerySet.insert(_occlusionQuery.idx);
+		}
+
+		return BGFX_ENCODER(submit(_id, _program, _occlusionQuery, _depth, _preserveState) );
 	}
 
-	void setViewName(uint8_t _id, const char* _name)
+	uint32_t Encoder::submit(uint8_t _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, int32_t _depth, bool _preserveState)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewName(_id, _name);
+		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Draw indirect is not supported! Use bgfx::getCaps to check BGFX_CAPS_DRAW_INDIRECT backend renderer capabilities.");
+		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_programHandle, _program);
+		BGFX_CHECK_HANDLE("submit", s_ctx->m_vertexBufferHandle, _indirectHandle);
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
+		&& !_preserveState)
+		{
+			BGFX_ENCODER(m_uniformSet.clear() );
+		}
+		return BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState) );
 	}
 
-	void setViewRect(uint8_t _id, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
+	void Encoder::setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewRect(_id, _x, _y, _width, _height);
+		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_indexBufferHandle, _handle);
+		BGFX_ENCODER(setBuffer(_stage, _handle, _access) );
 	}
 
-	void setViewRect(uint8_t _id, uint16_t _x, uint16_t _y, BackbufferRatio::Enum _ratio)
+	void Encoder::setBuffer(uint8_t _stage, VertexBufferHandle _handle, Access::Enum _access)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_vertexBufferHandle, _handle);
+		BGFX_ENCODER(setBuffer(_stage, _handle, _access) );
+	}
 
-		uint16_t width  = uint16_t(s_ctx->m_resolution.m_width);
-		uint16_t height = uint16_t(s_ctx->m_resolution.m_height);
-		getTextureSizeFromRatio(_ratio, width, height);
-		setViewRect(_id, _x, _y, width, height);
+	void Encoder::setBuffer(uint8_t _stage, DynamicIndexBufferHandle _handle, Access::Enum _access)
+	{
+		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
+		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
+		BGFX_ENCODER(setBuffer(_stage, dib.m_handle, _access) );
 	}
 
-	void setViewScissor(uint8_t _id, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
+	void Encoder::setBuffer(uint8_t _stage, DynamicVertexBufferHandle _handle, Access::Enum _access)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewScissor(_id, _x, _y, _width, _height);
+		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
+		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(setBuffer(_stage, dvb.m_handle, _access) );
 	}
 
-	void setViewClear(uint8_t _id, uint16_t _flags, uint32_t _rgba, float _depth, uint8_t _stencil)
+	void Encoder::setBuffer(uint8_t _stage, IndirectBufferHandle _handle, Access::Enum _access)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewClear(_id, _flags, _rgba, _depth, _stencil);
+		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_vertexBufferHandle, _handle);
+		VertexBufferHandle handle = { _handle.idx };
+		BGFX_ENCODER(setBuffer(_stage, handle, _access) );
 	}
 
-	void setViewClear(uint8_t _id, uint16_t _flags, float _depth, uint8_t _stencil, uint8_t _0, uint8_t _1, uint8_t _2, uint8_t _3, uint8_t _4, uint8_t _5, uint8_t _6, uint8_t _7)
+	void Encoder::setImage(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint8_t _mip, Access::Enum _access, TextureFormat::Enum _format)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewClear(_id, _flags, _depth, _stencil, _0, _1, _2, _3, _4, _5, _6, _7);
+		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		_format = TextureFormat::Count == _format ? TextureFormat::Enum(s_ctx->m_textureRef[_handle.idx].m_format) : _format;
+		BX_CHECK(_format != TextureFormat::BGRA8
+			, "Can't use TextureFormat::BGRA8 with compute, use TextureFormat::RGBA8 instead."
+			);
+		BGFX_ENCODER(setImage(_stage, _sampler, _handle, _mip, _access, _format) );
 	}
 
-	void setViewSeq(uint8_t _id, bool _enabled)
+	uint32_t Encoder::dispatch(uint8_t _id, ProgramHandle _handle, uint16_t _numX, uint16_t _numY, uint16_t _numZ, uint8_t _flags)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewSeq(_id, _enabled);
+		BGFX_CHECK_CAPS(BGFX_CAPS_COMPUTE, "Compute is not supported! Use bgfx::getCaps to check BGFX_CAPS_COMPUTE backend renderer capabilities.");
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		{
+			BGFX_ENCODER(m_uniformSet.clear() );
+		}
+		return BGFX_ENCODER(dispatch(_id, _handle, _numX, _numY, _numZ, _flags) );
 	}
 
-	void setViewFrameBuffer(uint8_t _id, FrameBufferHandle _handle)
+	uint32_t Encoder::dispatch(uint8_t _id, ProgramHandle _handle, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint8_t _flags)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewFrameBuffer(_id, _handle);
+		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Dispatch indirect is not supported! Use bgfx::getCaps to check BGFX_CAPS_DRAW_INDIRECT backend renderer capabilities.");
+		BGFX_CHECK_CAPS(BGFX_CAPS_COMPUTE, "Compute is not supported! Use bgfx::getCaps to check BGFX_CAPS_COMPUTE backend renderer capabilities.");
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		{
+			BGFX_ENCODER(m_uniformSet.clear() );
+		}
+		return BGFX_ENCODER(dispatch(_id, _handle, _indirectHandle, _start, _num, _flags) );
 	}
 
-	void setViewTransform(uint8_t _id, const void* _view, const void* _projL, uint8_t _flags, const void* _projR)
+	void Encoder::discard()
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewTransform(_id, _view, _projL, _flags, _projR);
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		{
+			BGFX_ENCODER(m_uniformSet.clear() );
+		}
+		BGFX_ENCODER(discard() );
 	}
 
-	void setViewOrder(uint8_t _id, uint8_t _num, const void* _order)
+#undef BGFX_ENCODER
+
+	Encoder* begin()
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->setViewOrder(_id, _num, _order);
+		return s_ctx->begin();
 	}
 
-	void resetView(uint8_t _id)
+	void end(Encoder* _encoder)
 	{
-		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
-		s_ctx->resetView(_id);
+		s_ctx->end(_encoder);
 	}
 
 	void setMarker(const char* _marker)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setMarker(_marker);
+		s_ctx->m_encoder0->setMarker(_marker);
 	}
 
 	void setState(uint64_t _state, uint32_t _rgba)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(0 == (_state&BGFX_STATE_RESERVED_MASK), "Do not set state reserved flags!");
-		s_ctx->setState(_state, _rgba);
+		s_ctx->m_encoder0->setState(_state, _rgba);
 	}
 
 	void setCondition(OcclusionQueryHandle _handle, bool _visible)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
-		s_ctx->setCondition(_handle, _visible);
+		s_ctx->m_encoder0->setCondition(_handle, _visible);
 	}
 
 	void setStencil(uint32_t _fstencil, uint32_t _bstencil)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setStencil(_fstencil, _bstencil);
+		s_ctx->m_encoder0->setStencil(_fstencil, _bstencil);
 	}
 
 	uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->setScissor(_x, _y, _width, _height);
+		return s_ctx->m_encoder0->setScissor(_x, _y, _width, _height);
 	}
 
 	void setScissor(uint16_t _cache)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setScissor(_cache);
+		s_ctx->m_encoder0->setScissor(_cache);
 	}
 
 	uint32_t setTransform(const void* _mtx, uint16_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->setTransform(_mtx, _num);
+		return s_ctx->m_encoder0->setTransform(_mtx, _num);
 	}
 
 	uint32_t allocTransform(Transform* _transform, uint16_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->allocTransform(_transform, _num);
+		return s_ctx->m_encoder0->allocTransform(_transform, _num);
 	}
 
 	void setTransform(uint32_t _cache, uint16_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setTransform(_cache, _num);
+		s_ctx->m_encoder0->setTransform(_cache, _num);
 	}
 
 	void setUniform(UniformHandle _handle, const void* _value, uint16_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setUniform(_handle, _value, _num);
+		s_ctx->m_encoder0->setUniform(_handle, _value, _num);
 	}
 
 	void setIndexBuffer(IndexBufferHandle _handle)
@@ -3645,7 +5156,7 @@ error:
 	void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setIndexBuffer(_handle, _firstIndex, _numIndices);
+		s_ctx->m_encoder0->setIndexBuffer(_handle, _firstIndex, _numIndices);
 	}
 
 	void setIndexBuffer(DynamicIndexBufferHandle _handle)
@@ -3656,7 +5167,7 @@ error:
 	void setIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setIndexBuffer(_handle, _firstIndex, _numIndices);
+		s_ctx->m_encoder0->setIndexBuffer(_handle, _firstIndex, _numIndices);
 	}
 
 	void setIndexBuffer(const TransientIndexBuffer* _tib)
@@ -3667,9 +5178,7 @@ error:
 	void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _tib, "_tib can't be NULL");
-		uint32_t numIndices = bx::uint32_min(_numIndices, _tib->size/2);
-		s_ctx->setIndexBuffer(_tib, _tib->startIndex + _firstIndex, numIndices);
+		s_ctx->m_encoder0->setIndexBuffer(_tib, _firstIndex, _numIndices);
 	}
 
 	void setVertexBuffer(VertexBufferHandle _handle)
@@ -3680,7 +5189,7 @@ error:
 	void setVertexBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setVertexBuffer(0, _handle, _startVertex, _numVertices);
+		s_ctx->m_encoder0->setVertexBuffer(_handle, _startVertex, _numVertices);
 	}
 
 	void setVertexBuffer(DynamicVertexBufferHandle _handle)
@@ -3691,7 +5200,7 @@ error:
 	void setVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setVertexBuffer(0, _handle, _startVertex, _numVertices);
+		s_ctx->m_encoder0->setVertexBuffer(_handle, _startVertex, _numVertices);
 	}
 
 	void setVertexBuffer(const TransientVertexBuffer* _tvb)
@@ -3702,34 +5211,31 @@ error:
 	void setVertexBuffer(const TransientVertexBuffer* _tvb, uint32_t _startVertex, uint32_t _numVertices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _tvb, "_tvb can't be NULL");
-		s_ctx->setVertexBuffer(0, _tvb, _startVertex, _numVertices);
+		s_ctx->m_encoder0->setVertexBuffer(_tvb, _startVertex, _numVertices);
 	}
 
 	void setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(NULL != _idb, "_idb can't be NULL");
-		s_ctx->setInstanceDataBuffer(_idb, _num);
+		s_ctx->m_encoder0->setInstanceDataBuffer(_idb, _num);
 	}
 
 	void setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setInstanceDataBuffer(_handle, _startVertex, _num);
+		s_ctx->m_encoder0->setInstanceDataBuffer(_handle, _startVertex, _num);
 	}
 
 	void setInstanceDataBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->setInstanceDataBuffer(_handle, _startVertex, _num);
+		s_ctx->m_encoder0->setInstanceDataBuffer(_handle, _startVertex, _num);
 	}
 
 	void setTexture(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint32_t _flags)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
-		s_ctx->setTexture(_stage, _sampler, _handle, _flags);
+		s_ctx->m_encoder0->setTexture(_stage, _sampler, _handle, _flags);
 	}
 
 	uint32_t touch(uint8_t _id)
@@ -3747,82 +5253,67 @@ error:
 	uint32_t submit(uint8_t _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, int32_t _depth, bool _preserveState)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(false
-			|| !isValid(_occlusionQuery)
-			|| 0 != (g_caps.supported & BGFX_CAPS_OCCLUSION_QUERY)
-			, "Occlusion query is not supported! Use bgfx::getCaps to check BGFX_CAPS_OCCLUSION_QUERY backend renderer capabilities."
-			);
-		return s_ctx->submit(_id, _program, _occlusionQuery, _depth, _preserveState);
+		return s_ctx->m_encoder0->submit(_id, _program, _occlusionQuery, _depth, _preserveState);
 	}
 
 	uint32_t submit(uint8_t _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, int32_t _depth, bool _preserveState)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Draw indirect is not supported! Use bgfx::getCaps to check BGFX_CAPS_DRAW_INDIRECT backend renderer capabilities.");
-		return s_ctx->submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState);
+		return s_ctx->m_encoder0->submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState);
 	}
 
 	void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
-		s_ctx->setBuffer(_stage, _handle, _access);
+		s_ctx->m_encoder0->setBuffer(_stage, _handle, _access);
 	}
 
 	void setBuffer(uint8_t _stage, VertexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
-		s_ctx->setBuffer(_stage, _handle, _access);
+		s_ctx->m_encoder0->setBuffer(_stage, _handle, _access);
 	}
 
 	void setBuffer(uint8_t _stage, DynamicIndexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
-		s_ctx->setBuffer(_stage, _handle, _access);
+		s_ctx->m_encoder0->setBuffer(_stage, _handle, _access);
 	}
 
 	void setBuffer(uint8_t _stage, DynamicVertexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
-		s_ctx->setBuffer(_stage, _handle, _access);
+		s_ctx->m_encoder0->setBuffer(_stage, _handle, _access);
 	}
 
 	void setBuffer(uint8_t _stage, IndirectBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
-		s_ctx->setBuffer(_stage, _handle, _access);
+		s_ctx->m_encoder0->setBuffer(_stage, _handle, _access);
 	}
 
 	void setImage(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint8_t _mip, Access::Enum _access, TextureFormat::Enum _format)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
-		s_ctx->setImage(_stage, _sampler, _handle, _mip, _access, _format);
+		s_ctx->m_encoder0->setImage(_stage, _sampler, _handle, _mip, _access, _format);
 	}
 
 	uint32_t dispatch(uint8_t _id, ProgramHandle _handle, uint16_t _numX, uint16_t _numY, uint16_t _numZ, uint8_t _flags)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BGFX_CHECK_CAPS(BGFX_CAPS_COMPUTE, "Compute is not supported! Use bgfx::getCaps to check BGFX_CAPS_COMPUTE backend renderer capabilities.");
-		return s_ctx->dispatch(_id, _handle, _numX, _numY, _numZ, _flags);
+		return s_ctx->m_encoder0->dispatch(_id, _handle, _numX, _numY, _numZ, _flags);
 	}
 
 	uint32_t dispatch(uint8_t _id, ProgramHandle _handle, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint8_t _flags)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Dispatch indirect is not supported! Use bgfx::getCaps to check BGFX_CAPS_DRAW_INDIRECT backend renderer capabilities.");
-		BGFX_CHECK_CAPS(BGFX_CAPS_COMPUTE, "Compute is not supported! Use bgfx::getCaps to check BGFX_CAPS_COMPUTE backend renderer capabilities.");
-		return s_ctx->dispatch(_id, _handle, _indirectHandle, _start, _num, _flags);
+		return s_ctx->m_encoder0->dispatch(_id, _handle, _indirectHandle, _start, _num, _flags);
 	}
 
 	void discard()
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		s_ctx->discard();
+		s_ctx->m_encoder0->discard();
 	}
 
 	void blit(uint8_t _id, TextureHandle _dst, uint16_t _dstX, uint16_t _dstY, TextureHandle _src, uint16_t _srcX, uint16_t _srcY, uint16_t _width, uint16_t _height)
@@ -4024,6 +5515,18 @@ BGFX_C_API void bgfx_vertex_unpack(float _output[4], bgfx_attrib_t _attr, const
 	bgfx::vertexUnpack(_output, bgfx::Attrib::Enum(_attr), decl, _data, _index);
 }
 
+BGFX_C_API void bgfx_vertex_pack_n(const float* _input, bool _inputNormalized, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, void* _data, uint32_t _num, uint32_t _index)
+{
+	bgfx::VertexDecl& decl = *(bgfx::VertexDecl*)_decl;
+	bgfx::vertexPackN(_input, _inputNormalized, bgfx::Attrib::Enum(_attr), decl, _data, _num, _index);
+}
+
+BGFX_C_API void bgfx_vertex_unpack_n(float* _output, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _num, uint32_t _index)
+{
+	bgfx::VertexDecl& decl = *(bgfx::VertexDecl*)_decl;
+	bgfx::vertexUnpackN(_output, bgfx::Attrib::Enum(_attr), decl, _data, _num, _index);
+}
+
 BGFX_C_API void bgfx_vertex_convert(const bgfx_vertex_decl_t* _destDecl, void* _destData, const bgfx_vertex_decl_t* _srcDecl, const void* _srcData, uint32_t _num)
 {
 	bgfx::VertexDecl& destDecl = *(bgfx::VertexDecl*)_destDecl;
@@ -4037,6 +5540,12 @@ BGFX_C_API uint16_t bgfx_weld_vertices(uint16_t* _output, const bgfx_vertex_decl
 	return bgfx::weldVertices(_output, decl, _data, _num, _epsilon);
 }
 
+BGFX_C_API uint32_t bgfx_weld_vertices32(uint32_t* _output, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _num, float _epsilon, uint8_t _flags)
+{
+	bgfx::VertexDecl& decl = *(bgfx::VertexDecl*)_decl;
+	return bgfx::weldVertices(_output, decl, _data, _num, _epsilon, _flags);
+}
+
 uint32_t bgfx_topology_convert(bgfx_topology_convert_t _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32)
 {
 	return bgfx::topologyConvert(bgfx::TopologyConvert::Enum(_conversion), _dst, _dstSize, _indices, _numIndices, _index32);
@@ -4047,6 +5556,45 @@ void bgfx_topology_sort_tri_list(bgfx_topology_sort_t _sort, void* _dst, uint32_
 	bgfx::topologySortTriList(bgfx::TopologySort::Enum(_sort), _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32);
 }
 
+void bgfx_topology_sort_tri_list_coherent(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, uint32_t* _order, bool _multithreaded)
+{
+	bgfx::topologySortTriListCoherent(bgfx::TopologySort::Enum(_sort), _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, _order, _multithreaded);
+}
+
+uint32_t bgfx_topology_optimize(bgfx_topology_optimize_t _optimize, void* _dst, uint32_t _dstSize, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+{
+	return bgfx::topologyOptimize(bgfx::TopologyOptimize::Enum(_optimize), _dst, _dstSize, _vertices, _numVertices, _stride, _indices, _numIndices, _index32);
+}
+
+uint32_t bgfx_topology_optimize_vertex_fetch(void* _dst, uint32_t _dstSize, const void* _vertices, uint32_t _numVertices, uint32_t _stride, void* _indices, uint32_t _numIndices, bool _index32)
+{
+	return bgfx::topologyOptimizeVertexFetch(_dst, _dstSize, _vertices, _numVertices, _stride, _indices, _numIndices, _index32);
+}
+
+void bgfx_topology_calc_stats(bgfx_topology_stats_t* _stats, uint32_t _cacheSize, const void* _indices, uint32_t _numIndices, uint32_t _numVertices, bool _index32)
+{
+	bgfx::TopologyStats* stats = (bgfx::TopologyStats*)_stats;
+	bgfx::topologyCalcStats(stats, _cacheSize, _indices, _numIndices, _numVertices, _index32);
+}
+
+uint32_t bgfx_topology_build_clusters(bgfx_topology_cluster_t* _clusters, uint32_t _maxClusters, void* _dst, uint32_t _dstSize, uint32_t _maxTriangles, uint32_t _maxVertices, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+{
+	bgfx::TopologyCluster* clusters = (bgfx::TopologyCluster*)_clusters;
+	return bgfx::topologyBuildClusters(clusters, _maxClusters, _dst, _dstSize, _maxTriangles, _maxVertices, _vertices, _numVertices, _stride, _indices, _numIndices, _index32);
+}
+
+uint32_t bgfx_topology_build_edges(bgfx_topology_edge_t* _edges, uint32_t _maxEdges, const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+{
+	bgfx::TopologyEdge* edges = (bgfx::TopologyEdge*)_edges;
+	return bgfx::topologyBuildEdges(edges, _maxEdges, _vertices, _stride, _indices, _numIndices, _index32);
+}
+
+uint32_t bgfx_topology_simplify(void* _dst, uint32_t _dstSize, uint32_t _numTargetIndices, float _maxError, const bgfx_vertex_decl_t* _decl, const void* _vertices, uint32_t _numVertices, const void* _indices, uint32_t _numIndices, bool _index32)
+{
+	const bgfx::VertexDecl& decl = *(const bgfx::VertexDecl*)_decl;
+	return bgfx::topologySimplify(_dst, _dstSize, _numTargetIndices, _maxError, decl, _vertices, _numVertices, _indices, _numIndices, _index32);
+}
+
 BGFX_C_API void bgfx_image_swizzle_bgra8(void* _dst, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src)
 {
 	bgfx::imageSwizzleBgra8(_dst, _width, _height, _pitch, _src);
@@ -4417,6 +5965,25 @@ BGFX_C_API void bgfx_destroy_texture(bgfx_texture_handle_t _handle)
 	bgfx::destroyTexture(handle.cpp);
 }
 
+BGFX_C_API bgfx_texture_handle_t bgfx_create_streaming_texture(const bgfx_memory_t* _mem, uint32_t _flags, uint8_t _numResidentMips, bgfx_texture_info_t* _info)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle;
+	bgfx::TextureInfo* info = (bgfx::TextureInfo*)_info;
+	handle.cpp = bgfx::createStreamingTexture( (const bgfx::Memory*)_mem, _flags, _numResidentMips, info);
+	return handle.c;
+}
+
+BGFX_C_API void bgfx_request_texture_mips(bgfx_texture_handle_t _handle, uint8_t _numMips)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	bgfx::requestTextureMips(handle.cpp, _numMips);
+}
+
+BGFX_C_API void bgfx_set_texture_streaming_budget(uint32_t _uploadBytesPerFrame, uint64_t _memoryCap)
+{
+	bgfx::setTextureStreamingBudget(_uploadBytesPerFrame, _memoryCap);
+}
+
 BGFX_C_API bgfx_frame_buffer_handle_t bgfx_create_frame_buffer(uint16_t _width, uint16_t _height, bgfx_texture_format_t _format, uint32_t _textureFlags)
 {
 	union { bgfx_frame_buffer_handle_t c; bgfx::FrameBufferHandle cpp; } handle;
@@ -4566,6 +6133,18 @@ BGFX_C_API void bgfx_set_view_order(uint8_t _id, uint8_t _num, const void* _orde
 	bgfx::setViewOrder(_id, _num, _order);
 }
 
+BGFX_C_API void bgfx_set_view_uniform(uint8_t _id, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num)
+{
+	union { bgfx_uniform_handle_t c; bgfx::UniformHandle cpp; } handle = { _handle };
+	bgfx::setViewUniform(_id, handle.cpp, _value, _num);
+}
+
+BGFX_C_API void bgfx_set_frame_uniform(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num)
+{
+	union { bgfx_uniform_handle_t c; bgfx::UniformHandle cpp; } handle = { _handle };
+	bgfx::setFrameUniform(handle.cpp, _value, _num);
+}
+
 BGFX_C_API void bgfx_reset_view(uint8_t _id)
 {
 	bgfx::resetView(_id);
@@ -4816,10 +6395,20 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 	BGFX_IMPORT_FUNC(vertex_decl_end) \
 	BGFX_IMPORT_FUNC(vertex_pack) \
 	BGFX_IMPORT_FUNC(vertex_unpack) \
+	BGFX_IMPORT_FUNC(vertex_pack_n) \
+	BGFX_IMPORT_FUNC(vertex_unpack_n) \
 	BGFX_IMPORT_FUNC(vertex_convert) \
 	BGFX_IMPORT_FUNC(weld_vertices) \
+	BGFX_IMPORT_FUNC(weld_vertices32) \
 	BGFX_IMPORT_FUNC(topology_convert) \
 	BGFX_IMPORT_FUNC(topology_sort_tri_list) \
+	BGFX_IMPORT_FUNC(topology_sort_tri_list_coherent) \
+	BGFX_IMPORT_FUNC(topology_optimize) \
+	BGFX_IMPORT_FUNC(topology_optimize_vertex_fetch) \
+	BGFX_IMPORT_FUNC(topology_calc_stats) \
+	BGFX_IMPORT_FUNC(topology_build_clusters) \
+	BGFX_IMPORT_FUNC(topology_build_edges) \
+	BGFX_IMPORT_FUNC(topology_simplify) \
 	BGFX_IMPORT_FUNC(image_swizzle_bgra8) \
 	BGFX_IMPORT_FUNC(image_rgba8_downsample_2x2) \
 	BGFX_IMPORT_FUNC(get_supported_renderers) \
@@ -4880,6 +6469,9 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 	BGFX_IMPORT_FUNC(update_texture_cube) \
 	BGFX_IMPORT_FUNC(read_texture) \
 	BGFX_IMPORT_FUNC(destroy_texture) \
+	BGFX_IMPORT_FUNC(create_streaming_texture) \
+	BGFX_IMPORT_FUNC(request_texture_mips) \
+	BGFX_IMPORT_FUNC(set_texture_streaming_budget) \
 	BGFX_IMPORT_FUNC(create_frame_buffer) \
 	BGFX_IMPORT_FUNC(create_frame_buffer_scaled) \
 	BGFX_IMPORT_FUNC(create_frame_buffer_from_attachment) \
@@ -4903,6 +6495,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 	BGFX_IMPORT_FUNC(set_view_transform) \
 	BGFX_IMPORT_FUNC(set_view_transform_stereo) \
 	BGFX_IMPORT_FUNC(set_view_order) \
+	BGFX_IMPORT_FUNC(set_view_uniform) \
+	BGFX_IMPORT_FUNC(set_frame_uniform) \
 	BGFX_IMPORT_FUNC(set_marker) \
 	BGFX_IMPORT_FUNC(set_state) \
 	BGFX_IMPORT_FUNC(set_condition) \
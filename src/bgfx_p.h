@@ -183,6 +183,7 @@ namespace stl = std;
 #endif // BX_PLATFORM_*
 
 #include <bx/cpu.h>
+#include <bx/mutex.h>
 #include <bx/thread.h>
 #include <bx/timer.h>
 
@@ -255,11 +256,7 @@ namespace bgfx
 	extern PlatformData g_platformData;
 	extern bool g_platformDataChangedSinceReset;
 
-#if BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
-	typedef uint16_t RenderItemCount;
-#else
 	typedef uint32_t RenderItemCount;
-#endif // BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
 
 	struct Clear
 	{
@@ -608,12 +605,21 @@ namespace bgfx
 
 	public:
 		CommandBuffer()
-			: m_pos(0)
-			, m_size(BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE)
+			: m_buffer(NULL)
+			, m_pos(0)
+			, m_size(0)
+			, m_capacity(0)
+			, m_started(true)
 		{
+			resize(BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE);
 			finish();
 		}
 
+		~CommandBuffer()
+		{
+			BX_FREE(g_allocator, m_buffer);
+		}
+
 		enum Enum
 		{
 			RendererInit,
@@ -630,6 +636,7 @@ namespace bgfx
 			CreateTexture,
 			UpdateTexture,
 			ResizeTexture,
+			SetTextureMinLod,
 			CreateFrameBuffer,
 			CreateUniform,
 			UpdateViewName,
@@ -649,12 +656,34 @@ namespace bgfx
 			SaveScreenShot,
 		};
 
+		enum
+		{
+			/// Every command starts at this alignment so that a range of
+			/// commands can be moved between buffers without changing the
+			/// padding of its payload.
+			CommandAlignment = 16,
+		};
+
+		void resize(uint32_t _capacity)
+		{
+			m_buffer   = (uint8_t*)BX_REALLOC(g_allocator, m_buffer, _capacity);
+			m_capacity = _capacity;
+		}
+
 		void write(const void* _data, uint32_t _size)
 		{
-			BX_CHECK(m_size == BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE, "Called write outside start/finish?");
-			BX_CHECK(m_pos < m_size, "CommandBuffer::write error (pos: %d, size: %d).", m_pos, m_size);
+			BX_CHECK(m_started, "Called write outside start/finish?");
+
+			const uint32_t size = m_pos + _size;
+			if (size > m_capacity)
+			{
+				const uint32_t chunk = BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+				resize( (size + chunk - 1) / chunk * chunk);
+			}
+
 			bx::memCopy(&m_buffer[m_pos], _data, _size);
-			m_pos += _size;
+			m_pos  = size;
+			m_size = size;
 		}
 
 		template<typename Type>
@@ -700,6 +729,20 @@ namespace bgfx
 			m_pos = pos;
 		}
 
+		void writeCommand(uint8_t _cmd)
+		{
+			align(CommandAlignment);
+			write(_cmd);
+		}
+
+		uint8_t readCommand()
+		{
+			align(CommandAlignment);
+			uint8_t cmd;
+			read(cmd);
+			return cmd;
+		}
+
 		void reset()
 		{
 			m_pos = 0;
@@ -708,20 +751,23 @@ namespace bgfx
 		void start()
 		{
 			m_pos = 0;
-			m_size = BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			m_size = 0;
+			m_started = true;
 		}
 
 		void finish()
 		{
-			uint8_t cmd = End;
-			write(cmd);
+			writeCommand(End);
 			m_size = m_pos;
 			m_pos = 0;
+			m_started = false;
 		}
 
+		uint8_t* m_buffer;
 		uint32_t m_pos;
 		uint32_t m_size;
-		uint8_t m_buffer[BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE];
+		uint32_t m_capacity;
+		bool m_started;
 	};
 
 #define SORT_KEY_NUM_BITS_TRANS        2
@@ -853,6 +899,18 @@ namespace bgfx
 			return key;
 		}
 
+		static uint64_t remapSeq(uint64_t _key, uint32_t _seq)
+		{
+			const uint64_t seq = (uint64_t(_seq) << SORT_KEY_SEQ_SHIFT) & SORT_KEY_SEQ_MASK;
+			const uint64_t key = (_key & ~SORT_KEY_SEQ_MASK) | seq;
+			return key;
+		}
+
+		static bool isCompute(uint64_t _key)
+		{
+			return 0 == (_key & SORT_KEY_DRAW_BIT);
+		}
+
 		void reset()
 		{
 			m_depth   = 0;
@@ -913,12 +971,37 @@ namespace bgfx
 		}
 	};
 
+	BX_STATIC_ASSERT(BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE > UINT16_MAX);
+
+	// Matrix cache grows in chunks, so pointers returned by allocTransform
+	// stay valid while other threads reserve more matrices. Matrices of one
+	// transform are always in the same chunk.
 	struct MatrixCache
 	{
 		MatrixCache()
 			: m_num(1)
+			, m_max(0)
+			, m_numChunks(0)
+		{
+			bx::memSet(m_chunk, 0, sizeof(m_chunk) );
+		}
+
+		void create()
+		{
+			grow(1);
+			m_chunk[0][0].setIdentity();
+		}
+
+		void destroy()
 		{
-			m_cache[0].setIdentity();
+			for (uint32_t ii = 0; ii < m_numChunks; ++ii)
+			{
+				BX_FREE(g_allocator, m_chunk[ii]);
+				m_chunk[ii] = NULL;
+			}
+
+			m_max       = 0;
+			m_numChunks = 0;
 		}
 
 		void reset()
@@ -929,45 +1012,94 @@ namespace bgfx
 		uint32_t reserve(uint16_t* _num)
 		{
 			uint32_t num = *_num;
-			BX_WARN(m_num+num < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", m_num+num, BGFX_CONFIG_MAX_MATRIX_CACHE);
-			num = bx::uint32_min(num, BGFX_CONFIG_MAX_MATRIX_CACHE-m_num);
-			uint32_t first = m_num < BGFX_CONFIG_MAX_MATRIX_CACHE
-				? m_num
-				: BGFX_CONFIG_MAX_MATRIX_CACHE - 1
-				;
-			m_num += num;
-			*_num = (uint16_t)num;
+			uint32_t first;
+
+			// Range crossing chunk boundary is abandoned, and reserved again
+			// from the next chunk.
+			do
+			{
+				first = bx::atomicFetchAndAdd<uint32_t>(&m_num, num);
+			}
+			while (0 != num
+				&& first < BGFX_CONFIG_MAX_MATRIX_CACHE
+				&& first/BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE != (first+num-1)/BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE
+				);
+
+			BX_WARN(first+num < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", first+num, BGFX_CONFIG_MAX_MATRIX_CACHE);
+			if (first+num > BGFX_CONFIG_MAX_MATRIX_CACHE)
+			{
+				*_num = 0;
+				return 0;
+			}
+
+			if (0 != num
+			&&  first+num > bx::atomicFetchAndAdd<uint32_t>(&m_max, 0) )
+			{
+				bx::MutexScope lock(m_lock);
+				grow(first+num);
+			}
+
 			return first;
 		}
 
-		uint32_t add(const void* _mtx, uint16_t _num)
+		uint32_t add(const void* _mtx, uint16_t* _num)
 		{
 			if (NULL != _mtx)
 			{
-				uint32_t first = reserve(&_num);
-				bx::memCopy(&m_cache[first], _mtx, sizeof(Matrix4)*_num);
+				uint32_t first = reserve(_num);
+				bx::memCopy(toPtr(first), _mtx, sizeof(Matrix4)*(*_num) );
 				return first;
 			}
 
 			return 0;
 		}
 
+		/// Returns number of matrices, up to `_num`, that are stored
+		/// contiguously starting at `_cacheIdx`.
+		uint16_t clamp(uint32_t _cacheIdx, uint16_t _num) const
+		{
+			const uint32_t end = (_cacheIdx/BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE + 1)*BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE;
+			return uint16_t(bx::uint32_min(_cacheIdx+_num, end) - _cacheIdx);
+		}
+
 		float* toPtr(uint32_t _cacheIdx)
 		{
-			BX_CHECK(_cacheIdx < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			BX_CHECK(_cacheIdx < m_max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cacheIdx
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, m_max
 				);
-			return m_cache[_cacheIdx].un.val;
+			return m_chunk[_cacheIdx/BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE][_cacheIdx%BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE].un.val;
+		}
+
+		const Matrix4& get(uint32_t _cacheIdx) const
+		{
+			return m_chunk[_cacheIdx/BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE][_cacheIdx%BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE];
 		}
 
-		uint32_t fromPtr(const void* _ptr) const
+		void grow(uint32_t _num)
 		{
-			return uint32_t( (const Matrix4*)_ptr - m_cache);
+			const uint32_t numChunks = (_num + BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE - 1) / BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE;
+
+			if (numChunks > m_numChunks)
+			{
+				for (uint32_t ii = m_numChunks; ii < numChunks; ++ii)
+				{
+					m_chunk[ii] = (Matrix4*)BX_ALLOC(g_allocator, BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE*sizeof(Matrix4) );
+				}
+
+				m_numChunks = numChunks;
+
+				// Publish new size only after chunks are visible to other
+				// threads.
+				bx::atomicFetchAndAdd<uint32_t>(&m_max, (numChunks*BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE) - m_max);
+			}
 		}
 
-		Matrix4 m_cache[BGFX_CONFIG_MAX_MATRIX_CACHE];
+		Matrix4* m_chunk[(BGFX_CONFIG_MAX_MATRIX_CACHE+BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE-1)/BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE];
+		bx::Mutex m_lock;
 		uint32_t m_num;
+		uint32_t m_max;
+		uint32_t m_numChunks;
 	};
 
 	struct RectCache
@@ -984,17 +1116,16 @@ namespace bgfx
 
 		uint32_t add(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 		{
-			BX_CHECK(m_num+1 < BGFX_CONFIG_MAX_RECT_CACHE, "Rect cache overflow. %d (max: %d)", m_num, BGFX_CONFIG_MAX_RECT_CACHE);
+			const uint32_t first = bx::atomicFetchAndAdd<uint32_t>(&m_num, 1);
+			BX_CHECK(first+1 < BGFX_CONFIG_MAX_RECT_CACHE, "Rect cache overflow. %d (max: %d)", first, BGFX_CONFIG_MAX_RECT_CACHE);
 
-			uint32_t first = m_num;
-			Rect& rect = m_cache[m_num];
+			Rect& rect = m_cache[first];
 
 			rect.m_x = _x;
 			rect.m_y = _y;
 			rect.m_width = _width;
 			rect.m_height = _height;
 
-			m_num++;
 			return first;
 		}
 
@@ -1258,6 +1389,7 @@ namespace bgfx
 			m_submitFlags   = BGFX_SUBMIT_EYE_FIRST;
 			m_scissor       = UINT16_MAX;
 			m_streamMask    = 0;
+			m_uniformIdx    = 0;
 			m_stream[0].clear();
 			m_indexBuffer.idx        = invalidHandle;
 			m_instanceDataBuffer.idx = invalidHandle;
@@ -1302,6 +1434,7 @@ namespace bgfx
 		uint16_t m_scissor;
 		uint8_t  m_submitFlags;
 		uint8_t  m_streamMask;
+		uint8_t  m_uniformIdx;
 
 		IndexBufferHandle    m_indexBuffer;
 		VertexBufferHandle   m_instanceDataBuffer;
@@ -1321,6 +1454,7 @@ namespace bgfx
 			m_numZ        = 0;
 			m_num         = 0;
 			m_submitFlags = BGFX_SUBMIT_EYE_FIRST;
+			m_uniformIdx  = 0;
 
 			m_indirectBuffer.idx = invalidHandle;
 			m_startIndirect      = 0;
@@ -1345,6 +1479,7 @@ namespace bgfx
 		uint16_t m_numIndirect;
 		uint16_t m_num;
 		uint8_t  m_submitFlags;
+		uint8_t  m_uniformIdx;
 	};
 
 	union RenderItem
@@ -1353,6 +1488,14 @@ namespace bgfx
 		RenderCompute compute;
 	};
 
+	BX_STATIC_ASSERT(0 == (BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE & (BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE-1) ) );
+
+	struct RenderItemChunk
+	{
+		uint64_t   m_sortKey[BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE];
+		RenderItem m_renderItem[BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE];
+	};
+
 	struct BlitItem
 	{
 		uint16_t m_srcX;
@@ -1410,22 +1553,30 @@ namespace bgfx
 		uint16_t m_flags;
 	};
 
+	struct ViewUniformRange
+	{
+		uint32_t m_begin;
+		uint32_t m_end;
+		uint16_t m_next;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
-			: m_uniformMax(0)
+			: m_uniformEnd(0)
+			, m_uniformMax(0)
 			, m_waitSubmit(0)
 			, m_waitRender(0)
 			, m_hmdInitialized(false)
 			, m_capture(false)
-			, m_discard(false)
+			, m_sortKeys(NULL)
+			, m_sortValues(NULL)
+			, m_maxSortItems(0)
+			, m_maxRenderItems(0)
+			, m_numChunks(0)
 		{
-			SortKey term;
-			term.reset();
-			term.m_program = invalidHandle;
-			m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS]   = term.encodeDraw();
-			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
+			bx::memSet(m_chunk, 0, sizeof(m_chunk) );
 		}
 
 		~Frame()
@@ -1434,7 +1585,17 @@ namespace bgfx
 
 		void create()
 		{
-			m_uniformBuffer = UniformBuffer::create();
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_uniformBuffer); ++ii)
+			{
+				m_uniformBuffer[ii] = UniformBuffer::create();
+			}
+
+			m_viewUniformBuffer = UniformBuffer::create();
+
+			growRenderItems(1);
+			growSortItems(1);
+			m_matrixCache.create();
+
 			reset();
 			start();
 			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
@@ -1442,7 +1603,30 @@ namespace bgfx
 
 		void destroy()
 		{
-			UniformBuffer::destroy(m_uniformBuffer);
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_uniformBuffer); ++ii)
+			{
+				UniformBuffer::destroy(m_uniformBuffer[ii]);
+			}
+
+			UniformBuffer::destroy(m_viewUniformBuffer);
+
+			for (uint32_t ii = 0; ii < m_numChunks; ++ii)
+			{
+				BX_FREE(g_allocator, m_chunk[ii]);
+				m_chunk[ii] = NULL;
+			}
+
+			BX_FREE(g_allocator, m_sortKeys);
+			BX_FREE(g_allocator, m_sortValues);
+
+			m_sortKeys       = NULL;
+			m_sortValues     = NULL;
+			m_maxSortItems   = 0;
+			m_maxRenderItems = 0;
+			m_numChunks      = 0;
+
+			m_matrixCache.destroy();
+
 			BX_DELETE(g_allocator, m_textVideoMem);
 		}
 
@@ -1455,25 +1639,28 @@ namespace bgfx
 
 		void start()
 		{
-			m_stateFlags = BGFX_STATE_NONE;
-			m_uniformBegin = 0;
-			m_uniformEnd   = 0;
-			m_draw.clear();
-			m_compute.clear();
 			m_matrixCache.reset();
 			m_rectCache.reset();
-			m_key.reset();
-			m_num            = 0;
-			m_numRenderItems = 0;
-			m_numDropped     = 0;
-			m_numBlitItems   = 0;
+			m_num              = 0;
+			m_numRenderItems   = 0;
+			m_numDropped       = 0;
+			m_numDeferredDraws = 0;
+			m_numBlitItems     = 0;
 			m_iboffset = 0;
 			m_vboffset = 0;
 			m_cmdPre.start();
 			m_cmdPost.start();
-			m_uniformBuffer->reset();
 			m_capture = false;
-			m_discard = false;
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_uniformBuffer); ++ii)
+			{
+				m_uniformBuffer[ii]->reset();
+			}
+
+			m_viewUniformBuffer->reset();
+			m_numViewUniformRanges = 0;
+			bx::memSet(m_viewUniformFirst, 0xff, sizeof(m_viewUniformFirst) );
+			bx::memSet(m_viewUniformLast,  0xff, sizeof(m_viewUniformLast) );
 		}
 
 		void finish()
@@ -1481,332 +1668,234 @@ namespace bgfx
 			m_cmdPre.finish();
 			m_cmdPost.finish();
 
-			m_uniformMax = bx::uint32_max(m_uniformMax, m_uniformBuffer->getPos() );
-			m_uniformBuffer->finish();
+			m_uniformEnd = 0;
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_uniformBuffer); ++ii)
+			{
+				UniformBuffer* uniformBuffer = m_uniformBuffer[ii];
+				m_uniformEnd += uniformBuffer->getPos();
+				uniformBuffer->finish();
+			}
+			m_uniformEnd += m_viewUniformBuffer->getPos();
+			m_viewUniformBuffer->finish();
+			m_uniformMax = bx::uint32_max(m_uniformMax, m_uniformEnd);
+
+			m_num            = RenderItemCount(bx::uint32_min(m_numRenderItems, g_caps.limits.maxDrawCalls) );
+			m_numRenderItems = m_num;
 
 			if (0 < m_numDropped)
 			{
 				BX_TRACE("Too many draw calls: %d, dropped %d (max: %d)"
 					, m_num+m_numDropped
 					, m_numDropped
-					, BGFX_CONFIG_MAX_DRAW_CALLS
+					, g_caps.limits.maxDrawCalls
 					);
 			}
 		}
 
-		void setMarker(const char* _name)
-		{
-			m_uniformBuffer->writeMarker(_name);
+		void blit(uint8_t _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
+
+		void sort();
+
+		/// Reserves `_num` consecutive sort key and render item slots. Safe to
+		/// call from multiple threads. Returns index of first slot, and number
+		/// of slots actually reserved in `_num`.
+		uint32_t reserve(uint32_t* _num)
+		{
+			const uint32_t num   = *_num;
+			const uint32_t first = bx::atomicFetchAndAdd<uint32_t>(&m_numRenderItems, num);
+			const uint32_t max   = g_caps.limits.maxDrawCalls;
+			const uint32_t avail = first < max
+				? bx::uint32_min(num, max-first)
+				: 0
+				;
+
+			if (avail != num)
+			{
+				bx::atomicFetchAndAdd<uint32_t>(&m_numDropped, num-avail);
+			}
+
+			if (0 < avail
+			&&  first+avail > bx::atomicFetchAndAdd<uint32_t>(&m_maxRenderItems, 0) )
+			{
+				bx::MutexScope lock(m_chunkLock);
+				growRenderItems(first+avail);
+			}
+
+			*_num = avail;
+			return first;
 		}
 
-		void setState(uint64_t _state, uint32_t _rgba)
+		/// Allocates render item chunks until there is storage for `_num`
+		/// items. Chunks are kept between frames.
+		void growRenderItems(uint32_t _num)
 		{
-			uint8_t blend = ( (_state&BGFX_STATE_BLEND_MASK)>>BGFX_STATE_BLEND_SHIFT)&0xff;
-			uint8_t alphaRef = ( (_state&BGFX_STATE_ALPHA_REF_MASK)>>BGFX_STATE_ALPHA_REF_SHIFT)&0xff;
-			// transparency sort order table
-			m_key.m_trans = "\x0\x2\x2\x3\x3\x2\x3\x2\x3\x2\x2\x2\x2\x2\x2\x2\x2\x2\x2"[( (blend)&0xf) + (!!blend)] + !!alphaRef;
-			m_draw.m_stateFlags = _state;
-			m_draw.m_rgba = _rgba;
+			const uint32_t numChunks = (_num + BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE - 1) / BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE;
+			BX_CHECK(numChunks <= BX_COUNTOF(m_chunk), "Render item chunk out of bounds %d (max: %d)."
+				, numChunks
+				, BX_COUNTOF(m_chunk)
+				);
+
+			if (numChunks > m_numChunks)
+			{
+				for (uint32_t ii = m_numChunks; ii < numChunks; ++ii)
+				{
+					m_chunk[ii] = (RenderItemChunk*)BX_ALLOC(g_allocator, sizeof(RenderItemChunk) );
+				}
+
+				m_numChunks = numChunks;
+
+				// Publish new size only after chunks are visible to other
+				// threads.
+				bx::atomicFetchAndAdd<uint32_t>(&m_maxRenderItems, (numChunks*BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE) - m_maxRenderItems);
+			}
 		}
 
-		void setCondition(OcclusionQueryHandle _handle, bool _visible)
+		/// Grows contiguous sort key and value arrays to hold at least
+		/// `_num` items. Called only from render thread.
+		void growSortItems(uint32_t _num)
 		{
-			m_draw.m_occlusionQuery = _handle;
-			m_draw.m_submitFlags   |= _visible ? BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE : 0;
+			if (_num > m_maxSortItems)
+			{
+				const uint32_t max = bx::uint32_max(_num + _num/2, BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE);
+				m_sortKeys     = (uint64_t*)BX_REALLOC(g_allocator, m_sortKeys, max*sizeof(uint64_t) );
+				m_sortValues   = (RenderItemCount*)BX_REALLOC(g_allocator, m_sortValues, max*sizeof(RenderItemCount) );
+				m_maxSortItems = max;
+			}
 		}
 
-		void setStencil(uint32_t _fstencil, uint32_t _bstencil)
+		uint64_t& getSortKey(uint32_t _idx)
 		{
-			m_draw.m_stencil = packStencil(_fstencil, _bstencil);
+			return m_chunk[_idx/BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE]->m_sortKey[_idx%BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE];
 		}
 
-		uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
+		RenderItem& getRenderItem(uint32_t _idx)
 		{
-			uint16_t scissor = (uint16_t)m_rectCache.add(_x, _y, _width, _height);
-			m_draw.m_scissor = scissor;
-			return scissor;
+			return m_chunk[_idx/BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE]->m_renderItem[_idx%BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE];
 		}
 
-		void setScissor(uint16_t _cache)
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
 		{
-			m_draw.m_scissor = _cache;
+			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
+			uint32_t iboffset = offset + _num*sizeof(uint16_t);
+			iboffset = bx::uint32_min(iboffset, BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
+			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
+			return num;
 		}
 
-		uint32_t setTransform(const void* _mtx, uint16_t _num)
+		uint32_t allocTransientIndexBuffer(uint32_t& _num)
 		{
-			m_draw.m_matrix = m_matrixCache.add(_mtx, _num);
-			m_draw.m_num    = _num;
+			uint32_t offset = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
+			uint32_t num    = getAvailTransientIndexBuffer(_num);
+			m_iboffset = offset + num*sizeof(uint16_t);
+			_num = num;
 
-			return m_draw.m_matrix;
+			return offset;
 		}
 
-		uint32_t allocTransform(Transform* _transform, uint16_t _num)
+		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
 		{
-			uint32_t first   = m_matrixCache.reserve(&_num);
-			_transform->data = m_matrixCache.toPtr(first);
-			_transform->num  = _num;
-
-			return first;
+			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
+			uint32_t vboffset = offset + _num * _stride;
+			vboffset = bx::uint32_min(vboffset, BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
+			uint32_t num = (vboffset-offset)/_stride;
+			return num;
 		}
 
-		void setTransform(uint32_t _cache, uint16_t _num)
+		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
 		{
-			BX_CHECK(_cache < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
-				, _cache
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
-				);
-			m_draw.m_matrix = _cache;
-			m_draw.m_num    = uint16_t(bx::uint32_min(_cache+_num, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _cache);
+			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
+			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
+			m_vboffset = offset + num * _stride;
+			_num = num;
+
+			return offset;
 		}
 
-		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
+		bool free(IndexBufferHandle _handle)
 		{
-			m_draw.m_startIndex  = _firstIndex;
-			m_draw.m_numIndices  = _numIndices;
-			m_draw.m_indexBuffer = _handle;
+			return m_freeIndexBuffer.queue(_handle);
 		}
 
-		void setIndexBuffer(const DynamicIndexBuffer& _dib, uint32_t _firstIndex, uint32_t _numIndices)
+		bool free(VertexDeclHandle _handle)
 		{
-			const uint32_t indexSize = 0 == (_dib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
-			m_draw.m_startIndex  = _dib.m_startIndex + _firstIndex;
-			m_draw.m_numIndices  = bx::uint32_min(_numIndices, _dib.m_size/indexSize);
-			m_draw.m_indexBuffer = _dib.m_handle;
+			return m_freeVertexDecl.queue(_handle);
 		}
 
-		void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
+		bool free(VertexBufferHandle _handle)
 		{
-			m_draw.m_indexBuffer = _tib->handle;
-			m_draw.m_startIndex  = _firstIndex;
-			m_draw.m_numIndices  = _numIndices;
-			m_discard = 0 == _numIndices;
+			return m_freeVertexBuffer.queue(_handle);
 		}
 
-		void setVertexBuffer(uint8_t _stream, VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
+		bool free(ShaderHandle _handle)
 		{
-			if (m_draw.setStreamBit(_stream, _handle) )
-			{
-				Stream& stream = m_draw.m_stream[_stream];
-				stream.m_startVertex   = _startVertex;
-				stream.m_handle        = _handle;
-				stream.m_decl.idx      = invalidHandle;
-				m_numVertices[_stream] = _numVertices;
-			}
+			return m_freeShader.queue(_handle);
 		}
 
-		void setVertexBuffer(uint8_t _stream, const DynamicVertexBuffer& _dvb, uint32_t _startVertex, uint32_t _numVertices)
+		bool free(ProgramHandle _handle)
 		{
-			if (m_draw.setStreamBit(_stream, _dvb.m_handle) )
-			{
-				Stream& stream = m_draw.m_stream[_stream];
-				stream.m_startVertex   = _dvb.m_startVertex + _startVertex;
-				stream.m_handle        = _dvb.m_handle;
-				stream.m_decl          = _dvb.m_decl;
-				m_numVertices[_stream] =
-					bx::uint32_min(bx::uint32_imax(0, _dvb.m_numVertices - _startVertex), _numVertices)
-					;
-			}
+			return m_freeProgram.queue(_handle);
 		}
 
-		void setVertexBuffer(uint8_t _stream, const TransientVertexBuffer* _tvb, uint32_t _startVertex, uint32_t _numVertices)
+		bool free(TextureHandle _handle)
 		{
-			if (m_draw.setStreamBit(_stream, _tvb->handle) )
-			{
-				Stream& stream = m_draw.m_stream[_stream];
-				stream.m_startVertex  = _tvb->startVertex + _startVertex;
-				stream.m_handle       = _tvb->handle;
-				stream.m_decl         = _tvb->decl;
-				m_numVertices[_stream] =
-					bx::uint32_min(bx::uint32_imax(0, _tvb->size/_tvb->stride - _startVertex), _numVertices)
-					;
-			}
+			return m_freeTexture.queue(_handle);
 		}
 
-		void setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _num)
+		bool free(FrameBufferHandle _handle)
 		{
- 			m_draw.m_instanceDataOffset = _idb->offset;
-			m_draw.m_instanceDataStride = _idb->stride;
-			m_draw.m_numInstances       = bx::uint32_min(_idb->num, _num);
-			m_draw.m_instanceDataBuffer = _idb->handle;
-			BX_FREE(g_allocator, const_cast<InstanceDataBuffer*>(_idb) );
+			return m_freeFrameBuffer.queue(_handle);
 		}
 
-		void setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num, uint16_t _stride)
+		bool free(UniformHandle _handle)
 		{
-			m_draw.m_instanceDataOffset = _startVertex * _stride;
-			m_draw.m_instanceDataStride = _stride;
-			m_draw.m_numInstances       = _num;
-			m_draw.m_instanceDataBuffer = _handle;
+			return m_freeUniform.queue(_handle);
 		}
 
-		void setTexture(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint32_t _flags)
+		// View uniforms are stored in separate buffer, as list of ranges per
+		// view. Consecutive uniforms for the same view extend last range.
+		// Index BGFX_CONFIG_MAX_VIEWS is used for frame uniforms.
+		void writeViewUniform(uint16_t _scope, UniformType::Enum _type, UniformHandle _handle, const void* _value, uint16_t _num)
 		{
-			Binding& bind = m_draw.m_bind[_stage];
-			bind.m_idx    = _handle.idx;
-			bind.m_type   = uint8_t(Binding::Texture);
-			bind.m_un.m_draw.m_textureFlags = (_flags&BGFX_TEXTURE_INTERNAL_DEFAULT_SAMPLER)
-				? BGFX_TEXTURE_INTERNAL_DEFAULT_SAMPLER
-				: _flags
-				;
+			UniformBuffer::update(m_viewUniformBuffer);
 
-			if (isValid(_sampler) )
+			const uint32_t begin = m_viewUniformBuffer->getPos();
+			m_viewUniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
+			const uint32_t end = m_viewUniformBuffer->getPos();
+
+			const uint16_t last = m_viewUniformLast[_scope];
+			if (UINT16_MAX != last
+			&&  begin == m_viewUniformRange[last].m_end)
 			{
-				uint32_t stage = _stage;
-				setUniform(_sampler, &stage);
+				m_viewUniformRange[last].m_end = end;
+				return;
 			}
-		}
-
-		void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
-		{
-			Binding& bind = m_compute.m_bind[_stage];
-			bind.m_idx    = _handle.idx;
-			bind.m_type   = uint8_t(Binding::IndexBuffer);
-			bind.m_un.m_compute.m_format = 0;
-			bind.m_un.m_compute.m_access = uint8_t(_access);
-			bind.m_un.m_compute.m_mip    = 0;
-		}
-
-		void setBuffer(uint8_t _stage, VertexBufferHandle _handle, Access::Enum _access)
-		{
-			Binding& bind = m_compute.m_bind[_stage];
-			bind.m_idx    = _handle.idx;
-			bind.m_type   = uint8_t(Binding::VertexBuffer);
-			bind.m_un.m_compute.m_format = 0;
-			bind.m_un.m_compute.m_access = uint8_t(_access);
-			bind.m_un.m_compute.m_mip    = 0;
-		}
 
-		void setImage(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint8_t _mip, Access::Enum _access, TextureFormat::Enum _format)
-		{
-			Binding& bind = m_compute.m_bind[_stage];
-			bind.m_idx    = _handle.idx;
-			bind.m_type   = uint8_t(Binding::Image);
-			bind.m_un.m_compute.m_format = uint8_t(_format);
-			bind.m_un.m_compute.m_access = uint8_t(_access);
-			bind.m_un.m_compute.m_mip    = _mip;
-
-			if (isValid(_sampler) )
+			BX_WARN(BGFX_CONFIG_MAX_VIEW_UNIFORM_RANGES > m_numViewUniformRanges
+				, "Too many view uniform ranges (max: %d)."
+				, BGFX_CONFIG_MAX_VIEW_UNIFORM_RANGES
+				);
+			if (BGFX_CONFIG_MAX_VIEW_UNIFORM_RANGES == m_numViewUniformRanges)
 			{
-				uint32_t stage = _stage;
-				setUniform(_sampler, &stage);
+				m_viewUniformBuffer->reset(begin);
+				return;
 			}
-		}
-
-		void discard()
-		{
-			m_discard = false;
-			m_draw.clear();
-			m_compute.clear();
-			m_stateFlags = BGFX_STATE_NONE;
-		}
-
-		uint32_t submit(uint8_t _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, int32_t _depth, bool _preserveState);
-
-		uint32_t submit(uint8_t _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, int32_t _depth, bool _preserveState)
-		{
-			m_draw.m_startIndirect  = _start;
-			m_draw.m_numIndirect    = _num;
-			m_draw.m_indirectBuffer = _indirectHandle;
-			OcclusionQueryHandle handle = BGFX_INVALID_HANDLE;
-			return submit(_id, _program, handle, _depth, _preserveState);
-		}
-
-		uint32_t dispatch(uint8_t _id, ProgramHandle _handle, uint16_t _ngx, uint16_t _ngy, uint16_t _ngz, uint8_t _flags);
-
-		uint32_t dispatch(uint8_t _id, ProgramHandle _handle, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint8_t _flags)
-		{
-			m_compute.m_indirectBuffer = _indirectHandle;
-			m_compute.m_startIndirect  = _start;
-			m_compute.m_numIndirect    = _num;
-			return dispatch(_id, _handle, 0, 0, 0, _flags);
-		}
-
-		void blit(uint8_t _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
-
-		void sort();
-
-		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
-		{
-			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
-			uint32_t iboffset = offset + _num*sizeof(uint16_t);
-			iboffset = bx::uint32_min(iboffset, BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
-			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
-			return num;
-		}
-
-		uint32_t allocTransientIndexBuffer(uint32_t& _num)
-		{
-			uint32_t offset = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
-			uint32_t num    = getAvailTransientIndexBuffer(_num);
-			m_iboffset = offset + num*sizeof(uint16_t);
-			_num = num;
-
-			return offset;
-		}
-
-		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
-		{
-			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
-			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::uint32_min(vboffset, BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
-			uint32_t num = (vboffset-offset)/_stride;
-			return num;
-		}
-
-		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
-		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
-
-			return offset;
-		}
-
-		void writeUniform(UniformType::Enum _type, UniformHandle _handle, const void* _value, uint16_t _num)
-		{
-			UniformBuffer::update(m_uniformBuffer);
-			m_uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
-		}
-
-		bool free(IndexBufferHandle _handle)
-		{
-			return m_freeIndexBuffer.queue(_handle);
-		}
-
-		bool free(VertexDeclHandle _handle)
-		{
-			return m_freeVertexDecl.queue(_handle);
-		}
-
-		bool free(VertexBufferHandle _handle)
-		{
-			return m_freeVertexBuffer.queue(_handle);
-		}
-
-		bool free(ShaderHandle _handle)
-		{
-			return m_freeShader.queue(_handle);
-		}
-
-		bool free(ProgramHandle _handle)
-		{
-			return m_freeProgram.queue(_handle);
-		}
 
-		bool free(TextureHandle _handle)
-		{
-			return m_freeTexture.queue(_handle);
-		}
+			const uint16_t idx = m_numViewUniformRanges++;
+			ViewUniformRange& range = m_viewUniformRange[idx];
+			range.m_begin = begin;
+			range.m_end   = end;
+			range.m_next  = UINT16_MAX;
 
-		bool free(FrameBufferHandle _handle)
-		{
-			return m_freeFrameBuffer.queue(_handle);
-		}
+			if (UINT16_MAX == last)
+			{
+				m_viewUniformFirst[_scope] = idx;
+			}
+			else
+			{
+				m_viewUniformRange[last].m_next = idx;
+			}
 
-		bool free(UniformHandle _handle)
-		{
-			return m_freeUniform.queue(_handle);
+			m_viewUniformLast[_scope] = idx;
 		}
 
 		void resetFreeHandles()
@@ -1821,8 +1910,6 @@ namespace bgfx
 			m_freeUniform.reset();
 		}
 
-		SortKey m_key;
-
 		uint8_t m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
 		FrameBufferHandle m_fb[BGFX_CONFIG_MAX_VIEWS];
 		Clear m_clear[BGFX_CONFIG_MAX_VIEWS];
@@ -1832,26 +1919,33 @@ namespace bgfx
 		Matrix4 m_view[BGFX_CONFIG_MAX_VIEWS];
 		Matrix4 m_proj[2][BGFX_CONFIG_MAX_VIEWS];
 		uint8_t m_viewFlags[BGFX_CONFIG_MAX_VIEWS];
+		uint16_t m_seqMask[BGFX_CONFIG_MAX_VIEWS];
 		uint8_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
 
-		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderDraw m_draw;
-		RenderCompute m_compute;
-		uint32_t m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+		uint64_t* m_sortKeys;
+		RenderItemCount* m_sortValues;
+		uint32_t m_maxSortItems;
+		uint32_t m_maxRenderItems;
+		uint32_t m_numChunks;
+		RenderItemChunk* m_chunk[(BGFX_CONFIG_MAX_DRAW_CALLS+BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE)/BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE];
+		bx::Mutex m_chunkLock;
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
-		uint64_t m_stateFlags;
-		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
 		uint32_t m_uniformMax;
 
-		UniformBuffer* m_uniformBuffer;
+		UniformBuffer* m_uniformBuffer[BGFX_CONFIG_MAX_ENCODERS];
+
+		UniformBuffer*   m_viewUniformBuffer;
+		ViewUniformRange m_viewUniformRange[BGFX_CONFIG_MAX_VIEW_UNIFORM_RANGES];
+		uint16_t         m_viewUniformFirst[BGFX_CONFIG_MAX_VIEWS+1];
+		uint16_t         m_viewUniformLast[BGFX_CONFIG_MAX_VIEWS+1];
+		uint16_t         m_numViewUniformRanges;
 
 		RenderItemCount m_num;
-		RenderItemCount m_numRenderItems;
-		RenderItemCount m_numDropped;
+		uint32_t m_numRenderItems;
+		uint32_t m_numDropped;
+		uint32_t m_numDeferredDraws;
 		uint16_t m_numBlitItems;
 
 		MatrixCache m_matrixCache;
@@ -1942,192 +2036,774 @@ namespace bgfx
 
 		bool m_hmdInitialized;
 		bool m_capture;
-		bool m_discard;
 	};
 
-	struct VertexDeclRef
+	// Records draw/compute state. Sort keys and render items are batched
+	// locally and flushed into submit frame with a single reservation, when
+	// batch is full or when encoder ends. Encoder 0 is owned by API thread
+	// and flushes after every draw call.
+	struct EncoderImpl
 	{
-		VertexDeclRef()
+		EncoderImpl()
+			: m_frame(NULL)
+			, m_num(0)
+			, m_uniformIdx(0)
 		{
 		}
 
-		void init()
+		~EncoderImpl()
 		{
-			bx::memSet(m_vertexDeclRef, 0, sizeof(m_vertexDeclRef) );
-			bx::memSet(m_vertexBufferRef, 0xff, sizeof(m_vertexBufferRef) );
 		}
 
-		template <uint16_t MaxHandlesT>
-		void shutdown(bx::HandleAllocT<MaxHandlesT>& _handleAlloc)
+		void begin(Frame* _frame, uint8_t _idx)
 		{
-			for (VertexDeclMap::Iterator it = m_vertexDeclMap.first(); m_vertexDeclMap.next(it); )
+			m_frame      = _frame;
+			m_uniformIdx = _idx;
+			m_num        = 0;
+			m_uniformBegin = m_frame->m_uniformBuffer[_idx]->getPos();
+			m_uniformEnd   = m_uniformBegin;
+			m_stateFlags   = BGFX_STATE_NONE;
+			m_draw.clear();
+			m_compute.clear();
+			m_key.reset();
+			m_discard = false;
+
+			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
 			{
-				_handleAlloc.free(it.handle);
+				m_uniformSet.clear();
 			}
 
-			m_vertexDeclMap.reset();
+			if (BX_ENABLED(BGFX_CONFIG_DEBUG_OCCLUSION) )
+			{
+				m_occlusionQuerySet.clear();
+			}
 		}
 
-		VertexDeclHandle find(uint32_t _hash)
+		void end()
 		{
-			VertexDeclHandle handle = { m_vertexDeclMap.find(_hash) };
-			return handle;
+			discard();
+			flush();
 		}
 
-		void add(VertexBufferHandle _handle, VertexDeclHandle _declHandle, uint32_t _hash)
+		bool isDirect() const
 		{
-			m_vertexBufferRef[_handle.idx] = _declHandle;
-			m_vertexDeclRef[_declHandle.idx]++;
-			m_vertexDeclMap.insert(_hash, _declHandle.idx);
+			return 0 == m_uniformIdx;
 		}
 
-		VertexDeclHandle release(VertexBufferHandle _handle)
+		UniformBuffer*& getUniformBuffer()
 		{
-			VertexDeclHandle declHandle = m_vertexBufferRef[_handle.idx];
-			if (isValid(declHandle) )
-			{
-				m_vertexDeclRef[declHandle.idx]--;
-
-				if (0 != m_vertexDeclRef[declHandle.idx])
-				{
-					VertexDeclHandle invalid = BGFX_INVALID_HANDLE;
-					return invalid;
-				}
-			}
-
-			m_vertexDeclMap.removeByHandle(declHandle.idx);
-
-			return declHandle;
+			return m_frame->m_uniformBuffer[m_uniformIdx];
 		}
 
-		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_VERTEX_DECLS*2> VertexDeclMap;
-		VertexDeclMap m_vertexDeclMap;
-
-		uint16_t m_vertexDeclRef[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		VertexDeclHandle m_vertexBufferRef[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-	};
+		void flush();
 
-	// First-fit non-local allocator.
-	class NonLocalAllocator
-	{
-	public:
-		static const uint64_t invalidBlock = UINT64_MAX;
+		void setMarker(const char* _name)
+		{
+			getUniformBuffer()->writeMarker(_name);
+		}
 
-		NonLocalAllocator()
+		void setState(uint64_t _state, uint32_t _rgba)
 		{
+			uint8_t blend = ( (_state&BGFX_STATE_BLEND_MASK)>>BGFX_STATE_BLEND_SHIFT)&0xff;
+			uint8_t alphaRef = ( (_state&BGFX_STATE_ALPHA_REF_MASK)>>BGFX_STATE_ALPHA_REF_SHIFT)&0xff;
+			// transparency sort order table
+			m_key.m_trans = "\x0\x2\x2\x3\x3\x2\x3\x2\x3\x2\x2\x2\x2\x2\x2\x2\x2\x2\x2"[( (blend)&0xf) + (!!blend)] + !!alphaRef;
+			m_draw.m_stateFlags = _state;
+			m_draw.m_rgba = _rgba;
 		}
 
-		~NonLocalAllocator()
+		void setCondition(OcclusionQueryHandle _handle, bool _visible)
 		{
+			m_draw.m_occlusionQuery = _handle;
+			m_draw.m_submitFlags   |= _visible ? BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE : 0;
 		}
 
-		void reset()
+		void setStencil(uint32_t _fstencil, uint32_t _bstencil)
 		{
-			m_free.clear();
-			m_used.clear();
+			m_draw.m_stencil = packStencil(_fstencil, _bstencil);
 		}
 
-		void add(uint64_t _ptr, uint32_t _size)
+		uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 		{
-			m_free.push_back(Free(_ptr, _size) );
+			uint16_t scissor = (uint16_t)m_frame->m_rectCache.add(_x, _y, _width, _height);
+			m_draw.m_scissor = scissor;
+			return scissor;
 		}
 
-		uint64_t remove()
+		void setScissor(uint16_t _cache)
 		{
-			BX_CHECK(0 == m_used.size(), "");
+			m_draw.m_scissor = _cache;
+		}
 
-			if (0 < m_free.size() )
-			{
-				Free freeBlock = m_free.front();
-				m_free.pop_front();
-				return freeBlock.m_ptr;
-			}
+		uint32_t setTransform(const void* _mtx, uint16_t _num)
+		{
+			m_draw.m_matrix = m_frame->m_matrixCache.add(_mtx, &_num);
+			m_draw.m_num    = _num;
 
-			return 0;
+			return m_draw.m_matrix;
 		}
 
-		uint64_t alloc(uint32_t _size)
+		uint32_t allocTransform(Transform* _transform, uint16_t _num)
 		{
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			uint32_t first   = m_frame->m_matrixCache.reserve(&_num);
+			_transform->data = m_frame->m_matrixCache.toPtr(first);
+			_transform->num  = _num;
+
+			return first;
+		}
+
+		void setTransform(uint32_t _cache, uint16_t _num)
+		{
+			BX_CHECK(_cache < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+				, _cache
+				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				);
+			m_draw.m_matrix = _cache;
+			m_draw.m_num    = m_frame->m_matrixCache.clamp(_cache, _num);
+		}
+
+		void setUniform(UniformType::Enum _type, UniformHandle _handle, const void* _value, uint16_t _num)
+		{
+			UniformBuffer::update(getUniformBuffer() );
+			getUniformBuffer()->writeUniform(_type, _handle.idx, _value, _num);
+		}
+
+		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
+		{
+			m_draw.m_startIndex  = _firstIndex;
+			m_draw.m_numIndices  = _numIndices;
+			m_draw.m_indexBuffer = _handle;
+		}
+
+		void setIndexBuffer(const DynamicIndexBuffer& _dib, uint32_t _firstIndex, uint32_t _numIndices)
+		{
+			const uint32_t indexSize = 0 == (_dib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+			m_draw.m_startIndex  = _dib.m_startIndex + _firstIndex;
+			m_draw.m_numIndices  = bx::uint32_min(_numIndices, _dib.m_size/indexSize);
+			m_draw.m_indexBuffer = _dib.m_handle;
+		}
+		void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
+		{
+			m_draw.m_indexBuffer = _tib->handle;
+			m_draw.m_startIndex  = _firstIndex;
+			m_draw.m_numIndices  = _numIndices;
+			m_discard = 0 == _numIndices;
+		}
+
+		void setVertexBuffer(uint8_t _stream, VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
+		{
+			if (m_draw.setStreamBit(_stream, _handle) )
+			{
+				Stream& stream = m_draw.m_stream[_stream];
+				stream.m_startVertex   = _startVertex;
+				stream.m_handle        = _handle;
+				stream.m_decl.idx      = invalidHandle;
+				m_numVertices[_stream] = _numVertices;
+			}
+		}
+
+		void setVertexBuffer(uint8_t _stream, const DynamicVertexBuffer& _dvb, uint32_t _startVertex, uint32_t _numVertices)
+		{
+			if (m_draw.setStreamBit(_stream, _dvb.m_handle) )
+			{
+				Stream& stream = m_draw.m_stream[_stream];
+				stream.m_startVertex   = _dvb.m_startVertex + _startVertex;
+				stream.m_handle        = _dvb.m_handle;
+				stream.m_decl          = _dvb.m_decl;
+				m_numVertices[_stream] =
+					bx::uint32_min(bx::uint32_imax(0, _dvb.m_numVertices - _startVertex), _numVertices)
+					;
+			}
+		}
+
+		void setVertexBuffer(uint8_t _stream, const TransientVertexBuffer* _tvb, uint32_t _startVertex, uint32_t _numVertices)
+		{
+			if (m_draw.setStreamBit(_stream, _tvb->handle) )
 			{
-				if (it->m_size >= _size)
+				Stream& stream = m_draw.m_stream[_stream];
+				stream.m_startVertex  = _tvb->startVertex + _startVertex;
+				stream.m_handle       = _tvb->handle;
+				stream.m_decl         = _tvb->decl;
+				m_numVertices[_stream] =
+					bx::uint32_min(bx::uint32_imax(0, _tvb->size/_tvb->stride - _startVertex), _numVertices)
+					;
+			}
+		}
+
+		void setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _num)
+		{
+ 			m_draw.m_instanceDataOffset = _idb->offset;
+			m_draw.m_instanceDataStride = _idb->stride;
+			m_draw.m_numInstances       = bx::uint32_min(_idb->num, _num);
+			m_draw.m_instanceDataBuffer = _idb->handle;
+			BX_FREE(g_allocator, const_cast<InstanceDataBuffer*>(_idb) );
+		}
+
+		void setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num, uint16_t _stride)
+		{
+			m_draw.m_instanceDataOffset = _startVertex * _stride;
+			m_draw.m_instanceDataStride = _stride;
+			m_draw.m_numInstances       = _num;
+			m_draw.m_instanceDataBuffer = _handle;
+		}
+
+		void setTexture(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint32_t _flags)
+		{
+			Binding& bind = m_draw.m_bind[_stage];
+			bind.m_idx    = _handle.idx;
+			bind.m_type   = uint8_t(Binding::Texture);
+			bind.m_un.m_draw.m_textureFlags = (_flags&BGFX_TEXTURE_INTERNAL_DEFAULT_SAMPLER)
+				? BGFX_TEXTURE_INTERNAL_DEFAULT_SAMPLER
+				: _flags
+				;
+
+			if (isValid(_sampler) )
+			{
+				uint32_t stage = _stage;
+				setUniform(UniformType::Int1, _sampler, &stage, 1);
+			}
+		}
+
+		void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
+		{
+			Binding& bind = m_compute.m_bind[_stage];
+			bind.m_idx    = _handle.idx;
+			bind.m_type   = uint8_t(Binding::IndexBuffer);
+			bind.m_un.m_compute.m_format = 0;
+			bind.m_un.m_compute.m_access = uint8_t(_access);
+			bind.m_un.m_compute.m_mip    = 0;
+		}
+
+		void setBuffer(uint8_t _stage, VertexBufferHandle _handle, Access::Enum _access)
+		{
+			Binding& bind = m_compute.m_bind[_stage];
+			bind.m_idx    = _handle.idx;
+			bind.m_type   = uint8_t(Binding::VertexBuffer);
+			bind.m_un.m_compute.m_format = 0;
+			bind.m_un.m_compute.m_access = uint8_t(_access);
+			bind.m_un.m_compute.m_mip    = 0;
+		}
+
+		void setImage(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint8_t _mip, Access::Enum _access, TextureFormat::Enum _format)
+		{
+			Binding& bind = m_compute.m_bind[_stage];
+			bind.m_idx    = _handle.idx;
+			bind.m_type   = uint8_t(Binding::Image);
+			bind.m_un.m_compute.m_format = uint8_t(_format);
+			bind.m_un.m_compute.m_access = uint8_t(_access);
+			bind.m_un.m_compute.m_mip    = _mip;
+
+			if (isValid(_sampler) )
+			{
+				uint32_t stage = _stage;
+				setUniform(UniformType::Int1, _sampler, &stage, 1);
+			}
+		}
+
+		void discard()
+		{
+			m_discard = false;
+			m_draw.clear();
+			m_compute.clear();
+			m_stateFlags = BGFX_STATE_NONE;
+		}
+
+		uint32_t submit(uint8_t _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, int32_t _depth, bool _preserveState);
+
+		uint32_t submit(uint8_t _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, int32_t _depth, bool _preserveState)
+		{
+			m_draw.m_startIndirect  = _start;
+			m_draw.m_numIndirect    = _num;
+			m_draw.m_indirectBuffer = _indirectHandle;
+			OcclusionQueryHandle handle = BGFX_INVALID_HANDLE;
+			return submit(_id, _program, handle, _depth, _preserveState);
+		}
+
+		uint32_t dispatch(uint8_t _id, ProgramHandle _handle, uint16_t _ngx, uint16_t _ngy, uint16_t _ngz, uint8_t _flags);
+
+		uint32_t dispatch(uint8_t _id, ProgramHandle _handle, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint8_t _flags)
+		{
+			m_compute.m_indirectBuffer = _indirectHandle;
+			m_compute.m_startIndirect  = _start;
+			m_compute.m_numIndirect    = _num;
+			return dispatch(_id, _handle, 0, 0, 0, _flags);
+		}
+
+
+		Frame* m_frame;
+
+		SortKey m_key;
+
+		RenderDraw    m_draw;
+		RenderCompute m_compute;
+		uint32_t      m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+		uint64_t      m_stateFlags;
+		uint32_t      m_uniformBegin;
+		uint32_t      m_uniformEnd;
+		bool          m_discard;
+
+		uint64_t    m_sortKeys[BGFX_CONFIG_ENCODER_BATCH_SIZE];
+		RenderItem  m_renderItem[BGFX_CONFIG_ENCODER_BATCH_SIZE];
+		uint32_t    m_itemIdx[BGFX_CONFIG_ENCODER_BATCH_SIZE];
+		uint32_t    m_num;
+		uint8_t     m_uniformIdx;
+
+		typedef stl::unordered_set<uint16_t> HandleSet;
+		HandleSet m_uniformSet;
+		HandleSet m_occlusionQuerySet;
+	};
+
+	struct VertexDeclRef
+	{
+		VertexDeclRef()
+		{
+		}
+
+		void init()
+		{
+			bx::memSet(m_vertexDeclRef, 0, sizeof(m_vertexDeclRef) );
+			bx::memSet(m_vertexBufferRef, 0xff, sizeof(m_vertexBufferRef) );
+		}
+
+		template <uint16_t MaxHandlesT>
+		void shutdown(bx::HandleAllocT<MaxHandlesT>& _handleAlloc)
+		{
+			for (VertexDeclMap::Iterator it = m_vertexDeclMap.first(); m_vertexDeclMap.next(it); )
+			{
+				_handleAlloc.free(it.handle);
+			}
+
+			m_vertexDeclMap.reset();
+		}
+
+		VertexDeclHandle find(uint32_t _hash)
+		{
+			VertexDeclHandle handle = { m_vertexDeclMap.find(_hash) };
+			return handle;
+		}
+
+		void add(VertexBufferHandle _handle, VertexDeclHandle _declHandle, uint32_t _hash)
+		{
+			m_vertexBufferRef[_handle.idx] = _declHandle;
+			m_vertexDeclRef[_declHandle.idx]++;
+			m_vertexDeclMap.insert(_hash, _declHandle.idx);
+		}
+
+		VertexDeclHandle release(VertexBufferHandle _handle)
+		{
+			VertexDeclHandle declHandle = m_vertexBufferRef[_handle.idx];
+			if (isValid(declHandle) )
+			{
+				m_vertexDeclRef[declHandle.idx]--;
+
+				if (0 != m_vertexDeclRef[declHandle.idx])
 				{
-					uint64_t ptr = it->m_ptr;
+					VertexDeclHandle invalid = BGFX_INVALID_HANDLE;
+					return invalid;
+				}
+			}
 
-					m_used.insert(stl::make_pair(ptr, _size) );
+			m_vertexDeclMap.removeByHandle(declHandle.idx);
 
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr  += _size;
-					}
-					else
-					{
-						m_free.erase(it);
-					}
+			return declHandle;
+		}
+
+		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_VERTEX_DECLS*2> VertexDeclMap;
+		VertexDeclMap m_vertexDeclMap;
+
+		uint16_t m_vertexDeclRef[BGFX_CONFIG_MAX_VERTEX_DECLS];
+		VertexDeclHandle m_vertexBufferRef[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+	};
+
+	// Two-level segregated fit allocator for ranges inside of GPU buffers.
+	// Allocation and free are O(1). Freed blocks are available for reuse
+	// right away, while merging them with neighbouring free blocks is
+	// deferred until compact is called.
+	class NonLocalAllocator
+	{
+	public:
+		static const uint64_t invalidBlock = UINT64_MAX;
+
+		struct Stats
+		{
+			uint64_t totalSize;   //!< Total size of all buffers added to allocator.
+			uint64_t usedSize;    //!< Size of allocated blocks.
+			uint32_t numUsed;     //!< Number of allocated blocks.
+			uint32_t numFree;     //!< Number of free blocks.
+			uint32_t largestFree; //!< Size of largest free block.
+		};
+
+		NonLocalAllocator()
+		{
+			reset();
+		}
+
+		~NonLocalAllocator()
+		{
+		}
+
+		void reset()
+		{
+			m_block.clear();
+			m_freeNode.clear();
+			m_pending.clear();
+			m_pool.clear();
+			m_used.clear();
+
+			m_flBitmap  = 0;
+			m_totalSize = 0;
+			m_usedSize  = 0;
+			m_numFree   = 0;
+			bx::memSet(m_slBitmap, 0, sizeof(m_slBitmap) );
+			bx::memSet(m_head, 0xff, sizeof(m_head) );
+		}
+
+		void add(uint64_t _ptr, uint32_t _size)
+		{
+			const uint32_t idx = allocNode();
+			Block& block = m_block[idx];
+			block.m_ptr      = _ptr;
+			block.m_size     = _size;
+			block.m_prevPhys = invalidIndex;
+			block.m_nextPhys = invalidIndex;
+			insertFree(idx);
+
+			m_pool.push_back(_ptr);
+			m_totalSize += _size;
+		}
+
+		uint64_t remove()
+		{
+			BX_CHECK(0 == m_used.size(), "");
+
+			if (!m_pool.empty() )
+			{
+				const uint64_t ptr = m_pool.back();
+				m_pool.pop_back();
+
+				if (m_pool.empty() )
+				{
+					reset();
+				}
+
+				return ptr;
+			}
+
+			return 0;
+		}
+
+		uint64_t alloc(uint32_t _size)
+		{
+			uint32_t fl, sl;
+			mappingSearch(_size, fl, sl);
+
+			uint32_t idx = findFree(fl, sl);
+			if (invalidIndex == idx)
+			{
+				// Rounded up search skips list that contains blocks of
+				// requested size class, check it before giving up.
+				mapping(_size, fl, sl);
+				for (idx = m_head[fl][sl]; invalidIndex != idx && m_block[idx].m_size < _size; idx = m_block[idx].m_nextFree) {};
+
+				if (invalidIndex == idx)
+				{
+					// there is no block large enough.
+					return invalidBlock;
+				}
+			}
+
+			removeFree(idx);
+
+			if (m_block[idx].m_size != _size)
+			{
+				const uint32_t rest = allocNode();
+				Block& block     = m_block[idx];
+				Block& restBlock = m_block[rest];
+
+				restBlock.m_ptr      = block.m_ptr  + _size;
+				restBlock.m_size     = block.m_size - _size;
+				restBlock.m_prevPhys = idx;
+				restBlock.m_nextPhys = block.m_nextPhys;
+
+				if (invalidIndex != block.m_nextPhys)
+				{
+					m_block[block.m_nextPhys].m_prevPhys = rest;
+				}
+
+				block.m_size     = _size;
+				block.m_nextPhys = rest;
+
+				insertFree(rest);
+			}
+
+			Block& block = m_block[idx];
+			block.m_state = Used;
+			m_usedSize += block.m_size;
+			m_used.insert(stl::make_pair(block.m_ptr, idx) );
+
+			return block.m_ptr;
+		}
+
+		void free(uint64_t _block)
+		{
+			UsedList::iterator it = m_used.find(_block);
+			if (it != m_used.end() )
+			{
+				const uint32_t idx = it->second;
+				m_used.erase(it);
+
+				m_usedSize -= m_block[idx].m_size;
+				insertFree(idx);
+				m_pending.push_back(idx);
+			}
+		}
+
+		bool compact()
+		{
+			for (uint32_t ii = 0, num = uint32_t(m_pending.size() ); ii < num; ++ii)
+			{
+				const uint32_t idx = m_pending[ii];
+				if (Free == m_block[idx].m_state)
+				{
+					coalesce(idx);
+				}
+			}
+
+			m_pending.clear();
+
+			return 0 == m_used.size();
+		}
+
+		void getStats(Stats& _stats) const
+		{
+			_stats.totalSize   = m_totalSize;
+			_stats.usedSize    = m_usedSize;
+			_stats.numUsed     = uint32_t(m_used.size() );
+			_stats.numFree     = m_numFree;
+			_stats.largestFree = 0;
+
+			if (0 != m_flBitmap)
+			{
+				const uint32_t fl = 31 - bx::uint32_cntlz(m_flBitmap);
+				const uint32_t sl = 31 - bx::uint32_cntlz(m_slBitmap[fl]);
+				for (uint32_t idx = m_head[fl][sl]; invalidIndex != idx; idx = m_block[idx].m_nextFree)
+				{
+					_stats.largestFree = bx::uint32_max(_stats.largestFree, m_block[idx].m_size);
+				}
+			}
+		}
+
+	private:
+		enum
+		{
+			SlBits  = 4,
+			SlCount = 1<<SlBits,
+			FlCount = 32-SlBits+1,
+		};
+
+		static const uint32_t invalidIndex = UINT32_MAX;
+
+		enum State
+		{
+			Unused,
+			Free,
+			Used,
+		};
+
+		struct Block
+		{
+			uint64_t m_ptr;
+			uint32_t m_size;
+			uint32_t m_prevPhys;
+			uint32_t m_nextPhys;
+			uint32_t m_prevFree;
+			uint32_t m_nextFree;
+			State    m_state;
+		};
+
+		static void mapping(uint32_t _size, uint32_t& _fl, uint32_t& _sl)
+		{
+			if (_size < SlCount)
+			{
+				_fl = 0;
+				_sl = _size;
+			}
+			else
+			{
+				const uint32_t msb = 31 - bx::uint32_cntlz(_size);
+				_fl = msb - SlBits + 1;
+				_sl = (_size >> (msb - SlBits) ) ^ SlCount;
+			}
+		}
+
+		static void mappingSearch(uint32_t _size, uint32_t& _fl, uint32_t& _sl)
+		{
+			if (_size >= SlCount)
+			{
+				const uint32_t msb   = 31 - bx::uint32_cntlz(_size);
+				const uint32_t round = (1 << (msb - SlBits) ) - 1;
+				_size = bx::uint32_satadd(_size, round);
+			}
+
+			mapping(_size, _fl, _sl);
+		}
+
+		uint32_t findFree(uint32_t _fl, uint32_t _sl) const
+		{
+			if (_fl >= FlCount)
+			{
+				return invalidIndex;
+			}
 
-					return ptr;
+			uint32_t slMap = m_slBitmap[_fl] & (UINT32_MAX << _sl);
+			if (0 == slMap)
+			{
+				const uint32_t flMap = _fl+1 < 32 ? m_flBitmap & (UINT32_MAX << (_fl+1) ) : 0;
+				if (0 == flMap)
+				{
+					return invalidIndex;
 				}
+
+				_fl   = bx::uint32_cnttz(flMap);
+				slMap = m_slBitmap[_fl];
 			}
 
-			// there is no block large enough.
-			return invalidBlock;
+			_sl = bx::uint32_cnttz(slMap);
+			return m_head[_fl][_sl];
 		}
 
-		void free(uint64_t _block)
+		void insertFree(uint32_t _idx)
 		{
-			UsedList::iterator it = m_used.find(_block);
-			if (it != m_used.end() )
+			Block& block = m_block[_idx];
+
+			uint32_t fl, sl;
+			mapping(block.m_size, fl, sl);
+
+			const uint32_t head = m_head[fl][sl];
+			block.m_state    = Free;
+			block.m_prevFree = invalidIndex;
+			block.m_nextFree = head;
+
+			if (invalidIndex != head)
 			{
-				m_free.push_front(Free(it->first, it->second) );
-				m_used.erase(it);
+				m_block[head].m_prevFree = _idx;
 			}
+
+			m_head[fl][sl] = _idx;
+			m_slBitmap[fl] |= UINT32_C(1) << sl;
+			m_flBitmap     |= UINT32_C(1) << fl;
+			++m_numFree;
 		}
 
-		bool compact()
+		void removeFree(uint32_t _idx)
 		{
-			m_free.sort();
+			Block& block = m_block[_idx];
+
+			uint32_t fl, sl;
+			mapping(block.m_size, fl, sl);
 
-			for (FreeList::iterator it = m_free.begin(), next = it, itEnd = m_free.end(); next != itEnd;)
+			if (invalidIndex != block.m_prevFree)
 			{
-				if ( (it->m_ptr + it->m_size) == next->m_ptr)
-				{
-					it->m_size += next->m_size;
-					next = m_free.erase(next);
-				}
-				else
+				m_block[block.m_prevFree].m_nextFree = block.m_nextFree;
+			}
+			else
+			{
+				m_head[fl][sl] = block.m_nextFree;
+
+				if (invalidIndex == block.m_nextFree)
 				{
-					it = next;
-					++next;
+					m_slBitmap[fl] &= ~(UINT32_C(1) << sl);
+					if (0 == m_slBitmap[fl])
+					{
+						m_flBitmap &= ~(UINT32_C(1) << fl);
+					}
 				}
 			}
 
-			return 0 == m_used.size();
+			if (invalidIndex != block.m_nextFree)
+			{
+				m_block[block.m_nextFree].m_prevFree = block.m_prevFree;
+			}
+
+			block.m_state = Unused;
+			--m_numFree;
 		}
 
-	private:
-		struct Free
+		void coalesce(uint32_t _idx)
 		{
-			Free(uint64_t _ptr, uint32_t _size)
-				: m_ptr(_ptr)
-				, m_size(_size)
+			removeFree(_idx);
+
+			const uint32_t prev = m_block[_idx].m_prevPhys;
+			if (invalidIndex != prev
+			&&  Free == m_block[prev].m_state)
 			{
+				removeFree(prev);
+				merge(prev, _idx);
+				_idx = prev;
 			}
 
-			bool operator<(const Free& rhs) const
+			const uint32_t next = m_block[_idx].m_nextPhys;
+			if (invalidIndex != next
+			&&  Free == m_block[next].m_state)
 			{
-				return m_ptr < rhs.m_ptr;
+				removeFree(next);
+				merge(_idx, next);
 			}
 
-			uint64_t m_ptr;
-			uint32_t m_size;
-		};
+			insertFree(_idx);
+		}
+
+		void merge(uint32_t _idx, uint32_t _next)
+		{
+			Block& block = m_block[_idx];
+			Block& next  = m_block[_next];
+			block.m_size    += next.m_size;
+			block.m_nextPhys = next.m_nextPhys;
+
+			if (invalidIndex != next.m_nextPhys)
+			{
+				m_block[next.m_nextPhys].m_prevPhys = _idx;
+			}
+
+			next.m_state = Unused;
+			m_freeNode.push_back(_next);
+		}
+
+		uint32_t allocNode()
+		{
+			if (!m_freeNode.empty() )
+			{
+				const uint32_t idx = m_freeNode.back();
+				m_freeNode.pop_back();
+				return idx;
+			}
+
+			Block block;
+			block.m_state = Unused;
+			m_block.push_back(block);
+			return uint32_t(m_block.size() - 1);
+		}
+
+		typedef stl::vector<Block> BlockArray;
+		BlockArray m_block;
+
+		typedef stl::vector<uint32_t> IndexArray;
+		IndexArray m_freeNode;
+		IndexArray m_pending;
 
-		typedef std::list<Free> FreeList;
-		FreeList m_free;
+		typedef stl::vector<uint64_t> PoolArray;
+		PoolArray m_pool;
 
 		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
 		UsedList m_used;
+
+		uint32_t m_flBitmap;
+		uint32_t m_slBitmap[FlCount];
+		uint32_t m_head[FlCount][SlCount];
+
+		uint64_t m_totalSize;
+		uint64_t m_usedSize;
+		uint32_t m_numFree;
 	};
 
 	struct BX_NO_VTABLE RendererContextI
@@ -2157,7 +2833,9 @@ namespace bgfx
 		virtual void updateTexture(TextureHandle _handle, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem) = 0;
 		virtual void updateTextureEnd() = 0;
 		virtual void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) = 0;
+		virtual uint32_t getReadBackLatency() const = 0;
 		virtual void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips) = 0;
+		virtual void setTextureMinLod(TextureHandle _handle, uint8_t _lod) = 0;
 		virtual void overrideInternal(TextureHandle _handle, uintptr_t _ptr) = 0;
 		virtual uintptr_t getInternal(TextureHandle _handle) = 0;
 		virtual void destroyTexture(TextureHandle _handle) = 0;
@@ -2175,63 +2853,536 @@ namespace bgfx
 		virtual void blitRender(TextVideoMemBlitter& _blitter, uint32_t _numIndices) = 0;
 	};
 
-	inline RendererContextI::~RendererContextI()
-	{
-	}
+	inline RendererContextI::~RendererContextI()
+	{
+	}
+
+	// Copy of last value of each uniform applied by renderer. Only the first
+	// m_valid bytes of each copy are known to match renderer's value.
+	struct UniformCache
+	{
+		UniformCache()
+		{
+			bx::memSet(m_data,  0, sizeof(m_data) );
+			bx::memSet(m_size,  0, sizeof(m_size) );
+			bx::memSet(m_valid, 0, sizeof(m_valid) );
+		}
+
+		void create(uint16_t _loc, uint32_t _size)
+		{
+			destroy(_loc);
+			m_data[_loc] = (uint8_t*)BX_ALLOC(g_allocator, _size);
+			m_size[_loc] = _size;
+		}
+
+		void destroy(uint16_t _loc)
+		{
+			if (NULL != m_data[_loc])
+			{
+				BX_FREE(g_allocator, m_data[_loc]);
+				m_data[_loc] = NULL;
+			}
+
+			m_size[_loc]  = 0;
+			m_valid[_loc] = 0;
+		}
+
+		void invalidate()
+		{
+			bx::memSet(m_valid, 0, sizeof(m_valid) );
+		}
+
+		bool update(uint16_t _loc, const void* _value, uint32_t _size)
+		{
+			if (_size > m_size[_loc])
+			{
+				m_valid[_loc] = 0;
+				return true;
+			}
+
+			if (_size <= m_valid[_loc]
+			&&  0 == bx::memCmp(m_data[_loc], _value, _size) )
+			{
+				return false;
+			}
+
+			bx::memCopy(m_data[_loc], _value, _size);
+			m_valid[_loc] = bx::uint32_max(m_valid[_loc], _size);
+			return true;
+		}
+
+		uint8_t* m_data[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_size[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_valid[BGFX_CONFIG_MAX_UNIFORMS];
+	};
+
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+	bool rendererUpdateViewUniforms(RendererContextI* _renderCtx, Frame* _render, uint16_t _view);
+	void rendererInvalidateUniforms();
+
+#define BGFX_SORT_RADIX_BITS 11
+#define BGFX_SORT_RADIX_SIZE (1<<BGFX_SORT_RADIX_BITS)
+#define BGFX_SORT_RADIX_MASK (BGFX_SORT_RADIX_SIZE-1)
+
+	// LSD radix sort of frame sort keys. Each pass builds per thread
+	// histograms of thread's block of keys, and then every thread scatters
+	// its own block into destination. Passes where all keys have the same
+	// digit are skipped.
+	struct SortKeyRadixSort
+	{
+		SortKeyRadixSort()
+			: m_tempKeys(NULL)
+			, m_tempValues(NULL)
+			, m_maxTemp(0)
+			, m_numThreads(0)
+			, m_numActive(1)
+		{
+		}
+
+		void init(uint32_t _numThreads);
+		void shutdown();
+		void sort(uint64_t* _keys, RenderItemCount* _values, uint32_t _num, const bool* _sequential);
+
+	private:
+		enum Phase
+		{
+			Histogram,
+			Scatter,
+			Exit,
+		};
+
+		void sort(uint64_t* _keys, RenderItemCount* _values, uint64_t* _tempKeys, RenderItemCount* _tempValues, uint32_t _num, uint32_t _beginBit, uint32_t _endBit);
+		void run(Phase _phase);
+		void execute(uint32_t _idx);
+
+		uint64_t*        m_src;
+		uint64_t*        m_dst;
+		RenderItemCount* m_srcValues;
+		RenderItemCount* m_dstValues;
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t         m_maxTemp;
+		uint32_t         m_num;
+		uint32_t         m_shift;
+		uint32_t         m_numThreads;
+		uint32_t         m_numActive;
+		Phase            m_phase;
+
+		uint32_t m_histogram[BGFX_CONFIG_SORT_NUM_THREADS+1][BGFX_SORT_RADIX_SIZE];
+
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+		static int32_t threadFunc(void* _userData);
+
+		struct Worker
+		{
+			SortKeyRadixSort* m_sort;
+			uint32_t          m_idx;
+			bx::Semaphore     m_sem;
+			bx::Thread        m_thread;
+		};
+
+		Worker        m_worker[BGFX_CONFIG_SORT_NUM_THREADS];
+		bx::Semaphore m_doneSem;
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_SORT_NUM_THREADS > 0
+	};
+
+	// Decodes textures in formats that renderer would have to emulate, on
+	// worker threads, before CreateTexture command reaches render thread.
+	// All jobs issued during frame are finished before frame is submitted.
+	struct TexturePrepare
+	{
+		TexturePrepare()
+			: m_num(0)
+			, m_next(0)
+			, m_numThreads(0)
+			, m_exit(false)
+		{
+		}
+
+		void init(uint32_t _numThreads);
+		void shutdown();
+		void add(const Memory* _src, const Memory* _data, uint8_t _startLod);
+		void wait();
+
+		static bool isNeeded(const ImageContainer& _imageContainer, uint32_t _flags);
+		static uint32_t getSize(const ImageContainer& _imageContainer, uint8_t _startLod);
+		static const Memory* convertUpdate(TextureFormat::Enum _format, uint16_t _width, uint16_t _height, uint16_t _pitch, const Memory* _mem);
+
+	private:
+		struct Job
+		{
+			const Memory* m_src;
+			const Memory* m_data;
+			uint8_t m_startLod;
+		};
+
+		static void execute(const Job& _job);
+
+		Job m_job[BGFX_CONFIG_MAX_TEXTURE_PREPARE_JOBS];
+		uint32_t m_num;
+		volatile uint32_t m_next;
+		uint32_t m_numThreads;
+		volatile bool m_exit;
+
+#if BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+		static int32_t threadFunc(void* _userData);
+
+		bx::Thread    m_thread[BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS];
+		bx::Semaphore m_sem;
+		bx::Semaphore m_doneSem;
+#endif // BGFX_CONFIG_MULTITHREADED && BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS > 0
+	};
+
+	struct TextureStreaming
+	{
+		struct Entry
+		{
+			const Memory* m_mem;
+			uint32_t m_size;
+			uint32_t m_frame;
+			uint16_t m_handle;
+			uint8_t  m_numMips;
+			uint8_t  m_topLod;
+			uint8_t  m_residentLod;
+			uint8_t  m_requestedLod;
+			uint8_t  m_uploadedLod;
+		};
+
+		TextureStreaming()
+			: m_num(0)
+			, m_next(0)
+			, m_memory(0)
+			, m_uploaded(0)
+			, m_frameUploaded(0)
+			, m_uploadBudget(BGFX_CONFIG_TEXTURE_STREAMING_UPLOAD_BUDGET)
+			, m_memoryCap(BGFX_CONFIG_TEXTURE_STREAMING_MEMORY_CAP)
+		{
+			bx::memSet(m_index, 0xff, sizeof(m_index) );
+		}
+
+		void shutdown();
+		Entry* add(TextureHandle _handle, const Memory* _mem, uint8_t _numMips, uint8_t _topLod, uint8_t _lod);
+		void remove(TextureHandle _handle);
+		uint16_t getNumPending() const;
+
+		static uint32_t getMipSize(const Entry& _entry, uint8_t _lod);
+		static uint32_t getResidentSize(const Entry& _entry, uint8_t _lod);
+
+		Entry* find(TextureHandle _handle)
+		{
+			const uint16_t idx = m_index[_handle.idx];
+			return UINT16_MAX == idx ? NULL : &m_entry[idx];
+		}
+
+		bool isFull() const
+		{
+			return BGFX_CONFIG_MAX_STREAMING_TEXTURES == m_num;
+		}
+
+		Entry    m_entry[BGFX_CONFIG_MAX_STREAMING_TEXTURES];
+		uint16_t m_index[BGFX_CONFIG_MAX_TEXTURES];
+		uint32_t m_num;
+		uint32_t m_next;
+		uint64_t m_memory;
+		uint32_t m_uploaded;
+		uint32_t m_frameUploaded;
+		uint32_t m_uploadBudget;
+		uint64_t m_memoryCap;
+	};
+
+#if BGFX_CONFIG_DEBUG
+#	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
+#else
+#	define BGFX_API_FUNC(_func) _func
+#endif // BGFX_CONFIG_DEBUG
+
+	struct Context
+	{
+		Context()
+			: m_render(&m_frame[0])
+			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
+			, m_encoder0(NULL)
+			, m_numFreeDynamicIndexBufferHandles(0)
+			, m_numFreeDynamicVertexBufferHandles(0)
+			, m_numFreeOcclusionQueryHandles(0)
+			, m_colorPaletteDirty(0)
+			, m_numDeferredRetired(0)
+			, m_numResourceCommands(0)
+			, m_numDeferredHandles(0)
+			, m_numDeferredDraws(0)
+			, m_instBufferCount(0)
+			, m_frames(0)
+			, m_debug(BGFX_DEBUG_NONE)
+			, m_renderCtx(NULL)
+			, m_rendererInitialized(false)
+			, m_exit(false)
+			, m_flipAfterRender(false)
+			, m_singleThreaded(false)
+		{
+		}
+
+		~Context()
+		{
+		}
+
+		static int32_t renderThread(void* /*_userData*/)
+		{
+			BX_TRACE("render thread start");
+			BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Render Thread");
+			while (RenderFrame::Exiting != bgfx::renderFrame() ) {};
+			BX_TRACE("render thread exit");
+			return EXIT_SUCCESS;
+		}
+
+		// game thread
+		bool init(RendererType::Enum _type);
+		void shutdown();
+
+		static bool isResourceCommand(CommandBuffer::Enum _cmd)
+		{
+			return (CommandBuffer::CreateVertexDecl  <= _cmd && CommandBuffer::CreateUniform  >= _cmd)
+				|| (CommandBuffer::DestroyVertexDecl <= _cmd && CommandBuffer::DestroyUniform >= _cmd)
+				;
+		}
+
+		static bool isCreateCommand(CommandBuffer::Enum _cmd)
+		{
+			switch (_cmd)
+			{
+			case CommandBuffer::CreateVertexDecl:
+			case CommandBuffer::CreateIndexBuffer:
+			case CommandBuffer::CreateVertexBuffer:
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+			case CommandBuffer::CreateShader:
+			case CommandBuffer::CreateProgram:
+			case CommandBuffer::CreateTexture:
+			case CommandBuffer::CreateFrameBuffer:
+			case CommandBuffer::CreateUniform:
+				return true;
+
+			default:
+				break;
+			}
+
+			return false;
+		}
+
+		static bool isUpdateCommand(CommandBuffer::Enum _cmd)
+		{
+			return CommandBuffer::UpdateDynamicIndexBuffer  == _cmd
+				|| CommandBuffer::UpdateDynamicVertexBuffer == _cmd
+				|| CommandBuffer::UpdateTexture             == _cmd
+				|| CommandBuffer::ResizeTexture             == _cmd
+				|| CommandBuffer::SetTextureMinLod          == _cmd
+				;
+		}
+
+		static bool isDeferrableCommand(CommandBuffer::Enum _cmd)
+		{
+			return isResourceCommand(_cmd)
+				|| CommandBuffer::UpdateViewName == _cmd
+				|| CommandBuffer::ReadTexture    == _cmd
+				|| CommandBuffer::SaveScreenShot == _cmd
+				;
+		}
+
+		uint8_t* getDeferredHandles(uint8_t _cmd)
+		{
+			switch (_cmd)
+			{
+			case CommandBuffer::CreateIndexBuffer:
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::UpdateDynamicIndexBuffer:  return m_deferredIndexBuffer;
+			case CommandBuffer::CreateVertexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+			case CommandBuffer::UpdateDynamicVertexBuffer: return m_deferredVertexBuffer;
+			case CommandBuffer::CreateProgram:             return m_deferredProgram;
+			case CommandBuffer::CreateTexture:
+			case CommandBuffer::UpdateTexture:
+			case CommandBuffer::ResizeTexture:
+			case CommandBuffer::SetTextureMinLod:          return m_deferredTexture;
+			case CommandBuffer::CreateFrameBuffer:         return m_deferredFrameBuffer;
+			case CommandBuffer::CreateUniform:             return m_deferredUniform;
+			default:
+				break;
+			}
+
+			return NULL;
+		}
+
+		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd, uint16_t _handle = invalidHandle)
+		{
+			uint8_t cmd = (uint8_t)_cmd;
+
+			if (0 != BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME
+			&&  isDeferrableCommand(_cmd) )
+			{
+				const bool create = isCreateCommand(_cmd);
+
+				// Once the backlog is not empty every resource command, and
+				// every command referencing resources, goes through it, so
+				// the renderer sees them in submission order. Updates depend
+				// only on creation of their own resource, they are deferred
+				// only while it's still in the backlog, and keep it pending
+				// until they are retired.
+				uint8_t* deferred = getDeferredHandles(cmd);
+				const bool defer = isUpdateCommand(_cmd)
+					? invalidHandle != _handle && 0 != deferred[_handle]
+					: m_numDeferredRetired != m_deferredCmd.size()
+					|| (create && BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME <= m_numResourceCommands)
+					;
+
+				if (defer)
+				{
+					if (NULL != deferred
+					&&  invalidHandle != _handle)
+					{
+						BX_CHECK(UINT8_MAX != deferred[_handle], "Too many deferred commands for handle %d.", _handle);
+						++deferred[_handle];
+						++m_numDeferredHandles;
+					}
+					else
+					{
+						_handle = invalidHandle;
+					}
+
+					m_cmdDeferred.align(CommandBuffer::CommandAlignment);
+					DeferredCommand dc = { m_cmdDeferred.m_pos, _handle, cmd, create };
+					m_deferredCmd.push_back(dc);
+					m_cmdDeferred.writeCommand(cmd);
+					return m_cmdDeferred;
+				}
+
+				m_numResourceCommands += create;
+			}
+
+			CommandBuffer& cmdbuf = _cmd < CommandBuffer::End ? m_submit->m_cmdPre : m_submit->m_cmdPost;
+			cmdbuf.writeCommand(cmd);
+			return cmdbuf;
+		}
+
+		/// Number of frames until command written to deferred backlog is
+		/// retired, 0 if backlog is empty.
+		uint32_t getDeferredLatency() const
+		{
+			if (0 == BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME
+			||  m_numDeferredRetired == m_deferredCmd.size() )
+			{
+				return 0;
+			}
+
+			// Mirrors retireDeferredCommands, a frame retires at most budget
+			// create commands, and nothing after the first pre command that
+			// follows a post command.
+			const uint32_t budget = BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME;
+			uint32_t latency = 1;
+			uint32_t count   = 0;
+			bool post = false;
+			for (uint32_t ii = m_numDeferredRetired, num = uint32_t(m_deferredCmd.size() ); ii < num; ++ii)
+			{
+				const DeferredCommand& dc = m_deferredCmd[ii];
+				const bool isPost = CommandBuffer::End < dc.m_cmd;
+				if ( (dc.m_create && budget == count)
+				||   (post && !isPost) )
+				{
+					++latency;
+					count = 0;
+					post  = false;
+				}
+
+				count += dc.m_create;
+				post  |= isPost;
+			}
+
+			return latency;
+		}
+
+		bool isDeferred(const RenderDraw& _draw, ProgramHandle _program, uint8_t _id) const
+		{
+			if (isValid(_program)
+			&&  0 != m_deferredProgram[_program.idx])
+			{
+				return true;
+			}
+
+			if (isValid(m_fb[_id])
+			&&  0 != m_deferredFrameBuffer[m_fb[_id].idx])
+			{
+				return true;
+			}
+
+			if (isValid(_draw.m_indexBuffer)
+			&&  0 != m_deferredIndexBuffer[_draw.m_indexBuffer.idx])
+			{
+				return true;
+			}
+
+			if (isValid(_draw.m_instanceDataBuffer)
+			&&  0 != m_deferredVertexBuffer[_draw.m_instanceDataBuffer.idx])
+			{
+				return true;
+			}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++ii)
+			{
+				if (0 != (_draw.m_streamMask & (1<<ii) )
+				&&  0 != m_deferredVertexBuffer[_draw.m_stream[ii].m_handle.idx])
+				{
+					return true;
+				}
+			}
 
-#if BGFX_CONFIG_DEBUG
-#	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
-#else
-#	define BGFX_API_FUNC(_func) _func
-#endif // BGFX_CONFIG_DEBUG
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+			{
+				const uint16_t idx = _draw.m_bind[ii].m_idx;
+				if (invalidHandle != idx
+				&&  0 != m_deferredTexture[idx])
+				{
+					return true;
+				}
+			}
 
-	struct Context
-	{
-		Context()
-			: m_render(&m_frame[0])
-			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
-			, m_numFreeDynamicIndexBufferHandles(0)
-			, m_numFreeDynamicVertexBufferHandles(0)
-			, m_numFreeOcclusionQueryHandles(0)
-			, m_colorPaletteDirty(0)
-			, m_instBufferCount(0)
-			, m_frames(0)
-			, m_debug(BGFX_DEBUG_NONE)
-			, m_renderCtx(NULL)
-			, m_rendererInitialized(false)
-			, m_exit(false)
-			, m_flipAfterRender(false)
-			, m_singleThreaded(false)
-		{
+			return false;
 		}
 
-		~Context()
+		bool isDeferred(const RenderCompute& _compute, ProgramHandle _program) const
 		{
-		}
+			if (0 != m_deferredProgram[_program.idx])
+			{
+				return true;
+			}
 
-		static int32_t renderThread(void* /*_userData*/)
-		{
-			BX_TRACE("render thread start");
-			BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Render Thread");
-			while (RenderFrame::Exiting != bgfx::renderFrame() ) {};
-			BX_TRACE("render thread exit");
-			return EXIT_SUCCESS;
-		}
+			for (uint32_t ii = 0; ii < BGFX_MAX_COMPUTE_BINDINGS; ++ii)
+			{
+				const Binding& bind = _compute.m_bind[ii];
+				if (invalidHandle == bind.m_idx)
+				{
+					continue;
+				}
 
-		// game thread
-		bool init(RendererType::Enum _type);
-		void shutdown();
+				const uint8_t* deferred = NULL;
+				switch (bind.m_type)
+				{
+				case Binding::Image:
+				case Binding::Texture:      deferred = m_deferredTexture;      break;
+				case Binding::IndexBuffer:  deferred = m_deferredIndexBuffer;  break;
+				case Binding::VertexBuffer: deferred = m_deferredVertexBuffer; break;
+				default:                                                       break;
+				}
 
-		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
-		{
-			CommandBuffer& cmdbuf = _cmd < CommandBuffer::End ? m_submit->m_cmdPre : m_submit->m_cmdPost;
-			uint8_t cmd = (uint8_t)_cmd;
-			cmdbuf.write(cmd);
-			return cmdbuf;
+				if (NULL != deferred
+				&&  0 != deferred[bind.m_idx])
+				{
+					return true;
+				}
+			}
+
+			return false;
 		}
 
+		void retireDeferredCommands(uint32_t _budget);
+
 		BGFX_API_FUNC(void reset(uint32_t _width, uint32_t _height, uint32_t _flags) )
 		{
 			BX_WARN(g_caps.limits.maxTextureSize >= _width
@@ -2310,6 +3461,24 @@ namespace bgfx
 			const TextVideoMem* tvm = m_submit->m_textVideoMem;
 			stats.textWidth  = tvm->m_width;
 			stats.textHeight = tvm->m_height;
+			stats.textureStreamingMemory = m_textureStreaming.m_memory;
+			stats.textureStreamingUpload = m_textureStreaming.m_frameUploaded;
+			stats.numStreamingTextures   = uint16_t(m_textureStreaming.m_num);
+			stats.numStreamingPending    = m_textureStreaming.getNumPending();
+
+			NonLocalAllocator::Stats allocatorStats;
+			m_dynIndexBufferAllocator.getStats(allocatorStats);
+			stats.dynamicIndexBufferSize        = allocatorStats.totalSize;
+			stats.dynamicIndexBufferUsed        = allocatorStats.usedSize;
+			stats.dynamicIndexBufferLargestFree = allocatorStats.largestFree;
+
+			m_dynVertexBufferAllocator.getStats(allocatorStats);
+			stats.dynamicVertexBufferSize        = allocatorStats.totalSize;
+			stats.dynamicVertexBufferUsed        = allocatorStats.usedSize;
+			stats.dynamicVertexBufferLargestFree = allocatorStats.largestFree;
+
+			stats.numDeferredCommands = uint32_t(m_deferredCmd.size() ) - m_numDeferredRetired;
+			stats.numDeferredDraws    = m_numDeferredDraws;
 			return &stats;
 		}
 
@@ -2320,7 +3489,7 @@ namespace bgfx
 			BX_WARN(isValid(handle), "Failed to allocate index buffer handle.");
 			if (isValid(handle) )
 			{
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffer, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(_mem);
 				cmdbuf.write(_flags);
@@ -2367,7 +3536,7 @@ namespace bgfx
 
 				m_vertexBuffers[handle.idx].m_stride = _decl.m_stride;
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexBuffer, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(_mem);
 				cmdbuf.write(declHandle);
@@ -2414,7 +3583,7 @@ namespace bgfx
 
 				uint32_t allocSize = bx::uint32_max(BGFX_CONFIG_DYNAMIC_INDEX_BUFFER_SIZE, _size);
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer, indexBufferHandle.idx);
 				cmdbuf.write(indexBufferHandle);
 				cmdbuf.write(allocSize);
 				cmdbuf.write(_flags);
@@ -2441,7 +3610,7 @@ namespace bgfx
 					return handle;
 				}
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer, indexBufferHandle.idx);
 				cmdbuf.write(indexBufferHandle);
 				cmdbuf.write(size);
 				cmdbuf.write(_flags);
@@ -2516,7 +3685,7 @@ namespace bgfx
 				, size
 				, _mem->size
 				);
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicIndexBuffer);
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicIndexBuffer, dib.m_handle.idx);
 			cmdbuf.write(dib.m_handle);
 			cmdbuf.write(offset);
 			cmdbuf.write(size);
@@ -2569,7 +3738,7 @@ namespace bgfx
 
 				uint32_t allocSize = bx::uint32_max(BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE, _size);
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer, vertexBufferHandle.idx);
 				cmdbuf.write(vertexBufferHandle);
 				cmdbuf.write(allocSize);
 				cmdbuf.write(_flags);
@@ -2595,7 +3764,7 @@ namespace bgfx
 					return handle;
 				}
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer, vertexBufferHandle.idx);
 				cmdbuf.write(vertexBufferHandle);
 				cmdbuf.write(size);
 				cmdbuf.write(_flags);
@@ -2670,7 +3839,7 @@ namespace bgfx
 				, _mem->size
 				);
 
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer);
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer, dvb.m_handle.idx);
 			cmdbuf.write(dvb.m_handle);
 			cmdbuf.write(offset);
 			cmdbuf.write(size);
@@ -2734,7 +3903,7 @@ namespace bgfx
 			BX_WARN(isValid(handle), "Failed to allocate transient index buffer handle.");
 			if (isValid(handle) )
 			{
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(_size);
 				uint16_t flags = BGFX_BUFFER_NONE;
@@ -2791,7 +3960,7 @@ namespace bgfx
 					stride = _decl->m_stride;
 				}
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(_size);
 				uint16_t flags = BGFX_BUFFER_NONE;
@@ -2847,7 +4016,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(const InstanceDataBuffer* allocInstanceDataBuffer(uint32_t _num, uint16_t _stride) )
 		{
-			++m_instBufferCount;
+			bx::atomicInc(&m_instBufferCount);
 
 			uint16_t stride = BX_ALIGN_16(_stride);
 			uint32_t offset = m_submit->allocTransientVertexBuffer(_num, stride);
@@ -2875,7 +4044,7 @@ namespace bgfx
 				uint32_t size  = _num * BGFX_CONFIG_DRAW_INDIRECT_STRIDE;
 				uint16_t flags = BGFX_BUFFER_DRAW_INDIRECT;
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(size);
 				cmdbuf.write(flags);
@@ -3105,7 +4274,7 @@ namespace bgfx
 				bool ok = m_programHashMap.insert(key, handle.idx);
 				BX_CHECK(ok, "Program already exists (key: %x, handle: %3d)!", key, handle.idx); BX_UNUSED(ok);
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(_vsh);
 				cmdbuf.write(_fsh);
@@ -3155,7 +4324,7 @@ namespace bgfx
 				bool ok = m_programHashMap.insert(key, handle.idx);
 				BX_CHECK(ok, "Program already exists (key: %x, handle: %3d)!", key, handle.idx); BX_UNUSED(ok);
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(_vsh);
 				cmdbuf.write(fsh);
@@ -3239,17 +4408,184 @@ namespace bgfx
 				ref.m_format   = uint8_t(_info->format);
 				ref.m_numMips  = imageContainer.m_numMips;
 				ref.m_owned    = false;
+				ref.m_prepared = false;
+
+				const Memory* mem = _mem;
+				uint8_t skip = _skip;
+
+				if (TextureFormat::Unknown != _info->format
+				&&  TexturePrepare::isNeeded(imageContainer, _flags) )
+				{
+					const uint8_t startLod = uint8_t(bx::uint32_min(_skip, imageContainer.m_numMips-1) );
+					const ImageBlockInfo& blockInfo = getBlockInfo(TextureFormat::Enum(imageContainer.m_format) );
+
+					const Memory* data = alloc(TexturePrepare::getSize(imageContainer, startLod) );
+
+					mem = alloc(sizeof(uint32_t)+sizeof(TextureCreate) );
+					bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+					uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+					bx::write(&writer, magic);
+
+					TextureCreate tc;
+					tc.m_width     = uint16_t(bx::uint32_max(blockInfo.blockWidth,  imageContainer.m_width >>startLod) );
+					tc.m_height    = uint16_t(bx::uint32_max(blockInfo.blockHeight, imageContainer.m_height>>startLod) );
+					tc.m_depth     = 0;
+					tc.m_numLayers = imageContainer.m_numLayers;
+					tc.m_numMips   = uint8_t(imageContainer.m_numMips - startLod);
+					tc.m_format    = TextureFormat::BGRA8;
+					tc.m_cubeMap   = imageContainer.m_cubeMap;
+					tc.m_mem       = data;
+					bx::write(&writer, tc);
+
+					_flags |= imageContainer.m_srgb ? BGFX_TEXTURE_SRGB : 0;
+					skip = 0;
+					ref.m_prepared = true;
+
+					m_texturePrepare.add(_mem, data, startLod);
+				}
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture, handle.idx);
 				cmdbuf.write(handle);
-				cmdbuf.write(_mem);
+				cmdbuf.write(mem);
 				cmdbuf.write(_flags);
-				cmdbuf.write(_skip);
+				cmdbuf.write(skip);
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(TextureHandle createStreamingTexture(const Memory* _mem, uint32_t _flags, uint8_t _numResidentMips, TextureInfo* _info) )
+		{
+			ImageContainer imageContainer;
+			if (!imageParse(imageContainer, _mem->data, _mem->size)
+			||  imageContainer.m_cubeMap
+			||  1 < imageContainer.m_depth
+			||  1 < imageContainer.m_numLayers
+			||  1 >= imageContainer.m_numMips
+			||  calcNumMips(true, uint16_t(imageContainer.m_width), uint16_t(imageContainer.m_height) ) != imageContainer.m_numMips
+			||  0 != (_flags & (BGFX_TEXTURE_RT_MASK|BGFX_TEXTURE_COMPUTE_WRITE) )
+			||  getViableTextureFormat(imageContainer) != imageContainer.m_format
+			||  m_textureStreaming.isFull() )
+			{
+				BX_TRACE("Texture can't be streamed, creating regular texture.");
+				return createTexture(_mem, _flags, 0, _info, BackbufferRatio::Count);
+			}
+
+			TextureInfo ti;
+			if (NULL == _info)
+			{
+				_info = &ti;
+			}
+
+			calcTextureSize(*_info
+				, (uint16_t)imageContainer.m_width
+				, (uint16_t)imageContainer.m_height
+				, 1
+				, false
+				, true
+				, 1
+				, TextureFormat::Enum(imageContainer.m_format)
+				);
+
+			TextureHandle handle = { m_textureHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate texture handle.");
+			if (!isValid(handle) )
+			{
+				release(_mem);
+				return handle;
+			}
+
+			const uint8_t numMips     = imageContainer.m_numMips;
+			const uint8_t numResident = uint8_t(bx::uint32_clamp(_numResidentMips, 1, numMips) );
+			const uint8_t lod         = uint8_t(numMips - numResident);
+
+			// When renderer can clamp min LOD, whole mip chain is allocated
+			// once, and only newly resident mips are uploaded. Otherwise
+			// texture is allocated with resident mips only.
+			const bool    minLod      = 0 != (g_caps.supported & BGFX_CAPS_TEXTURE_MIN_LOD);
+			const uint8_t topLod      = minLod ? 0 : lod;
+
+			ImageMip mip;
+			imageGetRawData(imageContainer, 0, topLod, _mem->data, _mem->size, mip);
+
+			TextureRef& ref = m_textureRef[handle.idx];
+			ref.m_refCount = 1;
+			ref.m_bbRatio  = uint8_t(BackbufferRatio::Count);
+			ref.m_format   = uint8_t(_info->format);
+			ref.m_numMips  = uint8_t(numMips - topLod);
+			ref.m_owned    = false;
+			ref.m_prepared = false;
+
+			const Memory* mem = alloc(sizeof(uint32_t)+sizeof(TextureCreate) );
+			bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+			uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+			bx::write(&writer, magic);
+
+			TextureCreate tc;
+			tc.m_width     = uint16_t(mip.m_width);
+			tc.m_height    = uint16_t(mip.m_height);
+			tc.m_depth     = 0;
+			tc.m_numLayers = 1;
+			tc.m_numMips   = uint8_t(numMips - topLod);
+			tc.m_format    = TextureFormat::Enum(imageContainer.m_format);
+			tc.m_cubeMap   = false;
+			tc.m_mem       = NULL;
+			bx::write(&writer, tc);
+
+			_flags |= imageContainer.m_srgb ? BGFX_TEXTURE_SRGB : 0;
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture, handle.idx);
+			cmdbuf.write(handle);
+			cmdbuf.write(mem);
+			cmdbuf.write(_flags);
+			uint8_t skip = 0;
+			cmdbuf.write(skip);
+
+			// Memory is charged for allocated mips, not only resident ones.
+			TextureStreaming::Entry* entry = m_textureStreaming.add(handle, _mem, numMips, topLod, lod);
+			entry->m_frame = m_frames;
+			entry->m_size  = TextureStreaming::getResidentSize(*entry, topLod);
+			m_textureStreaming.m_uploaded += textureStreamingUpload(*entry, lod, numMips, topLod);
+			m_textureStreaming.m_memory   += entry->m_size;
+
+			if (minLod)
+			{
+				textureStreamingSetMinLod(handle, lod);
 			}
 
 			return handle;
 		}
 
+		BGFX_API_FUNC(void requestTextureMips(TextureHandle _handle, uint8_t _numMips) )
+		{
+			BGFX_CHECK_HANDLE("requestTextureMips", m_textureHandle, _handle);
+
+			TextureStreaming::Entry* entry = m_textureStreaming.find(_handle);
+			BX_WARN(NULL != entry, "Texture %d is not streaming texture.", _handle.idx);
+			if (NULL != entry)
+			{
+				const uint8_t numMips = uint8_t(bx::uint32_clamp(_numMips, 1, entry->m_numMips) );
+				entry->m_requestedLod = uint8_t(entry->m_numMips - numMips);
+			}
+		}
+
+		BGFX_API_FUNC(void setTextureStreamingBudget(uint32_t _uploadBytesPerFrame, uint64_t _memoryCap) )
+		{
+			m_textureStreaming.m_uploadBudget = _uploadBytesPerFrame;
+			m_textureStreaming.m_memoryCap    = _memoryCap;
+		}
+
+		uint32_t textureStreamingUpload(TextureStreaming::Entry& _entry, uint8_t _begin, uint8_t _end, uint8_t _topLod);
+		uint32_t textureStreamingSetLod(TextureStreaming::Entry& _entry, uint8_t _lod, bool _resize);
+
+		void textureStreamingSetMinLod(TextureHandle _handle, uint8_t _lod)
+		{
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetTextureMinLod, _handle.idx);
+			cmdbuf.write(_handle);
+			cmdbuf.write(_lod);
+		}
+		void textureStreamingUpdate();
+
 		BGFX_API_FUNC(void destroyTexture(TextureHandle _handle) )
 		{
 			BGFX_CHECK_HANDLE("destroyTexture", m_textureHandle, _handle);
@@ -3274,7 +4610,7 @@ namespace bgfx
 			cmdbuf.write(_handle);
 			cmdbuf.write(_data);
 			cmdbuf.write(_mip);
-			return m_frames + 2;
+			return m_frames + 2 + m_renderCtx->getReadBackLatency() + getDeferredLatency();
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips)
@@ -3292,7 +4628,7 @@ namespace bgfx
 				, bgfx::getName(TextureFormat::Enum(textureRef.m_format) )
 				);
 
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::ResizeTexture);
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::ResizeTexture, _handle.idx);
 			cmdbuf.write(_handle);
 			cmdbuf.write(_width);
 			cmdbuf.write(_height);
@@ -3324,6 +4660,8 @@ namespace bgfx
 				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 				BX_CHECK(ok, "Texture handle %d is already destroyed!", _handle.idx);
 
+				m_textureStreaming.remove(_handle);
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyTexture);
 				cmdbuf.write(_handle);
 			}
@@ -3343,7 +4681,16 @@ namespace bgfx
 			, const Memory* _mem
 		) )
 		{
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
+			const TextureRef& ref = m_textureRef[_handle.idx];
+			if (ref.m_prepared)
+			{
+				// Texture was created as BGRA8, decode update from format
+				// requested by user.
+				_mem   = TexturePrepare::convertUpdate(TextureFormat::Enum(ref.m_format), _width, _height, _pitch, _mem);
+				_pitch = UINT16_MAX;
+			}
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture, _handle.idx);
 			cmdbuf.write(_handle);
 			cmdbuf.write(_side);
 			cmdbuf.write(_mip);
@@ -3395,7 +4742,7 @@ namespace bgfx
 
 			if (isValid(handle) )
 			{
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateFrameBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateFrameBuffer, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(false);
 				cmdbuf.write(_num);
@@ -3436,7 +4783,7 @@ namespace bgfx
 
 			if (isValid(handle) )
 			{
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateFrameBuffer);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateFrameBuffer, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(true);
 				cmdbuf.write(_nwh);
@@ -3519,7 +4866,7 @@ namespace bgfx
 					uniform.m_type = oldsize < newsize ? _type : uniform.m_type;
 					uniform.m_num  = bx::uint16_max(uniform.m_num, _num);
 
-					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateUniform);
+					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateUniform, handle.idx);
 					cmdbuf.write(handle);
 					cmdbuf.write(uniform.m_type);
 					cmdbuf.write(uniform.m_num);
@@ -3547,7 +4894,7 @@ namespace bgfx
 				bool ok = m_uniformHashMap.insert(bx::hashMurmur2A(_name), handle.idx);
 				BX_CHECK(ok, "Uniform already exists (name: %s)!", _name); BX_UNUSED(ok);
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateUniform);
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateUniform, handle.idx);
 				cmdbuf.write(handle);
 				cmdbuf.write(_type);
 				cmdbuf.write(_num);
@@ -3721,6 +5068,15 @@ namespace bgfx
 			m_fb[_id] = _handle;
 		}
 
+		BGFX_API_FUNC(void setViewUniform(uint16_t _scope, UniformHandle _handle, const void* _value, uint16_t _num) )
+		{
+			BGFX_CHECK_HANDLE("setViewUniform", m_uniformHandle, _handle);
+			const UniformRef& uniform = m_uniformRef[_handle.idx];
+			BX_CHECK(isValid(_handle) && 0 < uniform.m_refCount, "Setting invalid uniform (handle %3d)!", _handle.idx);
+			BX_CHECK(_num == UINT16_MAX || uniform.m_num >= _num, "Truncated uniform update. %d (max: %d)", _num, uniform.m_num);
+			m_submit->writeViewUniform(_scope, uniform.m_type, _handle, _value, bx::uint16_min(uniform.m_num, _num) );
+		}
+
 		BGFX_API_FUNC(void setViewTransform(uint8_t _id, const void* _view, const void* _proj, uint8_t _flags, const void* _proj1) )
 		{
 			m_viewFlags[_id] = _flags;
@@ -3781,241 +5137,33 @@ namespace bgfx
 			}
 		}
 
-		BGFX_API_FUNC(void setMarker(const char* _marker) )
-		{
-			m_submit->setMarker(_marker);
-		}
-
-		BGFX_API_FUNC(void setState(uint64_t _state, uint32_t _rgba) )
-		{
-			m_submit->setState(_state, _rgba);
-		}
-
-		BGFX_API_FUNC(void setCondition(OcclusionQueryHandle _handle, bool _visible) )
-		{
-			m_submit->setCondition(_handle, _visible);
-		}
-
-		BGFX_API_FUNC(void setStencil(uint32_t _fstencil, uint32_t _bstencil) )
-		{
-			m_submit->setStencil(_fstencil, _bstencil);
-		}
-
-		BGFX_API_FUNC(uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height) )
-		{
-			return m_submit->setScissor(_x, _y, _width, _height);
-		}
-
-		BGFX_API_FUNC(void setScissor(uint16_t _cache) )
-		{
-			m_submit->setScissor(_cache);
-		}
-
-		BGFX_API_FUNC(uint32_t setTransform(const void* _mtx, uint16_t _num) )
-		{
-			return m_submit->setTransform(_mtx, _num);
-		}
-
-		BGFX_API_FUNC(uint32_t allocTransform(Transform* _transform, uint16_t _num) )
-		{
-			return m_submit->allocTransform(_transform, _num);
-		}
-
-		BGFX_API_FUNC(void setTransform(uint32_t _cache, uint16_t _num) )
-		{
-			m_submit->setTransform(_cache, _num);
-		}
-
-		BGFX_API_FUNC(void setUniform(UniformHandle _handle, const void* _value, uint16_t _num) )
-		{
-			BGFX_CHECK_HANDLE("setUniform", m_uniformHandle, _handle);
-			UniformRef& uniform = m_uniformRef[_handle.idx];
-			BX_CHECK(isValid(_handle) && 0 < uniform.m_refCount, "Setting invalid uniform (handle %3d)!", _handle.idx);
-			BX_CHECK(_num == UINT16_MAX || uniform.m_num >= _num, "Truncated uniform update. %d (max: %d)", _num, uniform.m_num);
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
-			{
-				BX_CHECK(m_uniformSet.end() == m_uniformSet.find(_handle.idx)
-					, "Uniform %d (%s) was already set for this draw call."
-					, _handle.idx
-					, getName(_handle)
-					);
-				m_uniformSet.insert(_handle.idx);
-			}
-			m_submit->writeUniform(uniform.m_type, _handle, _value, bx::uint16_min(uniform.m_num, _num) );
-		}
-
-		BGFX_API_FUNC(void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices) )
-		{
-			BGFX_CHECK_HANDLE("setIndexBuffer", m_indexBufferHandle, _handle);
-			m_submit->setIndexBuffer(_handle, _firstIndex, _numIndices);
-		}
-
-		BGFX_API_FUNC(void setIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices) )
-		{
-			BGFX_CHECK_HANDLE("setIndexBuffer", m_dynamicIndexBufferHandle, _handle);
-			m_submit->setIndexBuffer(m_dynamicIndexBuffers[_handle.idx], _firstIndex, _numIndices);
-		}
-
-		BGFX_API_FUNC(void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices) )
-		{
-			BGFX_CHECK_HANDLE("setIndexBuffer", m_indexBufferHandle, _tib->handle);
-			m_submit->setIndexBuffer(_tib, _firstIndex, _numIndices);
-		}
-
-		BGFX_API_FUNC(void setVertexBuffer(uint8_t _stream, VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices) )
-		{
-			BGFX_CHECK_HANDLE("setVertexBuffer", m_vertexBufferHandle, _handle);
-			BX_CHECK(_stream < BGFX_CONFIG_MAX_VERTEX_STREAMS, "Invalid stream %d (max %d).", _stream, BGFX_CONFIG_MAX_VERTEX_STREAMS);
-			m_submit->setVertexBuffer(_stream, _handle, _startVertex, _numVertices);
-		}
-
-		BGFX_API_FUNC(void setVertexBuffer(uint8_t _stream, DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices) )
-		{
-			BGFX_CHECK_HANDLE("setVertexBuffer", m_dynamicVertexBufferHandle, _handle);
-			BX_CHECK(_stream < BGFX_CONFIG_MAX_VERTEX_STREAMS, "Invalid stream %d (max %d).", _stream, BGFX_CONFIG_MAX_VERTEX_STREAMS);
-			m_submit->setVertexBuffer(_stream, m_dynamicVertexBuffers[_handle.idx], _startVertex, _numVertices);
-		}
-
-		BGFX_API_FUNC(void setVertexBuffer(uint8_t _stream, const TransientVertexBuffer* _tvb, uint32_t _startVertex, uint32_t _numVertices) )
-		{
-			BGFX_CHECK_HANDLE("setVertexBuffer", m_vertexBufferHandle, _tvb->handle);
-			BX_CHECK(_stream < BGFX_CONFIG_MAX_VERTEX_STREAMS, "Invalid stream %d (max %d).", _stream, BGFX_CONFIG_MAX_VERTEX_STREAMS);
-			m_submit->setVertexBuffer(_stream, _tvb, _startVertex, _numVertices);
-		}
-
-		BGFX_API_FUNC(void setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _num) )
-		{
-			--m_instBufferCount;
-
-			m_submit->setInstanceDataBuffer(_idb, _num);
-		}
-
-		BGFX_API_FUNC(void setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num) )
-		{
-			BGFX_CHECK_HANDLE("setInstanceDataBuffer", m_vertexBufferHandle, _handle);
-			const VertexBuffer& vb = m_vertexBuffers[_handle.idx];
-			m_submit->setInstanceDataBuffer(_handle, _startVertex, _num, vb.m_stride);
-		}
-
-		BGFX_API_FUNC(void setInstanceDataBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num) )
+		BGFX_API_FUNC(Encoder* begin() )
 		{
-			BGFX_CHECK_HANDLE("setInstanceDataBuffer", m_dynamicVertexBufferHandle, _handle);
-			const DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
-			m_submit->setInstanceDataBuffer(dvb.m_handle
-				, dvb.m_startVertex + _startVertex
-				, _num
-				, dvb.m_stride
-				);
-		}
-
-		BGFX_API_FUNC(void setTexture(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint32_t _flags) )
-		{
-			BGFX_CHECK_HANDLE_INVALID_OK("setTexture/TextureHandle", m_textureHandle, _handle);
-			m_submit->setTexture(_stage, _sampler, _handle, _flags);
-		}
-
-		BGFX_API_FUNC(uint32_t submit(uint8_t _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, int32_t _depth, bool _preserveState) )
-		{
-			BGFX_CHECK_HANDLE_INVALID_OK("submit", m_programHandle, _program);
-			BGFX_CHECK_HANDLE_INVALID_OK("submit", m_occlusionQueryHandle, _occlusionQuery);
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
-			&& !_preserveState)
-			{
-				m_uniformSet.clear();
-			}
-
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_OCCLUSION)
-			&&  isValid(_occlusionQuery) )
-			{
-				BX_CHECK(m_occlusionQuerySet.end() == m_occlusionQuerySet.find(_occlusionQuery.idx)
-					, "OcclusionQuery %d was already used for this frame."
-					, _occlusionQuery.idx
-					);
-				m_occlusionQuerySet.insert(_occlusionQuery.idx);
-			}
-
-			return m_submit->submit(_id, _program, _occlusionQuery, _depth, _preserveState);
-		}
+			Encoder* encoder = NULL;
 
-		BGFX_API_FUNC(uint32_t submit(uint8_t _id, ProgramHandle _handle, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, int32_t _depth, bool _preserveState) )
-		{
-			BGFX_CHECK_HANDLE_INVALID_OK("submit", m_programHandle, _handle);
-			BGFX_CHECK_HANDLE("submit", m_vertexBufferHandle, _indirectHandle);
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
-			&& !_preserveState)
+			bx::MutexScope scopeLock(m_encoderApiLock);
+			uint16_t idx = m_encoderHandle.alloc();
+			BX_WARN(invalidHandle != idx, "Too many encoders in use (max: %d).", BGFX_CONFIG_MAX_ENCODERS);
+			if (invalidHandle != idx)
 			{
-				m_uniformSet.clear();
+				EncoderImpl& impl = m_encoder[idx];
+				impl.begin(m_submit, uint8_t(idx) );
+				encoder = reinterpret_cast<Encoder*>(&impl);
 			}
-			return m_submit->submit(_id, _handle, _indirectHandle, _start, _num, _depth, _preserveState);
-		}
-
-		BGFX_API_FUNC(void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access) )
-		{
-			BGFX_CHECK_HANDLE("setBuffer", m_indexBufferHandle, _handle);
-			m_submit->setBuffer(_stage, _handle, _access);
-		}
-
-		BGFX_API_FUNC(void setBuffer(uint8_t _stage, VertexBufferHandle _handle, Access::Enum _access) )
-		{
-			BGFX_CHECK_HANDLE("setBuffer", m_vertexBufferHandle, _handle);
-			m_submit->setBuffer(_stage, _handle, _access);
-		}
-
-		BGFX_API_FUNC(void setBuffer(uint8_t _stage, DynamicIndexBufferHandle _handle, Access::Enum _access) )
-		{
-			BGFX_CHECK_HANDLE("setBuffer", m_dynamicIndexBufferHandle, _handle);
-			const DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
-			m_submit->setBuffer(_stage, dib.m_handle, _access);
-		}
-
-		BGFX_API_FUNC(void setBuffer(uint8_t _stage, DynamicVertexBufferHandle _handle, Access::Enum _access) )
-		{
-			BGFX_CHECK_HANDLE("setBuffer", m_dynamicVertexBufferHandle, _handle);
-			const DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
-			m_submit->setBuffer(_stage, dvb.m_handle, _access);
-		}
 
-		BGFX_API_FUNC(void setBuffer(uint8_t _stage, IndirectBufferHandle _handle, Access::Enum _access) )
-		{
-			BGFX_CHECK_HANDLE("setBuffer", m_vertexBufferHandle, _handle);
-			VertexBufferHandle handle = { _handle.idx };
-			m_submit->setBuffer(_stage, handle, _access);
-		}
-
-		BGFX_API_FUNC(void setImage(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint8_t _mip, Access::Enum _access, TextureFormat::Enum _format) )
-		{
-			_format = TextureFormat::Count == _format ? TextureFormat::Enum(m_textureRef[_handle.idx].m_format) : _format;
-			BX_CHECK(_format != TextureFormat::BGRA8
-					, "Can't use TextureFormat::BGRA8 with compute, use TextureFormat::RGBA8 instead."
-					);
-			m_submit->setImage(_stage, _sampler, _handle, _mip, _access, _format);
-		}
-
-		BGFX_API_FUNC(uint32_t dispatch(uint8_t _id, ProgramHandle _handle, uint16_t _numX, uint16_t _numY, uint16_t _numZ, uint8_t _flags) )
-		{
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
-			{
-				m_uniformSet.clear();
-			}
-			return m_submit->dispatch(_id, _handle, _numX, _numY, _numZ, _flags);
+			return encoder;
 		}
 
-		BGFX_API_FUNC(uint32_t dispatch(uint8_t _id, ProgramHandle _handle, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint8_t _flags) )
+		BGFX_API_FUNC(void end(Encoder* _encoder) )
 		{
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
-			{
-				m_uniformSet.clear();
-			}
-			return m_submit->dispatch(_id, _handle, _indirectHandle, _start, _num, _flags);
-		}
+			EncoderImpl* impl = reinterpret_cast<EncoderImpl*>(_encoder);
+			const uint16_t idx = uint16_t(impl - m_encoder);
+			BX_CHECK(idx < BGFX_CONFIG_MAX_ENCODERS, "Invalid encoder.");
+			BX_CHECK(0 != idx, "Encoder 0 is owned by API thread and can't be ended.");
+			impl->end();
 
-		BGFX_API_FUNC(void discard() )
-		{
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
-			{
-				m_uniformSet.clear();
-			}
-			m_submit->discard();
+			bx::MutexScope scopeLock(m_encoderApiLock);
+			m_encoderHandle.free(idx);
 		}
 
 		BGFX_API_FUNC(void blit(uint8_t _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth) )
@@ -4122,8 +5270,40 @@ namespace bgfx
 		Frame* m_render;
 		Frame* m_submit;
 
-		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		EncoderImpl m_encoder[BGFX_CONFIG_MAX_ENCODERS];
+		Encoder*    m_encoder0;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_ENCODERS> m_encoderHandle;
+		bx::Mutex   m_encoderApiLock;
+
+		struct DeferredCommand
+		{
+			uint32_t m_offset;
+			uint16_t m_handle;
+			uint8_t  m_cmd;
+			bool     m_create;
+		};
+
+		typedef stl::vector<DeferredCommand> DeferredCommandArray;
+		CommandBuffer        m_cmdDeferred;
+		DeferredCommandArray m_deferredCmd;
+		uint32_t m_numDeferredRetired;
+		uint32_t m_numResourceCommands;
+
+		// Number of create and update commands in backlog per handle. Draw and
+		// compute calls using these handles are skipped until they are retired.
+		uint8_t  m_deferredIndexBuffer[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		uint8_t  m_deferredVertexBuffer[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		uint8_t  m_deferredProgram[BGFX_CONFIG_MAX_PROGRAMS];
+		uint8_t  m_deferredTexture[BGFX_CONFIG_MAX_TEXTURES];
+		uint8_t  m_deferredFrameBuffer[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		uint8_t  m_deferredUniform[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_numDeferredHandles;
+		uint32_t m_numDeferredDraws;
+
+		uint32_t m_tempBlitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS];
+		SortKeyRadixSort m_sortKeyRadixSort;
+		TexturePrepare m_texturePrepare;
+		TextureStreaming m_textureStreaming;
 
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
 
@@ -4184,6 +5364,7 @@ namespace bgfx
 			uint8_t m_format;
 			uint8_t m_numMips;
 			bool    m_owned;
+			bool    m_prepared;
 		};
 
 		struct FrameBufferRef
@@ -4196,10 +5377,6 @@ namespace bgfx
 			bool m_window;
 		};
 
-		typedef stl::unordered_set<uint16_t> HandleSet;
-		HandleSet m_uniformSet;
-		HandleSet m_occlusionQuerySet;
-
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
 		UniformHashMap m_uniformHashMap;
 		UniformRef m_uniformRef[BGFX_CONFIG_MAX_UNIFORMS];
@@ -4224,7 +5401,7 @@ namespace bgfx
 		Matrix4 m_view[BGFX_CONFIG_MAX_VIEWS];
 		Matrix4 m_proj[2][BGFX_CONFIG_MAX_VIEWS];
 		uint8_t m_viewFlags[BGFX_CONFIG_MAX_VIEWS];
-		uint16_t m_seq[BGFX_CONFIG_MAX_VIEWS];
+		uint32_t m_seq[BGFX_CONFIG_MAX_VIEWS];
 		uint16_t m_seqMask[BGFX_CONFIG_MAX_VIEWS];
 
 		uint8_t m_colorPaletteDirty;
@@ -4247,6 +5424,10 @@ namespace bgfx
 
 		typedef UpdateBatchT<256> TextureUpdateBatch;
 		BX_ALIGN_DECL_CACHE_LINE(TextureUpdateBatch m_textureUpdateBatch);
+
+		UniformCache m_uniformCache;
+		uint32_t m_uniformUpdateBytes;
+		uint32_t m_uniformSkippedBytes;
 	};
 
 #undef BGFX_API_FUNC
@@ -199,18 +199,111 @@
 #	define BGFX_CONFIG_MULTITHREADED ( (0 == BX_PLATFORM_EMSCRIPTEN) ? 1 : 0)
 #endif // BGFX_CONFIG_MULTITHREADED
 
+#ifndef BGFX_CONFIG_MAX_ENCODERS
+#	define BGFX_CONFIG_MAX_ENCODERS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 8 : 1)
+#endif // BGFX_CONFIG_MAX_ENCODERS
+
+/// Number of draw calls encoder batches before reserving space for them in
+/// submit frame.
+#ifndef BGFX_CONFIG_ENCODER_BATCH_SIZE
+#	define BGFX_CONFIG_ENCODER_BATCH_SIZE 256
+#endif // BGFX_CONFIG_ENCODER_BATCH_SIZE
+
+/// Upper bound of draw calls per frame. Frame storage is not preallocated
+/// for this many draw calls, it grows in chunks of
+/// BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE as needed.
 #ifndef BGFX_CONFIG_MAX_DRAW_CALLS
-#	define BGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
+#	define BGFX_CONFIG_MAX_DRAW_CALLS ( (1<<20)-1)
 #endif // BGFX_CONFIG_MAX_DRAW_CALLS
 
+/// Number of draw calls frame storage grows by. Must be power of 2.
+#ifndef BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE
+#	define BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE (1<<10)
+#endif // BGFX_CONFIG_DRAW_CALL_CHUNK_SIZE
+
+/// Number of worker threads used to sort draw calls, in addition to render
+/// thread.
+#ifndef BGFX_CONFIG_SORT_NUM_THREADS
+#	define BGFX_CONFIG_SORT_NUM_THREADS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 3 : 0)
+#endif // BGFX_CONFIG_SORT_NUM_THREADS
+
+/// Minimum number of draw calls before sort is split between threads.
+#ifndef BGFX_CONFIG_SORT_PARALLEL_THRESHOLD
+#	define BGFX_CONFIG_SORT_PARALLEL_THRESHOLD (8<<10)
+#endif // BGFX_CONFIG_SORT_PARALLEL_THRESHOLD
+
+/// Number of worker threads used by weldVertices with BGFX_WELD_MULTITHREADED
+/// flag, in addition to calling thread.
+#ifndef BGFX_CONFIG_WELD_NUM_THREADS
+#	define BGFX_CONFIG_WELD_NUM_THREADS 3
+#endif // BGFX_CONFIG_WELD_NUM_THREADS
+
+/// Minimum number of vertices per thread when welding vertices.
+#ifndef BGFX_CONFIG_WELD_MIN_VERTICES_PER_THREAD
+#	define BGFX_CONFIG_WELD_MIN_VERTICES_PER_THREAD (16<<10)
+#endif // BGFX_CONFIG_WELD_MIN_VERTICES_PER_THREAD
+
+/// Number of worker threads used by topologySortTriListCoherent to
+/// calculate triangle sort keys, in addition to calling thread.
+#ifndef BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS
+#	define BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS 3
+#endif // BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS
+
+/// Minimum number of triangles per thread when calculating sort keys.
+#ifndef BGFX_CONFIG_TOPOLOGY_SORT_MIN_TRIANGLES_PER_THREAD
+#	define BGFX_CONFIG_TOPOLOGY_SORT_MIN_TRIANGLES_PER_THREAD (16<<10)
+#endif // BGFX_CONFIG_TOPOLOGY_SORT_MIN_TRIANGLES_PER_THREAD
+
+/// Number of worker threads used to decode textures in formats that are
+/// emulated by renderer.
+#ifndef BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS
+#	define BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 2 : 0)
+#endif // BGFX_CONFIG_TEXTURE_PREPARE_NUM_THREADS
+
+/// Maximum number of texture decode jobs in flight per frame.
+#ifndef BGFX_CONFIG_MAX_TEXTURE_PREPARE_JOBS
+#	define BGFX_CONFIG_MAX_TEXTURE_PREPARE_JOBS 64
+#endif // BGFX_CONFIG_MAX_TEXTURE_PREPARE_JOBS
+
+/// Maximum number of streaming textures.
+#ifndef BGFX_CONFIG_MAX_STREAMING_TEXTURES
+#	define BGFX_CONFIG_MAX_STREAMING_TEXTURES 1024
+#endif // BGFX_CONFIG_MAX_STREAMING_TEXTURES
+
+/// Default number of bytes streaming textures are allowed to upload per
+/// frame. See: `bgfx::setTextureStreamingBudget`.
+#ifndef BGFX_CONFIG_TEXTURE_STREAMING_UPLOAD_BUDGET
+#	define BGFX_CONFIG_TEXTURE_STREAMING_UPLOAD_BUDGET (4<<20)
+#endif // BGFX_CONFIG_TEXTURE_STREAMING_UPLOAD_BUDGET
+
+/// Default memory cap for storage allocated by streaming textures.
+#ifndef BGFX_CONFIG_TEXTURE_STREAMING_MEMORY_CAP
+#	define BGFX_CONFIG_TEXTURE_STREAMING_MEMORY_CAP (UINT64_C(256)<<20)
+#endif // BGFX_CONFIG_TEXTURE_STREAMING_MEMORY_CAP
+
 #ifndef BGFX_CONFIG_MAX_BLIT_ITEMS
 #	define BGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // BGFX_CONFIG_MAX_BLIT_ITEMS
 
+/// Upper bound of matrices per frame. Matrix cache is not preallocated
+/// for this many matrices, it grows in chunks of
+/// BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE as needed.
 #ifndef BGFX_CONFIG_MAX_MATRIX_CACHE
 #	define BGFX_CONFIG_MAX_MATRIX_CACHE (BGFX_CONFIG_MAX_DRAW_CALLS+1)
 #endif // BGFX_CONFIG_MAX_MATRIX_CACHE
 
+/// Number of matrices matrix cache grows by. Must be larger than maximum
+/// number of matrices in one transform.
+#ifndef BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE
+#	define BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE (64<<10)
+#endif // BGFX_CONFIG_MATRIX_CACHE_CHUNK_SIZE
+
+/// Number of draw calls D3D12 and Vulkan per frame scratch buffers are sized
+/// for. Those renderers limit draw calls per frame to this value.
+#ifndef BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+#	define BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS (64<<10)
+#endif // BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+
 #ifndef BGFX_CONFIG_MAX_RECT_CACHE
 #	define BGFX_CONFIG_MAX_RECT_CACHE (4<<10)
 #endif //  BGFX_CONFIG_MAX_RECT_CACHE
@@ -245,6 +338,12 @@
 #	define BGFX_CONFIG_MAX_VERTEX_DECLS 64
 #endif // BGFX_CONFIG_MAX_VERTEX_DECLS
 
+/// Number of cached vertexConvert conversion plans between pairs of
+/// vertex declarations.
+#ifndef BGFX_CONFIG_MAX_VERTEX_CONVERT_PLANS
+#	define BGFX_CONFIG_MAX_VERTEX_CONVERT_PLANS 16
+#endif // BGFX_CONFIG_MAX_VERTEX_CONVERT_PLANS
+
 #ifndef BGFX_CONFIG_MAX_INDEX_BUFFERS
 #	define BGFX_CONFIG_MAX_INDEX_BUFFERS (4<<10)
 #endif // BGFX_CONFIG_MAX_INDEX_BUFFERS
@@ -297,14 +396,41 @@
 #	define BGFX_CONFIG_MAX_UNIFORMS 512
 #endif // BGFX_CONFIG_MAX_UNIFORMS
 
+/// Maximum number of view and frame uniform ranges per frame. Consecutive
+/// view uniforms for the same view share one range.
+#ifndef BGFX_CONFIG_MAX_VIEW_UNIFORM_RANGES
+#	define BGFX_CONFIG_MAX_VIEW_UNIFORM_RANGES (1<<10)
+#endif // BGFX_CONFIG_MAX_VIEW_UNIFORM_RANGES
+
 #ifndef BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
+/// Number of in flight asynchronous readbacks (frame captures and texture
+/// reads) for renderers that support them.
+#ifndef BGFX_CONFIG_MAX_READBACKS
+#	define BGFX_CONFIG_MAX_READBACKS 4
+#endif // BGFX_CONFIG_MAX_READBACKS
+
+/// Initial size of pre/post command buffers. Command buffers grow in
+/// chunks of this size when a frame submits more commands.
 #ifndef BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
 #	define BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE (64<<10)
 #endif // BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
 
+/// Maximum number of resource create commands executed by renderer per
+/// frame. Commands over budget are queued and retired in following frames
+/// in submission order. Updates count against no budget, they are queued
+/// only when resource they update is still in the queue. 0 means
+/// unlimited.
+///
+/// Note: Resources still in the queue, or with updates in the queue, are
+/// not ready on renderer side yet. Draw and compute calls using them are
+/// skipped, and uniform updates are ignored, see `Stats::numDeferredDraws`.
+#ifndef BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME
+#	define BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME 0
+#endif // BGFX_CONFIG_MAX_RESOURCE_COMMANDS_PER_FRAME
+
 #ifndef BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
 #	define BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE (6<<20)
 #endif // BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
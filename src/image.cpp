@@ -816,6 +816,446 @@ namespace bgfx
 		}
 	}
 
+	typedef void (*ImageConvertFn)(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch);
+
+	static void imageConvertRgba8ToBgra8(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
+	{
+		using namespace bx;
+
+		const simd128_t mf0f0 = simd_isplat(0xff00ff00);
+		const simd128_t m0f0f = simd_isplat(0x00ff00ff);
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		const uint32_t dstPitch = _width*4;
+
+		for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch, dst += dstPitch)
+		{
+			const uint8_t* rgba = src;
+			uint8_t* bgra = dst;
+			uint32_t xx = 0;
+
+			if (isAligned(rgba, 16)
+			&&  isAligned(bgra, 16) )
+			{
+				for (const uint32_t width = _width & ~UINT32_C(3); xx < width; xx += 4, rgba += 16, bgra += 16)
+				{
+					const simd128_t tabgr = simd_ld(rgba);
+					const simd128_t t00ab = simd_srl(tabgr, 16);
+					const simd128_t tgr00 = simd_sll(tabgr, 16);
+					const simd128_t tgrab = simd_or(t00ab, tgr00);
+					const simd128_t ta0g0 = simd_and(tabgr, mf0f0);
+					const simd128_t t0r0b = simd_and(tgrab, m0f0f);
+					const simd128_t targb = simd_or(ta0g0, t0r0b);
+					simd_st(bgra, targb);
+				}
+			}
+
+			for (; xx < _width; ++xx, rgba += 4, bgra += 4)
+			{
+				const uint8_t rr = rgba[0];
+				const uint8_t gg = rgba[1];
+				const uint8_t bb = rgba[2];
+				const uint8_t aa = rgba[3];
+				bgra[0] = bb;
+				bgra[1] = gg;
+				bgra[2] = rr;
+				bgra[3] = aa;
+			}
+		}
+	}
+
+	// Extracts 8-bit channel at byte Shift of each lane.
+	template<uint32_t Shift>
+	inline bx::simd128_t simdUnpack8(bx::simd128_t _value)
+	{
+		using namespace bx;
+
+		return simd_and(simd_srl(_value, Shift*8), simd_isplat(0xff) );
+	}
+
+	template<uint32_t SrcR>
+	static void imageConvert8888ToR8(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
+	{
+		using namespace bx;
+
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch)
+		{
+			const uint8_t* rgba = src;
+			uint32_t xx = 0;
+
+			if (isAligned(rgba, 16)
+			&&  isAligned(dst, 16) )
+			{
+				for (const uint32_t width = _width & ~UINT32_C(15); xx < width; xx += 16, rgba += 64, dst += 16)
+				{
+					const simd128_t r0 = simdUnpack8<SrcR>(simd_ld(rgba) );
+					const simd128_t r1 = simdUnpack8<SrcR>(simd_ld(rgba+16) );
+					const simd128_t r2 = simdUnpack8<SrcR>(simd_ld(rgba+32) );
+					const simd128_t r3 = simdUnpack8<SrcR>(simd_ld(rgba+48) );
+
+					// Transpose so that each lane holds 4 consecutive pixels.
+					const simd128_t r01xy = simd_shuf_xAyB(r0, r1);
+					const simd128_t r23xy = simd_shuf_xAyB(r2, r3);
+					const simd128_t r01zw = simd_shuf_zCwD(r0, r1);
+					const simd128_t r23zw = simd_shuf_zCwD(r2, r3);
+
+					const simd128_t xx0 = simd_shuf_xyAB(r01xy, r23xy);
+					const simd128_t yy0 = simd_sll(simd_shuf_zwCD(r01xy, r23xy),  8);
+					const simd128_t zz0 = simd_sll(simd_shuf_xyAB(r01zw, r23zw), 16);
+					const simd128_t ww0 = simd_sll(simd_shuf_zwCD(r01zw, r23zw), 24);
+
+					simd_st(dst, simd_or(simd_or(xx0, yy0), simd_or(zz0, ww0) ) );
+				}
+			}
+
+			for (; xx < _width; ++xx, rgba += 4, ++dst)
+			{
+				dst[0] = rgba[SrcR];
+			}
+		}
+	}
+
+	// Converts 8-bit channels to unorm floats, same as bx::fromUnorm.
+	inline bx::simd128_t simdFromUnorm8(bx::simd128_t _value)
+	{
+		using namespace bx;
+
+		return simd_div(simd_itof(_value), simd_splat(255.0f) );
+	}
+
+	// Converts unorm floats to half floats in low 16 bits of each lane. All
+	// non-zero n/255 values are normal halfs, so exponent is rebiased by
+	// subtracting 112 and mantissa is rounded the same as bx::halfFromFloat.
+	inline bx::simd128_t simdUnormToHalf(bx::simd128_t _value)
+	{
+		using namespace bx;
+
+		const simd128_t bias  = simd_isplat(0x1000 - (112<<23) );
+		const simd128_t half  = simd_srl(simd_iadd(_value, bias), 13);
+		const simd128_t nzero = simd_cmpgt(_value, simd_zero() );
+
+		return simd_and(half, nzero);
+	}
+
+	template<uint32_t SrcR, uint32_t SrcB>
+	static void imageConvert8888ToRgba16F(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
+	{
+		using namespace bx;
+
+		const uint8_t* src = (const uint8_t*)_src;
+		uint16_t* dst = (uint16_t*)_dst;
+
+		for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch)
+		{
+			const uint8_t* rgba = src;
+			uint32_t xx = 0;
+
+			if (isAligned(rgba, 16)
+			&&  isAligned(dst, 16) )
+			{
+				for (const uint32_t width = _width & ~UINT32_C(3); xx < width; xx += 4, rgba += 16, dst += 16)
+				{
+					const simd128_t abgr = simd_ld(rgba);
+					const simd128_t rr = simdUnormToHalf(simdFromUnorm8(simdUnpack8<SrcR>(abgr) ) );
+					const simd128_t gg = simdUnormToHalf(simdFromUnorm8(simdUnpack8<1>(abgr) ) );
+					const simd128_t bb = simdUnormToHalf(simdFromUnorm8(simdUnpack8<SrcB>(abgr) ) );
+					const simd128_t aa = simdUnormToHalf(simdFromUnorm8(simd_srl(abgr, 24) ) );
+
+					// Two pixels per store, as r|g<<16, b|a<<16 lanes.
+					const simd128_t rg = simd_or(rr, simd_sll(gg, 16) );
+					const simd128_t ba = simd_or(bb, simd_sll(aa, 16) );
+
+					simd_st(dst,   simd_shuf_xAyB(rg, ba) );
+					simd_st(dst+8, simd_shuf_zCwD(rg, ba) );
+				}
+			}
+
+			for (; xx < _width; ++xx, rgba += 4, dst += 4)
+			{
+				dst[0] = bx::halfFromFloat(bx::fromUnorm(rgba[SrcR], 255.0f) );
+				dst[1] = bx::halfFromFloat(bx::fromUnorm(rgba[1],    255.0f) );
+				dst[2] = bx::halfFromFloat(bx::fromUnorm(rgba[SrcB], 255.0f) );
+				dst[3] = bx::halfFromFloat(bx::fromUnorm(rgba[3],    255.0f) );
+			}
+		}
+	}
+
+	template<uint32_t SrcR, uint32_t SrcB>
+	static void imageConvert8888ToRgba32F(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
+	{
+		using namespace bx;
+
+		const uint8_t* src = (const uint8_t*)_src;
+		float* dst = (float*)_dst;
+
+		for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch)
+		{
+			const uint8_t* rgba = src;
+			uint32_t xx = 0;
+
+			if (isAligned(rgba, 16)
+			&&  isAligned(dst, 16) )
+			{
+				for (const uint32_t width = _width & ~UINT32_C(3); xx < width; xx += 4, rgba += 16, dst += 16)
+				{
+					const simd128_t abgr = simd_ld(rgba);
+					const simd128_t rr = simdFromUnorm8(simdUnpack8<SrcR>(abgr) );
+					const simd128_t gg = simdFromUnorm8(simdUnpack8<1>(abgr) );
+					const simd128_t bb = simdFromUnorm8(simdUnpack8<SrcB>(abgr) );
+					const simd128_t aa = simdFromUnorm8(simd_srl(abgr, 24) );
+
+					// Transpose to pixel vectors.
+					const simd128_t rgrg0 = simd_shuf_xAyB(rr, gg);
+					const simd128_t rgrg1 = simd_shuf_zCwD(rr, gg);
+					const simd128_t baba0 = simd_shuf_xAyB(bb, aa);
+					const simd128_t baba1 = simd_shuf_zCwD(bb, aa);
+
+					simd_st(dst,    simd_shuf_xyAB(rgrg0, baba0) );
+					simd_st(dst+4,  simd_shuf_zwCD(rgrg0, baba0) );
+					simd_st(dst+8,  simd_shuf_xyAB(rgrg1, baba1) );
+					simd_st(dst+12, simd_shuf_zwCD(rgrg1, baba1) );
+				}
+			}
+
+			for (; xx < _width; ++xx, rgba += 4, dst += 4)
+			{
+				dst[0] = bx::fromUnorm(rgba[SrcR], 255.0f);
+				dst[1] = bx::fromUnorm(rgba[1],    255.0f);
+				dst[2] = bx::fromUnorm(rgba[SrcB], 255.0f);
+				dst[3] = bx::fromUnorm(rgba[3],    255.0f);
+			}
+		}
+	}
+
+	// Converts to 8-bit unorm in low byte of each lane, same as bx::toUnorm.
+	inline bx::simd128_t simdToUnorm8(bx::simd128_t _value)
+	{
+		using namespace bx;
+
+		const simd128_t zero = simd_zero();
+		const simd128_t one  = simd_splat(1.0f);
+		const simd128_t full = simd_splat(255.0f);
+		const simd128_t half = simd_splat(0.5f);
+		const simd128_t sat  = simd_min(simd_max(_value, zero), one);
+
+		return simd_ftoi(simd_madd(sat, full, half) );
+	}
+
+	// Packs 4 pixels from channel vectors into 8888 layout.
+	template<uint32_t DstR, uint32_t DstB>
+	inline bx::simd128_t simdPack8888(bx::simd128_t _r, bx::simd128_t _g, bx::simd128_t _b, bx::simd128_t _a)
+	{
+		using namespace bx;
+
+		const simd128_t rr = simd_sll(simdToUnorm8(_r), DstR*8);
+		const simd128_t gg = simd_sll(simdToUnorm8(_g), 8);
+		const simd128_t bb = simd_sll(simdToUnorm8(_b), DstB*8);
+		const simd128_t aa = simd_sll(simdToUnorm8(_a), 24);
+
+		return simd_or(simd_or(rr, gg), simd_or(bb, aa) );
+	}
+
+	// Converts half floats in low 16 bits of each lane to floats. Exponent
+	// is rebiased by multiplying with 2^112, which also handles denormals.
+	// Infinity becomes 65536.0 and NaN becomes 0.0, which give the same
+	// unorm result as bx::halfToFloat.
+	inline bx::simd128_t simdHalfToFloatUnorm(bx::simd128_t _half)
+	{
+		using namespace bx;
+
+		const simd128_t mmag   = simd_isplat(0x7fff);
+		const simd128_t msign  = simd_isplat(0x8000);
+		const simd128_t magic  = simd_isplat(0x77800000);
+		const simd128_t maxinf = simd_splat(65536.0f);
+
+		const simd128_t mag    = simd_sll(simd_and(_half, mmag), 13);
+		const simd128_t magf   = simd_mul(mag, magic);
+		const simd128_t nan    = simd_cmpgt(magf, maxinf);
+		const simd128_t num    = simd_xor(magf, simd_and(magf, nan) );
+		const simd128_t sign   = simd_sll(simd_and(_half, msign), 16);
+
+		return simd_or(num, sign);
+	}
+
+	template<uint32_t DstR, uint32_t DstB>
+	static void imageConvertRgba16FTo8888(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
+	{
+		using namespace bx;
+
+		const simd128_t mlow = simd_isplat(0xffff);
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch)
+		{
+			const uint16_t* rgba = (const uint16_t*)src;
+			uint32_t xx = 0;
+
+			if (isAligned(rgba, 16)
+			&&  isAligned(dst, 16) )
+			{
+				for (const uint32_t width = _width & ~UINT32_C(3); xx < width; xx += 4, rgba += 16, dst += 16)
+				{
+					// Two pixels per load, as r|g<<16, b|a<<16 lanes.
+					const simd128_t p01   = simd_ld(rgba);
+					const simd128_t p23   = simd_ld(rgba+8);
+					const simd128_t rbrb0 = simd_and(p01, mlow);
+					const simd128_t rbrb1 = simd_and(p23, mlow);
+					const simd128_t gaga0 = simd_srl(p01, 16);
+					const simd128_t gaga1 = simd_srl(p23, 16);
+
+					const simd128_t rrbb0 = simd_shuf_xAyB(rbrb0, rbrb1);
+					const simd128_t rrbb1 = simd_shuf_zCwD(rbrb0, rbrb1);
+					const simd128_t ggaa0 = simd_shuf_xAyB(gaga0, gaga1);
+					const simd128_t ggaa1 = simd_shuf_zCwD(gaga0, gaga1);
+
+					const simd128_t rr = simdHalfToFloatUnorm(simd_shuf_xAyB(rrbb0, rrbb1) );
+					const simd128_t bb = simdHalfToFloatUnorm(simd_shuf_zCwD(rrbb0, rrbb1) );
+					const simd128_t gg = simdHalfToFloatUnorm(simd_shuf_xAyB(ggaa0, ggaa1) );
+					const simd128_t aa = simdHalfToFloatUnorm(simd_shuf_zCwD(ggaa0, ggaa1) );
+
+					simd_st(dst, simdPack8888<DstR, DstB>(rr, gg, bb, aa) );
+				}
+			}
+
+			for (; xx < _width; ++xx, rgba += 4, dst += 4)
+			{
+				dst[DstR] = uint8_t(bx::toUnorm(bx::halfToFloat(rgba[0]), 255.0f) );
+				dst[1]    = uint8_t(bx::toUnorm(bx::halfToFloat(rgba[1]), 255.0f) );
+				dst[DstB] = uint8_t(bx::toUnorm(bx::halfToFloat(rgba[2]), 255.0f) );
+				dst[3]    = uint8_t(bx::toUnorm(bx::halfToFloat(rgba[3]), 255.0f) );
+			}
+		}
+	}
+
+	template<uint32_t DstR, uint32_t DstB>
+	static void imageConvertRgba32FTo8888(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
+	{
+		using namespace bx;
+
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch)
+		{
+			const float* rgba = (const float*)src;
+			uint32_t xx = 0;
+
+			if (isAligned(rgba, 16)
+			&&  isAligned(dst, 16) )
+			{
+				for (const uint32_t width = _width & ~UINT32_C(3); xx < width; xx += 4, rgba += 16, dst += 16)
+				{
+					const simd128_t p0 = simd_ld(rgba);
+					const simd128_t p1 = simd_ld(rgba+4);
+					const simd128_t p2 = simd_ld(rgba+8);
+					const simd128_t p3 = simd_ld(rgba+12);
+
+					// Transpose to channel vectors.
+					const simd128_t rrgg0 = simd_shuf_xAyB(p0, p2);
+					const simd128_t rrgg1 = simd_shuf_xAyB(p1, p3);
+					const simd128_t bbaa0 = simd_shuf_zCwD(p0, p2);
+					const simd128_t bbaa1 = simd_shuf_zCwD(p1, p3);
+
+					const simd128_t rr = simd_shuf_xAyB(rrgg0, rrgg1);
+					const simd128_t gg = simd_shuf_zCwD(rrgg0, rrgg1);
+					const simd128_t bb = simd_shuf_xAyB(bbaa0, bbaa1);
+					const simd128_t aa = simd_shuf_zCwD(bbaa0, bbaa1);
+
+					simd_st(dst, simdPack8888<DstR, DstB>(rr, gg, bb, aa) );
+				}
+			}
+
+			for (; xx < _width; ++xx, rgba += 4, dst += 4)
+			{
+				dst[DstR] = uint8_t(bx::toUnorm(rgba[0], 255.0f) );
+				dst[1]    = uint8_t(bx::toUnorm(rgba[1], 255.0f) );
+				dst[DstB] = uint8_t(bx::toUnorm(rgba[2], 255.0f) );
+				dst[3]    = uint8_t(bx::toUnorm(rgba[3], 255.0f) );
+			}
+		}
+	}
+
+	static void imageConvertRgba16FToRgba32F(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		float* dst = (float*)_dst;
+
+		for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch)
+		{
+			const uint16_t* rgba = (const uint16_t*)src;
+			for (uint32_t xx = 0, num = _width*4; xx < num; ++xx)
+			{
+				dst[xx] = bx::halfToFloat(rgba[xx]);
+			}
+
+			dst += _width*4;
+		}
+	}
+
+	static void imageConvertRgba32FToRgba16F(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint16_t* dst = (uint16_t*)_dst;
+
+		for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch)
+		{
+			const float* rgba = (const float*)src;
+			for (uint32_t xx = 0, num = _width*4; xx < num; ++xx)
+			{
+				dst[xx] = bx::halfFromFloat(rgba[xx]);
+			}
+
+			dst += _width*4;
+		}
+	}
+
+	struct ImageConvert
+	{
+		TextureFormat::Enum dstFormat;
+		TextureFormat::Enum srcFormat;
+		ImageConvertFn fn;
+	};
+
+	// Specialized conversions for common format pairs. Results match
+	// generic pack/unpack path.
+	static const ImageConvert s_imageConvert[] =
+	{
+		{ TextureFormat::BGRA8,   TextureFormat::RGBA8,   imageConvertRgba8ToBgra8          },
+		{ TextureFormat::RGBA8,   TextureFormat::BGRA8,   imageConvertRgba8ToBgra8          },
+		{ TextureFormat::R8,      TextureFormat::RGBA8,   imageConvert8888ToR8<0>           },
+		{ TextureFormat::R8,      TextureFormat::BGRA8,   imageConvert8888ToR8<2>           },
+		{ TextureFormat::RGBA16F, TextureFormat::RGBA8,   imageConvert8888ToRgba16F<0, 2>   },
+		{ TextureFormat::RGBA16F, TextureFormat::BGRA8,   imageConvert8888ToRgba16F<2, 0>   },
+		{ TextureFormat::RGBA32F, TextureFormat::RGBA8,   imageConvert8888ToRgba32F<0, 2>   },
+		{ TextureFormat::RGBA32F, TextureFormat::BGRA8,   imageConvert8888ToRgba32F<2, 0>   },
+		{ TextureFormat::RGBA8,   TextureFormat::RGBA16F, imageConvertRgba16FTo8888<0, 2>   },
+		{ TextureFormat::BGRA8,   TextureFormat::RGBA16F, imageConvertRgba16FTo8888<2, 0>   },
+		{ TextureFormat::RGBA8,   TextureFormat::RGBA32F, imageConvertRgba32FTo8888<0, 2>   },
+		{ TextureFormat::BGRA8,   TextureFormat::RGBA32F, imageConvertRgba32FTo8888<2, 0>   },
+		{ TextureFormat::RGBA32F, TextureFormat::RGBA16F, imageConvertRgba16FToRgba32F      },
+		{ TextureFormat::RGBA16F, TextureFormat::RGBA32F, imageConvertRgba32FToRgba16F      },
+	};
+
+	static ImageConvertFn findImageConvert(TextureFormat::Enum _dstFormat, TextureFormat::Enum _srcFormat)
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_imageConvert); ++ii)
+		{
+			const ImageConvert& ic = s_imageConvert[ii];
+			if (ic.dstFormat == _dstFormat
+			&&  ic.srcFormat == _srcFormat)
+			{
+				return ic.fn;
+			}
+		}
+
+		return NULL;
+	}
+
 	bool imageConvert(void* _dst, TextureFormat::Enum _dstFormat, const void* _src, TextureFormat::Enum _srcFormat, uint32_t _width, uint32_t _height, uint32_t _srcPitch)
 	{
 		bx::UnpackFn unpack = s_packUnpack[_srcFormat].unpack;
@@ -828,6 +1268,20 @@ namespace bgfx
 
 		const uint32_t srcBpp = s_imageBlockInfo[_srcFormat].bitsPerPixel;
 		const uint32_t dstBpp = s_imageBlockInfo[_dstFormat].bitsPerPixel;
+
+		if (_dstFormat == _srcFormat)
+		{
+			imageCopy(_dst, _height, _srcPitch, _src, _width*dstBpp/8);
+			return true;
+		}
+
+		ImageConvertFn fn = findImageConvert(_dstFormat, _srcFormat);
+		if (NULL != fn)
+		{
+			fn(_dst, _src, _width, _height, _srcPitch);
+			return true;
+		}
+
 		imageConvert(_dst, dstBpp, pack, _src, srcBpp, unpack, _width, _height, _srcPitch);
 
 		return true;
@@ -1284,6 +1284,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					| BGFX_CAPS_DRAW_INDIRECT
 					| BGFX_CAPS_TEXTURE_BLIT
 					| BGFX_CAPS_TEXTURE_READ_BACK
+					| ( (m_featureLevel >= D3D_FEATURE_LEVEL_10_0) ? BGFX_CAPS_TEXTURE_MIN_LOD : 0)
 					| ( (m_featureLevel >= D3D_FEATURE_LEVEL_9_2) ? BGFX_CAPS_OCCLUSION_QUERY : 0)
 					| BGFX_CAPS_ALPHA_TO_COVERAGE
 					| ( (m_deviceInterfaceVersion >= 3) ? BGFX_CAPS_CONSERVATIVE_RASTER : 0)
@@ -1878,6 +1879,11 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 			m_deviceCtx->Unmap(texture.m_ptr, _mip);
 		}
 
+		uint32_t getReadBackLatency() const BX_OVERRIDE
+		{
+			return 0;
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips) BX_OVERRIDE
 		{
 			TextureD3D11& texture = m_textures[_handle.idx];
@@ -1906,6 +1912,12 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle _handle, uint8_t _lod) BX_OVERRIDE
+		{
+			const TextureD3D11& texture = m_textures[_handle.idx];
+			m_deviceCtx->SetResourceMinLOD(texture.m_ptr, float(_lod) );
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) BX_OVERRIDE
 		{
 			// Resource ref. counts might be messed up outside of bgfx.
@@ -2184,6 +2196,8 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 
 		void postReset()
 		{
+			rendererInvalidateUniforms();
+
 			if (NULL != m_swapChain)
 			{
 				ID3D11Texture2D* color;
@@ -5282,6 +5296,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		setDebugWireframe(wireframe);
 
 		uint16_t programIdx = invalidHandle;
+		bool viewUniformsChanged = false;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
@@ -5334,7 +5349,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					|| item == numItems
 					;
 
-				const RenderItem& renderItem = _render->m_renderItem[_render->m_sortValues[item] ];
+				const RenderItem& renderItem = _render->getRenderItem(_render->m_sortValues[item]);
 				++item;
 
 				if (viewChanged)
@@ -5349,6 +5364,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					}
 
 					view = key.m_view;
+					viewUniformsChanged = rendererUpdateViewUniforms(this, _render, view);
 					programIdx = invalidHandle;
 
 					if (_render->m_fb[view].idx != fbh.idx)
@@ -5550,8 +5566,8 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					}
 
 					bool programChanged = false;
-					bool constantsChanged = compute.m_constBegin < compute.m_constEnd;
-					rendererUpdateUniforms(this, _render->m_uniformBuffer, compute.m_constBegin, compute.m_constEnd);
+					bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_constBegin, compute.m_constEnd) || viewUniformsChanged;
+					viewUniformsChanged = false;
 
 					if (key.m_program != programIdx)
 					{
@@ -5819,8 +5835,8 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_constBegin < draw.m_constEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_constBegin, draw.m_constEnd) || viewUniformsChanged;
+				viewUniformsChanged = false;
 
 				if (key.m_program != programIdx)
 				{
@@ -939,10 +939,11 @@ namespace bgfx { namespace d3d12
 
 				for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 				{
-					m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS*1024
-							, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
+					m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS*1024
+							, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
 							);
 				}
+				g_caps.limits.maxDrawCalls = bx::uint32_min(g_caps.limits.maxDrawCalls, BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS);
 				m_samplerAllocator.create(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
 						, 1024
 						, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS
@@ -1002,6 +1003,7 @@ namespace bgfx { namespace d3d12
 //									| BGFX_CAPS_SWAP_CHAIN
 									| BGFX_CAPS_TEXTURE_BLIT
 									| BGFX_CAPS_TEXTURE_READ_BACK
+									| BGFX_CAPS_TEXTURE_MIN_LOD
 									| BGFX_CAPS_OCCLUSION_QUERY
 									| BGFX_CAPS_ALPHA_TO_COVERAGE
 									| BGFX_CAPS_TEXTURE_2D_ARRAY
@@ -1467,6 +1469,11 @@ namespace bgfx { namespace d3d12
 			DX_RELEASE(readback, 0);
 		}
 
+		uint32_t getReadBackLatency() const BX_OVERRIDE
+		{
+			return 0;
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips) BX_OVERRIDE
 		{
 			TextureD3D12& texture = m_textures[_handle.idx];
@@ -1495,6 +1502,13 @@ namespace bgfx { namespace d3d12
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle _handle, uint8_t _lod) BX_OVERRIDE
+		{
+			TextureD3D12& texture = m_textures[_handle.idx];
+			BX_CHECK(D3D12_SRV_DIMENSION_TEXTURE2D == texture.m_srvd.ViewDimension, "Min LOD is supported only for 2D textures.");
+			texture.m_srvd.Texture2D.ResourceMinLODClamp = float(_lod);
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) BX_OVERRIDE
 		{
 			BX_UNUSED(_handle, _ptr);
@@ -1762,6 +1776,8 @@ namespace bgfx { namespace d3d12
 
 		void postReset()
 		{
+			rendererInvalidateUniforms();
+
 			bx::memSet(m_backBufferColorFence, 0, sizeof(m_backBufferColorFence) );
 
 			uint32_t rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
@@ -4791,6 +4807,7 @@ data.NumQualityLevels = 0;
 
 		uint16_t currentSamplerStateIdx = invalidHandle;
 		uint16_t currentProgramIdx      = invalidHandle;
+		bool     viewUniformsChanged    = false;
 		uint32_t currentBindHash        = 0;
 		bool     hasPredefined          = false;
 		bool     commandListChanged     = false;
@@ -4865,7 +4882,7 @@ data.NumQualityLevels = 0;
 					|| item == numItems
 					;
 
-				const RenderItem& renderItem = _render->m_renderItem[_render->m_sortValues[item] ];
+				const RenderItem& renderItem = _render->getRenderItem(_render->m_sortValues[item]);
 				++item;
 
 				if (viewChanged)
@@ -4874,6 +4891,7 @@ data.NumQualityLevels = 0;
 					kick();
 
 					view = key.m_view;
+					viewUniformsChanged = rendererUpdateViewUniforms(this, _render, view);
 					currentPso = NULL;
 					currentSamplerStateIdx = invalidHandle;
 					currentProgramIdx      = invalidHandle;
@@ -5106,12 +5124,12 @@ data.NumQualityLevels = 0;
 						}
 					}
 
-					bool constantsChanged = false;
-					if (compute.m_constBegin < compute.m_constEnd
+					bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_constBegin, compute.m_constEnd) || viewUniformsChanged;
+					viewUniformsChanged = false;
+
+					if (constantsChanged
 					||  currentProgramIdx != key.m_program)
 					{
-						rendererUpdateUniforms(this, _render->m_uniformBuffer, compute.m_constBegin, compute.m_constEnd);
-
 						currentProgramIdx = key.m_program;
 						ProgramD3D12& program = m_program[currentProgramIdx];
 
@@ -5222,7 +5240,8 @@ data.NumQualityLevels = 0;
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
 				}
 
-				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
+				const bool uniformsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_constBegin, draw.m_constEnd) || viewUniformsChanged;
+				viewUniformsChanged = false;
 
 				if (isValid(draw.m_stream[0].m_handle) )
 				{
@@ -5394,7 +5413,7 @@ data.NumQualityLevels = 0;
 					}
 
 					bool constantsChanged = false;
-					if (draw.m_constBegin < draw.m_constEnd
+					if (uniformsChanged
 					||  currentProgramIdx != key.m_program
 					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
 					{
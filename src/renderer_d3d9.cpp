@@ -1032,6 +1032,11 @@ namespace bgfx { namespace d3d9
 			DX_CHECK(texture.m_texture2d->UnlockRect(_mip) );
 		}
 
+		uint32_t getReadBackLatency() const BX_OVERRIDE
+		{
+			return 0;
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips) BX_OVERRIDE
 		{
 			TextureD3D9& texture = m_textures[_handle.idx];
@@ -1060,6 +1065,10 @@ namespace bgfx { namespace d3d9
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle /*_handle*/, uint8_t /*_lod*/) BX_OVERRIDE
+		{
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) BX_OVERRIDE
 		{
 			// Resource ref. counts might be messed up outside of bgfx.
@@ -1549,6 +1558,8 @@ namespace bgfx { namespace d3d9
 
 		void postReset()
 		{
+			rendererInvalidateUniforms();
+
 			DX_CHECK(m_device->GetSwapChain(0, &m_swapChain) );
 			DX_CHECK(m_swapChain->GetBackBuffer(0, D3DBACKBUFFER_TYPE_MONO, &m_backBufferColor) );
 			DX_CHECK(m_device->GetDepthStencilSurface(&m_backBufferDepthStencil) );
@@ -3599,6 +3610,7 @@ namespace bgfx { namespace d3d9
 
 		DX_CHECK(device->SetRenderState(D3DRS_FILLMODE, _render->m_debug&BGFX_DEBUG_WIREFRAME ? D3DFILL_WIREFRAME : D3DFILL_SOLID) );
 		uint16_t programIdx = invalidHandle;
+		bool viewUniformsChanged = false;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
@@ -3647,7 +3659,7 @@ namespace bgfx { namespace d3d9
 					continue;
 				}
 
-				const RenderDraw& draw = _render->m_renderItem[_render->m_sortValues[item] ].draw;
+				const RenderDraw& draw = _render->getRenderItem(_render->m_sortValues[item]).draw;
 
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				if (isValid(draw.m_occlusionQuery)
@@ -3683,6 +3695,7 @@ namespace bgfx { namespace d3d9
 					BGFX_PROFILER_BEGIN_DYNAMIC(s_viewName[key.m_view]);
 
 					view = key.m_view;
+					viewUniformsChanged = rendererUpdateViewUniforms(this, _render, view);
 					programIdx = invalidHandle;
 
 					if (_render->m_fb[view].idx != fbh.idx)
@@ -3999,8 +4012,8 @@ namespace bgfx { namespace d3d9
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_constBegin < draw.m_constEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_constBegin, draw.m_constEnd) || viewUniformsChanged;
+				viewUniformsChanged = false;
 
 				if (key.m_program != programIdx)
 				{
@@ -499,6 +499,7 @@ namespace bgfx { namespace gl
 			ARB_shader_image_load_store,
 			ARB_shader_storage_buffer_object,
 			ARB_shader_texture_lod,
+			ARB_sync,
 			ARB_texture_compression_bptc,
 			ARB_texture_compression_rgtc,
 			ARB_texture_cube_map_array,
@@ -712,6 +713,7 @@ namespace bgfx { namespace gl
 		{ "ARB_shader_image_load_store",              BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
 		{ "ARB_shader_storage_buffer_object",         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_shader_texture_lod",                   BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
+		{ "ARB_sync",                                 BGFX_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_texture_compression_bptc",             BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_texture_compression_rgtc",             BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
 		{ "ARB_texture_cube_map_array",               BGFX_CONFIG_RENDERER_OPENGL >= 40, true  },
@@ -1420,6 +1422,7 @@ namespace bgfx { namespace gl
 			, m_vao(0)
 			, m_blitSupported(false)
 			, m_readBackSupported(BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) )
+			, m_asyncReadBackSupported(false)
 			, m_vaoSupport(false)
 			, m_samplerObjectSupport(false)
 			, m_shadowSamplersSupport(false)
@@ -1888,6 +1891,10 @@ namespace bgfx { namespace gl
 				? BGFX_CAPS_TEXTURE_COMPARE_ALL
 				: 0
 				;
+			g_caps.supported |= !!(BGFX_CONFIG_RENDERER_OPENGL || BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+				? BGFX_CAPS_TEXTURE_MIN_LOD
+				: 0
+				;
 			g_caps.supported |= !!(BGFX_CONFIG_RENDERER_OPENGL || BGFX_CONFIG_RENDERER_OPENGLES >= 30)
 				|| s_extension[Extension::OES_vertex_half_float].m_supported
 				? BGFX_CAPS_VERTEX_ATTRIB_HALF
@@ -2075,6 +2082,20 @@ namespace bgfx { namespace gl
 				&& NULL != glEndQuery
 				;
 
+			m_asyncReadBackSupported = false
+				|| BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+				|| (s_extension[Extension::ARB_sync            ].m_supported
+				&&  s_extension[Extension::ARB_map_buffer_range].m_supported)
+				;
+
+			m_asyncReadBackSupported &= true
+				&& NULL != glFenceSync
+				&& NULL != glClientWaitSync
+				&& NULL != glDeleteSync
+				&& NULL != glMapBufferRange
+				&& NULL != glUnmapBuffer
+				;
+
 			m_atocSupport = s_extension[Extension::ARB_multisample].m_supported;
 			m_conservativeRasterSupport = s_extension[Extension::NV_conservative_raster].m_supported;
 
@@ -2207,6 +2228,11 @@ namespace bgfx { namespace gl
 				m_occlusionQuery.create();
 			}
 
+			if (m_asyncReadBackSupported)
+			{
+				m_readBack.create();
+			}
+
 			// Init reserved part of view name.
 			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 			{
@@ -2248,6 +2274,11 @@ namespace bgfx { namespace gl
 				m_occlusionQuery.destroy();
 			}
 
+			if (m_asyncReadBackSupported)
+			{
+				m_readBack.destroy();
+			}
+
 			destroyMsaaFbo();
 			m_glctx.destroy();
 
@@ -2401,7 +2432,15 @@ namespace bgfx { namespace gl
 
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) BX_OVERRIDE
 		{
-			if (m_readBackSupported)
+			// Texture readback uses glGetTexImage, which is not available on
+			// GLES. Asynchronous path is used only when synchronous texture
+			// readback is supported too.
+			if (m_readBackSupported
+			&&  m_asyncReadBackSupported)
+			{
+				m_readBack.readTexture(m_textures[_handle.idx], _mip, _data);
+			}
+			else if (m_readBackSupported)
 			{
 				const TextureGL& texture = m_textures[_handle.idx];
 				const bool compressed    = isCompressed(TextureFormat::Enum(texture.m_textureFormat) );
@@ -2429,6 +2468,13 @@ namespace bgfx { namespace gl
 			}
 		}
 
+		uint32_t getReadBackLatency() const BX_OVERRIDE
+		{
+			// Asynchronous readbacks are resolved at the beginning of next
+			// frame's submit.
+			return m_readBackSupported && m_asyncReadBackSupported ? 1 : 0;
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips) BX_OVERRIDE
 		{
 			TextureGL& texture = m_textures[_handle.idx];
@@ -2457,6 +2503,13 @@ namespace bgfx { namespace gl
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle _handle, uint8_t _lod) BX_OVERRIDE
+		{
+			const TextureGL& texture = m_textures[_handle.idx];
+			GL_CHECK(glBindTexture(texture.m_target, texture.m_id) );
+			GL_CHECK(glTexParameteri(texture.m_target, GL_TEXTURE_BASE_LEVEL, _lod) );
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) BX_OVERRIDE
 		{
 			m_textures[_handle.idx].overrideInternal(_ptr);
@@ -2687,6 +2740,8 @@ namespace bgfx { namespace gl
 				m_textVideoMem.resize(false, _resolution.m_width, _resolution.m_height);
 				m_textVideoMem.clear();
 
+				rendererInvalidateUniforms();
+
 				if ( (flags & BGFX_RESET_HMD)
 				&&  m_ovr.isInitialized() )
 				{
@@ -3074,6 +3129,12 @@ namespace bgfx { namespace gl
 
 		void updateCapture()
 		{
+			if (m_asyncReadBackSupported)
+			{
+				// Deliver frames captured with previous resolution.
+				m_readBack.resolve(true);
+			}
+
 			if (m_resolution.m_flags&BGFX_RESET_CAPTURE)
 			{
 				m_captureSize = m_resolution.m_width*m_resolution.m_height*4;
@@ -3088,7 +3149,12 @@ namespace bgfx { namespace gl
 
 		void capture()
 		{
-			if (NULL != m_capture)
+			if (NULL != m_capture
+			&&  m_asyncReadBackSupported)
+			{
+				m_readBack.readPixels(m_resolution.m_width, m_resolution.m_height, m_readPixelsFmt);
+			}
+			else if (NULL != m_capture)
 			{
 				GL_CHECK(glReadPixels(0
 					, 0
@@ -3112,6 +3178,11 @@ namespace bgfx { namespace gl
 		{
 			if (NULL != m_capture)
 			{
+				if (m_asyncReadBackSupported)
+				{
+					m_readBack.resolve(true);
+				}
+
 				g_callback->captureEnd();
 				BX_FREE(g_allocator, m_capture);
 				m_capture = NULL;
@@ -3445,6 +3516,7 @@ namespace bgfx { namespace gl
 
 		TimerQueryGL m_gpuTimer;
 		OcclusionQueryGL m_occlusionQuery;
+		ReadBackGL m_readBack;
 
 		VaoStateCache m_vaoStateCache;
 		SamplerStateCache m_samplerStateCache;
@@ -3464,6 +3536,7 @@ namespace bgfx { namespace gl
 		GLuint m_vao;
 		bool m_blitSupported;
 		bool m_readBackSupported;
+		bool m_asyncReadBackSupported;
 		bool m_vaoSupport;
 		bool m_samplerObjectSupport;
 		bool m_shadowSamplersSupport;
@@ -6130,6 +6203,190 @@ namespace bgfx { namespace gl
 		}
 	}
 
+	void ReadBackGL::create()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_item); ++ii)
+		{
+			Item& item = m_item[ii];
+			GL_CHECK(glGenBuffers(1, &item.m_pbo) );
+			item.m_sync    = NULL;
+			item.m_pboSize = 0;
+		}
+	}
+
+	void ReadBackGL::destroy()
+	{
+		resolve(true);
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_item); ++ii)
+		{
+			Item& item = m_item[ii];
+			GL_CHECK(glDeleteBuffers(1, &item.m_pbo) );
+		}
+
+		BX_FREE(g_allocator, m_swizzle);
+		m_swizzle     = NULL;
+		m_swizzleSize = 0;
+	}
+
+	ReadBackGL::Item* ReadBackGL::reserve(uint32_t _size)
+	{
+		while (0 == m_control.reserve(1) )
+		{
+			resolve(true);
+		}
+
+		Item& item = m_item[m_control.m_current];
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, item.m_pbo) );
+
+		if (item.m_pboSize < _size)
+		{
+			GL_CHECK(glBufferData(GL_PIXEL_PACK_BUFFER, _size, NULL, GL_STREAM_READ) );
+			item.m_pboSize = _size;
+		}
+
+		item.m_size = _size;
+
+		return &item;
+	}
+
+	void ReadBackGL::commit()
+	{
+		Item& item = m_item[m_control.m_current];
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+		item.m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_control.commit(1);
+	}
+
+	void ReadBackGL::readPixels(uint32_t _width, uint32_t _height, GLenum _fmt)
+	{
+		Item* item = reserve(_width*_height*4);
+		item->m_data    = NULL;
+		item->m_width   = _width;
+		item->m_height  = _height;
+		item->m_swizzle = GL_RGBA == _fmt;
+
+		GL_CHECK(glReadPixels(0
+			, 0
+			, _width
+			, _height
+			, _fmt
+			, GL_UNSIGNED_BYTE
+			, NULL
+			) );
+
+		commit();
+	}
+
+	void ReadBackGL::readTexture(const TextureGL& _texture, uint8_t _mip, void* _data)
+	{
+		const TextureFormat::Enum format = TextureFormat::Enum(_texture.m_textureFormat);
+		const ImageBlockInfo& blockInfo  = getBlockInfo(format);
+		const bool compressed = isCompressed(format);
+
+		const uint32_t width  = bx::uint32_max(1, _texture.m_width  >> _mip);
+		const uint32_t height = bx::uint32_max(1, _texture.m_height >> _mip);
+		const uint32_t depth  = bx::uint32_max(1, _texture.m_depth  >> _mip);
+
+		const uint32_t size = compressed
+			? ( (width +blockInfo.blockWidth -1)/blockInfo.blockWidth)
+			* ( (height+blockInfo.blockHeight-1)/blockInfo.blockHeight)
+			* blockInfo.blockSize
+			* depth
+			: width*height*depth*blockInfo.bitsPerPixel/8
+			;
+
+		Item* item = reserve(size);
+		item->m_data    = _data;
+		item->m_width   = width;
+		item->m_height  = height;
+		item->m_swizzle = false;
+
+		GL_CHECK(glBindTexture(_texture.m_target, _texture.m_id) );
+
+		if (compressed)
+		{
+			GL_CHECK(glGetCompressedTexImage(_texture.m_target
+				, _mip
+				, NULL
+				) );
+		}
+		else
+		{
+			GL_CHECK(glGetTexImage(_texture.m_target
+				, _mip
+				, _texture.m_fmt
+				, _texture.m_type
+				, NULL
+				) );
+		}
+
+		GL_CHECK(glBindTexture(_texture.m_target, 0) );
+
+		commit();
+		++m_numTextures;
+	}
+
+	void ReadBackGL::resolve(bool _wait)
+	{
+		while (0 != m_control.available() )
+		{
+			Item& item = m_item[m_control.m_read];
+
+			const GLenum result = glClientWaitSync(item.m_sync
+				, _wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0
+				, _wait ? UINT64_MAX : 0
+				);
+
+			if (GL_TIMEOUT_EXPIRED == result)
+			{
+				break;
+			}
+
+			BX_WARN(GL_WAIT_FAILED != result, "Waiting for readback fence failed.");
+
+			GL_CHECK(glDeleteSync(item.m_sync) );
+			item.m_sync = NULL;
+
+			GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, item.m_pbo) );
+			const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, item.m_size, GL_MAP_READ_BIT);
+
+			if (NULL != data)
+			{
+				if (NULL != item.m_data)
+				{
+					bx::memCopy(item.m_data, data, item.m_size);
+				}
+				else if (item.m_swizzle)
+				{
+					if (m_swizzleSize < item.m_size)
+					{
+						m_swizzle     = BX_REALLOC(g_allocator, m_swizzle, item.m_size);
+						m_swizzleSize = item.m_size;
+					}
+
+					imageSwizzleBgra8(m_swizzle, item.m_width, item.m_height, item.m_width*4, data);
+					g_callback->captureFrame(m_swizzle, item.m_size);
+				}
+				else
+				{
+					g_callback->captureFrame(data, item.m_size);
+				}
+
+				GL_CHECK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER) );
+			}
+
+			GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+			if (NULL != item.m_data)
+			{
+				--m_numTextures;
+			}
+
+			m_control.consume(1);
+		}
+	}
+
 	void RendererContextGL::submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter)
 	{
 		BGFX_GPU_PROFILER_BEGIN_DYNAMIC("rendererSubmit");
@@ -6195,6 +6452,7 @@ namespace bgfx { namespace gl
 		viewState.reset(_render, hmdEnabled);
 
 		uint16_t programIdx = invalidHandle;
+		bool viewUniformsChanged = false;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
@@ -6247,6 +6505,13 @@ namespace bgfx { namespace gl
 			m_occlusionQuery.resolve(_render);
 		}
 
+		if (m_asyncReadBackSupported)
+		{
+			// Texture reads issued last frame must be complete before this
+			// frame is done, frame captures are delivered when ready.
+			m_readBack.resolve(0 != m_readBack.m_numTextures);
+		}
+
 		uint8_t eye = 0;
 
 		if (0 == (_render->m_debug&BGFX_DEBUG_IFH) )
@@ -6269,7 +6534,7 @@ namespace bgfx { namespace gl
 					|| item == numItems
 					;
 
-				const RenderItem& renderItem = _render->m_renderItem[_render->m_sortValues[item] ];
+				const RenderItem& renderItem = _render->getRenderItem(_render->m_sortValues[item]);
 				++item;
 
 				if (viewChanged)
@@ -6284,6 +6549,7 @@ namespace bgfx { namespace gl
 					}
 
 					view = key.m_view;
+					viewUniformsChanged = rendererUpdateViewUniforms(this, _render, view);
 					programIdx = invalidHandle;
 
 					if (_render->m_fb[view].idx != fbh.idx)
@@ -6485,8 +6751,9 @@ namespace bgfx { namespace gl
 
 						if (0 != barrier)
 						{
-							bool constantsChanged = compute.m_constBegin < compute.m_constEnd;
-							rendererUpdateUniforms(this, _render->m_uniformBuffer, compute.m_constBegin, compute.m_constEnd);
+							bool constantsChanged = compute.m_constBegin < compute.m_constEnd || viewUniformsChanged;
+							rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_constBegin, compute.m_constEnd);
+							viewUniformsChanged = false;
 
 							if (constantsChanged
 							&&  NULL != program.m_constantBuffer)
@@ -6897,9 +7164,9 @@ namespace bgfx { namespace gl
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_constBegin < draw.m_constEnd;
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_constBegin, draw.m_constEnd) || viewUniformsChanged;
+				viewUniformsChanged = false;
 				bool bindAttribs = false;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
 
 				if (key.m_program != programIdx)
 				{
@@ -551,6 +551,34 @@ typedef uint64_t GLuint64;
 #	define GL_TIMESTAMP 0x8E28
 #endif // GL_TIMESTAMP
 
+#ifndef GL_PIXEL_PACK_BUFFER
+#	define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif // GL_PIXEL_PACK_BUFFER
+
+#ifndef GL_STREAM_READ
+#	define GL_STREAM_READ 0x88E1
+#endif // GL_STREAM_READ
+
+#ifndef GL_MAP_READ_BIT
+#	define GL_MAP_READ_BIT 0x0001
+#endif // GL_MAP_READ_BIT
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#	define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#	define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif // GL_SYNC_FLUSH_COMMANDS_BIT
+
+#ifndef GL_TIMEOUT_EXPIRED
+#	define GL_TIMEOUT_EXPIRED 0x911B
+#endif // GL_TIMEOUT_EXPIRED
+
+#ifndef GL_WAIT_FAILED
+#	define GL_WAIT_FAILED 0x911D
+#endif // GL_WAIT_FAILED
+
 #ifndef GL_VBO_FREE_MEMORY_ATI
 #	define GL_VBO_FREE_MEMORY_ATI 0x87FB
 #endif // GL_VBO_FREE_MEMORY_ATI
@@ -672,6 +700,10 @@ typedef uint64_t GLuint64;
 #	define GL_SAMPLER_2D_ARRAY_SHADOW 0x8DC4
 #endif // GL_SAMPLER_2D_ARRAY_SHADOW
 
+#ifndef GL_TEXTURE_BASE_LEVEL
+#	define GL_TEXTURE_BASE_LEVEL 0x813C
+#endif // GL_TEXTURE_BASE_LEVEL
+
 #ifndef GL_TEXTURE_MAX_LEVEL
 #	define GL_TEXTURE_MAX_LEVEL 0x813D
 #endif // GL_TEXTURE_MAX_LEVEL
@@ -1495,6 +1527,44 @@ namespace bgfx { namespace gl
 		bx::RingBufferControl m_control;
 	};
 
+	struct ReadBackGL
+	{
+		ReadBackGL()
+			: m_control(BX_COUNTOF(m_item) )
+			, m_swizzle(NULL)
+			, m_swizzleSize(0)
+			, m_numTextures(0)
+		{
+		}
+
+		void create();
+		void destroy();
+		void readPixels(uint32_t _width, uint32_t _height, GLenum _fmt);
+		void readTexture(const TextureGL& _texture, uint8_t _mip, void* _data);
+		void resolve(bool _wait = false);
+
+		struct Item
+		{
+			GLuint   m_pbo;
+			GLsync   m_sync;
+			uint32_t m_pboSize;
+			uint32_t m_size;
+			void*    m_data;
+			uint32_t m_width;
+			uint32_t m_height;
+			bool     m_swizzle;
+		};
+
+		Item* reserve(uint32_t _size);
+		void commit();
+
+		Item m_item[BGFX_CONFIG_MAX_READBACKS];
+		bx::RingBufferControl m_control;
+		void* m_swizzle;
+		uint32_t m_swizzleSize;
+		uint32_t m_numTextures;
+	};
+
 } /* namespace gl */ } // namespace bgfx
 
 #endif // BGFX_RENDERER_GL_H_HEADER_GUARD
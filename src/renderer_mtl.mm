@@ -811,6 +811,11 @@ namespace bgfx { namespace mtl
 
 		}
 
+		uint32_t getReadBackLatency() const BX_OVERRIDE
+		{
+			return 0;
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips) BX_OVERRIDE
 		{
 			TextureMtl& texture = m_textures[_handle.idx];
@@ -839,6 +844,10 @@ namespace bgfx { namespace mtl
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle /*_handle*/, uint8_t /*_lod*/) BX_OVERRIDE
+		{
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) BX_OVERRIDE
 		{
 			BX_UNUSED(_handle, _ptr);
@@ -1126,6 +1135,8 @@ namespace bgfx { namespace mtl
 				m_resolution = _resolution;
 				m_resolution.m_flags &= ~BGFX_RESET_INTERNAL_FORCE;
 
+				rendererInvalidateUniforms();
+
 				m_textureDescriptor.textureType = sampleCount > 1 ? MTLTextureType2DMultisample : MTLTextureType2D;
 
 				if (m_hasPixelFormatDepth32Float_Stencil8)
@@ -3029,6 +3040,7 @@ namespace bgfx { namespace mtl
 		bool wireframe = !!(_render->m_debug&BGFX_DEBUG_WIREFRAME);
 
 		uint16_t programIdx = invalidHandle;
+		bool viewUniformsChanged = false;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
@@ -3077,7 +3089,7 @@ namespace bgfx { namespace mtl
 					|| key.m_view != view
 					|| item == numItems
 					;
-				const RenderItem& renderItem = _render->m_renderItem[_render->m_sortValues[item] ];
+				const RenderItem& renderItem = _render->getRenderItem(_render->m_sortValues[item]);
 				++item;
 
 				if (viewChanged)
@@ -3092,6 +3104,7 @@ namespace bgfx { namespace mtl
 					}
 
 					view = key.m_view;
+					viewUniformsChanged = rendererUpdateViewUniforms(this, _render, view);
 					programIdx = invalidHandle;
 
 					viewRestart = ( (BGFX_VIEW_STEREO == (_render->m_viewFlags[view] & BGFX_VIEW_STEREO) ) );
@@ -3477,8 +3490,8 @@ namespace bgfx { namespace mtl
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_constBegin < draw.m_constEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_constBegin, draw.m_constEnd) || viewUniformsChanged;
+				viewUniformsChanged = false;
 
 				if (key.m_program != programIdx
 				|| (BGFX_STATE_BLEND_MASK|BGFX_STATE_BLEND_EQUATION_MASK|BGFX_STATE_ALPHA_WRITE|BGFX_STATE_RGB_WRITE|BGFX_STATE_BLEND_INDEPENDENT|BGFX_STATE_MSAA|BGFX_STATE_BLEND_ALPHA_TO_COVERAGE) & changedFlags
@@ -144,6 +144,15 @@ namespace bgfx { namespace noop
 		{
 		}
 
+		void setTextureMinLod(TextureHandle /*_handle*/, uint8_t /*_lod*/) BX_OVERRIDE
+		{
+		}
+
+		uint32_t getReadBackLatency() const BX_OVERRIDE
+		{
+			return 0;
+		}
+
 		void overrideInternal(TextureHandle /*_handle*/, uintptr_t /*_ptr*/) BX_OVERRIDE
 		{
 		}
@@ -1754,10 +1754,11 @@ VK_IMPORT_DEVICE
 
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 			{
-				m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS*1024
+				m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS*1024
 					, 1024 //BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
 					);
 			}
+			g_caps.limits.maxDrawCalls = bx::uint32_min(g_caps.limits.maxDrawCalls, BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS);
 
 			errorState = ErrorState::DescriptorCreated;
 
@@ -2052,6 +2053,15 @@ VK_IMPORT_DEVICE
 		{
 		}
 
+		void setTextureMinLod(TextureHandle /*_handle*/, uint8_t /*_lod*/) BX_OVERRIDE
+		{
+		}
+
+		uint32_t getReadBackLatency() const BX_OVERRIDE
+		{
+			return 0;
+		}
+
 		void overrideInternal(TextureHandle /*_handle*/, uintptr_t /*_ptr*/) BX_OVERRIDE
 		{
 		}
@@ -2163,6 +2173,8 @@ VK_IMPORT_DEVICE
 				m_textVideoMem.resize(false, _resolution.m_width, _resolution.m_height);
 				m_textVideoMem.clear();
 
+				rendererInvalidateUniforms();
+
 #if 1
 				BX_UNUSED(resize);
 #else
@@ -3649,6 +3661,7 @@ VK_DESTROY
 
 		uint16_t currentSamplerStateIdx = invalidHandle;
 		uint16_t currentProgramIdx      = invalidHandle;
+		bool     viewUniformsChanged    = false;
 		uint32_t currentBindHash        = 0;
 		bool     hasPredefined          = false;
 		bool     commandListChanged     = false;
@@ -3748,7 +3761,7 @@ VK_DESTROY
 					|| item == numItems
 					;
 
-				const RenderItem& renderItem = _render->m_renderItem[_render->m_sortValues[item] ];
+				const RenderItem& renderItem = _render->getRenderItem(_render->m_sortValues[item]);
 				++item;
 
 				if (viewChanged)
@@ -3767,6 +3780,7 @@ VK_DESTROY
 finishAll();
 
 					view = key.m_view;
+					viewUniformsChanged = rendererUpdateViewUniforms(this, _render, view);
 					currentPipeline = VK_NULL_HANDLE;
 					currentSamplerStateIdx = invalidHandle;
 BX_UNUSED(currentSamplerStateIdx);
@@ -4003,12 +4017,12 @@ BX_UNUSED(currentSamplerStateIdx);
 //						}
 //					}
 
-					bool constantsChanged = false;
-					if (compute.m_constBegin < compute.m_constEnd
+					bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_constBegin, compute.m_constEnd) || viewUniformsChanged;
+					viewUniformsChanged = false;
+
+					if (constantsChanged
 					||  currentProgramIdx != key.m_program)
 					{
-						rendererUpdateUniforms(this, _render->m_uniformBuffer, compute.m_constBegin, compute.m_constEnd);
-
 						currentProgramIdx = key.m_program;
 						ProgramVK& program = m_program[currentProgramIdx];
 
@@ -4119,7 +4133,8 @@ BX_UNUSED(currentSamplerStateIdx);
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
 				}
 
-				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
+				const bool uniformsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_constBegin, draw.m_constEnd) || viewUniformsChanged;
+				viewUniformsChanged = false;
 
 				if (isValid(draw.m_stream[0].m_handle) )
 				{
@@ -4290,7 +4305,7 @@ BX_UNUSED(currentSamplerStateIdx);
 					}
 
 					bool constantsChanged = false;
-					if (draw.m_constBegin < draw.m_constEnd
+					if (uniformsChanged
 					||  currentProgramIdx != key.m_program
 					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
 					{
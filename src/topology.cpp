@@ -4,9 +4,13 @@
  */
 
 #include <bx/allocator.h>
+#include <bx/cpu.h>
 #include <bx/debug.h>
 #include <bx/fpumath.h>
+#include <bx/mutex.h>
 #include <bx/sort.h>
+#include <bx/string.h>
+#include <bx/thread.h>
 #include <bx/uint32_t.h>
 
 #include "config.h"
@@ -167,6 +171,95 @@ namespace bgfx
 		return uint32_t(dst - (IndexT*)_dst);
 	}
 
+	template<typename IndexT, typename SortT>
+	static void topologySortEdges(SortT* _keys, uint32_t* _values, const IndexT* _indices, uint32_t _numIndices, SortT* _tempKeys, uint32_t* _tempValues)
+	{
+		// Directed edge key is (i0, i1), value is position of i0 in index
+		// buffer. Triangle is value/3, and opposite vertex of edge is next
+		// after i1.
+		const uint32_t shift = sizeof(IndexT)*8;
+		for (uint32_t ii = 0; ii < _numIndices; ii += 3)
+		{
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				const SortT i0 = _indices[ii+jj];
+				const SortT i1 = _indices[ii+(jj+1)%3];
+				_keys[ii+jj]   = (i0<<shift) | i1;
+				_values[ii+jj] = ii+jj;
+			}
+		}
+
+		bx::radixSort(_keys, _tempKeys, _values, _tempValues, _numIndices);
+	}
+
+	template<typename SortT>
+	static uint32_t topologyFindEdge(const SortT* _keys, uint32_t _num, SortT _key)
+	{
+		uint32_t lo = 0;
+		uint32_t hi = _num;
+		while (lo < hi)
+		{
+			const uint32_t mid = (lo+hi)/2;
+			if (_keys[mid] < _key)
+			{
+				lo = mid+1;
+			}
+			else
+			{
+				hi = mid;
+			}
+		}
+
+		return lo < _num && _keys[lo] == _key ? lo : UINT32_MAX;
+	}
+
+	inline uint32_t oppositeIndex(uint32_t _edge)
+	{
+		return _edge/3*3 + (_edge+2)%3;
+	}
+
+	template<typename IndexT, typename SortT>
+	static uint32_t topologyConvertTriListToTriListAdj(void* _dst, uint32_t _dstSize, const IndexT* _indices, uint32_t _numIndices, bx::AllocatorI* _allocator)
+	{
+		if (NULL == _dst)
+		{
+			return _numIndices*2;
+		}
+
+		SortT*    keys       = (SortT*)BX_ALLOC(_allocator, _numIndices*(sizeof(SortT)+sizeof(uint32_t) )*2);
+		SortT*    tempKeys   = &keys[_numIndices];
+		uint32_t* values     = (uint32_t*)&tempKeys[_numIndices];
+		uint32_t* tempValues = &values[_numIndices];
+		topologySortEdges(keys, values, _indices, _numIndices, tempKeys, tempValues);
+
+		const uint32_t shift = sizeof(IndexT)*8;
+
+		IndexT* dst = (IndexT*)_dst;
+		IndexT* end = &dst[_dstSize/sizeof(IndexT)];
+		for (uint32_t ii = 0; ii < _numIndices && dst+6 <= end; ii += 3, dst += 6)
+		{
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				const IndexT i0 = _indices[ii+jj];
+				const IndexT i1 = _indices[ii+(jj+1)%3];
+
+				// Triangle sharing edge has it in reverse order. On open edge
+				// use opposite vertex of the same triangle.
+				const uint32_t edge = topologyFindEdge(keys, _numIndices, SortT( (SortT(i1)<<shift) | i0) );
+
+				dst[jj*2+0] = i0;
+				dst[jj*2+1] = UINT32_MAX == edge
+					? _indices[ii+(jj+2)%3]
+					: _indices[oppositeIndex(values[edge])]
+					;
+			}
+		}
+
+		BX_FREE(_allocator, keys);
+
+		return uint32_t(dst - (IndexT*)_dst);
+	}
+
 	uint32_t topologyConvert(
 		  TopologyConvert::Enum _conversion
 		, void* _dst
@@ -208,6 +301,19 @@ namespace bgfx
 
 			return topologyConvertTriListToLineList<uint16_t, uint32_t>(_dst, _dstSize, (const uint16_t*)_indices, _numIndices, _allocator);
 
+		case TopologyConvert::TriListToTriListAdj:
+			if (NULL == _allocator)
+			{
+				return 0;
+			}
+
+			if (_index32)
+			{
+				return topologyConvertTriListToTriListAdj<uint32_t, uint64_t>(_dst, _dstSize, (const uint32_t*)_indices, _numIndices, _allocator);
+			}
+
+			return topologyConvertTriListToTriListAdj<uint16_t, uint32_t>(_dst, _dstSize, (const uint16_t*)_indices, _numIndices, _allocator);
+
 		case TopologyConvert::LineStripToLineList:
 			if (_index32)
 			{
@@ -267,10 +373,13 @@ namespace bgfx
 		, const void* __restrict _vertices
 		, uint32_t _stride
 		, const IndexT* _indices
+		, uint32_t _first
 		, uint32_t _num
 		)
 	{
-		for (uint32_t ii = 0; ii < _num; ++ii)
+		_indices += _first*3;
+
+		for (uint32_t ii = _first, end = _first+_num; ii < end; ++ii)
 		{
 			const uint32_t idx0 = _indices[0];
 			const uint32_t idx1 = _indices[1];
@@ -290,19 +399,17 @@ namespace bgfx
 	}
 
 	template<typename IndexT>
-	void topologySortTriList(
-		  TopologySort::Enum  _sort
-		, IndexT* _dst
+	static void calcSortKeys(
+		  TopologySort::Enum _sort
 		, uint32_t* _keys
 		, uint32_t* _values
-		, uint32_t* _tempKeys
-		, uint32_t* _tempValues
-		, uint32_t  _num
 		, const float _dir[3]
 		, const float _pos[3]
 		, const void* _vertices
-		, uint32_t    _stride
+		, uint32_t _stride
 		, const IndexT* _indices
+		, uint32_t _first
+		, uint32_t _num
 		)
 	{
 		using namespace bx;
@@ -310,27 +417,29 @@ namespace bgfx
 		switch (_sort)
 		{
 		default:
-		case TopologySort::DirectionFrontToBackMin: calcSortKeys<IndexT, distanceDir, fmin3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionFrontToBackAvg: calcSortKeys<IndexT, distanceDir, favg3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionFrontToBackMax: calcSortKeys<IndexT, distanceDir, fmax3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontMin: calcSortKeys<IndexT, distanceDir, fmin3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontAvg: calcSortKeys<IndexT, distanceDir, favg3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontMax: calcSortKeys<IndexT, distanceDir, fmax3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackMin:  calcSortKeys<IndexT, distancePos, fmin3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackAvg:  calcSortKeys<IndexT, distancePos, favg3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackMax:  calcSortKeys<IndexT, distancePos, fmax3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontMin:  calcSortKeys<IndexT, distancePos, fmin3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontAvg:  calcSortKeys<IndexT, distancePos, favg3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontMax:  calcSortKeys<IndexT, distancePos, fmax3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		}
-
-		radixSort(_keys, _tempKeys, _values, _tempValues, _num);
+		case TopologySort::DirectionFrontToBackMin: calcSortKeys<IndexT, distanceDir, fmin3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DirectionFrontToBackAvg: calcSortKeys<IndexT, distanceDir, favg3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DirectionFrontToBackMax: calcSortKeys<IndexT, distanceDir, fmax3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DirectionBackToFrontMin: calcSortKeys<IndexT, distanceDir, fmin3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DirectionBackToFrontAvg: calcSortKeys<IndexT, distanceDir, favg3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DirectionBackToFrontMax: calcSortKeys<IndexT, distanceDir, fmax3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DistanceFrontToBackMin:  calcSortKeys<IndexT, distancePos, fmin3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DistanceFrontToBackAvg:  calcSortKeys<IndexT, distancePos, favg3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DistanceFrontToBackMax:  calcSortKeys<IndexT, distancePos, fmax3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DistanceBackToFrontMin:  calcSortKeys<IndexT, distancePos, fmin3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DistanceBackToFrontAvg:  calcSortKeys<IndexT, distancePos, favg3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _first, _num); break;
+		case TopologySort::DistanceBackToFrontMax:  calcSortKeys<IndexT, distancePos, fmax3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _first, _num); break;
+		}
+	}
 
+	template<typename IndexT>
+	static void writeSortedTriList(IndexT* _dst, const uint32_t* _order, const IndexT* _indices, uint32_t _num)
+	{
 		IndexT* sorted = _dst;
 
 		for (uint32_t ii = 0; ii < _num; ++ii)
 		{
-			uint32_t face = _values[ii]*3;
+			uint32_t face = _order[ii]*3;
 			const IndexT idx0 = _indices[face+0];
 			const IndexT idx1 = _indices[face+1];
 			const IndexT idx2 = _indices[face+2];
@@ -342,6 +451,29 @@ namespace bgfx
 		}
 	}
 
+	template<typename IndexT>
+	void topologySortTriList(
+		  TopologySort::Enum  _sort
+		, IndexT* _dst
+		, uint32_t* _keys
+		, uint32_t* _values
+		, uint32_t* _tempKeys
+		, uint32_t* _tempValues
+		, uint32_t  _num
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t    _stride
+		, const IndexT* _indices
+		)
+	{
+		calcSortKeys(_sort, _keys, _values, _dir, _pos, _vertices, _stride, _indices, 0, _num);
+
+		bx::radixSort(_keys, _tempKeys, _values, _tempValues, _num);
+
+		writeSortedTriList(_dst, _values, _indices, _num);
+	}
+
 	void topologySortTriList(
 		  TopologySort::Enum  _sort
 		, void*       _dst
@@ -406,4 +538,2090 @@ namespace bgfx
 		BX_FREE(_allocator, temp);
 	}
 
+	static const uint32_t s_sortCoherentMaxDescents = 32; // Full sort when more than 1/32 of triangles are out of order.
+	static const uint32_t s_sortCoherentMaxMoves    = 8;  // Full sort when insertion moves triangles more than 8 times on average.
+
+	struct SortKeysJob
+	{
+		TopologySort::Enum sort;
+		uint32_t* keys;
+		uint32_t* values;
+		const float* dir;
+		const float* pos;
+		const void* vertices;
+		uint32_t stride;
+		const void* indices;
+		bool index32;
+		uint32_t begin;
+		uint32_t end;
+	};
+
+	static void calcSortKeys(const SortKeysJob& _job)
+	{
+		if (_job.index32)
+		{
+			calcSortKeys(_job.sort, _job.keys, _job.values, _job.dir, _job.pos, _job.vertices, _job.stride, (const uint32_t*)_job.indices, _job.begin, _job.end - _job.begin);
+		}
+		else
+		{
+			calcSortKeys(_job.sort, _job.keys, _job.values, _job.dir, _job.pos, _job.vertices, _job.stride, (const uint16_t*)_job.indices, _job.begin, _job.end - _job.begin);
+		}
+	}
+
+#if BX_CONFIG_SUPPORTS_THREADING && BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS > 0
+	// Worker threads are started on first multithreaded call, and kept
+	// waiting for jobs until process exit, so sorting every frame doesn't
+	// pay for thread creation.
+	struct SortKeysWorkers
+	{
+		SortKeysWorkers()
+			: m_job(NULL)
+			, m_numThreads(0)
+			, m_next(0)
+			, m_exit(false)
+		{
+		}
+
+		~SortKeysWorkers()
+		{
+			m_exit = true;
+
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_sem.post();
+			}
+
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+		}
+
+		void run(const SortKeysJob* _job, uint32_t _num)
+		{
+			// Workers are shared, calls from different threads run one after
+			// another.
+			bx::MutexScope scope(m_mutex);
+
+			for (; m_numThreads < _num-1; ++m_numThreads)
+			{
+				m_thread[m_numThreads].init(threadFunc, this, 0, "bgfx - topology sort thread");
+			}
+
+			m_job  = _job;
+			m_next = 1;
+
+			for (uint32_t ii = 1; ii < _num; ++ii)
+			{
+				m_sem.post();
+			}
+
+			calcSortKeys(_job[0]);
+
+			for (uint32_t ii = 1; ii < _num; ++ii)
+			{
+				m_doneSem.wait();
+			}
+
+			m_job = NULL;
+		}
+
+		static int32_t threadFunc(void* _userData)
+		{
+			SortKeysWorkers* workers = (SortKeysWorkers*)_userData;
+
+			for (;;)
+			{
+				workers->m_sem.wait();
+
+				if (workers->m_exit)
+				{
+					break;
+				}
+
+				const uint32_t idx = bx::atomicFetchAndAdd(&workers->m_next, 1u);
+				calcSortKeys(workers->m_job[idx]);
+				workers->m_doneSem.post();
+			}
+
+			return 0;
+		}
+
+		bx::Thread    m_thread[BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS];
+		bx::Semaphore m_sem;
+		bx::Semaphore m_doneSem;
+		bx::Mutex     m_mutex;
+		const SortKeysJob* m_job;
+		uint32_t m_numThreads;
+		volatile uint32_t m_next;
+		volatile bool m_exit;
+	};
+
+	static SortKeysWorkers s_sortKeysWorkers;
+#endif // BX_CONFIG_SUPPORTS_THREADING && BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS > 0
+
+	static void calcSortKeys(
+		  TopologySort::Enum _sort
+		, uint32_t* _keys
+		, uint32_t* _values
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, bool _index32
+		, uint32_t _num
+		, bool _multithreaded
+		)
+	{
+		uint32_t numThreads = 1;
+#if BX_CONFIG_SUPPORTS_THREADING && BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS > 0
+		if (_multithreaded)
+		{
+			numThreads = bx::uint32_clamp(_num/BGFX_CONFIG_TOPOLOGY_SORT_MIN_TRIANGLES_PER_THREAD, 1, BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS+1);
+		}
+#else
+		BX_UNUSED(_multithreaded);
+#endif // BX_CONFIG_SUPPORTS_THREADING && BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS > 0
+
+		SortKeysJob job[BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS+1];
+
+		const uint32_t numPerThread = (_num + numThreads - 1)/numThreads;
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			SortKeysJob& sortKeys = job[ii];
+			sortKeys.sort     = _sort;
+			sortKeys.keys     = _keys;
+			sortKeys.values   = _values;
+			sortKeys.dir      = _dir;
+			sortKeys.pos      = _pos;
+			sortKeys.vertices = _vertices;
+			sortKeys.stride   = _stride;
+			sortKeys.indices  = _indices;
+			sortKeys.index32  = _index32;
+			sortKeys.begin    = bx::uint32_min(ii*numPerThread, _num);
+			sortKeys.end      = bx::uint32_min(sortKeys.begin+numPerThread, _num);
+		}
+
+#if BX_CONFIG_SUPPORTS_THREADING && BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS > 0
+		if (1 < numThreads)
+		{
+			s_sortKeysWorkers.run(job, numThreads);
+			return;
+		}
+#endif // BX_CONFIG_SUPPORTS_THREADING && BGFX_CONFIG_TOPOLOGY_SORT_NUM_THREADS > 0
+
+		calcSortKeys(job[0]);
+	}
+
+	// Refines triangle order from previous call with insertion sort, which
+	// is close to linear when camera moves only a little between calls.
+	// Returns false when order is too far from sorted, and full sort is
+	// cheaper.
+	static bool refineSortOrder(uint32_t* _order, uint32_t* _orderKeys, const uint32_t* _keys, uint32_t _num)
+	{
+		uint32_t numDescents = 0;
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const uint32_t tri = _order[ii];
+			BX_CHECK(tri < _num, "Invalid triangle order %d (num triangles %d).", tri, _num);
+			if (tri >= _num)
+			{
+				return false;
+			}
+
+			_orderKeys[ii] = _keys[tri];
+			numDescents += 0 < ii && _orderKeys[ii] < _orderKeys[ii-1];
+		}
+
+		if (numDescents > _num/s_sortCoherentMaxDescents)
+		{
+			return false;
+		}
+
+		uint32_t budget = _num*s_sortCoherentMaxMoves;
+
+		for (uint32_t ii = 1; ii < _num; ++ii)
+		{
+			const uint32_t key = _orderKeys[ii];
+			const uint32_t tri = _order[ii];
+
+			uint32_t jj = ii;
+			for (; 0 < jj && _orderKeys[jj-1] > key && 0 < budget; --jj, --budget)
+			{
+				_orderKeys[jj] = _orderKeys[jj-1];
+				_order[jj]     = _order[jj-1];
+			}
+
+			_orderKeys[jj] = key;
+			_order[jj]     = tri;
+
+			if (0 == budget)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void topologySortTriListCoherent(
+		  TopologySort::Enum  _sort
+		, void*       _dst
+		, uint32_t    _dstSize
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t    _stride
+		, const void* _indices
+		, uint32_t    _numIndices
+		, bool        _index32
+		, uint32_t*   _order
+		, bool        _multithreaded
+		, bx::AllocatorI* _allocator
+		)
+	{
+		uint32_t indexSize = _index32
+			? sizeof(uint32_t)
+			: sizeof(uint16_t)
+			;
+		uint32_t num = bx::uint32_min(_numIndices*indexSize, _dstSize)/(indexSize*3);
+
+		if (0 == num)
+		{
+			return;
+		}
+
+		uint32_t* temp = (uint32_t*)BX_ALLOC(_allocator, sizeof(uint32_t)*num*4);
+
+		uint32_t* keys       = &temp[num*0];
+		uint32_t* values     = &temp[num*1];
+		uint32_t* tempKeys   = &temp[num*2];
+		uint32_t* tempValues = &temp[num*3];
+
+		calcSortKeys(_sort, keys, values, _dir, _pos, _vertices, _stride, _indices, _index32, num, _multithreaded);
+
+		if (UINT32_MAX == _order[0]
+		||  !refineSortOrder(_order, tempKeys, keys, num) )
+		{
+			bx::radixSort(keys, tempKeys, values, tempValues, num);
+			bx::memCopy(_order, values, num*sizeof(uint32_t) );
+		}
+
+		if (_index32)
+		{
+			writeSortedTriList( (uint32_t*)_dst, _order, (const uint32_t*)_indices, num);
+		}
+		else
+		{
+			writeSortedTriList( (uint16_t*)_dst, _order, (const uint16_t*)_indices, num);
+		}
+
+		BX_FREE(_allocator, temp);
+	}
+
+	static const uint32_t s_vertexCacheSize    = 32;
+	static const uint32_t s_vertexCacheValence = 32;
+	static const uint32_t s_overdrawCacheSize  = 16;
+	static const float    s_overdrawThreshold  = 1.05f;
+
+	template<typename IndexT>
+	static void copyIndices(uint32_t* _dst, const IndexT* _indices, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			_dst[ii] = _indices[ii];
+		}
+	}
+
+	template<typename IndexT>
+	static uint32_t writeIndices(void* _dst, uint32_t _dstSize, const uint32_t* _indices, uint32_t _num)
+	{
+		IndexT* dst = (IndexT*)_dst;
+		const uint32_t num = bx::uint32_min(_num, _dstSize/sizeof(IndexT)/3*3);
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			dst[ii] = IndexT(_indices[ii]);
+		}
+
+		return num;
+	}
+
+	inline float vertexCacheScore(
+		  const float* _cacheScore
+		, const float* _valenceScore
+		, uint32_t _cachePos
+		, uint32_t _numActive
+		)
+	{
+		if (0 == _numActive)
+		{
+			return -1.0f;
+		}
+
+		const float score = _cachePos < s_vertexCacheSize ? _cacheScore[_cachePos] : 0.0f;
+		return score + _valenceScore[bx::uint32_min(_numActive, s_vertexCacheValence-1)];
+	}
+
+	// Linear-Speed Vertex Cache Optimisation, Tom Forsyth 2006.
+	static void topologyOptimizeVertexCache(
+		  uint32_t* _dst
+		, const uint32_t* _indices
+		, uint32_t _numIndices
+		, uint32_t _numVertices
+		, bx::AllocatorI* _allocator
+		)
+	{
+		const uint32_t numTris = _numIndices/3;
+
+		float cacheScore[s_vertexCacheSize];
+		for (uint32_t ii = 0; ii < s_vertexCacheSize; ++ii)
+		{
+			cacheScore[ii] = ii < 3
+				? 0.75f
+				: bx::fpow(1.0f - float(ii-3)/float(s_vertexCacheSize-3), 1.5f)
+				;
+		}
+
+		float valenceScore[s_vertexCacheValence];
+		valenceScore[0] = 0.0f;
+		for (uint32_t ii = 1; ii < s_vertexCacheValence; ++ii)
+		{
+			valenceScore[ii] = 2.0f * bx::fpow(float(ii), -0.5f);
+		}
+
+		uint8_t* temp = (uint8_t*)BX_ALLOC(_allocator, 0
+			+ _numVertices*sizeof(uint32_t)*3
+			+ _numVertices*sizeof(float)
+			+ _numIndices*sizeof(uint32_t)
+			+ numTris
+			);
+		uint32_t* numActive   = (uint32_t*)temp;
+		uint32_t* offset      = &numActive[_numVertices];
+		uint32_t* cachePos    = &offset[_numVertices];
+		float*    vertexScore = (float*)&cachePos[_numVertices];
+		uint32_t* adjacency   = (uint32_t*)&vertexScore[_numVertices];
+		uint8_t*  emitted     = (uint8_t*)&adjacency[_numIndices];
+
+		bx::memSet(numActive, 0, _numVertices*sizeof(uint32_t) );
+		bx::memSet(emitted, 0, numTris);
+
+		for (uint32_t ii = 0, num = numTris*3; ii < num; ++ii)
+		{
+			BX_CHECK(_indices[ii] < _numVertices, "Index %d is out of range (num vertices %d).", _indices[ii], _numVertices);
+			++numActive[_indices[ii] ];
+		}
+
+		for (uint32_t ii = 0, sum = 0; ii < _numVertices; ++ii)
+		{
+			offset[ii]   = sum;
+			sum         += numActive[ii];
+			numActive[ii] = 0;
+			cachePos[ii]  = UINT32_MAX;
+		}
+
+		for (uint32_t ii = 0; ii < numTris; ++ii)
+		{
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				const uint32_t idx = _indices[ii*3+jj];
+				adjacency[offset[idx] + numActive[idx] ] = ii;
+				++numActive[idx];
+			}
+		}
+
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			vertexScore[ii] = vertexCacheScore(cacheScore, valenceScore, cachePos[ii], numActive[ii]);
+		}
+
+		uint32_t bestTri = UINT32_MAX;
+		float    best    = -1.0f;
+		for (uint32_t ii = 0; ii < numTris; ++ii)
+		{
+			const uint32_t* tri = &_indices[ii*3];
+			const float score = vertexScore[tri[0] ] + vertexScore[tri[1] ] + vertexScore[tri[2] ];
+			if (score > best)
+			{
+				best    = score;
+				bestTri = ii;
+			}
+		}
+
+		uint32_t cache[s_vertexCacheSize+3];
+		uint32_t numCache = 0;
+		uint32_t next     = 0;
+
+		for (uint32_t out = 0; out < numTris; ++out)
+		{
+			if (UINT32_MAX == bestTri)
+			{
+				// Nothing in cache has active triangles left, continue with
+				// first triangle that wasn't emitted yet.
+				for (; emitted[next]; ++next) {}
+				bestTri = next;
+			}
+
+			const uint32_t* tri = &_indices[bestTri*3];
+			emitted[bestTri] = 1;
+
+			_dst[out*3+0] = tri[0];
+			_dst[out*3+1] = tri[1];
+			_dst[out*3+2] = tri[2];
+
+			uint32_t newCache[s_vertexCacheSize+3];
+			uint32_t numNewCache = 0;
+
+			for (uint32_t ii = 0; ii < 3; ++ii)
+			{
+				const uint32_t idx = tri[ii];
+
+				uint32_t* list = &adjacency[offset[idx] ];
+				for (uint32_t jj = 0, num = numActive[idx]; jj < num; ++jj)
+				{
+					if (list[jj] == bestTri)
+					{
+						list[jj] = list[num-1];
+						--numActive[idx];
+						break;
+					}
+				}
+
+				bool found = false;
+				for (uint32_t jj = 0; jj < numNewCache && !found; ++jj)
+				{
+					found = newCache[jj] == idx;
+				}
+
+				if (!found)
+				{
+					newCache[numNewCache++] = idx;
+				}
+			}
+
+			for (uint32_t ii = 0; ii < numCache; ++ii)
+			{
+				const uint32_t idx = cache[ii];
+				if (idx != tri[0]
+				&&  idx != tri[1]
+				&&  idx != tri[2])
+				{
+					newCache[numNewCache++] = idx;
+				}
+			}
+
+			for (uint32_t ii = 0; ii < numNewCache; ++ii)
+			{
+				const uint32_t idx = newCache[ii];
+				cachePos[idx]    = ii < s_vertexCacheSize ? ii : UINT32_MAX;
+				vertexScore[idx] = vertexCacheScore(cacheScore, valenceScore, cachePos[idx], numActive[idx]);
+			}
+
+			numCache = bx::uint32_min(numNewCache, s_vertexCacheSize);
+			bx::memCopy(cache, newCache, numCache*sizeof(uint32_t) );
+
+			// Only triangles touching vertices that moved in cache changed
+			// score, pick next triangle from those.
+			bestTri = UINT32_MAX;
+			best    = -1.0f;
+			for (uint32_t ii = 0; ii < numNewCache; ++ii)
+			{
+				const uint32_t  idx  = newCache[ii];
+				const uint32_t* list = &adjacency[offset[idx] ];
+				for (uint32_t jj = 0, num = numActive[idx]; jj < num; ++jj)
+				{
+					const uint32_t  face = list[jj];
+					const uint32_t* ftri = &_indices[face*3];
+					const float score = vertexScore[ftri[0] ] + vertexScore[ftri[1] ] + vertexScore[ftri[2] ];
+					if (score > best)
+					{
+						best    = score;
+						bestTri = face;
+					}
+				}
+			}
+		}
+
+		BX_FREE(_allocator, temp);
+	}
+
+	inline uint32_t vertexCacheMiss(uint32_t* _timestamps, uint32_t& _time, uint32_t _cacheSize, uint32_t _index)
+	{
+		// FIFO cache, vertex is in cache if it was transformed within last
+		// _cacheSize transforms.
+		if (_time - _timestamps[_index] > _cacheSize)
+		{
+			_timestamps[_index] = _time++;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	inline uint32_t vertexCacheMiss(uint32_t* _timestamps, uint32_t& _time, uint32_t _cacheSize, const uint32_t* _tri)
+	{
+		return 0
+			+ vertexCacheMiss(_timestamps, _time, _cacheSize, _tri[0])
+			+ vertexCacheMiss(_timestamps, _time, _cacheSize, _tri[1])
+			+ vertexCacheMiss(_timestamps, _time, _cacheSize, _tri[2])
+			;
+	}
+
+	// Fast Triangle Reordering for Vertex Locality and Reduced Overdraw,
+	// Sander, Nehab, Barczak 2007.
+	static void topologyOptimizeOverdraw(
+		  uint32_t* _dst
+		, const uint32_t* _indices
+		, uint32_t _numIndices
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, float _threshold
+		, bx::AllocatorI* _allocator
+		)
+	{
+		const uint32_t numTris = _numIndices/3;
+
+		uint32_t* temp = (uint32_t*)BX_ALLOC(_allocator, sizeof(uint32_t)*(_numVertices + (numTris+1)*6) );
+		uint32_t* timestamps = temp;
+		uint32_t* hard       = &timestamps[_numVertices];
+		uint32_t* soft       = &hard[numTris+1];
+		uint32_t* keys       = &soft[numTris+1];
+		uint32_t* values     = &keys[numTris+1];
+		uint32_t* tempKeys   = &values[numTris+1];
+		uint32_t* tempValues = &tempKeys[numTris+1];
+
+		bx::memSet(timestamps, 0, _numVertices*sizeof(uint32_t) );
+
+		const uint32_t cacheSize = s_overdrawCacheSize;
+		uint32_t time = cacheSize+1;
+
+		// Input is vertex cache optimized, and cache is flushed where all
+		// three vertices of triangle miss. Those are hard cluster boundaries.
+		uint32_t numHard = 0;
+		for (uint32_t ii = 0; ii < numTris; ++ii)
+		{
+			const uint32_t misses = vertexCacheMiss(timestamps, time, cacheSize, &_indices[ii*3]);
+			if (0 == ii
+			||  3 == misses)
+			{
+				hard[numHard++] = ii;
+			}
+		}
+		hard[numHard] = numTris;
+
+		// Split hard clusters further as long as splitting doesn't degrade
+		// cluster ACMR more than threshold.
+		uint32_t numSoft = 0;
+		for (uint32_t ii = 0; ii < numHard; ++ii)
+		{
+			const uint32_t start = hard[ii];
+			const uint32_t end   = hard[ii+1];
+
+			time += cacheSize+1;
+			uint32_t misses = 0;
+			for (uint32_t jj = start; jj < end; ++jj)
+			{
+				misses += vertexCacheMiss(timestamps, time, cacheSize, &_indices[jj*3]);
+			}
+
+			const float threshold = float(misses)/float(end-start) * _threshold;
+
+			time += cacheSize+1;
+			misses = 0;
+			soft[numSoft++] = start;
+
+			for (uint32_t jj = start, first = start; jj < end; ++jj)
+			{
+				misses += vertexCacheMiss(timestamps, time, cacheSize, &_indices[jj*3]);
+
+				if (jj+1 < end
+				&&  float(misses) <= threshold*float(jj+1-first) )
+				{
+					soft[numSoft++] = jj+1;
+					first  = jj+1;
+					misses = 0;
+					time  += cacheSize+1;
+				}
+			}
+		}
+		soft[numSoft] = numTris;
+
+		// Cluster sort key is how much cluster faces away from mesh centroid.
+		// Clusters on the outside of the mesh are drawn first, since they're
+		// likely to occlude the rest.
+		float* clusters = (float*)BX_ALLOC(_allocator, sizeof(float)*7*numSoft);
+
+		float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+		float meshArea = 0.0f;
+
+		for (uint32_t ii = 0; ii < numSoft; ++ii)
+		{
+			float* cluster = &clusters[ii*7];
+			bx::memSet(cluster, 0, sizeof(float)*7);
+
+			for (uint32_t jj = soft[ii], end = soft[ii+1]; jj < end; ++jj)
+			{
+				const uint32_t* tri = &_indices[jj*3];
+				const float* pos0 = vertexPos(_vertices, _stride, tri[0]);
+				const float* pos1 = vertexPos(_vertices, _stride, tri[1]);
+				const float* pos2 = vertexPos(_vertices, _stride, tri[2]);
+
+				float edge0[3];
+				float edge1[3];
+				float normal[3];
+				bx::vec3Sub(edge0, pos1, pos0);
+				bx::vec3Sub(edge1, pos2, pos0);
+				bx::vec3Cross(normal, edge0, edge1);
+
+				const float area = bx::fsqrt(bx::vec3Dot(normal, normal) );
+
+				for (uint32_t kk = 0; kk < 3; ++kk)
+				{
+					cluster[kk+0] += (pos0[kk] + pos1[kk] + pos2[kk]) * area / 3.0f;
+					cluster[kk+3] += normal[kk];
+				}
+
+				cluster[6] += area;
+			}
+
+			for (uint32_t kk = 0; kk < 3; ++kk)
+			{
+				meshCentroid[kk] += cluster[kk];
+			}
+
+			meshArea += cluster[6];
+		}
+
+		const float invMeshArea = meshArea > 0.0f ? 1.0f/meshArea : 0.0f;
+		bx::vec3Mul(meshCentroid, meshCentroid, invMeshArea);
+
+		for (uint32_t ii = 0; ii < numSoft; ++ii)
+		{
+			const float* cluster = &clusters[ii*7];
+
+			float dot = 0.0f;
+			if (cluster[6] > 0.0f)
+			{
+				float centroid[3];
+				bx::vec3Mul(centroid, cluster, 1.0f/cluster[6]);
+				bx::vec3Sub(centroid, centroid, meshCentroid);
+
+				const float len = bx::fsqrt(bx::vec3Dot(&cluster[3], &cluster[3]) );
+				dot = len > 0.0f ? bx::vec3Dot(centroid, &cluster[3])/len : 0.0f;
+			}
+
+			union { float fl; uint32_t ui; } un;
+			un.fl = dot;
+
+			keys[ii]   = floatFlip(un.ui) ^ UINT32_MAX;
+			values[ii] = ii;
+		}
+
+		BX_FREE(_allocator, clusters);
+
+		bx::radixSort(keys, tempKeys, values, tempValues, numSoft);
+
+		uint32_t* dst = _dst;
+		for (uint32_t ii = 0; ii < numSoft; ++ii)
+		{
+			const uint32_t cluster = values[ii];
+			const uint32_t start   = soft[cluster];
+			const uint32_t num     = (soft[cluster+1] - start)*3;
+			bx::memCopy(dst, &_indices[start*3], num*sizeof(uint32_t) );
+			dst += num;
+		}
+
+		BX_FREE(_allocator, temp);
+	}
+
+	uint32_t topologyOptimize(
+		  TopologyOptimize::Enum _optimize
+		, void* _dst
+		, uint32_t _dstSize
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		)
+	{
+		const uint32_t numIndices = _numIndices/3*3;
+
+		if (NULL == _dst)
+		{
+			return numIndices;
+		}
+
+		if (NULL == _allocator
+		||  0 == numIndices)
+		{
+			return 0;
+		}
+
+		// Source is copied before optimization, _dst and _indices can point
+		// to the same memory.
+		uint32_t* temp = (uint32_t*)BX_ALLOC(_allocator, numIndices*sizeof(uint32_t)*2);
+		uint32_t* src  = &temp[0];
+		uint32_t* dst  = &temp[numIndices];
+
+		if (_index32)
+		{
+			copyIndices(src, (const uint32_t*)_indices, numIndices);
+		}
+		else
+		{
+			copyIndices(src, (const uint16_t*)_indices, numIndices);
+		}
+
+		switch (_optimize)
+		{
+		case TopologyOptimize::VertexCache:
+			topologyOptimizeVertexCache(dst, src, numIndices, _numVertices, _allocator);
+			break;
+
+		case TopologyOptimize::Overdraw:
+			topologyOptimizeOverdraw(dst, src, numIndices, _vertices, _numVertices, _stride, s_overdrawThreshold, _allocator);
+			break;
+
+		default:
+			bx::memCopy(dst, src, numIndices*sizeof(uint32_t) );
+			break;
+		}
+
+		const uint32_t num = _index32
+			? writeIndices<uint32_t>(_dst, _dstSize, dst, numIndices)
+			: writeIndices<uint16_t>(_dst, _dstSize, dst, numIndices)
+			;
+
+		BX_FREE(_allocator, temp);
+
+		return num;
+	}
+
+	template<typename IndexT>
+	static uint32_t topologyOptimizeVertexFetch(
+		  void* _dst
+		, uint32_t _dstSize
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, IndexT* _indices
+		, uint32_t _numIndices
+		, uint32_t* _remap
+		)
+	{
+		bx::memSet(_remap, 0xff, _numVertices*sizeof(uint32_t) );
+
+		uint32_t num = 0;
+		for (uint32_t ii = 0; ii < _numIndices; ++ii)
+		{
+			const uint32_t idx = _indices[ii];
+			BX_CHECK(idx < _numVertices, "Index %d is out of range (num vertices %d).", idx, _numVertices);
+
+			if (UINT32_MAX == _remap[idx])
+			{
+				_remap[idx] = num++;
+			}
+		}
+
+		if (NULL == _dst)
+		{
+			return num;
+		}
+
+		if (num*_stride > _dstSize)
+		{
+			BX_WARN(false, "Destination vertex buffer is too small (%d bytes, required %d bytes)."
+				, _dstSize
+				, num*_stride
+				);
+			return 0;
+		}
+
+		const uint8_t* src = (const uint8_t*)_vertices;
+		uint8_t* dst = (uint8_t*)_dst;
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			if (UINT32_MAX != _remap[ii])
+			{
+				bx::memCopy(&dst[_remap[ii]*_stride], &src[ii*_stride], _stride);
+			}
+		}
+
+		for (uint32_t ii = 0; ii < _numIndices; ++ii)
+		{
+			_indices[ii] = IndexT(_remap[_indices[ii] ]);
+		}
+
+		return num;
+	}
+
+	uint32_t topologyOptimizeVertexFetch(
+		  void* _dst
+		, uint32_t _dstSize
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		)
+	{
+		if (NULL == _allocator)
+		{
+			return 0;
+		}
+
+		uint32_t* remap = (uint32_t*)BX_ALLOC(_allocator, _numVertices*sizeof(uint32_t) );
+
+		const uint32_t num = _index32
+			? topologyOptimizeVertexFetch(_dst, _dstSize, _vertices, _numVertices, _stride, (uint32_t*)_indices, _numIndices, remap)
+			: topologyOptimizeVertexFetch(_dst, _dstSize, _vertices, _numVertices, _stride, (uint16_t*)_indices, _numIndices, remap)
+			;
+
+		BX_FREE(_allocator, remap);
+
+		return num;
+	}
+
+	template<typename IndexT>
+	static void topologyCalcStats(
+		  TopologyStats* _stats
+		, uint32_t _cacheSize
+		, const IndexT* _indices
+		, uint32_t _numIndices
+		, uint32_t* _timestamps
+		)
+	{
+		uint32_t time     = _cacheSize+1;
+		uint32_t misses   = 0;
+		uint32_t vertices = 0;
+
+		for (uint32_t ii = 0; ii < _numIndices; ++ii)
+		{
+			const uint32_t idx = _indices[ii];
+			vertices += 0 == _timestamps[idx];
+			misses   += vertexCacheMiss(_timestamps, time, _cacheSize, idx);
+		}
+
+		const uint32_t numTris = _numIndices/3;
+		_stats->acmr = 0 == numTris  ? 0.0f : float(misses)/float(numTris);
+		_stats->atvr = 0 == vertices ? 0.0f : float(misses)/float(vertices);
+	}
+
+	void topologyCalcStats(
+		  TopologyStats* _stats
+		, uint32_t _cacheSize
+		, const void* _indices
+		, uint32_t _numIndices
+		, uint32_t _numVertices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		)
+	{
+		_stats->acmr = 0.0f;
+		_stats->atvr = 0.0f;
+
+		if (NULL == _allocator
+		||  0 == _cacheSize)
+		{
+			return;
+		}
+
+		uint32_t* timestamps = (uint32_t*)BX_ALLOC(_allocator, _numVertices*sizeof(uint32_t) );
+		bx::memSet(timestamps, 0, _numVertices*sizeof(uint32_t) );
+
+		if (_index32)
+		{
+			topologyCalcStats(_stats, _cacheSize, (const uint32_t*)_indices, _numIndices, timestamps);
+		}
+		else
+		{
+			topologyCalcStats(_stats, _cacheSize, (const uint16_t*)_indices, _numIndices, timestamps);
+		}
+
+		BX_FREE(_allocator, timestamps);
+	}
+
+	inline bool triNormal(float* _result, const void* _vertices, uint32_t _stride, const uint32_t* _tri)
+	{
+		const float* pos0 = vertexPos(_vertices, _stride, _tri[0]);
+		const float* pos1 = vertexPos(_vertices, _stride, _tri[1]);
+		const float* pos2 = vertexPos(_vertices, _stride, _tri[2]);
+
+		float edge0[3];
+		float edge1[3];
+		float normal[3];
+		bx::vec3Sub(edge0, pos1, pos0);
+		bx::vec3Sub(edge1, pos2, pos0);
+		bx::vec3Cross(normal, edge0, edge1);
+
+		const float len = bx::fsqrt(bx::vec3Dot(normal, normal) );
+		if (0.0f == len)
+		{
+			_result[0] = 0.0f;
+			_result[1] = 0.0f;
+			_result[2] = 0.0f;
+			return false;
+		}
+
+		bx::vec3Mul(_result, normal, 1.0f/len);
+		return true;
+	}
+
+	static void topologyClusterBounds(
+		  TopologyCluster& _cluster
+		, const uint32_t* _indices
+		, const void* _vertices
+		, uint32_t _stride
+		)
+	{
+		float min[3] = {  bx::huge,  bx::huge,  bx::huge };
+		float max[3] = { -bx::huge, -bx::huge, -bx::huge };
+		float axis[3] = { 0.0f, 0.0f, 0.0f };
+
+		const uint32_t numTris = _cluster.numIndices/3;
+		const uint32_t* indices = &_indices[_cluster.startIndex];
+
+		for (uint32_t ii = 0; ii < numTris*3; ++ii)
+		{
+			const float* pos = vertexPos(_vertices, _stride, indices[ii]);
+			for (uint32_t kk = 0; kk < 3; ++kk)
+			{
+				min[kk] = bx::fmin(min[kk], pos[kk]);
+				max[kk] = bx::fmax(max[kk], pos[kk]);
+			}
+		}
+
+		float* sphere = _cluster.sphere;
+		sphere[0] = (min[0] + max[0]) * 0.5f;
+		sphere[1] = (min[1] + max[1]) * 0.5f;
+		sphere[2] = (min[2] + max[2]) * 0.5f;
+
+		float radiusSq = 0.0f;
+		for (uint32_t ii = 0; ii < numTris*3; ++ii)
+		{
+			float tmp[3];
+			bx::vec3Sub(tmp, vertexPos(_vertices, _stride, indices[ii]), sphere);
+			radiusSq = bx::fmax(radiusSq, bx::vec3Dot(tmp, tmp) );
+		}
+		sphere[3] = bx::fsqrt(radiusSq);
+
+		// Normal cone is built from triangle winding, normal of triangle is
+		// cross(v1-v0, v2-v0).
+		for (uint32_t ii = 0; ii < numTris; ++ii)
+		{
+			float normal[3];
+			triNormal(normal, _vertices, _stride, &indices[ii*3]);
+			axis[0] += normal[0];
+			axis[1] += normal[1];
+			axis[2] += normal[2];
+		}
+
+		float* cone = _cluster.cone;
+		const float len = bx::fsqrt(bx::vec3Dot(axis, axis) );
+		if (len > 0.0f)
+		{
+			bx::vec3Mul(cone, axis, 1.0f/len);
+
+			float minDot = 1.0f;
+			for (uint32_t ii = 0; ii < numTris; ++ii)
+			{
+				float normal[3];
+				if (triNormal(normal, _vertices, _stride, &indices[ii*3]) )
+				{
+					minDot = bx::fmin(minDot, bx::vec3Dot(normal, cone) );
+				}
+			}
+
+			// Cone wider than hemisphere can't be culled.
+			cone[3] = minDot <= 0.0f ? 1.0f : bx::fsqrt(1.0f - minDot*minDot);
+		}
+		else
+		{
+			cone[0] = 0.0f;
+			cone[1] = 0.0f;
+			cone[2] = 0.0f;
+			cone[3] = 1.0f;
+		}
+	}
+
+	static uint32_t topologyBuildClusters(
+		  TopologyCluster* _clusters
+		, uint32_t* _dst
+		, uint32_t _maxTriangles
+		, uint32_t _maxVertices
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, const uint32_t* _indices
+		, uint32_t _numIndices
+		, bx::AllocatorI* _allocator
+		)
+	{
+		const uint32_t numTris = _numIndices/3;
+
+		uint32_t* temp = (uint32_t*)BX_ALLOC(_allocator, 0
+			+ _numVertices*sizeof(uint32_t)*3
+			+ _numIndices*sizeof(uint32_t)
+			+ _maxVertices*sizeof(uint32_t)
+			+ numTris
+			);
+		uint32_t* numActive = temp;
+		uint32_t* offset    = &numActive[_numVertices];
+		uint32_t* tag       = &offset[_numVertices];
+		uint32_t* adjacency = &tag[_numVertices];
+		uint32_t* vertices  = &adjacency[_numIndices];
+		uint8_t*  emitted   = (uint8_t*)&vertices[_maxVertices];
+
+		bx::memSet(numActive, 0, _numVertices*sizeof(uint32_t) );
+		bx::memSet(tag, 0, _numVertices*sizeof(uint32_t) );
+		bx::memSet(emitted, 0, numTris);
+
+		for (uint32_t ii = 0, num = numTris*3; ii < num; ++ii)
+		{
+			BX_CHECK(_indices[ii] < _numVertices, "Index %d is out of range (num vertices %d).", _indices[ii], _numVertices);
+			++numActive[_indices[ii] ];
+		}
+
+		for (uint32_t ii = 0, sum = 0; ii < _numVertices; ++ii)
+		{
+			offset[ii]    = sum;
+			sum          += numActive[ii];
+			numActive[ii] = 0;
+		}
+
+		for (uint32_t ii = 0; ii < numTris; ++ii)
+		{
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				const uint32_t idx = _indices[ii*3+jj];
+				adjacency[offset[idx] + numActive[idx] ] = ii;
+				++numActive[idx];
+			}
+		}
+
+		uint32_t numClusters = 0;
+		uint32_t next = 0;
+		uint32_t* dst = _dst;
+
+		for (uint32_t out = 0; out < numTris;)
+		{
+			// Cluster id is used to tag vertices already in cluster.
+			const uint32_t id = numClusters+1;
+
+			TopologyCluster& cluster = _clusters[numClusters++];
+			cluster.startIndex  = uint32_t(dst - _dst);
+			cluster.numVertices = 0;
+
+			uint32_t numClusterTris = 0;
+			uint32_t face = UINT32_MAX;
+
+			for (;;)
+			{
+				if (UINT32_MAX == face)
+				{
+					// No triangle connected to cluster, continue with next
+					// triangle in input order.
+					for (; next < numTris && emitted[next]; ++next) {}
+					face = next;
+
+					if (face == numTris)
+					{
+						break;
+					}
+
+					uint32_t numNew = 0;
+					for (uint32_t jj = 0; jj < 3; ++jj)
+					{
+						numNew += id != tag[_indices[face*3+jj] ];
+					}
+
+					if (cluster.numVertices + numNew > _maxVertices)
+					{
+						break;
+					}
+				}
+
+				const uint32_t* tri = &_indices[face*3];
+				emitted[face] = 1;
+				dst[0] = tri[0];
+				dst[1] = tri[1];
+				dst[2] = tri[2];
+				dst += 3;
+				++numClusterTris;
+				++out;
+
+				for (uint32_t jj = 0; jj < 3; ++jj)
+				{
+					const uint32_t idx = tri[jj];
+
+					uint32_t* list = &adjacency[offset[idx] ];
+					for (uint32_t kk = 0, num = numActive[idx]; kk < num; ++kk)
+					{
+						if (list[kk] == face)
+						{
+							list[kk] = list[num-1];
+							--numActive[idx];
+							break;
+						}
+					}
+
+					if (id != tag[idx])
+					{
+						tag[idx] = id;
+						vertices[cluster.numVertices++] = idx;
+					}
+				}
+
+				if (numClusterTris == _maxTriangles)
+				{
+					break;
+				}
+
+				// Grow cluster with triangle that adds the least new vertices.
+				face = UINT32_MAX;
+				uint32_t bestNew = 3;
+				for (uint32_t ii = 0; ii < cluster.numVertices && 0 != bestNew; ++ii)
+				{
+					const uint32_t  idx  = vertices[ii];
+					const uint32_t* list = &adjacency[offset[idx] ];
+					for (uint32_t jj = 0, num = numActive[idx]; jj < num; ++jj)
+					{
+						const uint32_t* candidate = &_indices[list[jj]*3];
+						const uint32_t numNew = 0
+							+ (id != tag[candidate[0] ])
+							+ (id != tag[candidate[1] ])
+							+ (id != tag[candidate[2] ])
+							;
+
+						if (numNew < bestNew)
+						{
+							bestNew = numNew;
+							face    = list[jj];
+						}
+					}
+				}
+
+				if (UINT32_MAX != face
+				&&  cluster.numVertices + bestNew > _maxVertices)
+				{
+					break;
+				}
+			}
+
+			cluster.numIndices = numClusterTris*3;
+
+			if (0 == numClusterTris)
+			{
+				--numClusters;
+				break;
+			}
+
+			topologyClusterBounds(cluster, _dst, _vertices, _stride);
+		}
+
+		BX_FREE(_allocator, temp);
+
+		return numClusters;
+	}
+
+	uint32_t topologyBuildClusters(
+		  TopologyCluster* _clusters
+		, uint32_t _maxClusters
+		, void* _dst
+		, uint32_t _dstSize
+		, uint32_t _maxTriangles
+		, uint32_t _maxVertices
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		)
+	{
+		const uint32_t numIndices = _numIndices/3*3;
+		const uint32_t numTris    = numIndices/3;
+
+		if (NULL == _allocator
+		||  0 == numTris
+		||  3 > _maxVertices
+		||  0 == _maxTriangles)
+		{
+			return 0;
+		}
+
+		uint32_t* temp = (uint32_t*)BX_ALLOC(_allocator, numIndices*sizeof(uint32_t)*2 + numTris*sizeof(TopologyCluster) );
+		uint32_t* src  = &temp[0];
+		uint32_t* dst  = &temp[numIndices];
+		TopologyCluster* clusters = (TopologyCluster*)&dst[numIndices];
+
+		if (_index32)
+		{
+			copyIndices(src, (const uint32_t*)_indices, numIndices);
+		}
+		else
+		{
+			copyIndices(src, (const uint16_t*)_indices, numIndices);
+		}
+
+		uint32_t num = topologyBuildClusters(clusters, dst, _maxTriangles, _maxVertices, _vertices, _numVertices, _stride, src, numIndices, _allocator);
+
+		if (NULL != _clusters)
+		{
+			num = bx::uint32_min(num, _maxClusters);
+			bx::memCopy(_clusters, clusters, num*sizeof(TopologyCluster) );
+		}
+
+		if (NULL != _dst)
+		{
+			if (_index32)
+			{
+				writeIndices<uint32_t>(_dst, _dstSize, dst, numIndices);
+			}
+			else
+			{
+				writeIndices<uint16_t>(_dst, _dstSize, dst, numIndices);
+			}
+		}
+
+		BX_FREE(_allocator, temp);
+
+		return num;
+	}
+
+	template<typename IndexT>
+	static void facePlane(float* _result, const void* _vertices, uint32_t _stride, const IndexT* _indices, uint32_t _face)
+	{
+		const uint32_t tri[3] =
+		{
+			_indices[_face*3+0],
+			_indices[_face*3+1],
+			_indices[_face*3+2],
+		};
+
+		triNormal(_result, _vertices, _stride, tri);
+		_result[3] = -bx::vec3Dot(_result, vertexPos(_vertices, _stride, tri[0]) );
+	}
+
+	template<typename IndexT, typename SortT>
+	static uint32_t topologyBuildEdges(TopologyEdge* _edges, uint32_t _maxEdges, const void* _vertices, uint32_t _stride, const IndexT* _indices, uint32_t _numIndices, bx::AllocatorI* _allocator)
+	{
+		SortT*    keys       = (SortT*)BX_ALLOC(_allocator, _numIndices*(sizeof(SortT)+sizeof(uint32_t) )*2);
+		SortT*    tempKeys   = &keys[_numIndices];
+		uint32_t* values     = (uint32_t*)&tempKeys[_numIndices];
+		uint32_t* tempValues = &values[_numIndices];
+		topologySortEdges(keys, values, _indices, _numIndices, tempKeys, tempValues);
+
+		const uint32_t shift = sizeof(IndexT)*8;
+		const SortT    mask  = (SortT(1)<<shift)-1;
+
+		uint32_t num = 0;
+		for (uint32_t ii = 0; ii < _numIndices; ++ii)
+		{
+			const SortT key = keys[ii];
+			const SortT i0  = key>>shift;
+			const SortT i1  = key&mask;
+
+			// Skip degenerate edges, and edges used more than once in the
+			// same direction (non-manifold).
+			if (i0 == i1
+			|| (0 < ii && keys[ii-1] == key) )
+			{
+				continue;
+			}
+
+			// Shared edge is emitted once, when its lower key is visited.
+			const SortT    reverse = (i1<<shift) | i0;
+			const uint32_t edge    = topologyFindEdge(keys, _numIndices, reverse);
+			if (UINT32_MAX != edge
+			&&  reverse < key)
+			{
+				continue;
+			}
+
+			if (NULL != _edges)
+			{
+				if (num == _maxEdges)
+				{
+					break;
+				}
+
+				TopologyEdge& result = _edges[num];
+				result.i0      = uint32_t(i0);
+				result.i1      = uint32_t(i1);
+				result.face[0] = values[ii]/3;
+				result.face[1] = UINT32_MAX == edge ? UINT32_MAX : values[edge]/3;
+
+				facePlane(result.plane[0], _vertices, _stride, _indices, result.face[0]);
+
+				if (UINT32_MAX == edge)
+				{
+					bx::memSet(result.plane[1], 0, sizeof(result.plane[1]) );
+				}
+				else
+				{
+					facePlane(result.plane[1], _vertices, _stride, _indices, result.face[1]);
+				}
+			}
+
+			++num;
+		}
+
+		BX_FREE(_allocator, keys);
+
+		return num;
+	}
+
+	uint32_t topologyBuildEdges(
+		  TopologyEdge* _edges
+		, uint32_t _maxEdges
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		)
+	{
+		const uint32_t numIndices = _numIndices/3*3;
+
+		if (NULL == _allocator
+		||  0 == numIndices)
+		{
+			return 0;
+		}
+
+		if (_index32)
+		{
+			return topologyBuildEdges<uint32_t, uint64_t>(_edges, _maxEdges, _vertices, _stride, (const uint32_t*)_indices, numIndices, _allocator);
+		}
+
+		return topologyBuildEdges<uint16_t, uint32_t>(_edges, _maxEdges, _vertices, _stride, (const uint16_t*)_indices, numIndices, _allocator);
+	}
+
+	static const float s_simplifyBorderWeight = 10.0f;
+
+	struct Quadric
+	{
+		float a00, a01, a02;
+		float      a11, a12;
+		float           a22;
+		float b0, b1, b2;
+		float c;
+		float w;
+	};
+
+	inline void quadricFromPlane(Quadric& _q, const float* _normal, float _dist, float _weight)
+	{
+		const float nx = _normal[0];
+		const float ny = _normal[1];
+		const float nz = _normal[2];
+
+		_q.a00 = nx*nx*_weight; _q.a01 = nx*ny*_weight; _q.a02 = nx*nz*_weight;
+		_q.a11 = ny*ny*_weight; _q.a12 = ny*nz*_weight;
+		_q.a22 = nz*nz*_weight;
+		_q.b0  = nx*_dist*_weight;
+		_q.b1  = ny*_dist*_weight;
+		_q.b2  = nz*_dist*_weight;
+		_q.c   = _dist*_dist*_weight;
+		_q.w   = _weight;
+	}
+
+	inline void quadricAdd(Quadric& _result, const Quadric& _q)
+	{
+		float* result = &_result.a00;
+		const float* q = &_q.a00;
+		for (uint32_t ii = 0; ii < sizeof(Quadric)/sizeof(float); ++ii)
+		{
+			result[ii] += q[ii];
+		}
+	}
+
+	inline float quadricError(const Quadric& _q0, const Quadric& _q1, const float* _pos)
+	{
+		Quadric q = _q0;
+		quadricAdd(q, _q1);
+
+		const float xx = _pos[0];
+		const float yy = _pos[1];
+		const float zz = _pos[2];
+
+		const float rx = q.a00*xx + q.a01*yy + q.a02*zz;
+		const float ry = q.a01*xx + q.a11*yy + q.a12*zz;
+		const float rz = q.a02*xx + q.a12*yy + q.a22*zz;
+
+		const float error = rx*xx + ry*yy + rz*zz + 2.0f*(q.b0*xx + q.b1*yy + q.b2*zz) + q.c;
+
+		// Weighted mean of squared distances to planes of collapsed faces.
+		return q.w > 0.0f ? bx::fabsolute(error)/q.w : 0.0f;
+	}
+
+	struct SimplifyVertex
+	{
+		enum Enum
+		{
+			Manifold, // Interior vertex, can collapse to any neighbour.
+			Border,   // Open edge vertex, can collapse only along open edge.
+			Seam,     // Attribute seam with two wedges, can collapse only along seam.
+			Locked,   // Never collapses.
+		};
+	};
+
+	struct Simplify
+	{
+		const float*    pos;
+		const uint32_t* canon;
+		const uint32_t* wedge;
+		const uint8_t*  kind;
+		const uint32_t* indices;
+		const uint32_t* adjOffset;
+		const uint32_t* adjCount;
+		const uint32_t* adjacency;
+
+		// Number of triangles using vertex _v that also use vertex _u, or
+		// any vertex at position of _u when _position is true.
+		uint32_t countShared(uint32_t _v, uint32_t _u, bool _position) const
+		{
+			uint32_t count = 0;
+			const uint32_t* list = &adjacency[adjOffset[_v] ];
+			for (uint32_t ii = 0, num = adjCount[_v]; ii < num; ++ii)
+			{
+				const uint32_t* tri = &indices[list[ii]*3];
+				for (uint32_t jj = 0; jj < 3; ++jj)
+				{
+					if (_position ? canon[tri[jj] ] == canon[_u] : tri[jj] == _u)
+					{
+						++count;
+						break;
+					}
+				}
+			}
+
+			return count;
+		}
+
+		// Returns sibling of _v collapsing together with _v, UINT32_MAX if
+		// none, or _v if collapse is not allowed.
+		uint32_t canCollapse(uint32_t _v, uint32_t _u, uint32_t& _siblingTarget) const
+		{
+			_siblingTarget = UINT32_MAX;
+
+			if (canon[_v] == canon[_u])
+			{
+				return _v;
+			}
+
+			switch (kind[_v])
+			{
+			case SimplifyVertex::Manifold:
+				return UINT32_MAX;
+
+			case SimplifyVertex::Border:
+				if (SimplifyVertex::Border == kind[_u]
+				||  SimplifyVertex::Locked == kind[_u])
+				{
+					return 1 == countShared(_v, _u, true) ? UINT32_MAX : _v;
+				}
+				break;
+
+			case SimplifyVertex::Seam:
+				if (SimplifyVertex::Seam == kind[_u]
+				&&  1 == countShared(_v, _u, false) )
+				{
+					const uint32_t sibling = wedge[_v];
+					_siblingTarget = wedge[_u];
+					return 1 == countShared(sibling, _siblingTarget, false) ? sibling : _v;
+				}
+				break;
+
+			default:
+				break;
+			}
+
+			return _v;
+		}
+
+		void lock(uint8_t* _locked, uint32_t _v) const
+		{
+			const uint32_t* list = &adjacency[adjOffset[_v] ];
+			for (uint32_t ii = 0, num = adjCount[_v]; ii < num; ++ii)
+			{
+				const uint32_t* tri = &indices[list[ii]*3];
+				_locked[canon[tri[0] ] ] = 1;
+				_locked[canon[tri[1] ] ] = 1;
+				_locked[canon[tri[2] ] ] = 1;
+			}
+		}
+
+		bool hasFlip(uint32_t _v, uint32_t _u) const
+		{
+			const float* newPos = &pos[_u*3];
+
+			const uint32_t* list = &adjacency[adjOffset[_v] ];
+			for (uint32_t ii = 0, num = adjCount[_v]; ii < num; ++ii)
+			{
+				const uint32_t* tri = &indices[list[ii]*3];
+				if (canon[tri[0] ] == canon[_u]
+				||  canon[tri[1] ] == canon[_u]
+				||  canon[tri[2] ] == canon[_u])
+				{
+					// Triangle is removed by collapse.
+					continue;
+				}
+
+				const float* p0 = &pos[tri[0]*3];
+				const float* p1 = &pos[tri[1]*3];
+				const float* p2 = &pos[tri[2]*3];
+
+				const float* q0 = tri[0] == _v ? newPos : p0;
+				const float* q1 = tri[1] == _v ? newPos : p1;
+				const float* q2 = tri[2] == _v ? newPos : p2;
+
+				float edge0[3];
+				float edge1[3];
+				float normal0[3];
+				float normal1[3];
+
+				bx::vec3Sub(edge0, p1, p0);
+				bx::vec3Sub(edge1, p2, p0);
+				bx::vec3Cross(normal0, edge0, edge1);
+
+				bx::vec3Sub(edge0, q1, q0);
+				bx::vec3Sub(edge1, q2, q0);
+				bx::vec3Cross(normal1, edge0, edge1);
+
+				// Reject flipped triangles and triangles rotated by more than
+				// ~75 degrees, those are usually slivers along borders.
+				const float dot = bx::vec3Dot(normal0, normal1);
+				const float len = bx::fsqrt(bx::vec3Dot(normal0, normal0)*bx::vec3Dot(normal1, normal1) );
+				if (dot <= 0.25f*len)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+	};
+
+	inline bool hasEdge(const uint64_t* _sorted, uint32_t _num, uint64_t _key)
+	{
+		uint32_t lo = 0;
+		uint32_t hi = _num;
+		while (lo < hi)
+		{
+			const uint32_t mid = (lo+hi)/2;
+			if (_sorted[mid] < _key)
+			{
+				lo = mid+1;
+			}
+			else
+			{
+				hi = mid;
+			}
+		}
+
+		return lo < _num && _sorted[lo] == _key;
+	}
+
+	inline uint32_t positionHash(const float* _pos)
+	{
+		union { float fl[3]; uint32_t ui[3]; } un = { { _pos[0], _pos[1], _pos[2] } };
+		uint32_t hash = un.ui[0]*73856093;
+		hash ^= un.ui[1]*19349663;
+		hash ^= un.ui[2]*83492791;
+		return hash;
+	}
+
+	static uint32_t topologySimplify(
+		  uint32_t* _indices
+		, uint32_t _numIndices
+		, uint32_t _numTargetIndices
+		, float _maxError
+		, const float* _pos
+		, uint32_t _numVertices
+		, bx::AllocatorI* _allocator
+		)
+	{
+		const uint32_t hashSize = bx::uint32_nextpow2(_numVertices*2);
+		const uint32_t hashMask = hashSize-1;
+
+		uint32_t* temp = (uint32_t*)BX_ALLOC(_allocator, 0
+			+ _numVertices*sizeof(uint32_t)*6
+			+ hashSize*sizeof(uint32_t)
+			+ _numIndices*sizeof(uint32_t)
+			);
+		uint32_t* canon     = temp;
+		uint32_t* wedge     = &canon[_numVertices];
+		uint32_t* remap     = &wedge[_numVertices];
+		uint32_t* adjOffset = &remap[_numVertices];
+		uint32_t* adjCount  = &adjOffset[_numVertices];
+		uint32_t* numWedges = &adjCount[_numVertices];
+		uint32_t* hashTable = &numWedges[_numVertices];
+		uint32_t* adjacency = &hashTable[hashSize];
+
+		uint8_t* kind   = (uint8_t*)BX_ALLOC(_allocator, _numVertices*2);
+		uint8_t* locked = &kind[_numVertices];
+
+		Quadric* quadrics = (Quadric*)BX_ALLOC(_allocator, _numVertices*sizeof(Quadric) );
+
+		// Only vertices referenced by indices take part in wedges, welded
+		// duplicates stay in vertex buffer but are not used anymore.
+		bx::memSet(adjCount, 0, _numVertices*sizeof(uint32_t) );
+		for (uint32_t ii = 0; ii < _numIndices; ++ii)
+		{
+			adjCount[_indices[ii] ] = 1;
+		}
+
+		// Vertices at the same position are wedges of single vertex, with
+		// different attributes (UV or normal seam).
+		bx::memSet(hashTable, 0xff, hashSize*sizeof(uint32_t) );
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			if (0 == adjCount[ii])
+			{
+				canon[ii]     = ii;
+				wedge[ii]     = ii;
+				numWedges[ii] = 1;
+				continue;
+			}
+
+			const float* pos = &_pos[ii*3];
+
+			uint32_t hash = positionHash(pos) & hashMask;
+			for (; UINT32_MAX != hashTable[hash]; hash = (hash+1) & hashMask)
+			{
+				const float* other = &_pos[hashTable[hash]*3];
+				if (pos[0] == other[0]
+				&&  pos[1] == other[1]
+				&&  pos[2] == other[2])
+				{
+					break;
+				}
+			}
+
+			if (UINT32_MAX == hashTable[hash])
+			{
+				hashTable[hash] = ii;
+				canon[ii]     = ii;
+				wedge[ii]     = ii;
+				numWedges[ii] = 1;
+			}
+			else
+			{
+				const uint32_t first = hashTable[hash];
+				canon[ii]     = first;
+				wedge[ii]     = wedge[first];
+				wedge[first]  = ii;
+				++numWedges[first];
+			}
+		}
+
+		// Edges are keyed by position, to find open borders, and by index,
+		// to find open borders and attribute seams.
+		uint64_t* edges    = (uint64_t*)BX_ALLOC(_allocator, _numIndices*sizeof(uint64_t)*3);
+		uint64_t* wedges   = &edges[_numIndices];
+		uint64_t* tempSort = &wedges[_numIndices];
+		for (uint32_t ii = 0; ii < _numIndices; ii += 3)
+		{
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				const uint64_t i0 = _indices[ii+jj];
+				const uint64_t i1 = _indices[ii+(jj+1)%3];
+				edges[ii+jj]  = (uint64_t(canon[i0])<<32) | canon[i1];
+				wedges[ii+jj] = (i0<<32) | i1;
+			}
+		}
+		bx::radixSort(edges,  tempSort, _numIndices);
+		bx::radixSort(wedges, tempSort, _numIndices);
+
+		// Until vertices are classified, kind is used as border flag per
+		// position.
+		bx::memSet(kind, 0, _numVertices);
+		bx::memSet(quadrics, 0, _numVertices*sizeof(Quadric) );
+
+		for (uint32_t ii = 0; ii < _numIndices; ii += 3)
+		{
+			const float* p0 = &_pos[_indices[ii+0]*3];
+			const float* p1 = &_pos[_indices[ii+1]*3];
+			const float* p2 = &_pos[_indices[ii+2]*3];
+
+			float edge0[3];
+			float edge1[3];
+			float normal[3];
+			bx::vec3Sub(edge0, p1, p0);
+			bx::vec3Sub(edge1, p2, p0);
+			bx::vec3Cross(normal, edge0, edge1);
+
+			const float len = bx::fsqrt(bx::vec3Dot(normal, normal) );
+			if (0.0f == len)
+			{
+				continue;
+			}
+
+			bx::vec3Mul(normal, normal, 1.0f/len);
+
+			Quadric q;
+			quadricFromPlane(q, normal, -bx::vec3Dot(normal, p0), len*0.5f);
+
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				const uint32_t i0 = _indices[ii+jj];
+				const uint32_t i1 = _indices[ii+(jj+1)%3];
+
+				quadricAdd(quadrics[canon[i0] ], q);
+
+				if (!hasEdge(edges, _numIndices, (uint64_t(canon[i1])<<32) | canon[i0]) )
+				{
+					kind[canon[i0] ] = 1;
+					kind[canon[i1] ] = 1;
+				}
+
+				if (!hasEdge(wedges, _numIndices, (uint64_t(i1)<<32) | i0) )
+				{
+					// Plane perpendicular to triangle through open edge keeps
+					// borders and seams in place.
+					const float* e0 = &_pos[i0*3];
+					const float* e1 = &_pos[i1*3];
+
+					float dir[3];
+					float perp[3];
+					bx::vec3Sub(dir, e1, e0);
+					bx::vec3Cross(perp, dir, normal);
+
+					const float perpLen = bx::fsqrt(bx::vec3Dot(perp, perp) );
+					if (0.0f < perpLen)
+					{
+						bx::vec3Mul(perp, perp, 1.0f/perpLen);
+
+						Quadric border;
+						quadricFromPlane(border, perp, -bx::vec3Dot(perp, e0), bx::vec3Dot(dir, dir)*s_simplifyBorderWeight);
+						quadricAdd(quadrics[canon[i0] ], border);
+						quadricAdd(quadrics[canon[i1] ], border);
+					}
+				}
+			}
+		}
+
+		BX_FREE(_allocator, edges);
+
+		uint8_t* border = locked;
+		bx::memCopy(border, kind, _numVertices);
+
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			const uint32_t first = canon[ii];
+			const uint32_t num   = numWedges[first];
+			kind[ii] = uint8_t(0 == border[first]
+				? (1 == num ? SimplifyVertex::Manifold : 2 == num ? SimplifyVertex::Seam : SimplifyVertex::Locked)
+				: (1 == num ? SimplifyVertex::Border   :            SimplifyVertex::Locked)
+				);
+		}
+
+		// Each collapse candidate is (cost, v, u), collapsing v onto u. There
+		// are up to 6 candidates per triangle (both directions of each edge),
+		// stored as keys, values, temp keys, temp values, from, and to.
+		uint32_t* candidates = (uint32_t*)BX_ALLOC(_allocator, _numIndices/3*6*6*sizeof(uint32_t) );
+
+		const float maxErrorSq = _maxError*_maxError;
+
+		Simplify simplify;
+		simplify.pos       = _pos;
+		simplify.canon     = canon;
+		simplify.wedge     = wedge;
+		simplify.kind      = kind;
+		simplify.indices   = _indices;
+		simplify.adjOffset = adjOffset;
+		simplify.adjCount  = adjCount;
+		simplify.adjacency = adjacency;
+
+		uint32_t numIndices = _numIndices;
+
+		while (numIndices > _numTargetIndices)
+		{
+			bx::memSet(adjCount, 0, _numVertices*sizeof(uint32_t) );
+			for (uint32_t ii = 0; ii < numIndices; ++ii)
+			{
+				++adjCount[_indices[ii] ];
+			}
+
+			for (uint32_t ii = 0, sum = 0; ii < _numVertices; ++ii)
+			{
+				adjOffset[ii] = sum;
+				sum          += adjCount[ii];
+				adjCount[ii]  = 0;
+			}
+
+			for (uint32_t ii = 0; ii < numIndices; ++ii)
+			{
+				const uint32_t idx = _indices[ii];
+				adjacency[adjOffset[idx] + adjCount[idx] ] = ii/3;
+				++adjCount[idx];
+			}
+
+			const uint32_t numTris = numIndices/3;
+			uint32_t* keys       = candidates;
+			uint32_t* values     = &keys[numTris*6];
+			uint32_t* tempKeys   = &values[numTris*6];
+			uint32_t* tempValues = &tempKeys[numTris*6];
+			uint32_t* from       = &tempValues[numTris*6];
+			uint32_t* to         = &from[numTris*6];
+
+			uint32_t numCandidates = 0;
+			for (uint32_t ii = 0; ii < numIndices; ii += 3)
+			{
+				for (uint32_t jj = 0; jj < 6; ++jj)
+				{
+					const uint32_t v = _indices[ii + (jj>>1)];
+					const uint32_t u = _indices[ii + ( (jj>>1) + 1 + (jj&1) )%3];
+
+					uint32_t siblingTarget;
+					if (v == simplify.canCollapse(v, u, siblingTarget) )
+					{
+						continue;
+					}
+
+					union { float fl; uint32_t ui; } un;
+					un.fl = quadricError(quadrics[canon[v] ], quadrics[canon[u] ], &_pos[u*3]);
+
+					if (un.fl > maxErrorSq)
+					{
+						continue;
+					}
+
+					keys[numCandidates]   = un.ui;
+					values[numCandidates] = numCandidates;
+					from[numCandidates]   = v;
+					to[numCandidates]     = u;
+					++numCandidates;
+				}
+			}
+
+			if (0 == numCandidates)
+			{
+				break;
+			}
+
+			bx::radixSort(keys, tempKeys, values, tempValues, numCandidates);
+
+			for (uint32_t ii = 0; ii < _numVertices; ++ii)
+			{
+				remap[ii] = ii;
+			}
+			bx::memSet(locked, 0, _numVertices);
+
+			// Every collapse removes about two triangles, don't overshoot
+			// target in single pass.
+			const uint32_t maxCollapses = (numIndices - _numTargetIndices)/6 + 1;
+			uint32_t numCollapses = 0;
+
+			for (uint32_t ii = 0; ii < numCandidates && numCollapses < maxCollapses; ++ii)
+			{
+				const uint32_t candidate = values[ii];
+				const uint32_t v = from[candidate];
+				const uint32_t u = to[candidate];
+
+				if (0 != locked[canon[v] ]
+				||  0 != locked[canon[u] ])
+				{
+					continue;
+				}
+
+				uint32_t siblingTarget;
+				const uint32_t sibling = simplify.canCollapse(v, u, siblingTarget);
+
+				if (simplify.hasFlip(v, u)
+				|| (UINT32_MAX != sibling && simplify.hasFlip(sibling, siblingTarget) ) )
+				{
+					continue;
+				}
+
+				remap[v] = u;
+				if (UINT32_MAX != sibling)
+				{
+					remap[sibling] = siblingTarget;
+				}
+
+				quadricAdd(quadrics[canon[u] ], quadrics[canon[v] ]);
+
+				// Collapses sharing triangles within single pass could flip
+				// them, lock whole neighbourhood.
+				simplify.lock(locked, v);
+				if (UINT32_MAX != sibling)
+				{
+					simplify.lock(locked, sibling);
+				}
+				++numCollapses;
+			}
+
+			if (0 == numCollapses)
+			{
+				break;
+			}
+
+			uint32_t num = 0;
+			for (uint32_t ii = 0; ii < numIndices; ii += 3)
+			{
+				const uint32_t i0 = remap[_indices[ii+0] ];
+				const uint32_t i1 = remap[_indices[ii+1] ];
+				const uint32_t i2 = remap[_indices[ii+2] ];
+
+				if (canon[i0] != canon[i1]
+				&&  canon[i1] != canon[i2]
+				&&  canon[i0] != canon[i2])
+				{
+					_indices[num+0] = i0;
+					_indices[num+1] = i1;
+					_indices[num+2] = i2;
+					num += 3;
+				}
+			}
+
+			numIndices = num;
+		}
+
+		BX_FREE(_allocator, candidates);
+		BX_FREE(_allocator, quadrics);
+		BX_FREE(_allocator, kind);
+		BX_FREE(_allocator, temp);
+
+		return numIndices;
+	}
+
+	static bool isVertexEqual(const VertexDecl& _decl, const void* _vertices, uint32_t _a, uint32_t _b)
+	{
+		for (uint32_t attr = 0; attr < Attrib::Count; ++attr)
+		{
+			if (!_decl.has(Attrib::Enum(attr) ) )
+			{
+				continue;
+			}
+
+			float a[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float b[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			vertexUnpack(a, Attrib::Enum(attr), _decl, _vertices, _a);
+			vertexUnpack(b, Attrib::Enum(attr), _decl, _vertices, _b);
+
+			if (a[0] != b[0]
+			||  a[1] != b[1]
+			||  a[2] != b[2]
+			||  a[3] != b[3])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	uint32_t topologySimplify(
+		  void* _dst
+		, uint32_t _dstSize
+		, uint32_t _numTargetIndices
+		, float _maxError
+		, const VertexDecl& _decl
+		, const void* _vertices
+		, uint32_t _numVertices
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		)
+	{
+		const uint32_t numIndices = _numIndices/3*3;
+
+		if (NULL == _allocator
+		||  0 == numIndices
+		||  !_decl.has(Attrib::Position) )
+		{
+			return 0;
+		}
+
+		uint32_t* indices = (uint32_t*)BX_ALLOC(_allocator, numIndices*sizeof(uint32_t) );
+		float*    pos     = (float*   )BX_ALLOC(_allocator, _numVertices*3*sizeof(float) );
+
+		if (_index32)
+		{
+			copyIndices(indices, (const uint32_t*)_indices, numIndices);
+		}
+		else
+		{
+			copyIndices(indices, (const uint16_t*)_indices, numIndices);
+		}
+
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			float tmp[4];
+			vertexUnpack(tmp, Attrib::Position, _decl, _vertices, ii);
+			pos[ii*3+0] = tmp[0];
+			pos[ii*3+1] = tmp[1];
+			pos[ii*3+2] = tmp[2];
+		}
+
+		// Vertices with the same position and all other attributes equal
+		// are duplicates, weld them so that unwelded meshes simplify. Those
+		// with different attributes are kept as wedges of attribute seam.
+		const uint32_t hashSize = bx::uint32_nextpow2(_numVertices*2);
+		const uint32_t hashMask = hashSize-1;
+
+		uint32_t* weld      = (uint32_t*)BX_ALLOC(_allocator, (_numVertices + hashSize)*sizeof(uint32_t) );
+		uint32_t* hashTable = &weld[_numVertices];
+
+		bx::memSet(hashTable, 0xff, hashSize*sizeof(uint32_t) );
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			const float* vpos = &pos[ii*3];
+
+			uint32_t hash = positionHash(vpos) & hashMask;
+			for (; UINT32_MAX != hashTable[hash]; hash = (hash+1) & hashMask)
+			{
+				const uint32_t other = hashTable[hash];
+				const float* opos = &pos[other*3];
+				if (vpos[0] == opos[0]
+				&&  vpos[1] == opos[1]
+				&&  vpos[2] == opos[2]
+				&&  isVertexEqual(_decl, _vertices, ii, other) )
+				{
+					break;
+				}
+			}
+
+			if (UINT32_MAX == hashTable[hash])
+			{
+				hashTable[hash] = ii;
+			}
+
+			weld[ii] = hashTable[hash];
+		}
+
+		for (uint32_t ii = 0; ii < numIndices; ++ii)
+		{
+			indices[ii] = weld[indices[ii] ];
+		}
+
+		BX_FREE(_allocator, weld);
+
+		uint32_t num = topologySimplify(indices, numIndices, _numTargetIndices, _maxError, pos, _numVertices, _allocator);
+
+		if (NULL != _dst)
+		{
+			num = _index32
+				? writeIndices<uint32_t>(_dst, _dstSize, indices, num)
+				: writeIndices<uint16_t>(_dst, _dstSize, indices, num)
+				;
+		}
+
+		BX_FREE(_allocator, pos);
+		BX_FREE(_allocator, indices);
+
+		return num;
+	}
+
 } //namespace bgfx
@@ -51,6 +51,130 @@ namespace bgfx
 		, bx::AllocatorI* _allocator
 		);
 
+	/// Sort indices, refining triangle order from previous call.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_sort_tri_list_coherent`.
+	///
+	void topologySortTriListCoherent(
+		  TopologySort::Enum _sort
+		, void* _dst
+		, uint32_t _dstSize
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, uint32_t* _order
+		, bool _multithreaded
+		, bx::AllocatorI* _allocator
+		);
+
+	/// Reorder triangle list for post-transform vertex cache, or to reduce
+	/// overdraw. See `TopologyOptimize::Enum`.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_optimize`.
+	///
+	uint32_t topologyOptimize(
+		  TopologyOptimize::Enum _optimize
+		, void* _dst
+		, uint32_t _dstSize
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		);
+
+	/// Reorder vertices in order of first use by index buffer, and remap
+	/// index buffer in place.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_optimize_vertex_fetch`.
+	///
+	uint32_t topologyOptimizeVertexFetch(
+		  void* _dst
+		, uint32_t _dstSize
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		);
+
+	/// Calculate vertex cache statistics of triangle list.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_calc_stats`.
+	///
+	void topologyCalcStats(
+		  TopologyStats* _stats
+		, uint32_t _cacheSize
+		, const void* _indices
+		, uint32_t _numIndices
+		, uint32_t _numVertices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		);
+
+	/// Split triangle list into clusters with bounding sphere and normal
+	/// cone.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_build_clusters`.
+	///
+	uint32_t topologyBuildClusters(
+		  TopologyCluster* _clusters
+		, uint32_t _maxClusters
+		, void* _dst
+		, uint32_t _dstSize
+		, uint32_t _maxTriangles
+		, uint32_t _maxVertices
+		, const void* _vertices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		);
+
+	/// Build table of unique edges with planes of adjacent faces.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_build_edges`.
+	///
+	uint32_t topologyBuildEdges(
+		  TopologyEdge* _edges
+		, uint32_t _maxEdges
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		);
+
+	/// Reduce triangle count by collapsing edges using quadric error
+	/// metric.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_simplify`.
+	///
+	uint32_t topologySimplify(
+		  void* _dst
+		, uint32_t _dstSize
+		, uint32_t _numTargetIndices
+		, float _maxError
+		, const VertexDecl& _decl
+		, const void* _vertices
+		, uint32_t _numVertices
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bx::AllocatorI* _allocator
+		);
+
 } // namespace bgfx
 
 #endif // BGFX_TOPOLOGY_H_HEADER_GUARD
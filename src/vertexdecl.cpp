@@ -4,10 +4,14 @@
  */
 
 #include <bx/debug.h>
+#include <bx/fpumath.h>
 #include <bx/hash.h>
+#include <bx/mutex.h>
 #include <bx/readerwriter.h>
+#include <bx/simd_t.h>
 #include <bx/sort.h>
 #include <bx/string.h>
+#include <bx/thread.h>
 #include <bx/uint32_t.h>
 
 #include "config.h"
@@ -57,10 +61,15 @@ namespace bgfx
 	};
 	BX_STATIC_ASSERT(BX_COUNTOF(s_attribTypeSize) == RendererType::Count+1);
 
+	static void vertexConvertPlanCacheReset();
+
 	void initAttribTypeSizeTable(RendererType::Enum _type)
 	{
 		s_attribTypeSize[0]                   = s_attribTypeSize[_type];
 		s_attribTypeSize[RendererType::Count] = s_attribTypeSize[_type];
+
+		// Conversion plans store attribute sizes from this table.
+		vertexConvertPlanCacheReset();
 	}
 
 	VertexDecl::VertexDecl()
@@ -544,20 +553,20 @@ namespace bgfx
 				{
 					switch (num)
 					{
-					default: *_output++ = (float(*packed++) - 128.0f)*1.0f/127.0f;
-					case 3:  *_output++ = (float(*packed++) - 128.0f)*1.0f/127.0f;
-					case 2:  *_output++ = (float(*packed++) - 128.0f)*1.0f/127.0f;
-					case 1:  *_output++ = (float(*packed++) - 128.0f)*1.0f/127.0f;
+					default: *_output++ = (float(*packed++) - 128.0f)*(1.0f/127.0f);
+					case 3:  *_output++ = (float(*packed++) - 128.0f)*(1.0f/127.0f);
+					case 2:  *_output++ = (float(*packed++) - 128.0f)*(1.0f/127.0f);
+					case 1:  *_output++ = (float(*packed++) - 128.0f)*(1.0f/127.0f);
 					}
 				}
 				else
 				{
 					switch (num)
 					{
-					default: *_output++ = float(*packed++)*1.0f/255.0f;
-					case 3:  *_output++ = float(*packed++)*1.0f/255.0f;
-					case 2:  *_output++ = float(*packed++)*1.0f/255.0f;
-					case 1:  *_output++ = float(*packed++)*1.0f/255.0f;
+					default: *_output++ = float(*packed++)*(1.0f/255.0f);
+					case 3:  *_output++ = float(*packed++)*(1.0f/255.0f);
+					case 2:  *_output++ = float(*packed++)*(1.0f/255.0f);
+					case 1:  *_output++ = float(*packed++)*(1.0f/255.0f);
 					}
 				}
 			}
@@ -571,9 +580,9 @@ namespace bgfx
 					switch (num)
 					{
 					default:
-					case 3: *_output++ = (float(packed & 0x3ff) - 512.0f)*1.0f/511.0f; packed >>= 10;
-					case 2: *_output++ = (float(packed & 0x3ff) - 512.0f)*1.0f/511.0f; packed >>= 10;
-					case 1: *_output++ = (float(packed & 0x3ff) - 512.0f)*1.0f/511.0f;
+					case 3: *_output++ = (float(packed & 0x3ff) - 512.0f)*(1.0f/511.0f); packed >>= 10;
+					case 2: *_output++ = (float(packed & 0x3ff) - 512.0f)*(1.0f/511.0f); packed >>= 10;
+					case 1: *_output++ = (float(packed & 0x3ff) - 512.0f)*(1.0f/511.0f);
 					}
 				}
 				else
@@ -581,9 +590,9 @@ namespace bgfx
 					switch (num)
 					{
 					default:
-					case 3: *_output++ = float(packed & 0x3ff)*1.0f/1023.0f; packed >>= 10;
-					case 2: *_output++ = float(packed & 0x3ff)*1.0f/1023.0f; packed >>= 10;
-					case 1: *_output++ = float(packed & 0x3ff)*1.0f/1023.0f;
+					case 3: *_output++ = float(packed & 0x3ff)*(1.0f/1023.0f); packed >>= 10;
+					case 2: *_output++ = float(packed & 0x3ff)*(1.0f/1023.0f); packed >>= 10;
+					case 1: *_output++ = float(packed & 0x3ff)*(1.0f/1023.0f);
 					}
 				}
 			}
@@ -596,20 +605,20 @@ namespace bgfx
 				{
 					switch (num)
 					{
-					default: *_output++ = float(*packed++)*1.0f/32767.0f;
-					case 3:  *_output++ = float(*packed++)*1.0f/32767.0f;
-					case 2:  *_output++ = float(*packed++)*1.0f/32767.0f;
-					case 1:  *_output++ = float(*packed++)*1.0f/32767.0f;
+					default: *_output++ = float(*packed++)*(1.0f/32767.0f);
+					case 3:  *_output++ = float(*packed++)*(1.0f/32767.0f);
+					case 2:  *_output++ = float(*packed++)*(1.0f/32767.0f);
+					case 1:  *_output++ = float(*packed++)*(1.0f/32767.0f);
 					}
 				}
 				else
 				{
 					switch (num)
 					{
-					default: *_output++ = (float(*packed++) + 32768.0f)*1.0f/65535.0f;
-					case 3:  *_output++ = (float(*packed++) + 32768.0f)*1.0f/65535.0f;
-					case 2:  *_output++ = (float(*packed++) + 32768.0f)*1.0f/65535.0f;
-					case 1:  *_output++ = (float(*packed++) + 32768.0f)*1.0f/65535.0f;
+					default: *_output++ = (float(*packed++) + 32768.0f)*(1.0f/65535.0f);
+					case 3:  *_output++ = (float(*packed++) + 32768.0f)*(1.0f/65535.0f);
+					case 2:  *_output++ = (float(*packed++) + 32768.0f)*(1.0f/65535.0f);
+					case 1:  *_output++ = (float(*packed++) + 32768.0f)*(1.0f/65535.0f);
 					}
 				}
 			}
@@ -643,100 +652,448 @@ namespace bgfx
 		}
 	}
 
-	void vertexConvert(const VertexDecl& _destDecl, void* _destData, const VertexDecl& _srcDecl, const void* _srcData, uint32_t _num)
+	static void getPackScaleBias(AttribType::Enum _type, bool _inputNormalized, bool _asInt, float& _scale, float& _bias)
 	{
-		if (_destDecl.m_hash == _srcDecl.m_hash)
+		_scale = 1.0f;
+		_bias  = 0.0f;
+
+		if (_inputNormalized)
 		{
-			bx::memCopy(_destData, _srcData, _srcDecl.getSize(_num) );
-			return;
+			switch (_type)
+			{
+			case AttribType::Uint8:
+				_scale = _asInt ?   127.0f :   255.0f;
+				_bias  = _asInt ?   128.0f :     0.0f;
+				break;
+
+			case AttribType::Uint10:
+				_scale = _asInt ?   511.0f :  1023.0f;
+				_bias  = _asInt ?   512.0f :     0.0f;
+				break;
+
+			case AttribType::Int16:
+				_scale = _asInt ? 32767.0f : 65535.0f;
+				_bias  = _asInt ?     0.0f : -32768.0f;
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+
+	static void getUnpackBiasScale(AttribType::Enum _type, bool _asInt, float& _bias, float& _scale)
+	{
+		switch (_type)
+		{
+		default:
+		case AttribType::Uint8:
+			_bias  = _asInt ?  -128.0f :     0.0f;
+			_scale = _asInt ?   127.0f :   255.0f;
+			break;
+
+		case AttribType::Uint10:
+			_bias  = _asInt ?  -512.0f :     0.0f;
+			_scale = _asInt ?   511.0f :  1023.0f;
+			break;
+
+		case AttribType::Int16:
+			_bias  = _asInt ?     0.0f : 32768.0f;
+			_scale = _asInt ? 32767.0f : 65535.0f;
+			break;
+		}
+	}
+
+	static void packAttrib(uint8_t* _data, uint32_t _stride, const float* _input, uint32_t _numVertices, bool _inputNormalized, uint8_t _num, AttribType::Enum _type, bool _asInt)
+	{
+		using namespace bx;
+
+		switch (_type)
+		{
+		default:
+		case AttribType::Uint8:
+		case AttribType::Uint10:
+		case AttribType::Int16:
+			{
+				float scale;
+				float bias;
+				getPackScaleBias(_type, _inputNormalized, _asInt, scale, bias);
+
+				const simd128_t vscale = simd_splat(scale);
+				const simd128_t vbias  = simd_splat(bias);
+
+				BX_ALIGN_DECL_16(int32_t) packed[4];
+
+				for (uint32_t ii = 0; ii < _numVertices; ++ii, _input += 4, _data += _stride)
+				{
+					const simd128_t xyzw   = simd_ld(_input[0], _input[1], _input[2], _input[3]);
+					const simd128_t scaled = simd_mul(xyzw, vscale);
+					const simd128_t biased = simd_add(scaled, vbias);
+					simd_st(packed, simd_ftoi(biased) );
+
+					if (AttribType::Uint10 == _type)
+					{
+						uint32_t value;
+						switch (_num)
+						{
+						case 1:  value = uint32_t(packed[0]); break;
+						case 2:  value = (uint32_t(packed[0])<<10) | uint32_t(packed[1]); break;
+						default: value = (uint32_t(packed[0])<<20) | (uint32_t(packed[1])<<10) | uint32_t(packed[2]); break;
+						}
+
+						bx::memCopy(_data, &value, sizeof(uint32_t) );
+					}
+					else if (AttribType::Int16 == _type)
+					{
+						int16_t value[4] =
+						{
+							int16_t(packed[0]),
+							int16_t(packed[1]),
+							int16_t(packed[2]),
+							int16_t(packed[3]),
+						};
+						bx::memCopy(_data, value, _num*sizeof(int16_t) );
+					}
+					else
+					{
+						for (uint32_t jj = 0; jj < _num; ++jj)
+						{
+							_data[jj] = uint8_t(packed[jj]);
+						}
+					}
+				}
+			}
+			break;
+
+		case AttribType::Half:
+			for (uint32_t ii = 0; ii < _numVertices; ++ii, _input += 4, _data += _stride)
+			{
+				uint16_t value[4];
+				for (uint32_t jj = 0; jj < _num; ++jj)
+				{
+					value[jj] = bx::halfFromFloat(_input[jj]);
+				}
+				bx::memCopy(_data, value, _num*sizeof(uint16_t) );
+			}
+			break;
+
+		case AttribType::Float:
+			for (uint32_t ii = 0; ii < _numVertices; ++ii, _input += 4, _data += _stride)
+			{
+				bx::memCopy(_data, _input, _num*sizeof(float) );
+			}
+			break;
 		}
+	}
+
+	static void unpackAttrib(float* _output, const uint8_t* _data, uint32_t _stride, uint32_t _numVertices, uint8_t _num, AttribType::Enum _type, bool _asInt)
+	{
+		using namespace bx;
 
-		struct ConvertOp
+		switch (_type)
 		{
-			enum Enum
+		default:
+		case AttribType::Uint8:
+		case AttribType::Uint10:
+		case AttribType::Int16:
+			{
+				float bias;
+				float scale;
+				getUnpackBiasScale(_type, _asInt, bias, scale);
+
+				// Uint10 holds at most 3 components.
+				const uint32_t num = AttribType::Uint10 == _type
+					? bx::uint32_min(_num, 3)
+					: _num
+					;
+
+				// Multiply by reciprocal, same as vertexUnpack, so results are
+				// identical. simd_div is only an estimate on some platforms.
+				const simd128_t vbias  = simd_splat(bias);
+				const simd128_t vscale = simd_splat(1.0f/scale);
+				const simd128_t vmask  = simd_ild(
+					  0 < num ? UINT32_MAX : 0
+					, 1 < num ? UINT32_MAX : 0
+					, 2 < num ? UINT32_MAX : 0
+					, 3 < num ? UINT32_MAX : 0
+					);
+
+				BX_ALIGN_DECL_16(float) unpacked[4];
+
+				for (uint32_t ii = 0; ii < _numVertices; ++ii, _output += 4, _data += _stride)
+				{
+					uint32_t value[4] = { 0, 0, 0, 0 };
+
+					if (AttribType::Uint10 == _type)
+					{
+						uint32_t packed;
+						bx::memCopy(&packed, _data, sizeof(uint32_t) );
+						value[0] =  packed      & 0x3ff;
+						value[1] = (packed>>10) & 0x3ff;
+						value[2] = (packed>>20) & 0x3ff;
+					}
+					else if (AttribType::Int16 == _type)
+					{
+						int16_t packed[4];
+						bx::memCopy(packed, _data, num*sizeof(int16_t) );
+						for (uint32_t jj = 0; jj < num; ++jj)
+						{
+							value[jj] = uint32_t(int32_t(packed[jj]) );
+						}
+					}
+					else
+					{
+						for (uint32_t jj = 0; jj < num; ++jj)
+						{
+							value[jj] = _data[jj];
+						}
+					}
+
+					const simd128_t packed   = simd_ild(value[0], value[1], value[2], value[3]);
+					const simd128_t itof     = simd_itof(packed);
+					const simd128_t biased   = simd_add(itof, vbias);
+					const simd128_t scaled   = simd_mul(biased, vscale);
+					const simd128_t result   = simd_and(scaled, vmask);
+					simd_st(unpacked, result);
+					bx::memCopy(_output, unpacked, 4*sizeof(float) );
+				}
+			}
+			break;
+
+		case AttribType::Half:
+			for (uint32_t ii = 0; ii < _numVertices; ++ii, _output += 4, _data += _stride)
+			{
+				uint16_t packed[4];
+				bx::memCopy(packed, _data, _num*sizeof(uint16_t) );
+				for (uint32_t jj = 0; jj < 4; ++jj)
+				{
+					_output[jj] = jj < _num ? bx::halfToFloat(packed[jj]) : 0.0f;
+				}
+			}
+			break;
+
+		case AttribType::Float:
+			for (uint32_t ii = 0; ii < _numVertices; ++ii, _output += 4, _data += _stride)
 			{
-				Set,
-				Copy,
-				Convert,
-			};
+				bx::memSet(_output, 0, 4*sizeof(float) );
+				bx::memCopy(_output, _data, _num*sizeof(float) );
+			}
+			break;
+		}
+	}
+
+	void vertexPackN(const float* _input, bool _inputNormalized, Attrib::Enum _attr, const VertexDecl& _decl, void* _data, uint32_t _num, uint32_t _index)
+	{
+		if (!_decl.has(_attr) )
+		{
+			return;
+		}
+
+		uint32_t stride = _decl.getStride();
+		uint8_t* data = (uint8_t*)_data + _index*stride + _decl.getOffset(_attr);
+
+		uint8_t num;
+		AttribType::Enum type;
+		bool normalized;
+		bool asInt;
+		_decl.decode(_attr, num, type, normalized, asInt);
+
+		packAttrib(data, stride, _input, _num, _inputNormalized, num, type, asInt);
+	}
+
+	void vertexUnpackN(float* _output, Attrib::Enum _attr, const VertexDecl& _decl, const void* _data, uint32_t _num, uint32_t _index)
+	{
+		if (!_decl.has(_attr) )
+		{
+			bx::memSet(_output, 0, _num*4*sizeof(float) );
+			return;
+		}
+
+		uint32_t stride = _decl.getStride();
+		const uint8_t* data = (const uint8_t*)_data + _index*stride + _decl.getOffset(_attr);
+
+		uint8_t num;
+		AttribType::Enum type;
+		bool normalized;
+		bool asInt;
+		_decl.decode(_attr, num, type, normalized, asInt);
+
+		unpackAttrib(_output, data, stride, _num, num, type, asInt);
+	}
 
-			Attrib::Enum attr;
-			Enum op;
-			uint32_t src;
-			uint32_t dest;
-			uint32_t size;
+	struct VertexConvertOp
+	{
+		enum Enum
+		{
+			Set,
+			Copy,
+			Convert,
 		};
 
-		ConvertOp convertOp[Attrib::Count];
-		uint32_t numOps = 0;
+		Enum op;
+		uint16_t src;
+		uint16_t dest;
+		uint16_t size;
+
+		AttribType::Enum srcType;
+		AttribType::Enum destType;
+		uint8_t srcNum;
+		uint8_t destNum;
+		bool srcAsInt;
+		bool destAsInt;
+	};
+
+	struct VertexConvertPlan
+	{
+		uint32_t destHash;
+		uint32_t srcHash;
+		uint32_t numOps;
+		VertexConvertOp op[Attrib::Count];
+	};
+
+	static bx::Mutex s_vertexConvertPlanLock;
+	static VertexConvertPlan s_vertexConvertPlan[BGFX_CONFIG_MAX_VERTEX_CONVERT_PLANS];
+
+	static void vertexConvertPlanCacheReset()
+	{
+		bx::MutexScope lock(s_vertexConvertPlanLock);
+		bx::memSet(s_vertexConvertPlan, 0, sizeof(s_vertexConvertPlan) );
+	}
+
+	static void vertexConvertPlanBuild(VertexConvertPlan& _plan, const VertexDecl& _destDecl, const VertexDecl& _srcDecl)
+	{
+		_plan.destHash = _destDecl.m_hash;
+		_plan.srcHash  = _srcDecl.m_hash;
+		_plan.numOps   = 0;
 
 		for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
 		{
 			Attrib::Enum attr = (Attrib::Enum)ii;
 
-			if (_destDecl.has(attr) )
+			if (!_destDecl.has(attr) )
 			{
-				ConvertOp& cop = convertOp[numOps];
-				cop.attr = attr;
-				cop.dest = _destDecl.getOffset(attr);
+				continue;
+			}
 
-				uint8_t num;
-				AttribType::Enum type;
-				bool normalized;
-				bool asInt;
-				_destDecl.decode(attr, num, type, normalized, asInt);
-				cop.size = (*s_attribTypeSize[0])[type][num-1];
+			VertexConvertOp cop;
+			cop.dest = _destDecl.getOffset(attr);
+			cop.src  = 0;
 
-				if (_srcDecl.has(attr) )
-				{
-					cop.src = _srcDecl.getOffset(attr);
-					cop.op = _destDecl.m_attributes[attr] == _srcDecl.m_attributes[attr] ? ConvertOp::Copy : ConvertOp::Convert;
-				}
-				else
+			bool normalized;
+			_destDecl.decode(attr, cop.destNum, cop.destType, normalized, cop.destAsInt);
+			cop.size = (*s_attribTypeSize[0])[cop.destType][cop.destNum-1];
+
+			cop.srcType  = cop.destType;
+			cop.srcNum   = cop.destNum;
+			cop.srcAsInt = cop.destAsInt;
+
+			if (_srcDecl.has(attr) )
+			{
+				cop.src = _srcDecl.getOffset(attr);
+				cop.op  = _destDecl.m_attributes[attr] == _srcDecl.m_attributes[attr] ? VertexConvertOp::Copy : VertexConvertOp::Convert;
+				_srcDecl.decode(attr, cop.srcNum, cop.srcType, normalized, cop.srcAsInt);
+			}
+			else
+			{
+				cop.op = VertexConvertOp::Set;
+			}
+
+			// Merge with previous op when both source and destination ranges
+			// are adjacent.
+			if (0 < _plan.numOps)
+			{
+				VertexConvertOp& prev = _plan.op[_plan.numOps-1];
+				if (prev.op == cop.op
+				&&  VertexConvertOp::Convert != cop.op
+				&&  prev.dest + prev.size == cop.dest
+				&& (VertexConvertOp::Set == cop.op || prev.src + prev.size == cop.src) )
 				{
-					cop.op = ConvertOp::Set;
+					prev.size += cop.size;
+					continue;
 				}
-
-				++numOps;
 			}
+
+			_plan.op[_plan.numOps++] = cop;
+		}
+	}
+
+	static void vertexConvertPlanGet(VertexConvertPlan& _plan, const VertexDecl& _destDecl, const VertexDecl& _srcDecl)
+	{
+		const uint32_t idx = (_destDecl.m_hash ^ (_srcDecl.m_hash*31) ) % BGFX_CONFIG_MAX_VERTEX_CONVERT_PLANS;
+
+		bx::MutexScope lock(s_vertexConvertPlanLock);
+
+		VertexConvertPlan& plan = s_vertexConvertPlan[idx];
+		if (plan.destHash != _destDecl.m_hash
+		||  plan.srcHash  != _srcDecl.m_hash
+		||  0 == plan.numOps)
+		{
+			vertexConvertPlanBuild(plan, _destDecl, _srcDecl);
+		}
+
+		bx::memCopy(&_plan, &plan, sizeof(VertexConvertPlan) );
+	}
+
+	void vertexConvert(const VertexDecl& _destDecl, void* _destData, const VertexDecl& _srcDecl, const void* _srcData, uint32_t _num)
+	{
+		if (_destDecl.m_hash == _srcDecl.m_hash)
+		{
+			bx::memCopy(_destData, _srcData, _srcDecl.getSize(_num) );
+			return;
 		}
 
-		if (0 < numOps)
+		VertexConvertPlan plan;
+		vertexConvertPlanGet(plan, _destDecl, _srcDecl);
+
+		if (0 == plan.numOps)
 		{
-			const uint8_t* src = (const uint8_t*)_srcData;
-			uint32_t srcStride = _srcDecl.getStride();
+			return;
+		}
+
+		const uint8_t* src = (const uint8_t*)_srcData;
+		uint32_t srcStride = _srcDecl.getStride();
 
-			uint8_t* dest = (uint8_t*)_destData;
-			uint32_t destStride = _destDecl.getStride();
+		uint8_t* dest = (uint8_t*)_destData;
+		uint32_t destStride = _destDecl.getStride();
 
-			float unpacked[4];
+		// Vertices are processed in small batches so that every op of the
+		// plan works on data that is still in cache.
+		const uint32_t batchSize = 64;
+		float unpacked[batchSize*4];
 
-			for (uint32_t ii = 0; ii < _num; ++ii)
+		for (uint32_t ii = 0; ii < _num; ii += batchSize)
+		{
+			const uint32_t num = bx::uint32_min(batchSize, _num - ii);
+
+			for (uint32_t jj = 0; jj < plan.numOps; ++jj)
 			{
-				for (uint32_t jj = 0; jj < numOps; ++jj)
+				const VertexConvertOp& cop = plan.op[jj];
+
+				switch (cop.op)
 				{
-					const ConvertOp& cop = convertOp[jj];
+				case VertexConvertOp::Set:
+					for (uint32_t kk = 0; kk < num; ++kk)
+					{
+						bx::memSet(dest + kk*destStride + cop.dest, 0, cop.size);
+					}
+					break;
 
-					switch (cop.op)
+				case VertexConvertOp::Copy:
+					for (uint32_t kk = 0; kk < num; ++kk)
 					{
-					case ConvertOp::Set:
-						bx::memSet(dest + cop.dest, 0, cop.size);
-						break;
-
-					case ConvertOp::Copy:
-						bx::memCopy(dest + cop.dest, src + cop.src, cop.size);
-						break;
-
-					case ConvertOp::Convert:
-						vertexUnpack(unpacked, cop.attr, _srcDecl, src);
-						vertexPack(unpacked, true, cop.attr, _destDecl, dest);
-						break;
+						bx::memCopy(dest + kk*destStride + cop.dest, src + kk*srcStride + cop.src, cop.size);
 					}
-				}
+					break;
 
-				src += srcStride;
-				dest += destStride;
+				case VertexConvertOp::Convert:
+					unpackAttrib(unpacked, src + cop.src, srcStride, num, cop.srcNum, cop.srcType, cop.srcAsInt);
+					packAttrib(dest + cop.dest, destStride, unpacked, num, true, cop.destNum, cop.destType, cop.destAsInt);
+					break;
+				}
 			}
+
+			src  += num*srcStride;
+			dest += num*destStride;
 		}
 	}
 
@@ -834,4 +1191,300 @@ namespace bgfx
 		return (uint16_t)numVertices;
 	}
 
+	inline int32_t weldCellCoord(float _value)
+	{
+		// Clamp to keep far away or non-finite positions in int32 range.
+		return int32_t(bx::fclamp(bx::ffloor(_value), -1073741824.0f, 1073741824.0f) );
+	}
+
+	inline uint32_t weldCellHash(int32_t _x, int32_t _y, int32_t _z)
+	{
+		return (uint32_t(_x)*73856093u)
+			^  (uint32_t(_y)*19349663u)
+			^  (uint32_t(_z)*83492791u)
+			;
+	}
+
+	static bool weldCompareAttribs(const VertexDecl& _decl, const void* _data, uint32_t _a, uint32_t _b, const Attrib::Enum* _attribs, uint32_t _numAttribs, float _epsilonSq)
+	{
+		for (uint32_t ii = 0; ii < _numAttribs; ++ii)
+		{
+			float aa[4];
+			float bb[4];
+			vertexUnpack(aa, _attribs[ii], _decl, _data, _a);
+			vertexUnpack(bb, _attribs[ii], _decl, _data, _b);
+
+			const float xx = aa[0] - bb[0];
+			const float yy = aa[1] - bb[1];
+			const float zz = aa[2] - bb[2];
+			const float ww = aa[3] - bb[3];
+			if (xx*xx + yy*yy + zz*zz + ww*ww >= _epsilonSq)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Welding runs in three phases that can be split between threads:
+	// - Prepare unpacks positions and computes grid cells for range of
+	//   vertices.
+	// - Bucket links all vertices into hash chains, each thread owns range
+	//   of hash buckets. Chains are built in ascending vertex order.
+	// - Search finds lowest index earlier vertex within epsilon for range
+	//   of vertices.
+	// Final pass that picks unique vertices is sequential, but it only has
+	// to search again when the earlier vertex found is not unique itself.
+	struct WeldJob
+	{
+		enum Enum
+		{
+			Prepare,
+			Bucket,
+			Search,
+		};
+
+		Enum phase;
+		const VertexDecl* decl;
+		const void* data;
+		float* pos;
+		int32_t* cell;
+		uint32_t* hash;
+		uint32_t* hashTable;
+		uint32_t* next;
+		uint32_t* output;
+		const Attrib::Enum* attribs;
+		uint32_t numAttribs;
+		float invCellSize;
+		float epsilonSq;
+		uint32_t hashMask;
+		uint32_t num;
+		uint32_t begin;
+		uint32_t end;
+	};
+
+	// Returns lowest index vertex before _idx within epsilon, or UINT32_MAX.
+	// When _unique is set, only vertices that are not welded to other vertex
+	// are considered.
+	static uint32_t weldFind(const WeldJob& _job, uint32_t _idx, bool _unique)
+	{
+		const float*   vpos  = &_job.pos[_idx*4];
+		const int32_t* vcell = &_job.cell[_idx*3];
+
+		uint32_t weld = _idx;
+
+		for (int32_t zz = -1; zz <= 1; ++zz)
+		{
+			for (int32_t yy = -1; yy <= 1; ++yy)
+			{
+				for (int32_t xx = -1; xx <= 1; ++xx)
+				{
+					const uint32_t hashValue = weldCellHash(vcell[0]+xx, vcell[1]+yy, vcell[2]+zz) & _job.hashMask;
+
+					// Chains are in ascending order, first match in chain is
+					// the lowest one.
+					for (uint32_t offset = _job.hashTable[hashValue]; offset < weld; offset = _job.next[offset])
+					{
+						if ( (!_unique || offset == _job.output[offset])
+						&&  sqLength(&_job.pos[offset*4], vpos) < _job.epsilonSq
+						&&  weldCompareAttribs(*_job.decl, _job.data, offset, _idx, _job.attribs, _job.numAttribs, _job.epsilonSq) )
+						{
+							weld = offset;
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		return weld < _idx ? weld : UINT32_MAX;
+	}
+
+	static void weldExecute(const WeldJob& _job)
+	{
+		switch (_job.phase)
+		{
+		case WeldJob::Prepare:
+			{
+				float* pos    = &_job.pos[_job.begin*4];
+				int32_t* cell = &_job.cell[_job.begin*3];
+				const uint32_t num = _job.end - _job.begin;
+
+				vertexUnpackN(pos, Attrib::Position, *_job.decl, _job.data, num, _job.begin);
+
+				for (uint32_t ii = _job.begin; ii < _job.end; ++ii, pos += 4, cell += 3)
+				{
+					cell[0] = weldCellCoord(pos[0]*_job.invCellSize);
+					cell[1] = weldCellCoord(pos[1]*_job.invCellSize);
+					cell[2] = weldCellCoord(pos[2]*_job.invCellSize);
+					_job.hash[ii] = weldCellHash(cell[0], cell[1], cell[2]) & _job.hashMask;
+				}
+			}
+			break;
+
+		case WeldJob::Bucket:
+			for (uint32_t ii = _job.num; 0 < ii--;)
+			{
+				const uint32_t hashValue = _job.hash[ii];
+				if (hashValue >= _job.begin
+				&&  hashValue <  _job.end)
+				{
+					_job.next[ii] = _job.hashTable[hashValue];
+					_job.hashTable[hashValue] = ii;
+				}
+			}
+			break;
+
+		case WeldJob::Search:
+			for (uint32_t ii = _job.begin; ii < _job.end; ++ii)
+			{
+				_job.output[ii] = weldFind(_job, ii, false);
+			}
+			break;
+		}
+	}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	static int32_t weldThreadFunc(void* _userData)
+	{
+		weldExecute(*(const WeldJob*)_userData);
+		return 0;
+	}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	// Splits _num items of phase evenly between threads, calling thread
+	// executes first range.
+	static void weldRun(WeldJob* _job, uint32_t _numThreads, WeldJob::Enum _phase, uint32_t _num)
+	{
+		const uint32_t numPerThread = (_num + _numThreads - 1)/_numThreads;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+		bx::Thread thread[BGFX_CONFIG_WELD_NUM_THREADS+1];
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+		for (uint32_t ii = 0; ii < _numThreads; ++ii)
+		{
+			WeldJob& job = _job[ii];
+			job.phase = _phase;
+			job.begin = bx::uint32_min(ii*numPerThread, _num);
+			job.end   = bx::uint32_min(job.begin+numPerThread, _num);
+
+#if BX_CONFIG_SUPPORTS_THREADING
+			if (0 != ii)
+			{
+				thread[ii].init(weldThreadFunc, &job, 0, "bgfx - weld thread");
+			}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+		}
+
+		weldExecute(_job[0]);
+
+#if BX_CONFIG_SUPPORTS_THREADING
+		for (uint32_t ii = 1; ii < _numThreads; ++ii)
+		{
+			thread[ii].shutdown();
+		}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+	}
+
+	uint32_t weldVertices(uint32_t* _output, const VertexDecl& _decl, const void* _data, uint32_t _num, float _epsilon, uint8_t _flags, bx::AllocatorI* _allocator)
+	{
+		if (0 == _num)
+		{
+			return 0;
+		}
+
+		// Vertices closer than epsilon are at most one grid cell apart on
+		// each axis, so only neighbouring cells need to be searched.
+		const float cellSize  = 0.0f < _epsilon ? _epsilon : 1.0f;
+		const uint32_t hashSize = bx::uint32_nextpow2(_num);
+
+		float*    pos       = (float*   )BX_ALLOC(_allocator, _num*4*sizeof(float) );
+		int32_t*  cell      = (int32_t* )BX_ALLOC(_allocator, _num*3*sizeof(int32_t) );
+		uint32_t* hash      = (uint32_t*)BX_ALLOC(_allocator, _num*sizeof(uint32_t) );
+		uint32_t* hashTable = (uint32_t*)BX_ALLOC(_allocator, (hashSize+_num)*sizeof(uint32_t) );
+		bx::memSet(hashTable, 0xff, hashSize*sizeof(uint32_t) );
+
+		Attrib::Enum attribs[Attrib::Count];
+		uint32_t numAttribs = 0;
+		if (0 != (_flags & BGFX_WELD_ALL_ATTRIBUTES) )
+		{
+			for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
+			{
+				const Attrib::Enum attr = Attrib::Enum(ii);
+				if (Attrib::Position != attr
+				&&  _decl.has(attr) )
+				{
+					attribs[numAttribs++] = attr;
+				}
+			}
+		}
+
+		uint32_t numThreads = 1;
+#if BX_CONFIG_SUPPORTS_THREADING
+		if (0 != (_flags & BGFX_WELD_MULTITHREADED) )
+		{
+			numThreads = bx::uint32_clamp(_num/BGFX_CONFIG_WELD_MIN_VERTICES_PER_THREAD, 1, BGFX_CONFIG_WELD_NUM_THREADS+1);
+		}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+		WeldJob job[BGFX_CONFIG_WELD_NUM_THREADS+1];
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			WeldJob& weld = job[ii];
+			weld.decl        = &_decl;
+			weld.data        = _data;
+			weld.pos         = pos;
+			weld.cell        = cell;
+			weld.hash        = hash;
+			weld.hashTable   = hashTable;
+			weld.next        = hashTable + hashSize;
+			weld.output      = _output;
+			weld.attribs     = attribs;
+			weld.numAttribs  = numAttribs;
+			weld.invCellSize = 1.0f/cellSize;
+			weld.epsilonSq   = _epsilon*_epsilon;
+			weld.hashMask    = hashSize-1;
+			weld.num         = _num;
+		}
+
+		weldRun(job, numThreads, WeldJob::Prepare, _num);
+		weldRun(job, numThreads, WeldJob::Bucket,  hashSize);
+		weldRun(job, numThreads, WeldJob::Search,  _num);
+
+		// Pick lowest index unique vertex within epsilon, this gives the
+		// same result as brute force welding. Earlier vertices are final
+		// here, and unique vertices map to themselves.
+		uint32_t numVertices = 0;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			uint32_t weld = _output[ii];
+
+			if (UINT32_MAX != weld
+			&&  weld != _output[weld])
+			{
+				weld = weldFind(job[0], ii, true);
+			}
+
+			if (UINT32_MAX == weld)
+			{
+				_output[ii] = ii;
+				++numVertices;
+			}
+			else
+			{
+				_output[ii] = weld;
+			}
+		}
+
+		BX_FREE(_allocator, hashTable);
+		BX_FREE(_allocator, hash);
+		BX_FREE(_allocator, cell);
+		BX_FREE(_allocator, pos);
+
+		return numVertices;
+	}
+
 } // namespace bgfx
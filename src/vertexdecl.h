@@ -7,6 +7,7 @@
 #define BGFX_VERTEXDECL_H_HEADER_GUARD
 
 #include <bgfx/bgfx.h>
+#include <bx/allocator.h>
 #include <bx/readerwriter.h>
 
 namespace bgfx
@@ -35,6 +36,28 @@ namespace bgfx
 	///
 	int32_t read(bx::ReaderI* _reader, bgfx::VertexDecl& _decl, bx::Error* _err = NULL);
 
+	/// Weld vertices.
+	///
+	/// @param[in] _output Welded vertices remapping table. The size of buffer
+	///   must be the same as number of vertices.
+	/// @param[in] _decl Vertex stream declaration.
+	/// @param[in] _data Vertex stream.
+	/// @param[in] _num Number of vertices in vertex stream.
+	/// @param[in] _epsilon Error tolerance for vertex position comparison.
+	/// @param[in] _flags Weld flags, see `BGFX_WELD_*`.
+	/// @param[in] _allocator Allocator used for temporary storage.
+	/// @returns Number of unique vertices after vertex welding.
+	///
+	uint32_t weldVertices(
+		  uint32_t* _output
+		, const VertexDecl& _decl
+		, const void* _data
+		, uint32_t _num
+		, float _epsilon
+		, uint8_t _flags
+		, bx::AllocatorI* _allocator
+		);
+
 } // namespace bgfx
 
 #endif // BGFX_VERTEXDECL_H_HEADER_GUARD
@@ -11,6 +11,7 @@
 #include <string.h>
 
 #include <bgfx/bgfx.h>
+#include "../../src/topology.h"
 #include "../../src/vertexdecl.h"
 
 #include <tinystl/allocator.h>
@@ -113,12 +114,24 @@ struct Primitive
 
 typedef std::vector<Primitive> PrimitiveArray;
 
+typedef std::vector<bgfx::TopologyCluster> ClusterArray;
+
+struct Lod
+{
+	float m_ratio;
+	PrimitiveArray m_primitives;
+};
+
+typedef std::vector<Lod> LodArray;
+
 static uint32_t s_obbSteps = 17;
 
 #define BGFX_CHUNK_MAGIC_VB  BX_MAKEFOURCC('V', 'B', ' ', 0x1)
 #define BGFX_CHUNK_MAGIC_IB  BX_MAKEFOURCC('I', 'B', ' ', 0x0)
 #define BGFX_CHUNK_MAGIC_IBC BX_MAKEFOURCC('I', 'B', 'C', 0x0)
 #define BGFX_CHUNK_MAGIC_PRI BX_MAKEFOURCC('P', 'R', 'I', 0x0)
+#define BGFX_CHUNK_MAGIC_CLU BX_MAKEFOURCC('C', 'L', 'U', 0x0)
+#define BGFX_CHUNK_MAGIC_LOD BX_MAKEFOURCC('L', 'O', 'D', 0x0)
 
 long int fsize(FILE* _file)
 {
@@ -137,6 +150,90 @@ void triangleReorder(uint16_t* _indices, uint32_t _numIndices, uint32_t _numVert
 	delete [] newIndexList;
 }
 
+void triangleCluster(ClusterArray& _clusters, uint16_t* _indices, uint32_t _startIndex, uint32_t _numIndices, const uint8_t* _vertexData, uint32_t _numVertices, uint16_t _stride, uint32_t _maxTriangles)
+{
+	bx::CrtAllocator allocator;
+
+	const uint32_t num = bgfx::topologyBuildClusters(NULL
+		, 0
+		, NULL
+		, 0
+		, _maxTriangles
+		, _maxTriangles
+		, _vertexData
+		, _numVertices
+		, _stride
+		, _indices
+		, _numIndices
+		, false
+		, &allocator
+		);
+
+	const uint32_t first = uint32_t(_clusters.size() );
+	_clusters.resize(first + num);
+
+	bgfx::topologyBuildClusters(&_clusters[first]
+		, num
+		, _indices
+		, _numIndices*2
+		, _maxTriangles
+		, _maxTriangles
+		, _vertexData
+		, _numVertices
+		, _stride
+		, _indices
+		, _numIndices
+		, false
+		, &allocator
+		);
+
+	for (uint32_t ii = first, end = first + num; ii < end; ++ii)
+	{
+		_clusters[ii].startIndex += _startIndex;
+	}
+}
+
+void triangleSimplify(LodArray& _lods, uint16_t* _indexData, uint32_t& _numIndices, const PrimitiveArray& _primitives, const uint8_t* _vertexData, uint32_t _numVertices, const bgfx::VertexDecl& _decl)
+{
+	bx::CrtAllocator allocator;
+
+	// Each LOD is simplified from full detail primitive, and appended
+	// after all other indices.
+	for (LodArray::iterator lodIt = _lods.begin(); lodIt != _lods.end(); ++lodIt)
+	{
+		Lod& lod = *lodIt;
+		lod.m_primitives.clear();
+
+		for (PrimitiveArray::const_iterator primIt = _primitives.begin(); primIt != _primitives.end(); ++primIt)
+		{
+			const Primitive& prim = *primIt;
+			const uint32_t numTarget = uint32_t(prim.m_numIndices*lod.m_ratio)/3*3;
+
+			uint16_t* indices = _indexData + _numIndices;
+			const uint32_t num = bgfx::topologySimplify(indices
+				, prim.m_numIndices*2
+				, numTarget
+				, bx::huge
+				, _decl
+				, _vertexData
+				, _numVertices
+				, _indexData + prim.m_startIndex
+				, prim.m_numIndices
+				, false
+				, &allocator
+				);
+			triangleReorder(indices, num, _numVertices, 32);
+
+			Primitive lodPrim = prim;
+			lodPrim.m_startIndex = _numIndices;
+			lodPrim.m_numIndices = num;
+			lod.m_primitives.push_back(lodPrim);
+
+			_numIndices += num;
+		}
+	}
+}
+
 void triangleCompress(bx::WriterI* _writer, uint16_t* _indices, uint32_t _numIndices, uint8_t* _vertexData, uint32_t _numVertices, uint16_t _stride)
 {
 	uint32_t* vertexRemap = (uint32_t*)malloc(_numVertices*sizeof(uint32_t) );
@@ -303,6 +400,8 @@ void write(bx::WriterI* _writer
 		, uint32_t _compressedSize
 		, const std::string& _material
 		, const PrimitiveArray& _primitives
+		, const ClusterArray& _clusters
+		, const LodArray& _lods
 		)
 {
 	using namespace bx;
@@ -331,6 +430,38 @@ void write(bx::WriterI* _writer
 		write(_writer, _indices, _numIndices*2);
 	}
 
+	if (!_clusters.empty() )
+	{
+		write(_writer, BGFX_CHUNK_MAGIC_CLU);
+		write(_writer, uint32_t(_clusters.size() ) );
+		for (ClusterArray::const_iterator it = _clusters.begin(); it != _clusters.end(); ++it)
+		{
+			const TopologyCluster& cluster = *it;
+			write(_writer, cluster.startIndex);
+			write(_writer, cluster.numIndices);
+			write(_writer, cluster.sphere, sizeof(cluster.sphere) );
+			write(_writer, cluster.cone, sizeof(cluster.cone) );
+		}
+	}
+
+	if (!_lods.empty() )
+	{
+		write(_writer, BGFX_CHUNK_MAGIC_LOD);
+		write(_writer, uint16_t(_lods.size() ) );
+		for (LodArray::const_iterator lodIt = _lods.begin(); lodIt != _lods.end(); ++lodIt)
+		{
+			const Lod& lod = *lodIt;
+			write(_writer, lod.m_ratio);
+			write(_writer, uint16_t(lod.m_primitives.size() ) );
+			for (PrimitiveArray::const_iterator primIt = lod.m_primitives.begin(); primIt != lod.m_primitives.end(); ++primIt)
+			{
+				const Primitive& prim = *primIt;
+				write(_writer, prim.m_startIndex);
+				write(_writer, prim.m_numIndices);
+			}
+		}
+	}
+
 	write(_writer, BGFX_CHUNK_MAGIC_PRI);
 	uint16_t nameLen = uint16_t(_material.size() );
 	write(_writer, nameLen);
@@ -389,6 +520,10 @@ void help(const char* _error = NULL)
 		  "      --tangent            Calculate tangent vectors (packing mode is the same as normal).\n"
 		  "      --barycentric        Adds barycentric vertex attribute (packed in bgfx::Attrib::Color1).\n"
 		  "  -c, --compress           Compress indices.\n"
+		  "      --clusters <num>     Split primitives into clusters of <num> triangles\n"
+		  "           (and at most <num> vertices) with bounds for per cluster culling.\n"
+		  "      --lod <ratios>       Generate simplified levels of detail, comma separated list\n"
+		  "           of triangle count ratios (for example 0.5,0.25). Not compatible with --compress.\n"
 
 		  "\n"
 		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
@@ -439,6 +574,36 @@ int main(int _argc, const char* _argv[])
 
 	bool compress = cmdLine.hasArg('c', "compress");
 
+	uint32_t clusterSize = 0;
+	cmdLine.hasArg(clusterSize, '\0', "clusters");
+	clusterSize = 0 == clusterSize ? 0 : bx::uint32_min(bx::uint32_max(clusterSize, 3), 512);
+
+	LodArray lods;
+	const char* lodArg = cmdLine.findOption("lod");
+	if (NULL != lodArg)
+	{
+		for (const char* str = lodArg; '\0' != *str;)
+		{
+			char* end;
+			Lod lod;
+			lod.m_ratio = bx::fmin(bx::fmax(strtof(str, &end), 0.0f), 1.0f);
+			if (end == str)
+			{
+				help("Invalid --lod ratios.");
+				return EXIT_FAILURE;
+			}
+
+			lods.push_back(lod);
+			str = ',' == *end ? end+1 : end;
+		}
+
+		if (compress)
+		{
+			printf("Warning: --compress is ignored with --lod.\n");
+			compress = false;
+		}
+	}
+
 	cmdLine.hasArg(s_obbSteps, '\0', "obb");
 	s_obbSteps = bx::uint32_min(bx::uint32_max(s_obbSteps, 1), 90);
 
@@ -814,7 +979,7 @@ int main(int _argc, const char* _argv[])
 
 	uint32_t stride = decl.getStride();
 	uint8_t* vertexData = new uint8_t[triangles.size() * 3 * stride];
-	uint16_t* indexData = new uint16_t[triangles.size() * 3];
+	uint16_t* indexData = new uint16_t[triangles.size() * 3 * (1 + lods.size() )];
 	int32_t numVertices = 0;
 	int32_t numIndices = 0;
 	int32_t numPrimitives = 0;
@@ -825,6 +990,7 @@ int main(int _argc, const char* _argv[])
 	std::string material = groups.begin()->m_material;
 
 	PrimitiveArray primitives;
+	ClusterArray clusters;
 
 	bx::CrtFileWriter writer;
 	if (!bx::open(&writer, outFilePath) )
@@ -870,6 +1036,18 @@ int main(int _argc, const char* _argv[])
 				{
 					const Primitive& prim1 = *primIt;
 					triangleReorder(indexData + prim1.m_startIndex, prim1.m_numIndices, numVertices, 32);
+					if (0 != clusterSize)
+					{
+						triangleCluster(clusters
+							, indexData + prim1.m_startIndex
+							, prim1.m_startIndex
+							, prim1.m_numIndices
+							, vertexData
+							, numVertices
+							, stride
+							, clusterSize
+							);
+					}
 					if (compress)
 					{
 						triangleCompress(&memWriter
@@ -883,6 +1061,13 @@ int main(int _argc, const char* _argv[])
 				}
 				triReorderElapsed += bx::getHPCounter();
 
+				if (!lods.empty() )
+				{
+					uint32_t num = numIndices;
+					triangleSimplify(lods, indexData, num, primitives, vertexData, numVertices, decl);
+					numIndices = num;
+				}
+
 				write(&writer
 					, vertexData
 					, numVertices
@@ -893,8 +1078,11 @@ int main(int _argc, const char* _argv[])
 					, memBlock.getSize()
 					, material
 					, primitives
+					, clusters
+					, lods
 					);
 				primitives.clear();
+				clusters.clear();
 
 				for (Index3Map::iterator indexIt = indexMap.begin(); indexIt != indexMap.end(); ++indexIt)
 				{
@@ -1001,6 +1189,18 @@ int main(int _argc, const char* _argv[])
 		{
 			const Primitive& prim1 = *primIt;
 			triangleReorder(indexData + prim1.m_startIndex, prim1.m_numIndices, numVertices, 32);
+			if (0 != clusterSize)
+			{
+				triangleCluster(clusters
+					, indexData + prim1.m_startIndex
+					, prim1.m_startIndex
+					, prim1.m_numIndices
+					, vertexData
+					, numVertices
+					, stride
+					, clusterSize
+					);
+			}
 			if (compress)
 			{
 				triangleCompress(&memWriter
@@ -1014,6 +1214,13 @@ int main(int _argc, const char* _argv[])
 		}
 		triReorderElapsed += bx::getHPCounter();
 
+		if (!lods.empty() )
+		{
+			uint32_t num = numIndices;
+			triangleSimplify(lods, indexData, num, primitives, vertexData, numVertices, decl);
+			numIndices = num;
+		}
+
 		write(&writer
 			, vertexData
 			, numVertices
@@ -1024,6 +1231,8 @@ int main(int _argc, const char* _argv[])
 			, memBlock.getSize()
 			, material
 			, primitives
+			, clusters
+			, lods
 			);
 	}
 
@@ -73,9 +73,13 @@ BX_PRAGMA_DIAGNOSTIC_POP()
 
 #include <bx/bx.h>
 #include <bx/commandline.h>
+#include <bx/cpu.h>
 #include <bx/crtimpl.h>
+#include <bx/thread.h>
 #include <bx/uint32_t.h>
 
+#define TEXTUREC_MAX_JOBS 64
+
 namespace bgfx
 {
 	bool imageParse(ImageContainer& _imageContainer, const void* _data, uint32_t _size, void** _out)
@@ -311,6 +315,154 @@ namespace bgfx
 		return false;
 	}
 
+	struct EncodeJob
+	{
+		void*       m_dst;
+		const void* m_src;
+		uint32_t    m_width;
+		uint32_t    m_height;
+		uint8_t     m_format;
+	};
+
+	class EncodeJobQueue
+	{
+	public:
+		EncodeJobQueue(bx::AllocatorI* _allocator, uint32_t _numThreads)
+			: m_allocator(_allocator)
+			, m_jobs(NULL)
+			, m_num(0)
+			, m_max(0)
+			, m_next(0)
+			, m_numThreads(bx::uint32_clamp(_numThreads, 1, TEXTUREC_MAX_JOBS) )
+		{
+		}
+
+		~EncodeJobQueue()
+		{
+			BX_FREE(m_allocator, m_jobs);
+		}
+
+		void add(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint8_t _format)
+		{
+			const TextureFormat::Enum format = TextureFormat::Enum(_format);
+
+			if (1 == m_numThreads
+			||  !isStripeable(format) )
+			{
+				push(_dst, _src, _width, _height, _format);
+				return;
+			}
+
+			// Split image into stripes of whole block rows. Encoders used for
+			// stripeable formats only look at pixels of the block they encode,
+			// so the result is identical to encoding the whole image at once.
+			const ImageBlockInfo& blockInfo = getBlockInfo(format);
+			const uint32_t blockHeight = blockInfo.blockHeight;
+			const uint32_t numBlocksX  = (_width  + blockInfo.blockWidth - 1)/blockInfo.blockWidth;
+			const uint32_t numBlocksY  = (_height + blockHeight - 1)/blockHeight;
+			const uint32_t numStripes  = bx::uint32_min(numBlocksY, m_numThreads*4);
+			const uint32_t stripeBlocksY = (numBlocksY + numStripes - 1)/numStripes;
+			const uint32_t srcPitch = _width*4;
+			const uint32_t dstPitch = numBlocksX*blockInfo.blockSize;
+
+			for (uint32_t yy = 0; yy < numBlocksY; yy += stripeBlocksY)
+			{
+				const uint32_t y0     = yy*blockHeight;
+				const uint32_t height = bx::uint32_min(stripeBlocksY*blockHeight, _height - y0);
+				push( (uint8_t*)_dst + yy*dstPitch
+					, (const uint8_t*)_src + y0*srcPitch
+					, _width
+					, height
+					, _format
+					);
+			}
+		}
+
+		void run()
+		{
+			m_next = 0;
+
+			const uint32_t numThreads = bx::uint32_min(m_numThreads, m_num);
+			for (uint32_t ii = 1; ii < numThreads; ++ii)
+			{
+				m_thread[ii].init(threadFunc, this, 0, "texturec - encode");
+			}
+
+			execute();
+
+			for (uint32_t ii = 1; ii < numThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+
+			m_num = 0;
+		}
+
+	private:
+		static bool isStripeable(TextureFormat::Enum _format)
+		{
+			switch (_format)
+			{
+			case TextureFormat::BC1:
+			case TextureFormat::BC2:
+			case TextureFormat::BC3:
+			case TextureFormat::BC4:
+			case TextureFormat::BC5:
+			case TextureFormat::ETC1:
+			case TextureFormat::ETC2:
+				return true;
+
+			default:
+				// PVRTC blocks depend on neighbouring blocks, uncompressed
+				// formats are not worth splitting, and nvtt encoders index
+				// output by whole image width.
+				break;
+			}
+
+			return false;
+		}
+
+		void push(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint8_t _format)
+		{
+			if (m_num == m_max)
+			{
+				m_max  = bx::uint32_max(64, m_max*2);
+				m_jobs = (EncodeJob*)BX_REALLOC(m_allocator, m_jobs, m_max*sizeof(EncodeJob) );
+			}
+
+			EncodeJob& job = m_jobs[m_num++];
+			job.m_dst    = _dst;
+			job.m_src    = _src;
+			job.m_width  = _width;
+			job.m_height = _height;
+			job.m_format = _format;
+		}
+
+		static int32_t threadFunc(void* _userData)
+		{
+			EncodeJobQueue* queue = (EncodeJobQueue*)_userData;
+			queue->execute();
+			return EXIT_SUCCESS;
+		}
+
+		void execute()
+		{
+			for (uint32_t idx = bx::atomicFetchAndAdd(&m_next, 1u); idx < m_num; idx = bx::atomicFetchAndAdd(&m_next, 1u) )
+			{
+				const EncodeJob& job = m_jobs[idx];
+				imageEncodeFromRgba8(job.m_dst, job.m_src, job.m_width, job.m_height, job.m_format);
+			}
+		}
+
+		bx::AllocatorI* m_allocator;
+		EncodeJob* m_jobs;
+		uint32_t m_num;
+		uint32_t m_max;
+		volatile uint32_t m_next;
+		uint32_t m_numThreads;
+		bx::Thread m_thread[TEXTUREC_MAX_JOBS];
+	};
+
 	bool imageEncodeFromRgba32f(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint8_t _format)
 	{
 		TextureFormat::Enum format = TextureFormat::Enum(_format);
@@ -507,6 +659,7 @@ void help(const char* _error = NULL)
 		  "  -n, --normalmap          Input texture is normal map.\n"
 		  "      --sdf <edge>         Compute SDF texture.\n"
 		  "      --iqa                Image Quality Assesment\n"
+		  "  -j, --jobs <num>         Number of encoder threads (default: 1).\n"
 
 		  "\n"
 		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
@@ -551,6 +704,13 @@ int main(int _argc, const char* _argv[])
 	const bool normalMap = cmdLine.hasArg('n',  "normalmap");
 	const bool iqa       = cmdLine.hasArg('\0', "iqa");
 
+	uint32_t numJobs = 1;
+	const char* jobsOpt = cmdLine.findOption('j', "jobs");
+	if (NULL != jobsOpt)
+	{
+		numJobs = bx::uint32_clamp(uint32_t(atoi(jobsOpt) ), 1, TEXTUREC_MAX_JOBS);
+	}
+
 	bx::CrtFileReader reader;
 	if (!bx::open(&reader, inputFileName) )
 	{
@@ -800,16 +960,39 @@ int main(int _argc, const char* _argv[])
 						memcpy(ref, rgba, size);
 					}
 
-					imageEncodeFromRgba8(output->m_data, rgba, dstMip.m_width, dstMip.m_height, format);
+					// Mip chain is downsampled in place, so each level's input is
+					// copied aside and all levels are encoded together.
+					uint32_t mipSrcSize = 0;
+					for (uint8_t lod = 0; lod < numMips; ++lod)
+					{
+						imageGetRawData(*output, 0, lod, output->m_data, output->m_size, dstMip);
+						mipSrcSize += dstMip.m_width*dstMip.m_height*4;
+					}
+
+					uint8_t* mipSrc = (uint8_t*)BX_ALLOC(&allocator, mipSrcSize);
+					uint8_t* mipSrcPtr = mipSrc;
+
+					EncodeJobQueue jobs(&allocator, numJobs);
+
+					imageGetRawData(*output, 0, 0, output->m_data, output->m_size, dstMip);
+					memcpy(mipSrcPtr, rgba, dstMip.m_width*dstMip.m_height*4);
+					jobs.add(output->m_data, mipSrcPtr, dstMip.m_width, dstMip.m_height, format);
+					mipSrcPtr += dstMip.m_width*dstMip.m_height*4;
 
 					for (uint8_t lod = 1; lod < numMips; ++lod)
 					{
 						imageRgba8Downsample2x2(rgba, dstMip.m_width, dstMip.m_height, dstMip.m_width*4, rgba);
 						imageGetRawData(*output, 0, lod, output->m_data, output->m_size, dstMip);
 						uint8_t* data = const_cast<uint8_t*>(dstMip.m_data);
-						imageEncodeFromRgba8(data, rgba, dstMip.m_width, dstMip.m_height, format);
+						memcpy(mipSrcPtr, rgba, dstMip.m_width*dstMip.m_height*4);
+						jobs.add(data, mipSrcPtr, dstMip.m_width, dstMip.m_height, format);
+						mipSrcPtr += dstMip.m_width*dstMip.m_height*4;
 					}
 
+					jobs.run();
+
+					BX_FREE(&allocator, mipSrc);
+
 					if (NULL != ref)
 					{
 						imageDecodeToRgba8(rgba